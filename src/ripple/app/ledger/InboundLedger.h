@@ -86,6 +86,11 @@ public:
     /** Return a Json::objectValue. */
     Json::Value getJson (int);
 
+    /** Returns an estimate of the bytes held by this acquisition,
+        including peer data which has not been processed yet.
+    */
+    std::size_t getMemoryUsage ();
+
     void runData ();
 
 private:
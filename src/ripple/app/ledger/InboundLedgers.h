@@ -68,6 +68,9 @@ public:
 
     virtual Json::Value getInfo() = 0;
 
+    /** Returns an estimate of the bytes held by in-flight acquisitions. */
+    virtual std::size_t getMemoryUsage() = 0;
+
     /** Returns the rate of historical ledger fetches per minute. */
     virtual std::size_t fetchRate() = 0;
 
@@ -28,9 +28,11 @@
 #include <ripple/app/ledger/PendingSaves.h>
 #include <ripple/app/ledger/TransactionMaster.h>
 #include <ripple/app/main/Application.h>
+#include <ripple/app/misc/AccountTxIndex.h>
 #include <ripple/app/misc/HashRouter.h>
 #include <ripple/app/misc/LoadFeeTrack.h>
 #include <ripple/app/misc/NetworkOPs.h>
+#include <ripple/app/misc/ValidationArchive.h>
 #include <ripple/basics/contract.h>
 #include <ripple/basics/Log.h>
 #include <ripple/basics/StringUtilities.h>
@@ -450,6 +452,25 @@ Ledger::read (Keylet const& k) const
     return std::move(sle);
 }
 
+boost::optional<STLedgerEntryView>
+Ledger::readLazy (Keylet const& k) const
+{
+    if (k.key == zero)
+    {
+        assert(false);
+        return boost::none;
+    }
+    auto const& item =
+        stateMap_->peekItem(k.key);
+    if (! item)
+        return boost::none;
+    STLedgerEntryView view (item->key(),
+        Slice{item->data(), item->size()}, item);
+    if (! k.check(view.getType()))
+        return boost::none;
+    return view;
+}
+
 //------------------------------------------------------------------------------
 
 auto
@@ -878,6 +899,9 @@ static bool saveValidatedLedger (
         *db << boost::str (deleteLedger % seq);
     }
 
+    auto const index = app.getAccountTxIndex ();
+    std::vector<AccountTxIndex::Entry> indexEntries;
+
     {
         auto db = app.getTxnDB ().checkoutDb ();
 
@@ -932,6 +956,10 @@ static bool saveValidatedLedger (
                     sql += ",";
                     sql += txnSeq;
                     sql += ")";
+
+                    if (index)
+                        indexEntries.push_back ({account,
+                            vt.second->getTxnSeq (), transactionID});
                 }
                 sql += ";";
                 JLOG (j.trace()) << "ActTx: " << sql;
@@ -953,6 +981,9 @@ static bool saveValidatedLedger (
         tr.commit ();
     }
 
+    if (index)
+        index->saveLedger (seq, indexEntries);
+
     {
         static std::string addLedger(
             R"sql(INSERT OR REPLACE INTO Ledgers
@@ -1003,6 +1034,8 @@ static bool saveValidatedLedger (
         tr.commit();
     }
 
+    app.getValidationArchive ().ledgerSaved (seq, ledger->info().hash);
+
     // Clients can now trust the database for
     // information about this ledger sequence.
     app.pendingSaves().finishWork(seq);
@@ -1109,7 +1142,7 @@ loadLedgerHelper(std::string const& sqlSuffix, Application& app)
     uint256 ledgerHash{};
     std::uint32_t ledgerSeq{0};
 
-    auto db = app.getLedgerDB ().checkoutDb ();
+    auto db = app.getLedgerDB ().checkoutReadDb ();
 
     boost::optional<std::string> sLedgerHash, sPrevHash, sAccountHash,
         sTransHash;
@@ -1252,7 +1285,7 @@ getHashByIndex (std::uint32_t ledgerIndex, Application& app)
 
     std::string hash;
     {
-        auto db = app.getLedgerDB ().checkoutDb ();
+        auto db = app.getLedgerDB ().checkoutReadDb ();
 
         boost::optional<std::string> lh;
         *db << sql,
@@ -1275,7 +1308,7 @@ getHashesByIndex(std::uint32_t ledgerIndex,
     uint256& ledgerHash, uint256& parentHash,
         Application& app)
 {
-    auto db = app.getLedgerDB ().checkoutDb ();
+    auto db = app.getLedgerDB ().checkoutReadDb ();
 
     boost::optional <std::string> lhO, phO;
 
@@ -1312,7 +1345,7 @@ getHashesByIndex (std::uint32_t minSeq, std::uint32_t maxSeq,
     sql.append (beast::lexicalCastThrow <std::string> (maxSeq));
     sql.append (";");
 
-    auto db = app.getLedgerDB ().checkoutDb ();
+    auto db = app.getLedgerDB ().checkoutReadDb ();
 
     std::uint64_t ls;
     std::string lh;
@@ -0,0 +1,124 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_LEDGER_LEDGERHASHINDEX_H_INCLUDED
+#define RIPPLE_APP_LEDGER_LEDGERHASHINDEX_H_INCLUDED
+
+#include <ripple/ledger/ReadView.h>
+#include <ripple/protocol/RippleLedgerHash.h>
+#include <ripple/beast/utility/Journal.h>
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/optional.hpp>
+#include <cstdint>
+#include <mutex>
+
+namespace ripple {
+
+/** The hashes of validated ledgers, indexed by sequence.
+
+    Finding the hash of an old ledger otherwise means reading the
+    skip lists of a later ledger, which may have to be loaded from
+    the node store, or querying the Ledgers table. This index is a
+    memory-mapped file holding the hash and parent hash of each
+    ledger at a fixed offset, so a lookup is a single read.
+
+    Entries are only added for validated ledgers, and for older
+    ledgers which link to them by parent hash. Each validated ledger
+    is checked against the skip lists it holds, and entries which
+    disagree with it are replaced. The index is cleared when the
+    node starts a new history, such as a standalone chain or one
+    loaded from a given ledger.
+
+    The file is addressed directly by sequence. Slots for ledgers
+    which were never stored are zero and, on file systems which
+    support them, are not allocated.
+*/
+class LedgerHashIndex
+{
+public:
+    /** Open or create the index in the given file. */
+    LedgerHashIndex (boost::filesystem::path const& file,
+        beast::Journal journal);
+
+    LedgerHashIndex (LedgerHashIndex const&) = delete;
+    LedgerHashIndex& operator= (LedgerHashIndex const&) = delete;
+
+    /** Store the hashes of a ledger. */
+    void
+    insert (LedgerIndex seq, LedgerHash const& hash,
+        LedgerHash const& parentHash);
+
+    /** Returns the hash of a ledger, if it is known. */
+    boost::optional<LedgerHash>
+    getHash (LedgerIndex seq);
+
+    /** Make sure the hash of a ledger is the given one.
+        @return `true` if an entry was added or replaced.
+    */
+    bool
+    check (LedgerIndex seq, LedgerHash const& hash);
+
+    /** Add a validated ledger and check the index against its skip lists.
+        @return The number of entries which were added or replaced.
+    */
+    std::size_t
+    verify (ReadView const& ledger);
+
+    /** Add an older ledger which the index links to a validated one.
+
+        The ledger is added if its hash is already indexed, or is the
+        parent hash of the next ledger, so history acquired below the
+        validated ledgers extends the index one ledger at a time.
+
+        @return `true` if the ledger was added.
+    */
+    bool
+    extend (LedgerIndex seq, LedgerHash const& hash,
+        LedgerHash const& parentHash);
+
+    /** Forget every entry, when the history starts over. */
+    void
+    clear ();
+
+private:
+    struct Record;
+
+    Record*
+    slot (LedgerIndex seq);
+
+    void
+    grow (LedgerIndex seq);
+
+    void
+    map (std::uint64_t records);
+
+    boost::filesystem::path const file_;
+    beast::Journal j_;
+
+    std::mutex mutable mutex_;
+    boost::interprocess::file_mapping mapping_;
+    boost::interprocess::mapped_region region_;
+    std::uint64_t records_ = 0;
+};
+
+} // ripple
+
+#endif
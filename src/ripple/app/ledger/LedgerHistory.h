@@ -51,6 +51,17 @@ public:
         return m_ledgers_by_hash.getHitRate ();
     }
 
+    /** Get an estimate of the bytes held by the ledger caches.
+
+        Ledgers share their tree nodes with the TreeNodeCache, so
+        only the ledger objects themselves are counted here.
+    */
+    std::size_t getCacheMemoryUsage () const
+    {
+        return m_ledgers_by_hash.getMemoryUsage () +
+            m_consensus_validated.getMemoryUsage ();
+    }
+
     /** Get a ledger given its squence number */
     std::shared_ptr<Ledger const>
     getLedgerBySeq (LedgerIndex ledgerIndex);
@@ -73,10 +84,15 @@ public:
 
     /** Remove stale cache entries
     */
-    void sweep ()
+    /** Remove expired entries from the caches.
+
+        @param trash Receives the ledgers and entries which are no
+                     longer referenced, to be destroyed by the caller.
+    */
+    void sweep (std::vector <std::shared_ptr <void const>>& trash)
     {
-        m_ledgers_by_hash.sweep ();
-        m_consensus_validated.sweep ();
+        m_ledgers_by_hash.sweep (trash);
+        m_consensus_validated.sweep (trash);
     }
 
     /** Report that we have locally built a particular ledger */
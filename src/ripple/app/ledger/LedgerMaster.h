@@ -24,10 +24,12 @@
 #include <ripple/app/ledger/AbstractFetchPackContainer.h>
 #include <ripple/app/ledger/Ledger.h>
 #include <ripple/app/ledger/LedgerCleaner.h>
+#include <ripple/app/ledger/LedgerHashIndex.h>
 #include <ripple/app/ledger/LedgerHistory.h>
 #include <ripple/app/ledger/LedgerHolder.h>
 #include <ripple/app/misc/CanonicalTXSet.h>
 #include <ripple/basics/chrono.h>
+#include <ripple/basics/DecayingSample.h>
 #include <ripple/basics/RangeSet.h>
 #include <ripple/basics/ScopedLock.h>
 #include <ripple/basics/StringUtilities.h>
@@ -37,6 +39,7 @@
 #include <ripple/core/Stoppable.h>
 #include <ripple/beast/utility/PropertyStream.h>
 #include <mutex>
+#include <set>
 
 #include "ripple.pb.h"
 
@@ -155,6 +158,11 @@ public:
     /** Walk to a ledger's hash using the skip list */
     boost::optional<LedgerHash> walkHashBySeq (std::uint32_t index);
 
+    /** Get a validated ledger's hash from the ledger hash index
+        without loading any ledgers.
+    */
+    boost::optional<LedgerHash> getIndexedHash (std::uint32_t index);
+
     /** Walk the chain of ledger hashes to determine the hash of the
         ledger with the specified index. The referenceLedger is used as
         the base of the chain and should be fully validated and must not
@@ -196,8 +204,14 @@ public:
         std::uint32_t& minVal, std::uint32_t& maxVal);
 
     void tune (int size, int age);
-    void sweep ();
+    void sweep (std::vector <std::shared_ptr <void const>>& trash);
     float getCacheHitRate ();
+    std::size_t getCacheMemoryUsage () const;
+
+    /** Returns the rate, in ledgers per second, at which history is
+        being filled in.
+    */
+    double getBackfillRate ();
 
     void checkAccept (std::shared_ptr<Ledger const> const& ledger);
     void checkAccept (uint256 const& hash, std::uint32_t seq);
@@ -255,7 +269,8 @@ private:
         Job& job,
         std::shared_ptr<Ledger const> ledger);
 
-    void getFetchPack(LedgerHash missingHash, LedgerIndex missingIndex);
+    void getFetchPack(LedgerIndex missingIndex, std::set<std::uint32_t>& busy);
+    void prefetchHistory(LedgerIndex missing);
     boost::optional<LedgerHash> getLedgerHashForHistory(LedgerIndex index);
     int getNeededValidations();
     void advanceThread();
@@ -313,6 +328,9 @@ private:
 
     std::unique_ptr <detail::LedgerCleaner> mLedgerCleaner;
 
+    // Hashes of validated ledgers by sequence, if there is a database path
+    std::unique_ptr <LedgerHashIndex> hashIndex_;
+
     int mMinValidations;    // The minimum validations to publish a ledger.
     bool mStrictValCount;   // Don't raise the minimum
     uint256 mLastValidateHash;
@@ -343,11 +361,16 @@ private:
     // How much history do we want to keep
     std::uint32_t const ledger_history_;
 
-    int const ledger_fetch_size_;
+    // How many historical ledgers to acquire at once
+    std::uint32_t const backfill_window_;
 
     TaggedCache<uint256, Blob> fetch_packs_;
 
-    std::uint32_t fetch_seq_;
+    // Ledgers in the backfill window whose fetch packs were requested
+    std::set<std::uint32_t> fetch_seqs_;
+
+    std::mutex backfillRateMutex_;
+    DecayWindow<30, Stopwatch> backfillRate_;
 
 };
 
@@ -53,6 +53,12 @@ public:
 
     void sweep (void);
 
+    /** Sweep part of the cache, resuming where the last call stopped.
+        @return `true` if the pass completed.
+    */
+    bool sweep (std::chrono::microseconds budget,
+        std::vector <std::shared_ptr <void const>>& trash);
+
     TaggedCache <uint256, Transaction>&
     getCache();
 
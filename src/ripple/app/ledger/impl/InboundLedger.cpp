@@ -1244,6 +1244,24 @@ void InboundLedger::runData ()
         trigger (chosenPeer, TriggerReason::reply);
 }
 
+std::size_t InboundLedger::getMemoryUsage ()
+{
+    std::size_t bytes = sizeof (*this);
+
+    {
+        ScopedLockType sl (mLock);
+        if (mLedger)
+            bytes += sizeof (Ledger);
+        bytes += mRecentNodes.size () *
+            (sizeof (uint256) + 4 * sizeof (void*));
+    }
+
+    std::lock_guard<std::mutex> sl (mReceivedDataLock);
+    for (auto const& entry : mReceivedData)
+        bytes += entry.second->ByteSize ();
+    return bytes;
+}
+
 Json::Value InboundLedger::getJson (int)
 {
     Json::Value ret (Json::objectValue);
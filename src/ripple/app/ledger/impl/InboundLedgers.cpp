@@ -327,6 +327,23 @@ public:
         return ret;
     }
 
+    std::size_t getMemoryUsage()
+    {
+        std::vector<std::shared_ptr<InboundLedger>> acquires;
+        {
+            ScopedLockType sl (mLock);
+
+            acquires.reserve (mLedgers.size ());
+            for (auto const& it : mLedgers)
+                acquires.push_back (it.second);
+        }
+
+        std::size_t bytes = 0;
+        for (auto const& acquire : acquires)
+            bytes += acquire->getMemoryUsage ();
+        return bytes;
+    }
+
     void gotFetchPack ()
     {
         std::vector<std::shared_ptr<InboundLedger>> acquires;
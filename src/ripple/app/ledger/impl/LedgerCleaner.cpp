@@ -281,6 +281,10 @@ private:
         LedgerIndex index)
     {
         boost::optional<LedgerHash> hash;
+        if (index <= ledger->info().seq)
+            hash = app_.getLedgerMaster().getIndexedHash (index);
+        if (hash)
+            return *hash;
         try
         {
             hash = hashOfSeq(*ledger, index, j_);
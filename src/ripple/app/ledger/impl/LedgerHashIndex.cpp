@@ -0,0 +1,273 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/app/ledger/LedgerHashIndex.h>
+#include <ripple/basics/contract.h>
+#include <ripple/basics/Log.h>
+#include <ripple/protocol/Indexes.h>
+#include <cstring>
+#include <fstream>
+
+namespace ripple {
+
+struct LedgerHashIndex::Record
+{
+    std::uint8_t hash[32];
+    std::uint8_t parentHash[32];
+};
+
+static_assert (sizeof (uint256) == 32, "");
+
+namespace {
+
+// The header occupies the space of one record
+std::uint64_t constexpr headerSize = 64;
+
+// The file grows in steps of this many records
+std::uint64_t constexpr growRecords = 65536;
+
+char const magic[] = "RIPPLE_LEDGER_HASHES_1";
+
+LedgerHash
+toHash (std::uint8_t const* p)
+{
+    LedgerHash h;
+    std::memcpy (h.begin (), p, h.size ());
+    return h;
+}
+
+} // namespace
+
+LedgerHashIndex::LedgerHashIndex (boost::filesystem::path const& file,
+        beast::Journal journal)
+    : file_ (file)
+    , j_ (journal)
+{
+    namespace fs = boost::filesystem;
+
+    bool create = ! fs::exists (file_);
+    if (! create)
+    {
+        char header[headerSize] = {};
+        std::ifstream in (file_.string (), std::ios::binary);
+        in.read (header, sizeof (header));
+        if (! in || std::memcmp (header, magic, sizeof (magic)) != 0 ||
+            ((fs::file_size (file_) - headerSize) % sizeof (Record)) != 0)
+        {
+            JLOG (j_.warn()) <<
+                "Ledger hash index " << file_ << " is invalid, recreating";
+            create = true;
+        }
+    }
+
+    if (create)
+    {
+        if (file_.has_parent_path ())
+            fs::create_directories (file_.parent_path ());
+
+        char header[headerSize] = {};
+        std::memcpy (header, magic, sizeof (magic));
+        std::ofstream out (file_.string (),
+            std::ios::binary | std::ios::trunc);
+        out.write (header, sizeof (header));
+        if (! out)
+            Throw<std::runtime_error> (
+                "Unable to create " + file_.string ());
+    }
+
+    std::uint64_t const records =
+        (fs::file_size (file_) - headerSize) / sizeof (Record);
+    map (std::max (records, growRecords));
+
+    JLOG (j_.debug()) <<
+        "Ledger hash index " << file_ << " has room for " << records_;
+}
+
+void
+LedgerHashIndex::map (std::uint64_t records)
+{
+    namespace ip = boost::interprocess;
+
+    region_ = ip::mapped_region ();
+    if (records > records_)
+        boost::filesystem::resize_file (file_,
+            headerSize + records * sizeof (Record));
+    mapping_ = ip::file_mapping (file_.string ().c_str (), ip::read_write);
+    region_ = ip::mapped_region (mapping_, ip::read_write);
+    records_ = records;
+}
+
+void
+LedgerHashIndex::grow (LedgerIndex seq)
+{
+    if (seq < records_)
+        return;
+    map (((std::uint64_t (seq) / growRecords) + 1) * growRecords);
+}
+
+LedgerHashIndex::Record*
+LedgerHashIndex::slot (LedgerIndex seq)
+{
+    if (seq >= records_)
+        return nullptr;
+    return reinterpret_cast<Record*> (
+        static_cast<std::uint8_t*> (region_.get_address ()) +
+            headerSize) + seq;
+}
+
+void
+LedgerHashIndex::insert (LedgerIndex seq, LedgerHash const& hash,
+    LedgerHash const& parentHash)
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    grow (seq);
+    auto r = slot (seq);
+    std::memcpy (r->hash, hash.begin (), hash.size ());
+    std::memcpy (r->parentHash, parentHash.begin (), parentHash.size ());
+}
+
+boost::optional<LedgerHash>
+LedgerHashIndex::getHash (LedgerIndex seq)
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    if (auto r = slot (seq))
+    {
+        auto const hash = toHash (r->hash);
+        if (hash.isNonZero ())
+            return hash;
+    }
+    return boost::none;
+}
+
+bool
+LedgerHashIndex::check (LedgerIndex seq, LedgerHash const& hash)
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    grow (seq);
+    auto r = slot (seq);
+
+    auto const stored = toHash (r->hash);
+    if (stored == hash)
+        return false;
+
+    if (stored.isNonZero ())
+    {
+        JLOG (j_.warn()) <<
+            "Ledger " << seq << " was indexed as " << stored <<
+            " instead of " << hash;
+
+        // The parent hash came from the wrong ledger
+        std::memset (r->parentHash, 0, sizeof (r->parentHash));
+    }
+    std::memcpy (r->hash, hash.begin (), hash.size ());
+    return true;
+}
+
+std::size_t
+LedgerHashIndex::verify (ReadView const& ledger)
+{
+    auto const& info = ledger.info ();
+    std::size_t changed = 0;
+
+    if (check (info.seq, info.hash))
+        ++changed;
+    insert (info.seq, info.hash, info.parentHash);
+    if (info.seq > 1 && check (info.seq - 1, info.parentHash))
+        ++changed;
+
+    // The hashes of the previous 256 ledgers
+    if (auto const sle = ledger.read (keylet::skip ()))
+    {
+        auto const last = sle->getFieldU32 (sfLastLedgerSequence);
+        auto const hashes = sle->getFieldV256 (sfHashes);
+        auto const size = static_cast<LedgerIndex> (hashes.size ());
+        for (LedgerIndex i = 0; i < size && i <= last; ++i)
+        {
+            if (check (last - i, hashes[size - i - 1]))
+                ++changed;
+        }
+    }
+
+    // The hashes of every 256th ledger
+    if (auto const sle = ledger.read (keylet::skip (info.seq)))
+    {
+        auto const last = sle->getFieldU32 (sfLastLedgerSequence);
+        auto const hashes = sle->getFieldV256 (sfHashes);
+        auto const size = static_cast<LedgerIndex> (hashes.size ());
+        for (LedgerIndex i = 0; i < size && (i << 8) <= last; ++i)
+        {
+            if (check (last - (i << 8), hashes[size - i - 1]))
+                ++changed;
+        }
+    }
+
+    if (changed != 0)
+    {
+        JLOG (j_.debug()) <<
+            "Ledger " << info.seq << " added " << changed <<
+            " index entries";
+    }
+    return changed;
+}
+
+bool
+LedgerHashIndex::extend (LedgerIndex seq, LedgerHash const& hash,
+    LedgerHash const& parentHash)
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    auto r = slot (seq);
+    if (! r)
+        return false;
+
+    if (toHash (r->hash) != hash)
+    {
+        auto const next = seq < records_ - 1 ? slot (seq + 1) : nullptr;
+        if (! next || toHash (next->parentHash) != hash)
+            return false;
+        std::memcpy (r->hash, hash.begin (), hash.size ());
+    }
+    std::memcpy (r->parentHash, parentHash.begin (), parentHash.size ());
+
+    // The previous ledger is linked through our parent hash
+    if (seq > 0)
+    {
+        auto prev = slot (seq - 1);
+        if (toHash (prev->hash).isZero ())
+            std::memcpy (prev->hash, parentHash.begin (), parentHash.size ());
+    }
+    return true;
+}
+
+void
+LedgerHashIndex::clear ()
+{
+    namespace ip = boost::interprocess;
+
+    std::lock_guard<std::mutex> lock (mutex_);
+    region_ = ip::mapped_region ();
+    mapping_ = ip::file_mapping ();
+    boost::filesystem::resize_file (file_, headerSize);
+    records_ = 0;
+    map (growRecords);
+
+    JLOG (j_.info()) << "Cleared ledger hash index " << file_;
+}
+
+} // ripple
@@ -90,11 +90,30 @@ LedgerMaster::LedgerMaster (Application& app, Stopwatch& stopwatch,
     , fetch_depth_ (app_.getSHAMapStore ().clampFetchDepth (
         app_.config().FETCH_DEPTH))
     , ledger_history_ (app_.config().LEDGER_HISTORY)
-    , ledger_fetch_size_ (app_.config().getSize (siLedgerFetch))
+    , backfill_window_ (app_.config().BACKFILL_WINDOW)
     , fetch_packs_ ("FetchPack", 65536, 45, stopwatch,
         app_.journal("TaggedCache"))
-    , fetch_seq_ (0)
-{
+    , backfillRate_ (stopwatch.now())
+{
+    auto const& dbPath = app_.config().legacy ("database_path");
+    if (! dbPath.empty ())
+    {
+        hashIndex_ = std::make_unique <LedgerHashIndex> (
+            boost::filesystem::path (dbPath) / "ledger_hashes.idx",
+            app_.journal ("LedgerHashIndex"));
+
+        // A standalone chain, or one which starts from a ledger we
+        // were given, need not be the history the index describes
+        auto const startUp = app_.config().START_UP;
+        if (standalone_ ||
+            startUp == Config::FRESH ||
+            startUp == Config::LOAD ||
+            startUp == Config::LOAD_FILE ||
+            startUp == Config::REPLAY)
+        {
+            hashIndex_->clear ();
+        }
+    }
 }
 
 LedgerIndex
@@ -234,6 +253,9 @@ LedgerMaster::setValidLedger(
     mValidLedgerSign = signTime.time_since_epoch().count();
     mValidLedgerSeq = l->info().seq;
 
+    if (hashIndex_)
+        hashIndex_->verify (*l);
+
     app_.getOPs().updateLocalTx (*l);
     app_.getSHAMapStore().onLedgerClosed (getValidatedLedger());
     mLedgerHistory.validatedLedger (l);
@@ -523,9 +545,13 @@ LedgerMaster::tryFill (
 }
 
 /** Request a fetch pack to get to the specified ledger
+
+    Peers in `busy` were already sent a request for another ledger,
+    and are only asked if no other peer has the ledger.
 */
 void
-LedgerMaster::getFetchPack (LedgerHash missingHash, LedgerIndex missingIndex)
+LedgerMaster::getFetchPack (LedgerIndex missingIndex,
+    std::set<std::uint32_t>& busy)
 {
     auto haveHash = getLedgerHashForHistory (missingIndex + 1);
 
@@ -541,16 +567,20 @@ LedgerMaster::getFetchPack (LedgerHash missingHash, LedgerIndex missingIndex)
     std::shared_ptr<Peer> target;
     {
         int maxScore = 0;
+        bool targetBusy = true;
         auto peerList = app_.overlay ().getActivePeers();
         for (auto const& peer : peerList)
         {
             if (peer->hasRange (missingIndex, missingIndex + 1))
             {
+                bool const isBusy = busy.count (peer->id ()) != 0;
                 int score = peer->getScore (true);
-                if (! target || (score > maxScore))
+                if (! target || (targetBusy && ! isBusy) ||
+                    ((targetBusy == isBusy) && (score > maxScore)))
                 {
                     target = peer;
                     maxScore = score;
+                    targetBusy = isBusy;
                 }
             }
         }
@@ -566,6 +596,7 @@ LedgerMaster::getFetchPack (LedgerHash missingHash, LedgerIndex missingIndex)
             tmBH, protocol::mtGET_OBJECTS);
 
         target->send (packet);
+        busy.insert (target->id ());
         JLOG (m_journal.trace()) << "Requested fetch pack for "
                                             << missingIndex;
     }
@@ -573,6 +604,57 @@ LedgerMaster::getFetchPack (LedgerHash missingHash, LedgerIndex missingIndex)
         JLOG (m_journal.debug()) << "No peer for fetch pack";
 }
 
+/** Acquire the historical ledgers in the window ending at `missing`
+
+    Ledgers which are already complete are skipped. Fetch packs are
+    requested for the ones that are not available locally, each from
+    a different peer where possible.
+*/
+void
+LedgerMaster::prefetchHistory (LedgerIndex missing)
+{
+    // Requests above the window have been served, or have expired
+    fetch_seqs_.erase (fetch_seqs_.upper_bound (missing), fetch_seqs_.end ());
+
+    std::set<std::uint32_t> busy;
+    try
+    {
+        for (std::uint32_t i = 0; i < backfill_window_ && i < missing; ++i)
+        {
+            std::uint32_t const seq = missing - i;
+            {
+                ScopedLockType sl (mCompleteLock);
+                if (mCompleteLedgers.hasValue (seq))
+                    continue;
+            }
+
+            auto hash = getLedgerHashForHistory (seq);
+            if (! hash)
+                continue;
+            assert (hash->isNonZero ());
+
+            if (app_.getInboundLedgers ().isFailure (*hash))
+                continue;
+
+            if (app_.getInboundLedgers ().acquire (
+                    *hash, seq, InboundLedger::fcHISTORY))
+                continue;
+
+            if ((seq > 32600) && shouldFetchPack (seq))
+            {
+                JLOG (m_journal.trace()) <<
+                    "tryAdvance want fetch pack " << seq;
+                fetch_seqs_.insert (seq);
+                getFetchPack (seq, busy);
+            }
+        }
+    }
+    catch (std::exception const&)
+    {
+        JLOG (m_journal.warn()) << "Threw while prefetching";
+    }
+}
+
 void
 LedgerMaster::fixMismatch (ReadView const& ledger)
 {
@@ -645,6 +727,12 @@ LedgerMaster::setFullLedger (
     if (isCurrent)
         mLedgerHistory.insert(ledger, true);
 
+    if (hashIndex_)
+    {
+        hashIndex_->extend (ledger->info().seq,
+            ledger->info().hash, ledger->info().parentHash);
+    }
+
     {
         // Check the SQL database's entry for the sequence before this
         // ledger, if it's not this ledger's parent, invalidate it
@@ -975,7 +1063,9 @@ boost::optional<LedgerHash>
 LedgerMaster::getLedgerHashForHistory (LedgerIndex index)
 {
     // Try to get the hash of a ledger we need to fetch for history
-    boost::optional<LedgerHash> ret;
+    boost::optional<LedgerHash> ret = getIndexedHash (index);
+    if (ret)
+        return ret;
 
     if (mHistLedger && (mHistLedger->info().seq >= index))
     {
@@ -993,7 +1083,7 @@ LedgerMaster::getLedgerHashForHistory (LedgerIndex index)
 bool
 LedgerMaster::shouldFetchPack (std::uint32_t seq) const
 {
-    return (fetch_seq_ != seq);
+    return fetch_seqs_.count (seq) == 0;
 }
 
 std::vector<std::shared_ptr<Ledger const>>
@@ -1370,6 +1460,9 @@ LedgerMaster::getHashBySeq (std::uint32_t index)
     if (hash.isNonZero ())
         return hash;
 
+    if (auto indexed = getIndexedHash (index))
+        return *indexed;
+
     return getHashByIndex (index, app_);
 }
 
@@ -1379,11 +1472,24 @@ LedgerMaster::walkHashBySeq (std::uint32_t index)
     boost::optional<LedgerHash> ledgerHash;
 
     if (auto referenceLedger = mValidLedger.get ())
-        ledgerHash = walkHashBySeq (index, referenceLedger);
+    {
+        if (index <= referenceLedger->info().seq)
+            ledgerHash = getIndexedHash (index);
+        if (! ledgerHash)
+            ledgerHash = walkHashBySeq (index, referenceLedger);
+    }
 
     return ledgerHash;
 }
 
+boost::optional<LedgerHash>
+LedgerMaster::getIndexedHash (std::uint32_t index)
+{
+    if (! hashIndex_)
+        return boost::none;
+    return hashIndex_->getHash (index);
+}
+
 boost::optional<LedgerHash>
 LedgerMaster::walkHashBySeq (
     std::uint32_t index,
@@ -1450,7 +1556,9 @@ LedgerMaster::getLedgerBySeq (std::uint32_t index)
 
             try
             {
-                auto const hash = hashOfSeq(*valid, index, m_journal);
+                auto hash = getIndexedHash (index);
+                if (! hash)
+                    hash = hashOfSeq(*valid, index, m_journal);
 
                 if (hash)
                     return mLedgerHistory.getLedgerByHash (*hash);
@@ -1506,10 +1614,10 @@ LedgerMaster::tune (int size, int age)
 }
 
 void
-LedgerMaster::sweep ()
+LedgerMaster::sweep (std::vector <std::shared_ptr <void const>>& trash)
 {
-    mLedgerHistory.sweep ();
-    fetch_packs_.sweep ();
+    mLedgerHistory.sweep (trash);
+    fetch_packs_.sweep (trash);
 }
 
 float
@@ -1518,6 +1626,20 @@ LedgerMaster::getCacheHitRate ()
     return mLedgerHistory.getCacheHitRate ();
 }
 
+std::size_t
+LedgerMaster::getCacheMemoryUsage () const
+{
+    return mLedgerHistory.getCacheMemoryUsage () +
+        fetch_packs_.getMemoryUsage ();
+}
+
+double
+LedgerMaster::getBackfillRate ()
+{
+    std::lock_guard <std::mutex> lock (backfillRateMutex_);
+    return backfillRate_.value (stopwatch().now());
+}
+
 beast::PropertyStream::Source&
 LedgerMaster::getPropertySource ()
 {
@@ -1627,19 +1749,6 @@ void LedgerMaster::doAdvance ()
                                         app_.getInboundLedgers().acquire(
                                             *hash, missing,
                                             InboundLedger::fcHISTORY);
-                                    if (! ledger && (missing > 32600) &&
-                                        shouldFetchPack (missing))
-                                    {
-                                        JLOG (m_journal.trace()) <<
-                                        "tryAdvance want fetch pack " <<
-                                        missing;
-                                        fetch_seq_ = missing;
-                                        getFetchPack(*hash, missing);
-                                    }
-                                    else
-                                        JLOG (m_journal.trace()) <<
-                                        "tryAdvance no fetch pack for " <<
-                                        missing;
                                 }
                                 else
                                     JLOG (m_journal.debug()) <<
@@ -1656,6 +1765,11 @@ void LedgerMaster::doAdvance ()
                                     ledger,
                                     false,
                                     false);
+                                {
+                                    std::lock_guard <std::mutex> lock (
+                                        backfillRateMutex_);
+                                    backfillRate_.add (1, stopwatch().now());
+                                }
                                 auto const& parent = ledger->info().parentHash;
 
                                 int fillInProgress;
@@ -1683,30 +1797,10 @@ void LedgerMaster::doAdvance ()
 
                                 progress = true;
                             }
-                            else
-                            {
-                                try
-                                {
-                                    for (int i = 0; i < ledger_fetch_size_; ++i)
-                                    {
-                                        std::uint32_t seq = missing - i;
-                                        auto hash2 =
-                                                getLedgerHashForHistory(seq);
-                                        if (hash2)
-                                        {
-                                            assert(hash2->isNonZero());
-                                            app_.getInboundLedgers().acquire
-                                                (*hash2, seq,
-                                                    InboundLedger::fcHISTORY);
-                                        }
-                                    }
-                                }
-                                catch (std::exception const&)
-                                {
-                                    JLOG (m_journal.warn()) <<
-                                    "Threw while prefetching";
-                                }
-                            }
+
+                            // Keep the window below the lowest complete
+                            // ledger in flight
+                            prefetchHistory (ledger ? missing - 1 : missing);
                         }
                         else
                         {
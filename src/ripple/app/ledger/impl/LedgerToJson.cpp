@@ -19,6 +19,7 @@
 
 #include <ripple/app/ledger/LedgerToJson.h>
 #include <ripple/basics/base_uint.h>
+#include <cstring>
 
 namespace ripple {
 
@@ -39,6 +40,21 @@ bool isBinary(LedgerFill const& fill)
     return fill.options & LedgerFill::binary;
 }
 
+// Add the fields of an STObject to a JSON object. A Json::Object is
+// written directly from the STObject, without building a Json::Value.
+void copyFrom (Json::Value& to, STObject const& from)
+{
+    if (! to)
+        to = from.getJson (0);
+    else
+        Json::copyFrom (to, from.getJson (0));
+}
+
+void copyFrom (Json::Object& to, STObject const& from)
+{
+    from.addJson (to, 0);
+}
+
 template <class Object>
 void fillJson(Object& json, bool closed, LedgerInfo const& info, bool bFull)
 {
@@ -112,18 +128,22 @@ void fillJsonTx (Object& json, LedgerFill const& fill)
             }
             else
             {
+                // Members are written in key order
                 auto&& txJson = appendObject(txns);
                 if (bBinary)
                 {
-                    txJson[jss::tx_blob] = serializeHex(*i.first);
                     if (i.second)
                         txJson[jss::meta] = serializeHex(*i.second);
                 }
                 else
                 {
-                    copyFrom(txJson, i.first->getJson(0));
+                    copyFrom(txJson, *i.first);
+                    txJson[jss::hash] = to_string(i.first->getTransactionID());
                     if (i.second)
-                        txJson[jss::metaData] = i.second->getJson(0);
+                    {
+                        auto&& meta = Json::addObject(txJson, jss::metaData);
+                        copyFrom(meta, *i.second);
+                    }
                 }
 
                 if ((fill.options & LedgerFill::ownerFunds) &&
@@ -141,6 +161,9 @@ void fillJsonTx (Object& json, LedgerFill const& fill)
                         txJson[jss::owner_funds] = ownerFunds.getText ();
                     }
                 }
+
+                if (bBinary)
+                    txJson[jss::tx_blob] = serializeHex(*i.first);
             }
         }
     }
@@ -167,28 +190,55 @@ void fillJsonState(Object& json, LedgerFill const& fill)
             obj[jss::tx_blob] = serializeHex(*sle);
         }
         else if (expanded)
-            array.append(sle->getJson(0));
+        {
+            auto&& obj = appendObject(array);
+            copyFrom(obj, *sle);
+            obj[jss::index] = to_string(sle->key());
+        }
         else
             array.append(to_string(sle->key()));
     }
 }
 
+// The ledger is written in key order, as a Json::Value keeps its members,
+// so that a ledger written to a Json::Object matches the to_string of the
+// same ledger filled into a Json::Value.
 template <class Object>
 void fillJson (Object& json, LedgerFill const& fill)
 {
     // TODO: what happens if bBinary and bExtracted are both set?
     // Is there a way to report this back?
     auto bFull = isFull(fill);
+    Json::Value header (Json::objectValue);
     if (isBinary(fill))
-        fillJsonBinary(json, !fill.ledger.open(), fill.ledger.info());
+        fillJsonBinary(header, !fill.ledger.open(), fill.ledger.info());
     else
-        fillJson(json, !fill.ledger.open(), fill.ledger.info(), bFull);
+        fillJson(header, !fill.ledger.open(), fill.ledger.info(), bFull);
 
-    if (bFull || fill.options & LedgerFill::dumpTxrp)
-        fillJsonTx(json, fill);
+    bool state = bFull || fill.options & LedgerFill::dumpState;
+    bool txs = bFull || fill.options & LedgerFill::dumpTxrp;
 
-    if (bFull || fill.options & LedgerFill::dumpState)
+    for (auto iter = header.begin(); iter != header.end(); ++iter)
+    {
+        auto const key = iter.memberName();
+        if (state && std::strcmp (jss::accountState, key) < 0)
+        {
+            fillJsonState(json, fill);
+            state = false;
+        }
+        if (txs && std::strcmp (jss::transactions, key) < 0)
+        {
+            fillJsonTx(json, fill);
+            txs = false;
+        }
+        json[key] = *iter;
+    }
+
+    if (state)
         fillJsonState(json, fill);
+
+    if (txs)
+        fillJsonTx(json, fill);
 }
 
 } // namespace
@@ -114,6 +114,12 @@ void TransactionMaster::sweep (void)
     mCache.sweep ();
 }
 
+bool TransactionMaster::sweep (std::chrono::microseconds budget,
+    std::vector <std::shared_ptr <void const>>& trash)
+{
+    return mCache.sweep (budget, trash);
+}
+
 TaggedCache <uint256, Transaction>& TransactionMaster::getCache()
 {
     return mCache;
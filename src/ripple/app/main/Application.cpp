@@ -34,8 +34,11 @@
 #include <ripple/app/ledger/TransactionMaster.h>
 #include <ripple/app/main/CollectorManager.h>
 #include <ripple/app/main/LoadManager.h>
+#include <ripple/app/main/MemoryBudget.h>
 #include <ripple/app/main/NodeIdentity.h>
 #include <ripple/app/main/NodeStoreScheduler.h>
+#include <ripple/app/misc/AccountTxIndex.h>
+#include <ripple/app/misc/ValidationArchive.h>
 #include <ripple/app/misc/AmendmentTable.h>
 #include <ripple/app/misc/HashRouter.h>
 #include <ripple/app/misc/LoadFeeTrack.h>
@@ -56,6 +59,7 @@
 #include <ripple/json/to_string.h>
 #include <ripple/core/ConfigSections.h>
 #include <ripple/core/DeadlineTimer.h>
+#include <ripple/core/Reclaimer.h>
 #include <ripple/core/TimeKeeper.h>
 #include <ripple/ledger/CachedSLEs.h>
 #include <ripple/nodestore/Database.h>
@@ -332,6 +336,7 @@ public:
     std::unique_ptr <CollectorManager> m_collectorManager;
     detail::AppFamily family_;
     CachedSLEs cachedSLEs_;
+    MemoryBudget memoryBudget_;
     std::pair<PublicKey, SecretKey> nodeIdentity_;
 
     std::unique_ptr <Resource::Manager> m_resourceManager;
@@ -361,6 +366,8 @@ public:
     std::unique_ptr <DatabaseCon> mTxnDB;
     std::unique_ptr <DatabaseCon> mLedgerDB;
     std::unique_ptr <DatabaseCon> mWalletDB;
+    std::unique_ptr <AccountTxIndex> accountTxIndex_;
+    std::unique_ptr <ValidationArchive> validationArchive_;
     std::unique_ptr <Overlay> m_overlay;
     std::vector <std::unique_ptr<Stoppable>> websocketServers_;
 
@@ -373,6 +380,15 @@ public:
 
     io_latency_sampler m_io_latency_sampler;
 
+    // The caches swept a slice at a time, in order, and the next to sweep
+    std::vector <std::function <bool (std::chrono::microseconds,
+        std::vector <std::shared_ptr <void const>>&)>> sweepers_;
+    std::size_t sweepStage_ = 0;
+
+    // Destroys what the sweeps release. Declared last so
+    // that it finishes before anything else is destroyed.
+    Reclaimer reclaimer_;
+
     //--------------------------------------------------------------------------
 
     static
@@ -423,6 +439,10 @@ public:
 
         , cachedSLEs_ (std::chrono::minutes(1), stopwatch())
 
+        , memoryBudget_ (get<std::uint64_t> (
+            config_->section (SECTION_MEMORY_BUDGET), "megabytes") << 20,
+                logs_->journal("MemoryBudget"))
+
         , m_resourceManager (Resource::make_Manager (
             m_collectorManager->collector(), logs_->journal("Resource")))
 
@@ -502,6 +522,8 @@ public:
 
         , m_io_latency_sampler (m_collectorManager->collector()->make_event ("ios_latency"),
             logs_->journal("Application"), std::chrono::milliseconds (100), get_io_service())
+
+        , reclaimer_ ("Reclaimer")
     {
         add (m_resourceManager.get ());
 
@@ -524,6 +546,26 @@ public:
         m_nodeStoreScheduler.setJobQueue (*m_jobQueue);
 
         add (m_ledgerMaster->getPropertySource ());
+
+        // In the order they were always swept
+        using std::chrono::microseconds;
+        using Trash = std::vector <std::shared_ptr <void const>>;
+        sweepers_ = {
+            [this](microseconds budget, Trash&)
+                { return family().fullbelow().sweep (budget); },
+            [this](microseconds budget, Trash& trash)
+                { return m_txMaster.sweep (budget, trash); },
+            [this](microseconds budget, Trash& trash)
+                { return m_nodeStore->sweep (budget, trash); },
+            [this](microseconds budget, Trash& trash)
+                { return m_tempNodeCache.sweep (budget, trash); },
+            [this](microseconds budget, Trash& trash)
+                { return m_acceptedLedgerCache.sweep (budget, trash); },
+            [this](microseconds budget, Trash& trash)
+                { return family().treecache().sweep (budget, trash); },
+            [this](microseconds budget, Trash& trash)
+                { return cachedSLEs_.expire (budget, trash); },
+        };
     }
 
     //--------------------------------------------------------------------------
@@ -666,6 +708,11 @@ public:
         return cachedSLEs_;
     }
 
+    MemoryBudget& getMemoryBudget () override
+    {
+        return memoryBudget_;
+    }
+
     AmendmentTable& getAmendmentTable() override
     {
         return *m_amendmentTable;
@@ -750,6 +797,15 @@ public:
         assert (mWalletDB.get() != nullptr);
         return *mWalletDB;
     }
+    AccountTxIndex* getAccountTxIndex () override
+    {
+        return accountTxIndex_.get ();
+    }
+    ValidationArchive& getValidationArchive () override
+    {
+        assert (validationArchive_.get() != nullptr);
+        return *validationArchive_;
+    }
 
     bool serverOkay (std::string& reason) override;
 
@@ -767,6 +823,15 @@ public:
                 TxnDBInit, TxnDBCount);
         mLedgerDB = std::make_unique <DatabaseCon> (setup, "ledger.db",
                 LedgerDBInit, LedgerDBCount);
+        if (get<bool> (config_->section ("sqdb"),
+                "account_tx_index", false))
+            accountTxIndex_ = std::make_unique <AccountTxIndex> (
+                setup, *mTxnDB, logs_->journal ("AccountTxIndex"));
+        // Only the history databases are queried from RPC
+        setup.readConnections = 0;
+        validationArchive_ = make_ValidationArchive (
+            config_->section ("validation_archive"), setup, *mLedgerDB,
+                logs_->journal ("Validations"));
         mWalletDB = std::make_unique <DatabaseCon> (setup, "wallet.db",
                 WalletDBInit, WalletDBCount);
 
@@ -874,7 +939,7 @@ public:
         {
             // VFALCO TODO Move all this into doSweep
 
-            if (! config_->standalone())
+            if (sweepStage_ == 0 && ! config_->standalone())
             {
                 boost::filesystem::space_info space =
                         boost::filesystem::space (config_->legacy ("database_path"));
@@ -899,16 +964,48 @@ public:
         // VFALCO TODO fix the dependency inversion using an observer,
         //         have listeners register for "onSweep ()" notification.
 
-        family().fullbelow().sweep ();
-        getMasterTransaction().sweep();
-        getNodeStore().sweep();
-        getLedgerMaster().sweep();
-        getTempNodeCache().sweep();
-        getValidations().sweep();
-        getInboundLedgers().sweep();
-        m_acceptedLedgerCache.sweep();
-        family().treecache().sweep();
-        cachedSLEs_.expire();
+        using namespace std::chrono;
+        auto const deadline = steady_clock::now () +
+            microseconds (sweepSliceMicroseconds);
+
+        // Keep what is swept away alive until it can be
+        // handed to the reclaimer, outside of any cache lock.
+        std::vector <std::shared_ptr <void const>> trash;
+
+        if (sweepStage_ == 0)
+        {
+            // Retune the caches first so this sweep honors the new targets
+            memoryBudget_.update ();
+
+            // These are small enough to sweep in one go
+            getLedgerMaster().sweep (trash);
+            getValidations().sweep();
+            getInboundLedgers().sweep();
+            serverHandler_->sweep();
+        }
+
+        while (sweepStage_ < sweepers_.size ())
+        {
+            auto const left = duration_cast <microseconds> (
+                deadline - steady_clock::now ());
+            if (left <= microseconds::zero ())
+                break;
+            if (! sweepers_[sweepStage_] (left, trash))
+                break;
+            ++sweepStage_;
+        }
+
+        reclaimer_.release (std::move (trash));
+
+        if (sweepStage_ < sweepers_.size ())
+        {
+            // Let other jobs at the caches before continuing
+            m_sweepTimer.setExpiration (
+                milliseconds (sweepPauseMilliseconds));
+            return;
+        }
+
+        sweepStage_ = 0;
 
         // VFALCO NOTE does the call to sweep() happen on another thread?
         m_sweepTimer.setExpiration (
@@ -945,6 +1042,8 @@ bool ApplicationImp::setup()
 {
     // VFALCO NOTE: 0 means use heuristics to determine the thread count.
     m_jobQueue->setThreadCount (0, config_->standalone());
+    m_jobQueue->profiler ().setFrequency (get<std::uint32_t> (
+        config_->section (SECTION_JOB_PROFILER), "frequency"));
 
     // We want to intercept and wait for CTRL-C to terminate the process
     m_signals.add (SIGINT);
@@ -1078,6 +1177,29 @@ bool ApplicationImp::setup()
     family().treecache().setTargetSize (config_->getSize (siTreeCacheSize));
     family().treecache().setTargetAge (config_->getSize (siTreeCacheAge));
 
+    // Refilling costs grow from a key lookup, to a database read, to
+    // a read and a parse, to acquiring ledgers from the network
+    memoryBudget_.add ("full_below",
+        fullBelowTargetSize, fullBelowExpirationSeconds, 1,
+        [this](int size, int age) { family().fullbelow().tune (size, age); },
+        [this] { return family().fullbelow().getMemoryUsage (); });
+    memoryBudget_.add ("node_store",
+        config_->getSize (siNodeCacheSize), config_->getSize (siNodeCacheAge), 2,
+        [this](int size, int age) { m_nodeStore->tune (size, age); },
+        [this] { return m_nodeStore->getCacheMemoryUsage (); });
+    memoryBudget_.add ("tree_node",
+        config_->getSize (siTreeCacheSize), config_->getSize (siTreeCacheAge), 4,
+        [this](int size, int age)
+        {
+            family().treecache().setTargetSize (size);
+            family().treecache().setTargetAge (age);
+        },
+        [this] { return family().treecache().getMemoryUsage (); });
+    memoryBudget_.add ("ledger_history",
+        config_->getSize (siLedgerSize), config_->getSize (siLedgerAge), 16,
+        [this](int size, int age) { m_ledgerMaster->tune (size, age); },
+        [this] { return m_ledgerMaster->getCacheMemoryUsage (); });
+
     //----------------------------------------------------------------------
     //
     // Server
@@ -50,6 +50,7 @@ class InboundTransactions;
 class AcceptedLedger;
 class LedgerMaster;
 class LoadManager;
+class MemoryBudget;
 class NetworkOPs;
 class OpenLedger;
 class OrderBookDB;
@@ -57,6 +58,8 @@ class Overlay;
 class PathRequests;
 class PendingSaves;
 class AccountIDCache;
+class AccountTxIndex;
+class ValidationArchive;
 class STLedgerEntry;
 class TimeKeeper;
 class TransactionMaster;
@@ -117,6 +120,7 @@ public:
     virtual HashRouter&             getHashRouter () = 0;
     virtual LoadFeeTrack&           getFeeTrack () = 0;
     virtual LoadManager&            getLoadManager () = 0;
+    virtual MemoryBudget&           getMemoryBudget () = 0;
     virtual Overlay&                overlay () = 0;
     virtual TxQ&                    getTxQ() = 0;
     virtual ValidatorList&          validators () = 0;
@@ -157,6 +161,14 @@ public:
 
     /** Retrieve the "wallet database" */
     virtual DatabaseCon& getWalletDB () = 0;
+
+    /** Retrieve the account transaction index.
+        Returns nullptr unless the index is enabled in [sqdb].
+    */
+    virtual AccountTxIndex* getAccountTxIndex () = 0;
+
+    /** Retrieve the storage for validations which are no longer current. */
+    virtual ValidationArchive& getValidationArchive () = 0;
 };
 
 std::unique_ptr <Application>
@@ -29,6 +29,7 @@ class CollectorManagerImp
 public:
     beast::Journal m_journal;
     beast::insight::Collector::ptr m_collector;
+    std::shared_ptr <beast::insight::PrometheusCollector> m_prometheus;
     std::unique_ptr <beast::insight::Groups> m_groups;
 
     CollectorManagerImp (Section const& params,
@@ -45,6 +46,14 @@ public:
 
             m_collector = beast::insight::StatsDCollector::New (address, prefix, journal);
         }
+        else if (server == "prometheus")
+        {
+            std::string const& prefix (get<std::string> (params, "prefix"));
+
+            m_prometheus = beast::insight::PrometheusCollector::New (
+                prefix, journal);
+            m_collector = m_prometheus;
+        }
         else
         {
             m_collector = beast::insight::NullCollector::New ();
@@ -66,6 +75,16 @@ public:
     {
         return m_groups->get (name);
     }
+
+    boost::optional<std::string> metrics () override
+    {
+        if (! m_prometheus)
+            return boost::none;
+
+        std::string text;
+        m_prometheus->write (text);
+        return text;
+    }
 };
 
 //------------------------------------------------------------------------------
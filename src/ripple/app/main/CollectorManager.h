@@ -22,6 +22,8 @@
 
 #include <ripple/basics/BasicConfig.h>
 #include <ripple/beast/insight/Insight.h>
+#include <boost/optional.hpp>
+#include <string>
 
 namespace ripple {
 
@@ -36,6 +38,12 @@ public:
     virtual beast::insight::Collector::ptr const& collector () = 0;
     virtual beast::insight::Group::ptr const& group (
         std::string const& name) = 0;
+
+    /** Returns every metric in the Prometheus text format, as of the
+        collector's last collection.
+        @return boost::none unless the [insight] server is prometheus.
+    */
+    virtual boost::optional<std::string> metrics () = 0;
 };
 
 }
@@ -115,6 +115,62 @@ const char* LedgerDBInit[] =
 
 int LedgerDBCount = std::extent<decltype(LedgerDBInit)>::value;
 
+// Account transaction index, see AccountTxIndex
+const char* AccountTxDBInit[] =
+{
+    "PRAGMA synchronous=NORMAL;",
+    "PRAGMA journal_mode=WAL;",
+    "PRAGMA journal_size_limit=1582080;",
+    "PRAGMA max_page_count=2147483646;",
+
+#if (ULONG_MAX > UINT_MAX) && !defined (NO_SQLITE_MMAP)
+    "PRAGMA mmap_size=17179869184;",
+#endif
+
+    "BEGIN TRANSACTION;",
+
+    "CREATE TABLE IF NOT EXISTS AccountTx (                   \
+        Account     BLOB NOT NULL,              \
+        LedgerSeq   INTEGER NOT NULL,           \
+        TxnSeq      INTEGER NOT NULL,           \
+        TransID     BLOB NOT NULL,              \
+        PRIMARY KEY (Account, LedgerSeq, TxnSeq)\
+    ) WITHOUT ROWID;",
+    "CREATE INDEX IF NOT EXISTS AccountTxLgrIndex ON          \
+        AccountTx(LedgerSeq);",
+
+    "END TRANSACTION;"
+};
+
+int AccountTxDBCount = std::extent<decltype(AccountTxDBInit)>::value;
+
+// Archived validations, see ValidationArchive
+const char* ValidationsDBInit[] =
+{
+    "PRAGMA synchronous=NORMAL;",
+    "PRAGMA journal_mode=WAL;",
+    "PRAGMA journal_size_limit=1582080;",
+
+    "BEGIN TRANSACTION;",
+
+    "CREATE TABLE IF NOT EXISTS Validations (                 \
+        LedgerSeq   INTEGER,                    \
+        InitialSeq  INTEGER NOT NULL,           \
+        LedgerHash  BLOB NOT NULL,              \
+        NodePubKey  BLOB NOT NULL,              \
+        SignTime    INTEGER NOT NULL,           \
+        RawData     BLOB NOT NULL               \
+    );",
+    "CREATE INDEX IF NOT EXISTS ValidationsByHash ON          \
+        Validations(LedgerHash);",
+    "CREATE INDEX IF NOT EXISTS ValidationsByInitialSeq ON    \
+        Validations(InitialSeq);",
+
+    "END TRANSACTION;"
+};
+
+int ValidationsDBCount = std::extent<decltype(ValidationsDBInit)>::value;
+
 const char* WalletDBInit[] =
 {
     "BEGIN TRANSACTION;",
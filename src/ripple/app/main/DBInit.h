@@ -26,11 +26,15 @@ namespace ripple {
 extern const char* TxnDBInit[];
 extern const char* LedgerDBInit[];
 extern const char* WalletDBInit[];
+extern const char* AccountTxDBInit[];
+extern const char* ValidationsDBInit[];
 
 // VFALCO TODO Figure out what these counts are for
 extern int TxnDBCount;
 extern int LedgerDBCount;
 extern int WalletDBCount;
+extern int AccountTxDBCount;
+extern int ValidationsDBCount;
 
 } // ripple
 
@@ -0,0 +1,205 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/app/main/MemoryBudget.h>
+#include <ripple/basics/Log.h>
+#include <algorithm>
+#include <cassert>
+#include <fstream>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+namespace ripple {
+
+MemoryBudget::MemoryBudget (
+        std::uint64_t budget, beast::Journal journal)
+    : budget_ (budget)
+    , j_ (journal)
+{
+}
+
+void
+MemoryBudget::add (std::string const& name, int size, int age, int cost,
+    tune_type tune, usage_type usage)
+{
+    assert (cost > 0);
+    std::lock_guard <std::mutex> lock (mutex_);
+    caches_.push_back ({name, size, age, cost,
+        std::move (tune), std::move (usage)});
+}
+
+void
+MemoryBudget::update (std::uint64_t resident)
+{
+    std::lock_guard <std::mutex> lock (mutex_);
+    used_ = resident;
+    cached_ = 0;
+    for (auto& cache : caches_)
+    {
+        cache.bytes = cache.usage ();
+        cached_ += cache.bytes;
+    }
+
+    if (budget_ == 0)
+        return;
+
+    if (resident > std::max (budget_, peak_))
+    {
+        // The process grew past the budget. What the caches give back
+        // is reused before the process grows again, so they must give
+        // up the excess.
+        auto const excess = resident - budget_;
+        allowance_ = (cached_ > excess) ? cached_ - excess : 0;
+        peak_ = resident;
+    }
+    else if (resident <= budget_)
+    {
+        allowance_ = cached_ + (budget_ - resident);
+        peak_ = 0;
+    }
+
+    if (cached_ > allowance_)
+        shed ();
+    else if (cached_ < allowance_ / 4 * 3)
+        restore ();
+}
+
+void
+MemoryBudget::update ()
+{
+    if (auto const rss = residentBytes ())
+    {
+        update (*rss);
+        return;
+    }
+
+    std::uint64_t used = 0;
+    {
+        std::lock_guard <std::mutex> lock (mutex_);
+        for (auto const& cache : caches_)
+            used += cache.usage ();
+    }
+    update (used);
+}
+
+void
+MemoryBudget::shed ()
+{
+    Cache* best = nullptr;
+    for (auto& cache : caches_)
+    {
+        if (cache.level >= maxLevel)
+            continue;
+        // Halving the targets frees about half of the bytes
+        if (! best || cache.bytes * best->cost > best->bytes * cache.cost)
+            best = &cache;
+    }
+
+    if (! best)
+    {
+        JLOG (j_.warn()) <<
+            "Caches hold " << cached_ << " of an allowance of " <<
+            allowance_ << " with every cache at its floor";
+        return;
+    }
+    ++best->level;
+    apply (*best);
+}
+
+void
+MemoryBudget::restore ()
+{
+    Cache* best = nullptr;
+    for (auto& cache : caches_)
+    {
+        if (cache.level == 0)
+            continue;
+        if (! best || cache.cost >= best->cost)
+            best = &cache;
+    }
+
+    if (! best)
+        return;
+    --best->level;
+    apply (*best);
+}
+
+int
+MemoryBudget::level (std::string const& name) const
+{
+    std::lock_guard <std::mutex> lock (mutex_);
+    for (auto const& cache : caches_)
+        if (cache.name == name)
+            return cache.level;
+    return 0;
+}
+
+void
+MemoryBudget::apply (Cache& cache)
+{
+    auto const size = (cache.size == 0) ? 0 :
+        std::max (cache.size >> cache.level, 1);
+    auto const age = std::max (cache.age >> cache.level, 1);
+
+    JLOG (j_.info()) <<
+        "Memory use " << used_ << " of " << budget_ << ", caches " <<
+        cached_ << " of " << allowance_ << ": " <<
+        cache.name << " target size " << size << ", age " << age;
+
+    cache.tune (size, age);
+}
+
+Json::Value
+MemoryBudget::getJson () const
+{
+    Json::Value ret (Json::objectValue);
+    std::lock_guard <std::mutex> lock (mutex_);
+
+    ret["budget"] = std::to_string (budget_);
+    ret["used"] = std::to_string (used_);
+    ret["cached"] = std::to_string (cached_);
+    ret["allowance"] = std::to_string (allowance_);
+
+    Json::Value& caches = (ret["caches"] = Json::objectValue);
+    for (auto const& cache : caches_)
+    {
+        Json::Value& entry = (caches[cache.name] = Json::objectValue);
+        entry["bytes"] = std::to_string (cache.usage ());
+        entry["level"] = cache.level;
+    }
+    return ret;
+}
+
+boost::optional <std::uint64_t>
+MemoryBudget::residentBytes ()
+{
+#ifdef __linux__
+    std::ifstream statm ("/proc/self/statm");
+    std::uint64_t pages = 0;
+    std::uint64_t resident = 0;
+    if (statm >> pages >> resident)
+        return resident * ::sysconf (_SC_PAGESIZE);
+#endif
+    return boost::none;
+}
+
+} // ripple
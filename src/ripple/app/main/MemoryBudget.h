@@ -0,0 +1,134 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_MAIN_MEMORYBUDGET_H_INCLUDED
+#define RIPPLE_APP_MAIN_MEMORYBUDGET_H_INCLUDED
+
+#include <ripple/beast/utility/Journal.h>
+#include <ripple/json/json_value.h>
+#include <boost/optional.hpp>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ripple {
+
+/** Keeps the memory used by the server under a budget.
+
+    The resident size of the process is only a trigger, since memory
+    freed by a cache is kept by the allocator for reuse. When the
+    process grows past the budget, the caches together are allowed
+    what their estimates add up to, less the excess. While under the
+    budget, they are allowed their estimates plus the headroom.
+
+    While the caches hold more than their allowance, the cache which
+    frees the most bytes per unit of refill cost has its target size
+    and age halved. Once they hold less than three quarters of it,
+    the costliest reduced cache has its targets doubled, up to the
+    values it was added with. Only one cache is changed per update,
+    so the caches have a sweep to respond before the next decision.
+*/
+class MemoryBudget
+{
+public:
+    /** Sets the target size and age of a cache. */
+    using tune_type = std::function <void (int size, int age)>;
+
+    /** Returns an estimate of the bytes held by a cache. */
+    using usage_type = std::function <std::size_t ()>;
+
+    /** The number of times a cache's targets may be halved. */
+    static int constexpr maxLevel = 4;
+
+    /** Create a controller.
+
+        @param budget The budget in bytes, or 0 to only report usage.
+    */
+    MemoryBudget (std::uint64_t budget, beast::Journal journal);
+
+    MemoryBudget (MemoryBudget const&) = delete;
+    MemoryBudget& operator= (MemoryBudget const&) = delete;
+
+    /** Add a cache.
+
+        @param size The configured target size (0 = no size target).
+        @param age The configured target age in seconds.
+        @param cost The relative cost of refilling a byte of the cache.
+    */
+    void add (std::string const& name, int size, int age, int cost,
+        tune_type tune, usage_type usage);
+
+    /** Adjust the caches for the given resident size, in bytes. */
+    void update (std::uint64_t resident);
+
+    /** Adjust the caches for the resident size of the process.
+
+        Where the resident size is unavailable, the sum of the cache
+        estimates is used instead.
+    */
+    void update ();
+
+    /** Returns the budget in bytes, 0 if there is none. */
+    std::uint64_t budget () const
+    {
+        return budget_;
+    }
+
+    /** Returns the number of times a cache's targets have been halved. */
+    int level (std::string const& name) const;
+
+    /** Returns the budget, the memory used and the state of each cache. */
+    Json::Value getJson () const;
+
+    /** Returns the resident set size of this process in bytes, if known. */
+    static boost::optional <std::uint64_t> residentBytes ();
+
+private:
+    struct Cache
+    {
+        std::string name;
+        int size;
+        int age;
+        int cost;
+        tune_type tune;
+        usage_type usage;
+        int level = 0;
+        std::uint64_t bytes = 0;
+    };
+
+    void shed ();
+    void restore ();
+    void apply (Cache& cache);
+
+    std::uint64_t const budget_;
+    beast::Journal j_;
+    std::mutex mutable mutex_;
+    std::vector <Cache> caches_;
+    std::uint64_t used_ = 0;
+    std::uint64_t cached_ = 0;
+    std::uint64_t allowance_ = 0;
+    // The resident size when the allowance was last cut
+    std::uint64_t peak_ = 0;
+};
+
+} // ripple
+
+#endif
@@ -26,6 +26,12 @@ enum
 {
      fullBelowTargetSize = 524288
     ,fullBelowExpirationSeconds = 600
+
+    // Time a sweep job spends on the caches before yielding
+    ,sweepSliceMicroseconds = 2000
+
+    // Pause between the jobs of a sweep that did not finish in one
+    ,sweepPauseMilliseconds = 50
 };
 
 }
@@ -0,0 +1,141 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_MISC_ACCOUNTTXINDEX_H_INCLUDED
+#define RIPPLE_APP_MISC_ACCOUNTTXINDEX_H_INCLUDED
+
+#include <ripple/core/DatabaseCon.h>
+#include <ripple/basics/base_uint.h>
+#include <ripple/beast/utility/Journal.h>
+#include <ripple/protocol/AccountID.h>
+#include <boost/optional.hpp>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace ripple {
+
+/** An index of the transactions which affected each account.
+
+    The AccountTransactions table keys its rows by base58 account
+    strings in insertion order, so each page of account_tx has to
+    be sorted and joined against Transactions. This index lives in
+    its own database, in a table clustered on the binary account
+    ID, ledger sequence and transaction sequence. The transactions
+    of an account are stored together and in order, so a page is
+    one range scan of the primary key, however deep it is.
+
+    The index holds transaction IDs only; the transactions and
+    their metadata are read from the transaction database by
+    primary key.
+
+    When the index is first created, the existing rows of the
+    AccountTransactions table are imported in the background.
+    ready() returns false until the import completes, and until
+    then callers must use the transaction database instead.
+*/
+class AccountTxIndex
+{
+public:
+    struct Entry
+    {
+        AccountID account;
+        std::uint32_t txnSeq;
+        uint256 txID;
+    };
+
+    /** The position of a transaction: ledger and transaction sequence. */
+    using Marker = std::pair<std::uint32_t, std::uint32_t>;
+
+    AccountTxIndex (DatabaseCon::Setup const& setup,
+        DatabaseCon& txnDB, beast::Journal journal);
+
+    ~AccountTxIndex ();
+
+    AccountTxIndex (AccountTxIndex const&) = delete;
+    AccountTxIndex& operator= (AccountTxIndex const&) = delete;
+
+    /** Returns `true` if the index covers the transaction database. */
+    bool
+    ready () const
+    {
+        return ready_;
+    }
+
+    /** Returns the database holding the index. */
+    DatabaseCon&
+    getDB ()
+    {
+        return db_;
+    }
+
+    /** Replace the entries recorded for a ledger. */
+    void
+    saveLedger (std::uint32_t ledgerSeq,
+        std::vector<Entry> const& entries);
+
+    /** Note that online delete is removing the ledgers before `ledgerSeq`.
+
+        Call before deleting the entries of those ledgers. Entries
+        for them are no longer imported, so an import which runs
+        concurrently does not add back what was deleted.
+    */
+    void
+    setMinLedger (std::uint32_t ledgerSeq);
+
+    /** Visit a page of the transactions which affected an account.
+
+        @param marker If set, the position of the first transaction
+                      to visit; otherwise the page starts at the end
+                      of the ledger range given by `forward`.
+        @param limit  The most transactions to visit.
+
+        @return The position of the next transaction, if the range
+                holds more than `limit` transactions from the start.
+    */
+    boost::optional<Marker>
+    page (AccountID const& account,
+        std::uint32_t minLedger, std::uint32_t maxLedger,
+        bool forward, boost::optional<Marker> const& marker,
+        std::uint32_t limit, std::function<void (std::uint32_t ledgerSeq,
+            std::uint32_t txnSeq, uint256 const& txID)> const& f);
+
+private:
+    void
+    import ();
+
+    DatabaseCon db_;
+    DatabaseCon& txnDB_;
+    beast::Journal j_;
+    std::atomic<bool> ready_ {false};
+    std::atomic<bool> stop_ {false};
+    std::thread importer_;
+
+    // Serializes import batches with online delete
+    std::mutex mutex_;
+    std::uint32_t minLedger_ = 0;
+};
+
+} // ripple
+
+#endif
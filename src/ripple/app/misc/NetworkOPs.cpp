@@ -42,8 +42,10 @@
 #include <ripple/app/misc/TxQ.h>
 #include <ripple/app/misc/Validations.h>
 #include <ripple/app/misc/ValidatorList.h>
+#include <ripple/app/misc/AccountTxIndex.h>
 #include <ripple/app/misc/impl/AccountTxPaging.h>
 #include <ripple/app/tx/apply.h>
+#include <ripple/app/tx/applySteps.h>
 #include <ripple/basics/contract.h>
 #include <ripple/basics/Log.h>
 #include <ripple/basics/mulDiv.h>
@@ -103,15 +105,21 @@ class NetworkOPsImp final
         bool applied;
         TER result;
 
+        // Computed by precheck() before the transaction joins a
+        // batch, so less work is done under the open ledger lock.
+        PrecheckResult const precheck;
+
         TransactionStatus (
                 std::shared_ptr<Transaction> t,
                 bool a,
                 bool l,
-                FailHard f)
+                FailHard f,
+                PrecheckResult const& p)
             : transaction (t)
             , admin (a)
             , local (l)
             , failType (f)
+            , precheck (p)
         {}
     };
 
@@ -254,6 +262,18 @@ public:
     void doTransactionAsync (std::shared_ptr<Transaction> transaction,
         bool bUnlimited, FailHard failtype);
 
+    /**
+     * Run preflight, and the sequence check against a snapshot of the
+     * open ledger, on the calling thread. Only results which can not
+     * change while the open ledger keeps the same parent are kept.
+     *
+     * @param transaction Transaction about to be added to the batch.
+     * @param admin Whether the submitter has unlimited access.
+     * @return The preflight and any result which skips apply.
+     */
+    PrecheckResult precheck (
+        std::shared_ptr<Transaction> const& transaction, bool admin);
+
     /**
      * Apply transactions in batches. Continue until none are queued.
      */
@@ -864,13 +884,22 @@ void NetworkOPsImp::processTransaction (std::shared_ptr<Transaction>& transactio
 void NetworkOPsImp::doTransactionAsync (std::shared_ptr<Transaction> transaction,
         bool bUnlimited, FailHard failType)
 {
+    {
+        std::lock_guard<std::mutex> lock (mMutex);
+        if (transaction->getApplying())
+            return;
+    }
+
+    // The open ledger is checked without holding the batch lock
+    TransactionStatus e (transaction, bUnlimited, false, failType,
+        precheck (transaction, bUnlimited));
+
     std::lock_guard<std::mutex> lock (mMutex);
 
     if (transaction->getApplying())
         return;
 
-    mTransactions.push_back (TransactionStatus (transaction, bUnlimited, false,
-        failType));
+    mTransactions.push_back (std::move (e));
     transaction->setApplying();
 
     if (mDispatchState == DispatchState::none)
@@ -888,9 +917,17 @@ void NetworkOPsImp::doTransactionSync (std::shared_ptr<Transaction> transaction,
 
     if (! transaction->getApplying())
     {
-        mTransactions.push_back (TransactionStatus (transaction, bUnlimited,
-            true, failType));
-        transaction->setApplying();
+        // The open ledger is checked without holding the batch lock
+        lock.unlock();
+        TransactionStatus e (transaction, bUnlimited, true, failType,
+            precheck (transaction, bUnlimited));
+        lock.lock();
+
+        if (! transaction->getApplying())
+        {
+            mTransactions.push_back (std::move (e));
+            transaction->setApplying();
+        }
     }
 
     do
@@ -916,6 +953,19 @@ void NetworkOPsImp::doTransactionSync (std::shared_ptr<Transaction> transaction,
     while (transaction->getApplying());
 }
 
+PrecheckResult NetworkOPsImp::precheck (
+    std::shared_ptr<Transaction> const& transaction, bool admin)
+{
+    // we check before adding to the batch
+    ApplyFlags flags = tapNO_CHECK_SIGN;
+    if (admin)
+        flags = flags | tapUNLIMITED;
+
+    return ripple::precheck (app_, *app_.openLedger().current(),
+        *transaction->getSTransaction(), flags,
+            app_.journal ("OpenLedger"));
+}
+
 void NetworkOPsImp::transactionBatch()
 {
     std::unique_lock<std::mutex> lock (mMutex);
@@ -953,14 +1003,16 @@ void NetworkOPsImp::apply (std::unique_lock<std::mutex>& batchLock)
                 bool changed = false;
                 for (TransactionStatus& e : transactions)
                 {
-                    // we check before addingto the batch
-                    ApplyFlags flags = tapNO_CHECK_SIGN;
-                    if (e.admin)
-                        flags = flags | tapUNLIMITED;
-
-                    auto const result = app_.getTxQ().apply(
-                        app_, view, e.transaction->getSTransaction(),
-                        flags, j);
+                    if (auto const ter = e.precheck.reuse (view))
+                    {
+                        e.result = *ter;
+                        e.applied = false;
+                        continue;
+                    }
+
+                    auto const result = app_.getTxQ().apply(app_, view,
+                        e.transaction->getSTransaction(),
+                            e.precheck.preflight);
                     e.result = result.first;
                     e.applied = result.second;
                     changed = changed || result.second;
@@ -1013,7 +1065,8 @@ void NetworkOPsImp::apply (std::unique_lock<std::mutex>& batchLock)
                     auto t = std::make_shared<Transaction>(
                         trans, reason, app_);
                     submit_held.emplace_back(
-                        t, false, false, FailHard::no);
+                        t, false, false, FailHard::no,
+                            precheck (t, false));
                     t->setApplying();
                 }
             }
@@ -1843,7 +1896,7 @@ NetworkOPs::AccountTxs NetworkOPsImp::getAccountTxs (
         bUnlimited);
 
     {
-        auto db = app_.getTxnDB ().checkoutDb ();
+        auto db = app_.getTxnDB ().checkoutReadDb ();
 
         boost::optional<std::uint64_t> ledgerSeq;
         boost::optional<std::string> status;
@@ -1911,7 +1964,7 @@ std::vector<NetworkOPsImp::txnMetaLedgerType> NetworkOPsImp::getAccountTxsB (
         bUnlimited);
 
     {
-        auto db = app_.getTxnDB ().checkoutDb ();
+        auto db = app_.getTxnDB ().checkoutReadDb ();
 
         boost::optional<std::uint64_t> ledgerSeq;
         boost::optional<std::string> status;
@@ -1967,11 +2020,19 @@ NetworkOPsImp::getTxsAccount (
             ret, ledger_index, status, rawTxn, rawMeta, app);
     };
 
-    accountTxPage(app_.getTxnDB (), app_.accountIDCache(),
-        std::bind(saveLedgerAsync, std::ref(app_),
-            std::placeholders::_1), bound, account, minLedger,
-                maxLedger, forward, token, limit, bUnlimited,
-                    page_length);
+    auto const index = app_.getAccountTxIndex ();
+    if (index && index->ready ())
+        accountTxPage(*index, app_.getTxnDB (),
+            std::bind(saveLedgerAsync, std::ref(app_),
+                std::placeholders::_1), bound, account, minLedger,
+                    maxLedger, forward, token, limit, bUnlimited,
+                        page_length);
+    else
+        accountTxPage(app_.getTxnDB (), app_.accountIDCache(),
+            std::bind(saveLedgerAsync, std::ref(app_),
+                std::placeholders::_1), bound, account, minLedger,
+                    maxLedger, forward, token, limit, bUnlimited,
+                        page_length);
 
     return ret;
 }
@@ -1995,11 +2056,19 @@ NetworkOPsImp::getTxsAccountB (
         ret.emplace_back (strHex(rawTxn), strHex (rawMeta), ledgerIndex);
     };
 
-    accountTxPage(app_.getTxnDB (), app_.accountIDCache(),
-        std::bind(saveLedgerAsync, std::ref(app_),
-            std::placeholders::_1), bound, account, minLedger,
-                maxLedger, forward, token, limit, bUnlimited,
-                    page_length);
+    auto const index = app_.getAccountTxIndex ();
+    if (index && index->ready ())
+        accountTxPage(*index, app_.getTxnDB (),
+            std::bind(saveLedgerAsync, std::ref(app_),
+                std::placeholders::_1), bound, account, minLedger,
+                    maxLedger, forward, token, limit, bUnlimited,
+                        page_length);
+    else
+        accountTxPage(app_.getTxnDB (), app_.accountIDCache(),
+            std::bind(saveLedgerAsync, std::ref(app_),
+                std::placeholders::_1), bound, account, minLedger,
+                    maxLedger, forward, token, limit, bUnlimited,
+                        page_length);
     return ret;
 }
 
@@ -50,6 +50,9 @@ public:
         std::uint32_t deleteBatch = 100;
         std::uint32_t backOff = 100;
         std::int32_t ageThreshold = 60;
+        int copyThreads = 4;
+        std::uint32_t copyInterval = 256;
+        std::size_t filterMB = 32;
     };
 
     SHAMapStore (Stoppable& parent) : Stoppable ("SHAMapStore", parent) {}
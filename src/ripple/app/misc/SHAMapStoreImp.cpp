@@ -23,10 +23,12 @@
 #include <ripple/app/ledger/LedgerMaster.h>
 #include <ripple/app/ledger/TransactionMaster.h>
 #include <ripple/app/main/Application.h>
+#include <ripple/app/misc/AccountTxIndex.h>
+#include <ripple/app/misc/ValidationArchive.h>
 #include <ripple/basics/contract.h>
 #include <ripple/core/ConfigSections.h>
 #include <ripple/core/ThreadEntry.h>
-#include <boost/format.hpp>
+#include <ripple/protocol/Serializer.h>
 #include <boost/format.hpp>
 #include <boost/optional.hpp>
 #include <memory>
@@ -281,17 +283,90 @@ SHAMapStoreImp::fdlimit () const
 }
 
 bool
-SHAMapStoreImp::copyNode (std::uint64_t& nodeCount,
-        SHAMapAbstractNode const& node)
+SHAMapStoreImp::copyState (SHAMap const& map, NodeObjectType type,
+    std::uint64_t& nodeCount)
 {
-    // Copy a single record from node to database_
-    database_->fetchNode (node.getNodeHash().as_uint256());
-    if (! (++nodeCount % checkHealthInterval_))
+    auto const writable = database_->getWritableBackend();
+
+    std::mutex mutex;
+    std::mutex writeMutex;
+    std::atomic<bool> interrupted {false};
+    std::atomic<std::uint64_t> visited {0};
+    NodeStore::Batch batch;
+    std::vector<uint256> inner;
+
+    // Called with mutex unlocked. Backends do not accept
+    // concurrent batches.
+    auto flush = [&](NodeStore::Batch& b)
     {
-        if (health())
-            return true;
-    }
+        if (! b.empty())
+        {
+            std::lock_guard <std::mutex> lock (writeMutex);
+            writable->storeBatch (b);
+        }
+        b.clear();
+    };
+
+    map.visitNodesParallel (
+        [&](SHAMapAbstractNode& node)
+        {
+            if (interrupted)
+                return SHAMap::Visit::skip;
+
+            if (! (++visited % checkHealthInterval_))
+            {
+                std::lock_guard <std::mutex> lock (mutex);
+                if (health())
+                {
+                    interrupted = true;
+                    return SHAMap::Visit::skip;
+                }
+            }
+
+            auto const& hash = node.getNodeHash().as_uint256();
+
+            // Everything below this node is already in the backend
+            if (node.isInner() && copied_.count (hash))
+                return SHAMap::Visit::skip;
+
+            std::shared_ptr<NodeObject> object;
+            if (writable->fetch (hash.begin(), &object) != NodeStore::ok)
+            {
+                Serializer s;
+                node.addRaw (s, snfPREFIX);
+                object = NodeObject::createObject (
+                    type, std::move (s.modData()), hash);
+            }
+            else
+            {
+                object.reset();
+            }
 
+            NodeStore::Batch full;
+            {
+                std::lock_guard <std::mutex> lock (mutex);
+                if (node.isInner())
+                    inner.push_back (hash);
+                if (object)
+                {
+                    batch.push_back (std::move (object));
+                    if (batch.size() >= NodeStore::batchWritePreallocationSize)
+                        full.swap (batch);
+                }
+            }
+            flush (full);
+            return SHAMap::Visit::descend;
+        }, setup_.copyThreads);
+
+    nodeCount += visited;
+    if (interrupted)
+        return true;
+
+    flush (batch);
+
+    // The subtrees below these nodes are now complete in the
+    // writable backend, and need not be walked again until it rotates.
+    copied_.insert (inner.begin(), inner.end());
     return false;
 }
 
@@ -380,10 +455,9 @@ SHAMapStoreImp::runImpl()
             }
 
             std::uint64_t nodeCount = 0;
-            validatedLedger->stateMap().snapShot (
-                    false)->visitNodes (
-                    std::bind (&SHAMapStoreImp::copyNode, this,
-                    std::ref(nodeCount), std::placeholders::_1));
+            copyState (*validatedLedger->stateMap().snapShot (false),
+                hotACCOUNT_NODE, nodeCount);
+            lastCopied_ = validatedSeq;
             JLOG(journal_.debug()) << "copied ledger " << validatedSeq
                     << " nodecount " << nodeCount;
             switch (health())
@@ -442,10 +516,26 @@ SHAMapStoreImp::runImpl()
                 clearCaches (validatedSeq);
                 oldBackend = database_->rotateBackends (newBackend);
             }
+            copied_.clear();
             JLOG(journal_.debug()) << "finished rotation " << validatedSeq;
 
             oldBackend->setDeletePath();
         }
+        else if (setup_.copyInterval &&
+            validatedSeq >= lastCopied_ + setup_.copyInterval &&
+            health() == Health::ok)
+        {
+            // Copy the state ahead of the rotation, so that only the
+            // changes made since are left to copy when it comes.
+            std::uint64_t nodeCount = 0;
+            if (! copyState (*validatedLedger->stateMap().snapShot (false),
+                    hotACCOUNT_NODE, nodeCount))
+            {
+                lastCopied_ = validatedSeq;
+            }
+            JLOG(journal_.debug()) << "copied ledger " << validatedSeq
+                    << " ahead of rotation, nodecount " << nodeCount;
+        }
     }
 }
 
@@ -530,8 +620,15 @@ SHAMapStoreImp::makeBackendRotating (std::string path)
     }
     parameters.set("path", newPath.string());
 
-    return NodeStore::Manager::instance().make_Backend (parameters, scheduler_,
-            nodeStoreJournal_);
+    auto backend = NodeStore::Manager::instance().make_Backend (parameters,
+            scheduler_, nodeStoreJournal_);
+    if (setup_.filterMB)
+    {
+        // A backend without a path is new, and so empty
+        backend = NodeStore::make_FilteredBackend (std::move (backend),
+                setup_.filterMB * 1024 * 1024, path.empty(), nodeStoreJournal_);
+    }
+    return std::move (backend);
 }
 
 std::unique_ptr <NodeStore::DatabaseRotating>
@@ -742,6 +839,27 @@ SHAMapStoreImp::clearPrior (LedgerIndex lastRotated)
         "DELETE FROM AccountTransactions WHERE LedgerSeq < %u;");
     if (health())
         return;
+
+    if (auto const index = app_.getAccountTxIndex ())
+    {
+        index->setMinLedger (lastRotated);
+        clearSql (index->getDB (), lastRotated,
+            "SELECT MIN(LedgerSeq) FROM AccountTx;",
+            "DELETE FROM AccountTx WHERE LedgerSeq < %u;");
+        if (health())
+            return;
+    }
+
+    // Archived validations are trimmed by the ledger current when they
+    // were written, which is their ledger once it is saved.
+    if (auto const db = app_.getValidationArchive ().getDB ())
+    {
+        clearSql (*db, lastRotated,
+            "SELECT MIN(InitialSeq) FROM Validations;",
+            "DELETE FROM Validations WHERE InitialSeq < %u;");
+        if (health())
+            return;
+    }
 }
 
 SHAMapStoreImp::Health
@@ -836,6 +954,9 @@ setup_SHAMapStore (Config const& c)
     get_if_exists (setup.nodeDatabase, "delete_batch", setup.deleteBatch);
     get_if_exists (setup.nodeDatabase, "backOff", setup.backOff);
     get_if_exists (setup.nodeDatabase, "age_threshold", setup.ageThreshold);
+    get_if_exists (setup.nodeDatabase, "copy_threads", setup.copyThreads);
+    get_if_exists (setup.nodeDatabase, "copy_interval", setup.copyInterval);
+    get_if_exists (setup.nodeDatabase, "membership_filter_mb", setup.filterMB);
 
     return setup;
 }
@@ -26,6 +26,7 @@
 #include <ripple/core/SociDB.h>
 #include <ripple/nodestore/impl/Tuning.h>
 #include <ripple/nodestore/DatabaseRotating.h>
+#include <ripple/basics/UnorderedContainers.h>
 #include <iostream>
 #include <condition_variable>
 #include <thread>
@@ -109,6 +110,9 @@ private:
     DatabaseCon* transactionDb_ = nullptr;
     DatabaseCon* ledgerDb_ = nullptr;
     int fdlimit_ = 0;
+    // inner nodes whose subtrees are complete in the writable backend
+    hash_set<uint256> copied_;
+    LedgerIndex lastCopied_ = 0;
 
 public:
     SHAMapStoreImp (Application& app,
@@ -172,8 +176,16 @@ public:
     int fdlimit() const override;
 
 private:
-    // callback for visitNodes
-    bool copyNode (std::uint64_t& nodeCount, SHAMapAbstractNode const &node);
+    /** Copy the nodes of a map into the writable backend.
+
+        Subtrees which were copied since the last rotation are skipped,
+        and the nodes missing from the backend are written in batches
+        as objects of the given type.
+
+        @return true if the copy was interrupted.
+    */
+    bool copyState (SHAMap const& map, NodeObjectType type,
+        std::uint64_t& nodeCount);
     void run();
     void runImpl();
     void dbPaths();
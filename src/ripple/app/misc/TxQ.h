@@ -115,6 +115,16 @@ public:
         std::shared_ptr<STTx const> const& tx,
             ApplyFlags flags, beast::Journal j);
 
+    /**
+        Like the above, but reuse a `PreflightResult` the
+        caller computed for `tx` before taking the open ledger
+        lock. The flags and journal are taken from `pfresult`.
+    */
+    std::pair<TER, bool>
+    apply(Application& app, OpenView& view,
+        std::shared_ptr<STTx const> const& tx,
+            PreflightResult const& pfresult);
+
     /**
         Fill the new open ledger with transactions from the queue.
         As we apply more transactions to the ledger, the required
@@ -0,0 +1,101 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_MISC_VALIDATIONARCHIVE_H_INCLUDED
+#define RIPPLE_APP_MISC_VALIDATIONARCHIVE_H_INCLUDED
+
+#include <ripple/basics/base_uint.h>
+#include <ripple/basics/BasicConfig.h>
+#include <ripple/beast/utility/Journal.h>
+#include <ripple/core/DatabaseCon.h>
+#include <ripple/protocol/STValidation.h>
+#include <boost/optional.hpp>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace ripple {
+
+/** Persistent storage for validations which are no longer current.
+
+    Validations are written in batches. Each batch is one transaction
+    using one prepared statement. The sequence of the validated ledger
+    is looked up from its hash for trusted validations only. It is left
+    unknown for the others, rather than taken from what the validator
+    claims in the validation.
+
+    The archive is configured in the [validation_archive] section:
+
+    type=ledger_db      The Validations table of the ledger database.
+                        This is the default.
+
+    type=validations_db The Validations table of validations.db, using
+                        binary columns. The archive has its own
+                        connection, so writes never wait for ledger
+                        saves and lookups, nor delay them.
+
+    type=file           An append-only file at the given path, holding
+                        one record per validation: the big-endian
+                        32-bit record length and initial sequence,
+                        followed by the serialized validation.
+*/
+class ValidationArchive
+{
+public:
+    /** Returns the sequence of the ledger with a hash, if it is known. */
+    using LedgerSeq =
+        std::function<boost::optional<std::uint32_t> (uint256 const&)>;
+
+    virtual ~ValidationArchive () = default;
+
+    /** Store validations.
+
+        @param currentSeq The sequence of the current ledger, recorded
+                          with each validation for online delete.
+        @param ledgerSeq  Finds the sequence of a trusted validation's
+                          ledger.
+    */
+    virtual
+    void
+    write (std::vector<STValidation::pointer> const& validations,
+        std::uint32_t currentSeq, LedgerSeq const& ledgerSeq) = 0;
+
+    /** Note that a ledger was saved as validated. */
+    virtual
+    void
+    ledgerSaved (std::uint32_t seq, uint256 const& hash) = 0;
+
+    /** Returns the database holding the archive, if it is separate
+        from the ledger database. Online delete trims it.
+    */
+    virtual
+    DatabaseCon*
+    getDB () = 0;
+};
+
+/** Create the archive described by the configuration. */
+std::unique_ptr<ValidationArchive>
+make_ValidationArchive (Section const& section,
+    DatabaseCon::Setup const& setup, DatabaseCon& ledgerDB,
+        beast::Journal journal);
+
+} // ripple
+
+#endif
@@ -19,11 +19,11 @@
 
 #include <BeastConfig.h>
 #include <ripple/app/misc/Validations.h>
-#include <ripple/core/DatabaseCon.h>
 #include <ripple/app/ledger/LedgerMaster.h>
 #include <ripple/app/ledger/LedgerTiming.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/app/misc/NetworkOPs.h>
+#include <ripple/app/misc/ValidationArchive.h>
 #include <ripple/app/misc/ValidatorList.h>
 #include <ripple/basics/Log.h>
 #include <ripple/basics/StringUtilities.h>
@@ -403,11 +403,6 @@ private:
     {
         auto event = app_.getJobQueue ().getLoadEventAP (jtDISK, "ValidationWrite");
 
-        std::string insVal ("INSERT INTO Validations "
-            "(InitialSeq, LedgerSeq, LedgerHash,NodePubKey,SignTime,RawData) "
-            "VALUES (:initialSeq, :ledgerSeq, :ledgerHash,:nodePubKey,:signTime,:rawData);");
-        std::string findSeq("SELECT LedgerSeq FROM Ledgers WHERE Ledgerhash=:ledgerHash;");
-
         ScopedLockType sl (mLock);
         assert (mWriting);
 
@@ -419,47 +414,17 @@ private:
 
             {
                 ScopedUnlockType sul (mLock);
-                {
-                    auto db = app_.getLedgerDB ().checkoutDb ();
-
-                    Serializer s (1024);
-                    soci::transaction tr(*db);
-                    for (auto it: vector)
+                auto& ledgerMaster = app_.getLedgerMaster ();
+                app_.getValidationArchive ().write (vector,
+                    ledgerMaster.getCurrentLedgerIndex (),
+                    [&ledgerMaster] (uint256 const& hash)
+                        -> boost::optional<std::uint32_t>
                     {
-                        s.erase ();
-                        it->add (s);
-
-                        auto const ledgerHash = to_string(it->getLedgerHash());
-
-                        boost::optional<std::uint64_t> ledgerSeq;
-                        *db << findSeq, soci::use(ledgerHash),
-                            soci::into(ledgerSeq);
-
-                        auto const initialSeq = ledgerSeq.value_or(
-                            app_.getLedgerMaster().getCurrentLedgerIndex());
-                        auto const nodePubKey = toBase58(
-                            TokenType::TOKEN_NODE_PUBLIC,
-                            it->getSignerPublic());
-                        auto const signTime =
-                            it->getSignTime().time_since_epoch().count();
-
-                        soci::blob rawData(*db);
-                        rawData.append(reinterpret_cast<const char*>(
-                            s.peekData().data()), s.peekData().size());
-                        assert(rawData.get_len() == s.peekData().size());
-
-                        *db <<
-                            insVal,
-                            soci::use(initialSeq),
-                            soci::use(ledgerSeq),
-                            soci::use(ledgerHash),
-                            soci::use(nodePubKey),
-                            soci::use(signTime),
-                            soci::use(rawData);
-                    }
-
-                    tr.commit ();
-                }
+                        if (auto const ledger =
+                                ledgerMaster.getLedgerByHash (hash))
+                            return ledger->info().seq;
+                        return boost::none;
+                    });
             }
         }
 
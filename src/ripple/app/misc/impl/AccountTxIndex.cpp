@@ -0,0 +1,374 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/app/misc/AccountTxIndex.h>
+#include <ripple/app/main/DBInit.h>
+#include <ripple/basics/Log.h>
+#include <ripple/beast/core/Thread.h>
+#include <ripple/core/SociDB.h>
+#include <ripple/ledger/TxMeta.h>
+#include <algorithm>
+#include <limits>
+#include <tuple>
+
+namespace ripple {
+
+// Rows read from AccountTransactions at a time while importing
+static std::size_t const importBatch = 10000;
+
+// A row of the index and the ledger it belongs to
+using Row = std::pair<std::uint32_t, AccountTxIndex::Entry>;
+
+// Account and transaction IDs have a fixed size, so a blob
+// bound to a statement is overwritten completely by each row.
+template <class T>
+static
+void
+assignBlob (soci::blob& blob, T const& t)
+{
+    blob.write (0, reinterpret_cast<char const*> (t.data ()), t.size ());
+}
+
+static
+void
+insertRows (soci::session& session, char const* verb,
+    std::vector<Row> const& rows)
+{
+    soci::blob account (session);
+    std::uint64_t ledgerSeq = 0;
+    std::uint64_t txnSeq = 0;
+    soci::blob txID (session);
+    soci::statement st = (session.prepare <<
+        std::string (verb) + " INTO AccountTx "
+        "(Account, LedgerSeq, TxnSeq, TransID) "
+        "VALUES (:account, :ledgerSeq, :txnSeq, :txID);",
+            soci::use (account),
+            soci::use (ledgerSeq),
+            soci::use (txnSeq),
+            soci::use (txID));
+
+    for (auto const& row : rows)
+    {
+        assignBlob (account, row.second.account);
+        ledgerSeq = row.first;
+        txnSeq = row.second.txnSeq;
+        assignBlob (txID, row.second.txID);
+        st.execute (true);
+    }
+}
+
+// Old AccountTransactions rows may lack a TxnSeq. The position of
+// the transaction in its ledger is recorded in its metadata.
+static
+boost::optional<std::uint32_t>
+txnSeqFromMeta (soci::session& session,
+    uint256 const& txID, std::uint32_t ledgerSeq)
+{
+    std::string const id = to_string (txID);
+    soci::blob sociMeta (session);
+    soci::indicator present = soci::i_null;
+    session << "SELECT TxnMeta FROM Transactions WHERE TransID = :id;",
+        soci::use (id), soci::into (sociMeta, present);
+    if (! session.got_data () || present != soci::i_ok)
+        return boost::none;
+
+    Blob meta;
+    convert (sociMeta, meta);
+    try
+    {
+        return TxMeta (txID, ledgerSeq, meta, beast::Journal ()).getIndex ();
+    }
+    catch (std::exception const&)
+    {
+        return boost::none;
+    }
+}
+
+AccountTxIndex::AccountTxIndex (DatabaseCon::Setup const& setup,
+        DatabaseCon& txnDB, beast::Journal journal)
+    : db_ (setup, "account_tx.db", AccountTxDBInit, AccountTxDBCount)
+    , txnDB_ (txnDB)
+    , j_ (journal)
+{
+    // user_version is set once the import has completed
+    int version = 0;
+    db_.getSession () << "PRAGMA user_version;", soci::into (version);
+    if (version != 0)
+    {
+        ready_ = true;
+        return;
+    }
+
+    boost::optional<std::int64_t> first;
+    {
+        auto db = txnDB_.checkoutDb ();
+        *db << "SELECT rowid FROM AccountTransactions LIMIT 1;",
+            soci::into (first);
+    }
+
+    if (first)
+    {
+        importer_ = std::thread (&AccountTxIndex::import, this);
+        return;
+    }
+
+    db_.getSession () << "PRAGMA user_version=1;";
+    ready_ = true;
+}
+
+AccountTxIndex::~AccountTxIndex ()
+{
+    stop_ = true;
+    if (importer_.joinable ())
+        importer_.join ();
+}
+
+void
+AccountTxIndex::saveLedger (std::uint32_t ledgerSeq,
+    std::vector<Entry> const& entries)
+{
+    std::vector<Row> rows;
+    rows.reserve (entries.size ());
+    for (auto const& e : entries)
+        rows.emplace_back (ledgerSeq, e);
+
+    std::uint64_t const seq = ledgerSeq;
+    auto db = db_.checkoutDb ();
+    soci::transaction tr (*db);
+    *db << "DELETE FROM AccountTx WHERE LedgerSeq = :ledgerSeq;",
+        soci::use (seq);
+    insertRows (*db, "INSERT OR REPLACE", rows);
+    tr.commit ();
+}
+
+void
+AccountTxIndex::setMinLedger (std::uint32_t ledgerSeq)
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    minLedger_ = std::max (minLedger_, ledgerSeq);
+}
+
+boost::optional<AccountTxIndex::Marker>
+AccountTxIndex::page (AccountID const& account,
+    std::uint32_t minLedger, std::uint32_t maxLedger,
+    bool forward, boost::optional<Marker> const& marker,
+    std::uint32_t limit, std::function<void (std::uint32_t ledgerSeq,
+        std::uint32_t txnSeq, uint256 const& txID)> const& f)
+{
+    // Without a marker the page starts at the end of the range
+    auto const start = marker ? *marker : forward ?
+        Marker (minLedger, 0) :
+        Marker (maxLedger, std::numeric_limits<std::uint32_t>::max ());
+
+    // Reading one past the limit tells us where the next page starts
+    std::string const sql = forward ?
+        "SELECT LedgerSeq, TxnSeq, TransID FROM AccountTx "
+        "WHERE Account = :account "
+        "AND LedgerSeq BETWEEN :minLedger AND :maxLedger "
+        "AND (LedgerSeq > :startLedger OR "
+            "(LedgerSeq = :startLedger2 AND TxnSeq >= :startTxn)) "
+        "ORDER BY LedgerSeq ASC, TxnSeq ASC LIMIT :limit;" :
+        "SELECT LedgerSeq, TxnSeq, TransID FROM AccountTx "
+        "WHERE Account = :account "
+        "AND LedgerSeq BETWEEN :minLedger AND :maxLedger "
+        "AND (LedgerSeq < :startLedger OR "
+            "(LedgerSeq = :startLedger2 AND TxnSeq <= :startTxn)) "
+        "ORDER BY LedgerSeq DESC, TxnSeq DESC LIMIT :limit;";
+
+    std::vector<std::tuple<std::uint32_t, std::uint32_t, uint256>> found;
+    boost::optional<Marker> next;
+    {
+        auto db = db_.checkoutReadDb ();
+
+        soci::blob sociAccount (*db);
+        assignBlob (sociAccount, account);
+        std::uint64_t const lo = minLedger;
+        std::uint64_t const hi = maxLedger;
+        std::uint64_t const startLedger = start.first;
+        std::uint64_t const startTxn = start.second;
+        std::uint64_t const rows = std::uint64_t (limit) + 1;
+
+        std::uint64_t ledgerSeq = 0;
+        std::uint64_t txnSeq = 0;
+        soci::blob sociTxID (*db);
+        soci::statement st = (db->prepare << sql,
+            soci::use (sociAccount),
+            soci::use (lo),
+            soci::use (hi),
+            soci::use (startLedger),
+            soci::use (startLedger),
+            soci::use (startTxn),
+            soci::use (rows),
+            soci::into (ledgerSeq),
+            soci::into (txnSeq),
+            soci::into (sociTxID));
+
+        st.execute ();
+
+        Blob txID;
+        while (st.fetch ())
+        {
+            if (found.size () == limit)
+            {
+                next.emplace (ledgerSeq, txnSeq);
+                break;
+            }
+
+            convert (sociTxID, txID);
+            if (txID.size () != uint256::bytes)
+            {
+                JLOG (j_.warn()) <<
+                    "Bad transaction ID in ledger " << ledgerSeq;
+                continue;
+            }
+            found.emplace_back (ledgerSeq, txnSeq,
+                uint256::fromVoid (txID.data ()));
+        }
+    }
+
+    for (auto const& tx : found)
+        f (std::get<0> (tx), std::get<1> (tx), std::get<2> (tx));
+
+    return next;
+}
+
+void
+AccountTxIndex::import ()
+{
+    beast::Thread::setCurrentThreadName ("AccountTxIndex");
+
+    JLOG (j_.info()) << "Importing AccountTransactions";
+
+    try
+    {
+        std::int64_t last = 0;
+        std::size_t total = 0;
+        while (! stop_)
+        {
+            std::size_t fetched = 0;
+            std::vector<Row> rows;
+            rows.reserve (importBatch);
+            std::vector<Row> unknown;
+            {
+                auto db = txnDB_.checkoutReadDb ();
+
+                std::uint64_t const batch = importBatch;
+                std::int64_t rowid = 0;
+                std::string txID;
+                std::string account;
+                std::uint64_t ledgerSeq = 0;
+                boost::optional<std::uint64_t> txnSeq;
+                soci::statement st = (db->prepare <<
+                    "SELECT rowid, TransID, Account, LedgerSeq, TxnSeq "
+                    "FROM AccountTransactions WHERE rowid > :last "
+                    "ORDER BY rowid LIMIT :batch;",
+                        soci::use (last),
+                        soci::use (batch),
+                        soci::into (rowid),
+                        soci::into (txID),
+                        soci::into (account),
+                        soci::into (ledgerSeq),
+                        soci::into (txnSeq));
+
+                st.execute ();
+                while (st.fetch ())
+                {
+                    ++fetched;
+                    last = rowid;
+
+                    uint256 id;
+                    auto const acct = parseBase58<AccountID> (account);
+                    if (! acct || ! id.SetHexExact (txID))
+                    {
+                        JLOG (j_.warn()) <<
+                            "Skipping bad AccountTransactions row " << rowid;
+                        continue;
+                    }
+                    Row row (static_cast<std::uint32_t> (ledgerSeq),
+                        Entry {*acct, 0, id});
+                    if (! txnSeq)
+                    {
+                        unknown.push_back (row);
+                        continue;
+                    }
+                    row.second.txnSeq = static_cast<std::uint32_t> (*txnSeq);
+                    rows.push_back (row);
+                }
+
+                // Rows are keyed on their sequence, so rows without one
+                // would collide with the account's other such rows in
+                // the ledger.
+                for (auto& row : unknown)
+                {
+                    auto const seq = txnSeqFromMeta (
+                        *db, row.second.txID, row.first);
+                    if (! seq)
+                    {
+                        JLOG (j_.warn()) << "Skipping transaction " <<
+                            row.second.txID << " in ledger " <<
+                                row.first << " without a sequence";
+                        continue;
+                    }
+                    row.second.txnSeq = *seq;
+                    rows.push_back (row);
+                }
+            }
+
+            if (fetched == 0)
+                break;
+
+            {
+                // Online delete may have removed these ledgers since
+                // they were read. Holding the lock until the rows are
+                // written keeps a concurrent trim from running first.
+                std::lock_guard<std::mutex> lock (mutex_);
+                rows.erase (std::remove_if (rows.begin (), rows.end (),
+                    [this](Row const& row)
+                    {
+                        return row.first < minLedger_;
+                    }), rows.end ());
+
+                // Rows saved since the import started are newer
+                auto db = db_.checkoutDb ();
+                soci::transaction tr (*db);
+                insertRows (*db, "INSERT OR IGNORE", rows);
+                tr.commit ();
+            }
+
+            total += rows.size ();
+            JLOG (j_.debug()) << "Imported " << total << " rows";
+        }
+
+        if (stop_)
+            return;
+
+        *db_.checkoutDb () << "PRAGMA user_version=1;";
+        ready_ = true;
+
+        JLOG (j_.info()) <<
+            "Imported " << total << " rows, the index is ready";
+    }
+    catch (std::exception const& e)
+    {
+        JLOG (j_.error()) << "Import failed: " << e.what ();
+    }
+}
+
+} // ripple
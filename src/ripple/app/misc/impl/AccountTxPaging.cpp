@@ -20,12 +20,15 @@
 #include <BeastConfig.h>
 #include <ripple/app/ledger/LedgerToJson.h>
 #include <ripple/app/ledger/LedgerMaster.h>
+#include <ripple/app/ledger/PendingSaves.h>
 #include <ripple/app/main/Application.h>
+#include <ripple/app/misc/AccountTxIndex.h>
 #include <ripple/app/misc/Transaction.h>
 #include <ripple/app/misc/impl/AccountTxPaging.h>
 #include <ripple/protocol/Serializer.h>
 #include <ripple/protocol/types.h>
 #include <boost/format.hpp>
+#include <map>
 #include <memory>
 
 namespace ripple {
@@ -54,11 +57,26 @@ convertBlobsToTxResult (
     to.emplace_back(std::move(tr), metaset);
 };
 
-void
+bool
 saveLedgerAsync (Application& app, std::uint32_t seq)
 {
-    if (auto l = app.getLedgerMaster().getLedgerBySeq(seq))
-        pendSaveValidated(app, l, false, false);
+    auto l = app.getLedgerMaster().getLedgerBySeq(seq);
+    if (! l)
+        return false;
+    pendSaveValidated(app, l, false, false);
+    return app.pendingSaves().pending(seq);
+}
+
+// Transactions read by each statement when paging through the index
+static std::size_t const selectBatch = 500;
+
+static
+std::uint32_t
+pageSize (int limit, bool bAdmin, std::uint32_t page_length)
+{
+    if (limit <= 0 || (limit > page_length && !bAdmin))
+        return page_length;
+    return limit;
 }
 
 void
@@ -81,12 +99,7 @@ accountTxPage (
 {
     bool lookingForMarker =  !token.isNull() && token.isObject();
 
-    std::uint32_t numberOfResults;
-
-    if (limit <= 0 || (limit > page_length && !bAdmin))
-        numberOfResults = page_length;
-    else
-        numberOfResults = limit;
+    std::uint32_t numberOfResults = pageSize (limit, bAdmin, page_length);
 
     // As an account can have many thousands of transactions, there is a limit
     // placed on the amount of transactions returned. If the limit is reached
@@ -197,7 +210,7 @@ accountTxPage (
     }
 
     {
-        auto db (connection.checkoutDb());
+        auto db (connection.checkoutReadDb());
 
         Blob rawData;
         Blob rawMeta;
@@ -262,4 +275,162 @@ accountTxPage (
     return;
 }
 
+void
+accountTxPage (
+    AccountTxIndex& index,
+    DatabaseCon& connection,
+    std::function<bool (std::uint32_t)> const& onUnsavedLedger,
+    std::function<void (std::uint32_t,
+                        std::string const&,
+                        Blob const&,
+                        Blob const&)> const& onTransaction,
+    AccountID const& account,
+    std::int32_t minLedger,
+    std::int32_t maxLedger,
+    bool forward,
+    Json::Value& token,
+    int limit,
+    bool bAdmin,
+    std::uint32_t page_length)
+{
+    boost::optional<AccountTxIndex::Marker> marker;
+
+    if (!token.isNull() && token.isObject())
+    {
+        try
+        {
+            if (!token.isMember(jss::ledger) || !token.isMember(jss::seq))
+                return;
+            marker.emplace (token[jss::ledger].asUInt(),
+                token[jss::seq].asUInt());
+        }
+        catch (std::exception const&)
+        {
+            return;
+        }
+    }
+
+    token = Json::nullValue;
+
+    struct Found
+    {
+        std::uint32_t ledgerSeq;
+        std::uint32_t txnSeq;
+        std::string txID;
+    };
+
+    std::vector<Found> found;
+    auto const next = index.page (account,
+        std::max (minLedger, 0), std::max (maxLedger, 0),
+        forward, marker, pageSize (limit, bAdmin, page_length),
+        [&found](std::uint32_t ledgerSeq, std::uint32_t txnSeq,
+            uint256 const& txID)
+        {
+            found.push_back ({ledgerSeq, txnSeq, to_string (txID)});
+        });
+
+    if (next)
+    {
+        token = Json::objectValue;
+        token[jss::ledger] = next->first;
+        token[jss::seq] = next->second;
+    }
+
+    struct Stored
+    {
+        std::string status;
+        Blob rawData;
+        Blob rawMeta;
+    };
+
+    // The index only names the transactions, the blobs still live in
+    // the transaction database. They are read with one statement, in
+    // chunks which stay below SQLite's limit on bound parameters.
+    std::map<std::string, Stored> stored;
+    {
+        auto db (connection.checkoutReadDb());
+
+        std::string txID;
+        boost::optional<std::string> status;
+        soci::blob txnData (*db);
+        soci::blob txnMeta (*db);
+        soci::indicator dataPresent, metaPresent;
+
+        for (std::size_t i = 0; i < found.size (); i += selectBatch)
+        {
+            auto const end = std::min (found.size (), i + selectBatch);
+
+            std::string sql =
+                "SELECT TransID,Status,RawTxn,TxnMeta FROM Transactions "
+                "WHERE TransID IN (";
+            for (auto j = i; j < end; ++j)
+            {
+                if (j != i)
+                    sql += ',';
+                sql += ":t" + std::to_string (j - i);
+            }
+            sql += ");";
+
+            soci::statement st (*db);
+            st.exchange (soci::into (txID));
+            st.exchange (soci::into (status));
+            st.exchange (soci::into (txnData, dataPresent));
+            st.exchange (soci::into (txnMeta, metaPresent));
+            for (auto j = i; j < end; ++j)
+                st.exchange (soci::use (found[j].txID));
+            st.alloc ();
+            st.prepare (sql);
+            st.define_and_bind ();
+
+            st.execute ();
+            while (st.fetch ())
+            {
+                if (! status)
+                    continue;
+
+                auto& s = stored[txID];
+                s.status = *status;
+
+                if (dataPresent == soci::i_ok)
+                    convert (txnData, s.rawData);
+
+                if (metaPresent == soci::i_ok)
+                    convert (txnMeta, s.rawMeta);
+            }
+        }
+    }
+
+    for (auto const& tx : found)
+    {
+        auto const iter = stored.find (tx.txID);
+        if (iter == stored.end ())
+        {
+            // The ledger was not saved completely. While it is saved
+            // again, end the page here so the caller resumes at this
+            // transaction. Saving the ledger stores the transaction, or
+            // removes it from the index if it is not in the ledger.
+            if (onUnsavedLedger (tx.ledgerSeq))
+            {
+                token = Json::objectValue;
+                token[jss::ledger] = tx.ledgerSeq;
+                token[jss::seq] = tx.txnSeq;
+                break;
+            }
+
+            // The ledger can't be saved again: it is gone, was deleted,
+            // or was saved recently without this transaction. Skip it,
+            // as the transaction database does, so paging still ends.
+            continue;
+        }
+
+        auto const& s = iter->second;
+
+        // Work around a bug that could leave the metadata missing
+        if (s.rawMeta.size() == 0)
+            onUnsavedLedger (tx.ledgerSeq);
+
+        onTransaction (tx.ledgerSeq, s.status, s.rawData, s.rawMeta);
+    }
+}
+
 }
@@ -31,6 +31,8 @@
 
 namespace ripple {
 
+class AccountTxIndex;
+
 void
 convertBlobsToTxResult (
     NetworkOPs::AccountTxs& to,
@@ -40,7 +42,11 @@ convertBlobsToTxResult (
     Blob const& rawMeta,
     Application& app);
 
-void
+/** Save a validated ledger again, if it is still available.
+
+    @return `true` if the ledger is being saved.
+*/
+bool
 saveLedgerAsync (Application& app, std::uint32_t seq);
 
 void
@@ -61,6 +67,33 @@ accountTxPage (
     bool bAdmin,
     std::uint32_t pageLength);
 
+/** Page through an account's transactions using the account index.
+    Behaves like the overload above, reading the matching rows from
+    the index and the transaction blobs from the transaction database.
+
+    A transaction which is in the index but not in the transaction
+    database ends the page, with a marker which resumes there, if
+    `onUnsavedLedger` returns `true` because its ledger is being
+    saved again. Otherwise the transaction is skipped.
+*/
+void
+accountTxPage (
+    AccountTxIndex& index,
+    DatabaseCon& database,
+    std::function<bool (std::uint32_t)> const& onUnsavedLedger,
+    std::function<void (std::uint32_t,
+                        std::string const&,
+                        Blob const&,
+                        Blob const&)> const&,
+    AccountID const& account,
+    std::int32_t minLedger,
+    std::int32_t maxLedger,
+    bool forward,
+    Json::Value& token,
+    int limit,
+    bool bAdmin,
+    std::uint32_t pageLength);
+
 }
 
 #endif
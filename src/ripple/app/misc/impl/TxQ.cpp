@@ -595,18 +595,45 @@ TxQ::apply(Application& app, OpenView& view,
         return ripple::apply(app, view, *tx, flags, j);
     }
 
-    auto const account = (*tx)[sfAccount];
-    auto const transactionID = tx->getTransactionID();
-    auto const tSeq = tx->getSequence();
-
     // See if the transaction is valid, properly formed,
     // etc. before doing potentially expensive queue
     // replace and multi-transaction operations.
-    auto const pfresult = preflight(app, view.rules(),
-        *tx, flags, j);
+    return apply(app, view, tx,
+        preflight(app, view.rules(), *tx, flags, j));
+}
+
+std::pair<TER, bool>
+TxQ::apply(Application& app, OpenView& view,
+    std::shared_ptr<STTx const> const& tx,
+        PreflightResult const& pfresult)
+{
+    assert(&pfresult.tx == tx.get());
+
+    auto const allowEscalation =
+        (view.rules().enabled(featureFeeEscalation));
+    if (!allowEscalation)
+    {
+        return ripple::apply(app, view, pfresult);
+    }
+
+    // The preflight may have been run against different
+    // rules, in which case preclaim will redo it. Catch
+    // that here so a stale result can't reject the tx.
+    if (pfresult.rules != view.rules())
+    {
+        return apply(app, view, tx,
+            pfresult.flags, pfresult.j);
+    }
+
     if (pfresult.ter != tesSUCCESS)
         return{ pfresult.ter, false };
 
+    auto const account = (*tx)[sfAccount];
+    auto const transactionID = tx->getTransactionID();
+    auto const tSeq = tx->getSequence();
+    auto const flags = pfresult.flags;
+    auto const j = pfresult.j;
+
     struct MultiTxn
     {
         boost::optional<ApplyViewImpl> applyView;
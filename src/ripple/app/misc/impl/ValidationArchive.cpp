@@ -0,0 +1,315 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/app/misc/ValidationArchive.h>
+#include <ripple/app/main/DBInit.h>
+#include <ripple/basics/contract.h>
+#include <ripple/basics/Log.h>
+#include <ripple/core/SociDB.h>
+#include <ripple/protocol/Serializer.h>
+#include <boost/filesystem.hpp>
+#include <boost/optional.hpp>
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+namespace ripple {
+
+namespace {
+
+// The sequence of the validated ledger, if the validation is trusted and
+// the ledger is known. An untrusted validator could claim any sequence,
+// so its sfLedgerSequence is not used. Otherwise the sequence is filled in
+// when the ledger is saved.
+boost::optional<std::uint64_t>
+validatedSeq (STValidation const& val,
+    ValidationArchive::LedgerSeq const& ledgerSeq)
+{
+    if (! val.isTrusted ())
+        return boost::none;
+    if (auto const seq = ledgerSeq (val.getLedgerHash ()))
+        return *seq;
+    return boost::none;
+}
+
+void
+assignBlob (soci::blob& blob, void const* data, std::size_t size)
+{
+    blob.trim (0);
+    if (size != 0)
+        blob.append (static_cast<char const*> (data), size);
+}
+
+//------------------------------------------------------------------------------
+
+// The Validations table of the ledger database, with text columns.
+class LedgerDBArchive : public ValidationArchive
+{
+    // Rows written each time the shared session is checked out, so
+    // that ledger saves and lookups are not held up by a large batch.
+    static std::size_t const chunkSize = 128;
+
+    DatabaseCon& db_;
+
+public:
+    explicit
+    LedgerDBArchive (DatabaseCon& db)
+        : db_ (db)
+    {
+    }
+
+    void
+    write (std::vector<STValidation::pointer> const& validations,
+        std::uint32_t currentSeq, LedgerSeq const& ledgerSeq) override
+    {
+        Serializer s (1024);
+        for (std::size_t i = 0; i < validations.size (); i += chunkSize)
+        {
+            auto const end = std::min (validations.size (), i + chunkSize);
+
+            auto db = db_.checkoutDb ();
+            soci::transaction tr (*db);
+
+            boost::optional<std::uint64_t> seq;
+            std::uint64_t initialSeq = 0;
+            std::string ledgerHash;
+            std::string nodePubKey;
+            std::uint64_t signTime = 0;
+            soci::blob rawData (*db);
+            soci::statement st = (db->prepare <<
+                "INSERT INTO Validations "
+                "(InitialSeq, LedgerSeq, LedgerHash, NodePubKey, SignTime, RawData) "
+                "VALUES (:initialSeq, :ledgerSeq, :ledgerHash, :nodePubKey, "
+                ":signTime, :rawData);",
+                    soci::use (initialSeq),
+                    soci::use (seq),
+                    soci::use (ledgerHash),
+                    soci::use (nodePubKey),
+                    soci::use (signTime),
+                    soci::use (rawData));
+
+            for (auto j = i; j < end; ++j)
+            {
+                auto const& val = *validations[j];
+                s.erase ();
+                val.add (s);
+
+                seq = validatedSeq (val, ledgerSeq);
+                initialSeq = seq.value_or (currentSeq);
+                ledgerHash = to_string (val.getLedgerHash ());
+                nodePubKey = toBase58 (TokenType::TOKEN_NODE_PUBLIC,
+                    val.getSignerPublic ());
+                signTime = val.getSignTime ().time_since_epoch ().count ();
+                assignBlob (rawData, s.getDataPtr (), s.size ());
+
+                st.execute (true);
+            }
+
+            tr.commit ();
+        }
+    }
+
+    void
+    ledgerSaved (std::uint32_t, uint256 const&) override
+    {
+        // Ledger saves update this table themselves
+    }
+
+    DatabaseCon*
+    getDB () override
+    {
+        return nullptr;
+    }
+};
+
+//------------------------------------------------------------------------------
+
+// The Validations table of validations.db, with binary columns.
+class ValidationsDBArchive : public ValidationArchive
+{
+    DatabaseCon db_;
+
+public:
+    explicit
+    ValidationsDBArchive (DatabaseCon::Setup const& setup)
+        : db_ (setup, "validations.db", ValidationsDBInit, ValidationsDBCount)
+    {
+    }
+
+    void
+    write (std::vector<STValidation::pointer> const& validations,
+        std::uint32_t currentSeq, LedgerSeq const& ledgerSeq) override
+    {
+        auto db = db_.checkoutDb ();
+        soci::transaction tr (*db);
+
+        boost::optional<std::uint64_t> seq;
+        std::uint64_t initialSeq = 0;
+        soci::blob ledgerHash (*db);
+        soci::blob nodePubKey (*db);
+        std::uint64_t signTime = 0;
+        soci::blob rawData (*db);
+        soci::statement st = (db->prepare <<
+            "INSERT INTO Validations "
+            "(InitialSeq, LedgerSeq, LedgerHash, NodePubKey, SignTime, RawData) "
+            "VALUES (:initialSeq, :ledgerSeq, :ledgerHash, :nodePubKey, "
+            ":signTime, :rawData);",
+                soci::use (initialSeq),
+                soci::use (seq),
+                soci::use (ledgerHash),
+                soci::use (nodePubKey),
+                soci::use (signTime),
+                soci::use (rawData));
+
+        Serializer s (1024);
+        for (auto const& val : validations)
+        {
+            s.erase ();
+            val->add (s);
+
+            seq = validatedSeq (*val, ledgerSeq);
+            initialSeq = seq.value_or (currentSeq);
+            auto const hash = val->getLedgerHash ();
+            assignBlob (ledgerHash, hash.data (), hash.size ());
+            auto const key = val->getSignerPublic ();
+            assignBlob (nodePubKey, key.data (), key.size ());
+            signTime = val->getSignTime ().time_since_epoch ().count ();
+            assignBlob (rawData, s.getDataPtr (), s.size ());
+
+            st.execute (true);
+        }
+
+        tr.commit ();
+    }
+
+    void
+    ledgerSaved (std::uint32_t seq, uint256 const& hash) override
+    {
+        auto db = db_.checkoutDb ();
+        std::uint64_t const ledgerSeq = seq;
+        soci::blob ledgerHash (*db);
+        assignBlob (ledgerHash, hash.data (), hash.size ());
+        *db <<
+            "UPDATE Validations SET LedgerSeq = :ledgerSeq, "
+            "InitialSeq = :initialSeq WHERE LedgerHash = :ledgerHash;",
+                soci::use (ledgerSeq),
+                soci::use (ledgerSeq),
+                soci::use (ledgerHash);
+    }
+
+    DatabaseCon*
+    getDB () override
+    {
+        return &db_;
+    }
+};
+
+//------------------------------------------------------------------------------
+
+// An append-only file of length-prefixed records.
+class FileArchive : public ValidationArchive
+{
+    std::ofstream out_;
+    beast::Journal j_;
+
+public:
+    FileArchive (boost::filesystem::path const& path, beast::Journal journal)
+        : out_ (path.string (), std::ios::binary | std::ios::app)
+        , j_ (journal)
+    {
+        if (! out_)
+            Throw<std::runtime_error> (
+                "Unable to open validation archive " + path.string ());
+    }
+
+    void
+    write (std::vector<STValidation::pointer> const& validations,
+        std::uint32_t currentSeq, LedgerSeq const& ledgerSeq) override
+    {
+        Serializer batch (validations.size () * 256);
+        Serializer s (1024);
+        for (auto const& val : validations)
+        {
+            s.erase ();
+            val->add (s);
+
+            batch.add32 (s.size ());
+            batch.add32 (
+                validatedSeq (*val, ledgerSeq).value_or (currentSeq));
+            batch.addRaw (s);
+        }
+
+        out_.write (static_cast<char const*> (batch.getDataPtr ()),
+            batch.size ());
+        out_.flush ();
+        if (! out_)
+        {
+            JLOG (j_.error()) << "Unable to write " <<
+                validations.size () << " validations";
+            out_.clear ();
+        }
+    }
+
+    void
+    ledgerSaved (std::uint32_t, uint256 const&) override
+    {
+    }
+
+    DatabaseCon*
+    getDB () override
+    {
+        return nullptr;
+    }
+};
+
+} // namespace
+
+std::unique_ptr<ValidationArchive>
+make_ValidationArchive (Section const& section,
+    DatabaseCon::Setup const& setup, DatabaseCon& ledgerDB,
+        beast::Journal journal)
+{
+    auto const type = get<std::string> (section, "type", "ledger_db");
+
+    if (type == "ledger_db")
+        return std::make_unique<LedgerDBArchive> (ledgerDB);
+
+    if (type == "validations_db")
+        return std::make_unique<ValidationsDBArchive> (setup);
+
+    if (type == "file")
+    {
+        std::string name;
+        if (! set (name, "path", section) || name.empty ())
+            Throw<std::runtime_error> (
+                "[validation_archive] type=file requires a path");
+
+        boost::filesystem::path path (name);
+        if (path.is_relative ())
+            path = setup.dataDir / path;
+        return std::make_unique<FileArchive> (path, journal);
+    }
+
+    Throw<std::runtime_error> (
+        "Unknown [validation_archive] type: " + type);
+    return nullptr;
+}
+
+} // ripple
@@ -32,6 +32,7 @@ namespace ripple {
 
 class Application;
 class HashRouter;
+struct PreflightResult;
 
 enum class Validity
 {
@@ -95,6 +96,20 @@ apply (Application& app, OpenView& view,
     STTx const& tx, ApplyFlags flags,
         beast::Journal journal);
 
+/** Apply a transaction that has already passed preflight.
+
+    This allows the caller to run preflight, which needs
+    no ledger, before taking any lock protecting `view`.
+    If the rules of `view` differ from the ones used for
+    preflight, preflight is repeated.
+
+    @return A pair with the TER and a bool indicating
+            whether or not the transaction was applied.
+*/
+std::pair<TER, bool>
+apply (Application& app, OpenView& view,
+    PreflightResult const& preflightResult);
+
 
 /** Class for return value from applyTransaction */
 enum class ApplyResult
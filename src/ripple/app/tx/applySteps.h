@@ -22,6 +22,7 @@
 
 #include <ripple/ledger/ApplyViewImpl.h>
 #include <ripple/beast/utility/Journal.h>
+#include <boost/optional.hpp>
 
 namespace ripple {
 
@@ -92,6 +93,50 @@ public:
     PreclaimResult& operator=(PreclaimResult const&) = delete;
 };
 
+/** The checks of a transaction made against a snapshot of
+    the open ledger, before the lock protecting it is taken.
+*/
+struct PrecheckResult
+{
+public:
+    PreflightResult const preflight;
+
+    // A final preclaim result, which holds in every later
+    // state of the same open ledger, or none
+    boost::optional<TER> const ter;
+
+    // The open ledger that was checked
+    LedgerIndex const seq;
+    uint256 const parentHash;
+
+    PrecheckResult(PreflightResult const& preflight_,
+        boost::optional<TER> const& ter_, OpenView const& view)
+        : preflight(preflight_)
+        , ter(ter_)
+        , seq(view.seq())
+        , parentHash(view.info().parentHash)
+    {
+    }
+
+    PrecheckResult& operator=(PrecheckResult const&) = delete;
+
+    /** Return the final result, if it still holds for `view`.
+
+        The open ledger only grows until it is rebuilt on a new
+        parent, which may have a different history, so the result
+        is only reused for the same sequence, parent and rules.
+    */
+    boost::optional<TER>
+    reuse(OpenView const& view) const
+    {
+        if (ter && view.seq() == seq &&
+            view.info().parentHash == parentHash &&
+                view.rules() == preflight.rules)
+            return ter;
+        return boost::none;
+    }
+};
+
 struct TxConsequences
 {
     enum Category
@@ -157,6 +202,23 @@ PreclaimResult
 preclaim(PreflightResult const& preflightResult,
     Application& app, OpenView const& view);
 
+/** Check a transaction against a snapshot of the open ledger.
+
+    Preflight is run, and if it succeeds, the sequence check
+    which begins preclaim. Its failures which cannot change
+    while transactions are added to the open ledger are kept:
+    tefPAST_SEQ, tefALREADY and tefMAX_LEDGER. A transaction
+    with one of those need not be applied at all. The rest of
+    preclaim is left to apply, which reuses the preflight.
+
+    @return A PrecheckResult object containing the
+    PreflightResult and the final result, if any.
+*/
+PrecheckResult
+precheck(Application& app, OpenView const& view,
+    STTx const& tx, ApplyFlags flags,
+        beast::Journal j);
+
 /** Compute only the expected base fee for a transaction.
 
     Base fees are transaction specific, so any calculation
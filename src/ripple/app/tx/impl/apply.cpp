@@ -114,6 +114,15 @@ apply (Application& app, OpenView& view,
     return doApply(pcresult, app, view);
 }
 
+std::pair<TER, bool>
+apply (Application& app, OpenView& view,
+    PreflightResult const& preflightResult)
+{
+    STAmountSO saved(view.info().parentCloseTime);
+    auto pcresult = preclaim(preflightResult, app, view);
+    return doApply(pcresult, app, view);
+}
+
 ApplyResult
 applyTransaction (Application& app, OpenView& view,
     STTx const& txn,
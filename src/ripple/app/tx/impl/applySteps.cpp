@@ -291,6 +291,44 @@ preclaim (PreflightResult const& preflightResult,
     }
 }
 
+PrecheckResult
+precheck(Application& app, OpenView const& view,
+    STTx const& tx, ApplyFlags flags,
+        beast::Journal j)
+{
+    STAmountSO saved(view.info().parentCloseTime);
+
+    auto const pfresult = preflight(app, view.rules(),
+        tx, flags, j);
+    if (pfresult.ter != tesSUCCESS)
+        return { pfresult, boost::none, view };
+
+    // Preclaim checks the sequence before anything else. A
+    // transaction without an account is a pseudo-transaction,
+    // which preclaim does not check.
+    if (tx.getAccountID(sfAccount) == zero)
+        return { pfresult, boost::none, view };
+
+    // Within one open ledger the account sequence only moves
+    // forward and applied transactions are never removed.
+    PreclaimContext const ctx(app, view, pfresult.ter, tx, flags, j);
+    try
+    {
+        auto const ter = Transactor::checkSeq(ctx);
+        if (ter == tefPAST_SEQ ||
+            ter == tefALREADY ||
+            ter == tefMAX_LEDGER)
+            return { pfresult, ter, view };
+    }
+    catch (std::exception const& e)
+    {
+        JLOG(j.fatal()) <<
+            "apply: " << e.what();
+    }
+
+    return { pfresult, boost::none, view };
+}
+
 std::uint64_t
 calculateBaseFee(Application& app, ReadView const& view,
     STTx const& tx, beast::Journal j)
@@ -20,8 +20,11 @@
 #ifndef RIPPLE_BASICS_DECAYINGSAMPLE_H_INCLUDED
 #define RIPPLE_BASICS_DECAYINGSAMPLE_H_INCLUDED
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cmath>
+#include <cstdint>
 
 namespace ripple {
 
@@ -103,6 +106,119 @@ private:
 
 //------------------------------------------------------------------------------
 
+/** A DecayingSample which may be shared between threads without a lock.
+
+    The value and the whole second at which it was last aged are packed
+    into one atomic word, so adding a sample is a single compare-and-swap
+    and reading the value is a single load. Values saturate at zero and
+    at 2^32-1 exponential units.
+
+    @tparam Window The number of seconds in the decay window.
+*/
+template <int Window, typename Clock>
+class AtomicDecayingSample
+{
+public:
+    using value_type = typename Clock::duration::rep;
+    using time_point = typename Clock::time_point;
+
+    AtomicDecayingSample () = delete;
+    AtomicDecayingSample (AtomicDecayingSample const&) = delete;
+    AtomicDecayingSample& operator= (AtomicDecayingSample const&) = delete;
+
+    /**
+        @param now Start time of AtomicDecayingSample.
+    */
+    explicit AtomicDecayingSample (time_point now)
+        : m_state (pack (0, seconds (now)))
+    {
+    }
+
+    /** Add a new sample.
+        The value is first aged according to the specified time.
+    */
+    value_type add (value_type value, time_point now)
+    {
+        auto const when = seconds (now);
+        auto expected = m_state.load (std::memory_order_relaxed);
+        std::uint64_t desired;
+        do
+        {
+            auto const aged = decay (expected, when);
+            desired = pack (saturate (
+                static_cast<value_type> (units (aged)) + value),
+                    static_cast<std::uint32_t> (aged >> 32));
+        }
+        while (! m_state.compare_exchange_weak (expected, desired,
+            std::memory_order_relaxed));
+        return units (desired) / Window;
+    }
+
+    /** Retrieve the current value in normalized units.
+        The samples are aged according to the specified time.
+    */
+    value_type value (time_point now) const
+    {
+        return units (decay (m_state.load (
+            std::memory_order_relaxed), seconds (now))) / Window;
+    }
+
+private:
+    static std::uint32_t seconds (time_point now)
+    {
+        return static_cast<std::uint32_t> (
+            std::chrono::duration_cast<std::chrono::seconds> (
+                now.time_since_epoch()).count());
+    }
+
+    static std::uint64_t pack (std::uint32_t value, std::uint32_t when)
+    {
+        return (static_cast<std::uint64_t> (when) << 32) | value;
+    }
+
+    static value_type units (std::uint64_t state)
+    {
+        return static_cast<std::uint32_t> (state);
+    }
+
+    static std::uint32_t saturate (value_type value)
+    {
+        return static_cast<std::uint32_t> (std::min<value_type> (
+            std::max<value_type> (value, 0), 0xffffffff));
+    }
+
+    // Apply exponential decay up to the specified second. A thread which
+    // read the clock before another thread stored a later time does not
+    // move the time backwards.
+    static std::uint64_t decay (std::uint64_t state, std::uint32_t when)
+    {
+        auto value = static_cast<std::uint32_t> (state);
+        auto const elapsed = static_cast<std::int32_t> (
+            when - static_cast<std::uint32_t> (state >> 32));
+
+        if (elapsed <= 0)
+            return state;
+
+        // A span larger than four times the window decays the
+        // value to an insignificant amount so just reset it.
+        //
+        if (elapsed > 4 * Window)
+            value = 0;
+        else
+            for (auto n = elapsed; n-- && value != 0;)
+                value -= static_cast<std::uint32_t> (
+                    (std::uint64_t (value) + Window - 1) / Window);
+
+        return pack (value, when);
+    }
+
+    // Value in exponential units in the low half,
+    // second of the last aging in the high half
+    std::atomic <std::uint64_t> m_state;
+};
+
+//------------------------------------------------------------------------------
+
 /** Sampling function using exponential decay to provide a continuous value.
     @tparam HalfLife The half life of a sample, in seconds.
 */
@@ -24,7 +24,10 @@
 #include <ripple/basics/UnorderedContainers.h>
 #include <ripple/beast/clock/abstract_clock.h>
 #include <ripple/beast/insight/Insight.h>
+#include <algorithm>
+#include <chrono>
 #include <mutex>
+#include <vector>
 
 namespace ripple {
 
@@ -87,6 +90,18 @@ public:
     using size_type = typename map_type::size_type;
 
 private:
+    // Buckets examined each time the sweep takes the lock
+    static size_type constexpr sweepBatchBuckets = 1024;
+
+    // The position and expiration of the sweep in progress
+    struct SweepState
+    {
+        size_type bucket = 0;
+        clock_type::time_point now;
+        clock_type::time_point when_expire;
+        std::vector <key_type> keys;
+    };
+
     Mutex mutable m_mutex;
     map_type m_map;
     Stats mutable m_stats;
@@ -94,6 +109,7 @@ private:
     std::string const m_name;
     size_type m_target_size;
     clock_type::duration m_target_age;
+    SweepState m_sweep;
 
 public:
     /** Construct with the specified name.
@@ -148,6 +164,14 @@ public:
         return m_map.size ();
     }
 
+    /** Returns an estimate of the bytes held by the container. */
+    std::size_t getMemoryUsage () const
+    {
+        lock_guard lock (m_mutex);
+        return m_map.size () * (sizeof (typename map_type::value_type) +
+            2 * sizeof (void*)) + m_map.bucket_count () * sizeof (void*);
+    }
+
     /** Empty the cache */
     void clear ()
     {
@@ -240,48 +264,99 @@ public:
     /** Remove stale entries from the cache. */
     void sweep ()
     {
-        clock_type::time_point const now (m_clock.now ());
-        clock_type::time_point when_expire;
+        {
+            lock_guard lock (m_mutex);
+            m_sweep.bucket = 0;
+        }
 
-        lock_guard lock (m_mutex);
+        while (! sweep (std::chrono::microseconds::zero ()))
+            ;
+    }
+
+    /** Remove some stale entries, resuming where the last call stopped.
+
+        Buckets are examined in batches, each under the lock, until the
+        pass reaches the end of the table or the time budget is spent.
+
+        @param budget The time to spend before returning. At least one
+                      batch is examined.
+        @return `true` if the pass completed.
+    */
+    bool sweep (std::chrono::microseconds budget)
+    {
+        auto const deadline = std::chrono::steady_clock::now () + budget;
+
+        for (;;)
+        {
+            {
+                lock_guard lock (m_mutex);
+
+                if (m_sweep.bucket == 0)
+                    startSweep ();
+
+                auto const buckets = m_map.bucket_count ();
+                auto const last = std::min (buckets,
+                    m_sweep.bucket + sweepBatchBuckets);
+
+                for (; m_sweep.bucket < last; ++m_sweep.bucket)
+                    sweepBucket (m_sweep.bucket);
+
+                if (m_sweep.bucket >= buckets)
+                {
+                    m_sweep.bucket = 0;
+                    return true;
+                }
+            }
+
+            if (std::chrono::steady_clock::now () >= deadline)
+                return false;
+        }
+    }
+
+private:
+    // Called with the lock held when a sweep pass begins
+    void startSweep ()
+    {
+        clock_type::time_point const now (m_clock.now ());
 
         if (m_target_size == 0 ||
             (m_map.size () <= m_target_size))
         {
-            when_expire = now - m_target_age;
+            m_sweep.when_expire = now - m_target_age;
         }
         else
         {
-            when_expire = now - clock_type::duration (
+            m_sweep.when_expire = now - clock_type::duration (
                 m_target_age.count() * m_target_size / m_map.size ());
 
             clock_type::duration const minimumAge (
                 std::chrono::seconds (1));
-            if (when_expire > (now - minimumAge))
-                when_expire = now - minimumAge;
+            if (m_sweep.when_expire > (now - minimumAge))
+                m_sweep.when_expire = now - minimumAge;
         }
 
-        iterator it = m_map.begin ();
+        m_sweep.now = now;
+    }
+
+    // Called with the lock held
+    void sweepBucket (size_type bucket)
+    {
+        // Erasing invalidates the bucket's iterators,
+        // so the keys are collected and erased afterwards.
+        m_sweep.keys.clear ();
 
-        while (it != m_map.end ())
+        for (auto it = m_map.begin (bucket); it != m_map.end (bucket); ++it)
         {
-            if (it->second.last_access > now)
-            {
-                it->second.last_access = now;
-                ++it;
-            }
-            else if (it->second.last_access <= when_expire)
-            {
-                it = m_map.erase (it);
-            }
-            else
-            {
-                ++it;
-            }
+            if (it->second.last_access > m_sweep.now)
+                it->second.last_access = m_sweep.now;
+            else if (it->second.last_access <= m_sweep.when_expire)
+                m_sweep.keys.push_back (it->first);
         }
+
+        for (auto const& key : m_sweep.keys)
+            m_map.erase (key);
     }
 
-private:
     void collect_metrics ()
     {
         m_stats.size.set (size ());
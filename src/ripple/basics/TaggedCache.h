@@ -20,13 +20,17 @@
 #ifndef RIPPLE_BASICS_TAGGEDCACHE_H_INCLUDED
 #define RIPPLE_BASICS_TAGGEDCACHE_H_INCLUDED
 
+#include <ripple/basics/Blob.h>
 #include <ripple/basics/hardened_hash.h>
 #include <ripple/basics/Log.h>
 #include <ripple/basics/UnorderedContainers.h>
 #include <ripple/beast/clock/abstract_clock.h>
 #include <ripple/beast/insight/Insight.h>
+#include <algorithm>
+#include <chrono>
 #include <functional>
 #include <mutex>
+#include <string>
 #include <vector>
 
 namespace ripple {
@@ -34,6 +38,32 @@ namespace ripple {
 // VFALCO NOTE Deprecated
 struct TaggedCacheLog;
 
+/** Returns an estimate of the bytes used by a cached object.
+
+    Types which own memory beyond their own footprint should provide
+    an overload in their own namespace, found by argument dependent lookup.
+*/
+template <class T>
+std::size_t
+memoryUsed (T const&)
+{
+    return sizeof (T);
+}
+
+inline
+std::size_t
+memoryUsed (Blob const& blob)
+{
+    return sizeof (blob) + blob.capacity ();
+}
+
+inline
+std::size_t
+memoryUsed (std::string const& s)
+{
+    return sizeof (s) + s.capacity ();
+}
+
 /** Map/cache combination.
     This class implements a cache and a map. The cache keeps objects alive
     in the map. The map allows multiple code paths that reference objects
@@ -83,6 +113,7 @@ public:
         , m_target_size (size)
         , m_target_age (std::chrono::seconds (expiration_seconds))
         , m_cache_count (0)
+        , m_cache_bytes (0)
         , m_hits (0)
         , m_misses (0)
     {
@@ -139,6 +170,19 @@ public:
         return m_cache.size ();
     }
 
+    /** Returns an estimate of the bytes held by the cache.
+
+        This counts the strongly cached objects and the bookkeeping for
+        every tracked key. Weakly tracked objects are owned elsewhere.
+    */
+    std::size_t getMemoryUsage () const
+    {
+        lock_guard lock (m_mutex);
+        return m_cache_bytes +
+            m_cache.size () * entryOverhead +
+            m_cache.bucket_count () * sizeof (void*);
+    }
+
     float getHitRate ()
     {
         lock_guard lock (m_mutex);
@@ -158,100 +202,89 @@ public:
         lock_guard lock (m_mutex);
         m_cache.clear ();
         m_cache_count = 0;
+        m_cache_bytes = 0;
     }
 
     void sweep ()
     {
-        int cacheRemovals = 0;
-        int mapRemovals = 0;
-        int cc = 0;
-
         // Keep references to all the stuff we sweep
         // so that we can destroy them outside the lock.
         //
-        std::vector <mapped_ptr> stuffToSweep;
+        std::vector <std::shared_ptr <void const>> stuffToSweep;
 
-        {
-            clock_type::time_point const now (m_clock.now());
-            clock_type::time_point when_expire;
+        sweep (stuffToSweep);
 
-            lock_guard lock (m_mutex);
+        // At this point stuffToSweep will go out of scope outside the lock
+        // and decrement the reference count on each strong pointer.
+    }
 
-            if (m_target_size == 0 ||
-                (static_cast<int> (m_cache.size ()) <= m_target_size))
-            {
-                when_expire = now - m_target_age;
-            }
-            else
-            {
-                when_expire = now - clock_type::duration (
-                    m_target_age.count() * m_target_size / m_cache.size ());
+    /** Sweep the whole cache, abandoning any pass in progress.
 
-                clock_type::duration const minimumAge (
-                    std::chrono::seconds (1));
-                if (when_expire > (now - minimumAge))
-                    when_expire = now - minimumAge;
+        @param trash Receives the objects which only the cache referenced,
+                     so the caller decides where they are destroyed.
+    */
+    void sweep (std::vector <std::shared_ptr <void const>>& trash)
+    {
+        {
+            lock_guard lock (m_mutex);
+            m_sweep.bucket = 0;
+        }
 
-                JLOG(m_journal.trace()) <<
-                    m_name << " is growing fast " << m_cache.size () << " of " << m_target_size <<
-                        " aging at " << (now - when_expire).count() << " of " << m_target_age.count();
-            }
+        while (! sweep (std::chrono::microseconds::zero (), trash))
+            ;
+    }
+
+    /** Sweep part of the cache, resuming where the last call stopped.
 
-            stuffToSweep.reserve (m_cache.size ());
+        Buckets are examined in batches, each under the lock, until the
+        pass reaches the end of the table or the time budget is spent.
+        Entries moved by a rehash during the pass may be skipped until
+        the next one.
 
-            cache_iterator cit = m_cache.begin ();
+        @param budget The time to spend before returning. At least one
+                      batch is examined.
+        @param trash Receives the objects which only the cache referenced,
+                     so the caller decides where they are destroyed.
+        @return `true` if the pass completed.
+    */
+    bool sweep (std::chrono::microseconds budget,
+        std::vector <std::shared_ptr <void const>>& trash)
+    {
+        auto const deadline = std::chrono::steady_clock::now () + budget;
 
-            while (cit != m_cache.end ())
+        for (;;)
+        {
             {
-                if (cit->second.isWeak ())
-                {
-                    // weak
-                    if (cit->second.isExpired ())
-                    {
-                        ++mapRemovals;
-                        cit = m_cache.erase (cit);
-                    }
-                    else
-                    {
-                        ++cit;
-                    }
-                }
-                else if (cit->second.last_access <= when_expire)
+                lock_guard lock (m_mutex);
+
+                if (m_sweep.bucket == 0)
+                    startSweep ();
+
+                auto const buckets = m_cache.bucket_count ();
+                auto const last = std::min (buckets,
+                    m_sweep.bucket + sweepBatchBuckets);
+
+                for (; m_sweep.bucket < last; ++m_sweep.bucket)
+                    sweepBucket (m_sweep.bucket, trash);
+
+                if (m_sweep.bucket >= buckets)
                 {
-                    // strong, expired
-                    --m_cache_count;
-                    ++cacheRemovals;
-                    if (cit->second.ptr.unique ())
-                    {
-                        stuffToSweep.push_back (cit->second.ptr);
-                        ++mapRemovals;
-                        cit = m_cache.erase (cit);
-                    }
-                    else
+                    if (m_sweep.mapRemovals || m_sweep.cacheRemovals)
                     {
-                        // remains weakly cached
-                        cit->second.ptr.reset ();
-                        ++cit;
+                        JLOG(m_journal.trace()) <<
+                            m_name << ": cache = " << m_cache.size () <<
+                            "-" << m_sweep.cacheRemovals <<
+                            ", map-=" << m_sweep.mapRemovals;
                     }
-                }
-                else
-                {
-                    // strong, not expired
-                    ++cc;
-                    ++cit;
+
+                    m_sweep.bucket = 0;
+                    return true;
                 }
             }
-        }
 
-        if (mapRemovals || cacheRemovals)
-        {
-            JLOG(m_journal.trace()) <<
-                m_name << ": cache = " << m_cache.size () <<
-                "-" << cacheRemovals << ", map-=" << mapRemovals;
+            if (std::chrono::steady_clock::now () >= deadline)
+                return false;
         }
-
-        // At this point stuffToSweep will go out of scope outside the lock
-        // and decrement the reference count on each strong pointer.
     }
 
     bool del (const key_type& key, bool valid)
@@ -271,6 +304,7 @@ public:
         if (entry.isCached ())
         {
             --m_cache_count;
+            m_cache_bytes -= bytesOf (entry.ptr);
             entry.ptr.reset ();
             ret = true;
         }
@@ -308,6 +342,7 @@ public:
                 std::forward_as_tuple(key),
                 std::forward_as_tuple(m_clock.now(), data));
             ++m_cache_count;
+            m_cache_bytes += bytesOf (data);
             return false;
         }
 
@@ -318,6 +353,8 @@ public:
         {
             if (replace)
             {
+                m_cache_bytes -= bytesOf (entry.ptr);
+                m_cache_bytes += bytesOf (data);
                 entry.ptr = data;
                 entry.weak_ptr = data;
             }
@@ -345,12 +382,14 @@ public:
             }
 
             ++m_cache_count;
+            m_cache_bytes += bytesOf (entry.ptr);
             return true;
         }
 
         entry.ptr = data;
         entry.weak_ptr = data;
         ++m_cache_count;
+        m_cache_bytes += bytesOf (data);
 
         return false;
     }
@@ -383,6 +422,7 @@ public:
         {
             // independent of cache size, so not counted as a hit
             ++m_cache_count;
+            m_cache_bytes += bytesOf (entry.ptr);
             return entry.ptr;
         }
 
@@ -446,6 +486,7 @@ public:
                 {
                     // We just put the object back in cache
                     ++m_cache_count;
+                    m_cache_bytes += bytesOf (entry.ptr);
                     entry.touch (m_clock.now());
                     found = true;
                 }
@@ -491,9 +532,84 @@ public:
     }
 
 private:
+    // Called with the lock held when a sweep pass begins
+    void startSweep ()
+    {
+        clock_type::time_point const now (m_clock.now());
+
+        if (m_target_size == 0 ||
+            (static_cast<int> (m_cache.size ()) <= m_target_size))
+        {
+            m_sweep.when_expire = now - m_target_age;
+        }
+        else
+        {
+            m_sweep.when_expire = now - clock_type::duration (
+                m_target_age.count() * m_target_size / m_cache.size ());
+
+            clock_type::duration const minimumAge (
+                std::chrono::seconds (1));
+            if (m_sweep.when_expire > (now - minimumAge))
+                m_sweep.when_expire = now - minimumAge;
+
+            JLOG(m_journal.trace()) <<
+                m_name << " is growing fast " << m_cache.size () << " of " << m_target_size <<
+                    " aging at " << (now - m_sweep.when_expire).count() << " of " << m_target_age.count();
+        }
+
+        m_sweep.cacheRemovals = 0;
+        m_sweep.mapRemovals = 0;
+    }
+
+    // Called with the lock held
+    void sweepBucket (std::size_t bucket,
+        std::vector <std::shared_ptr <void const>>& trash)
+    {
+        // Erasing invalidates the bucket's iterators,
+        // so the keys are collected and erased afterwards.
+        m_sweep.keys.clear ();
+
+        for (auto it = m_cache.begin (bucket); it != m_cache.end (bucket); ++it)
+        {
+            Entry& entry = it->second;
+
+            if (entry.isWeak ())
+            {
+                // weak
+                if (entry.isExpired ())
+                {
+                    ++m_sweep.mapRemovals;
+                    m_sweep.keys.push_back (it->first);
+                }
+            }
+            else if (entry.last_access <= m_sweep.when_expire)
+            {
+                // strong, expired
+                --m_cache_count;
+                m_cache_bytes -= bytesOf (entry.ptr);
+                ++m_sweep.cacheRemovals;
+                if (entry.ptr.unique ())
+                {
+                    trash.push_back (std::move (entry.ptr));
+                    ++m_sweep.mapRemovals;
+                    m_sweep.keys.push_back (it->first);
+                }
+                else
+                {
+                    // remains weakly cached
+                    entry.ptr.reset ();
+                }
+            }
+        }
+
+        for (auto const& key : m_sweep.keys)
+            m_cache.erase (key);
+    }
+
     void collect_metrics ()
     {
         m_stats.size.set (getCacheSize ());
+        m_stats.bytes.set (getMemoryUsage ());
 
         {
             beast::insight::Gauge::value_type hit_rate (0);
@@ -516,11 +632,13 @@ private:
             : hook (collector->make_hook (handler))
             , size (collector->make_gauge (prefix, "size"))
             , hit_rate (collector->make_gauge (prefix, "hit_rate"))
+            , bytes (collector->make_gauge (prefix, "bytes"))
             { }
 
         beast::insight::Hook hook;
         beast::insight::Gauge size;
         beast::insight::Gauge hit_rate;
+        beast::insight::Gauge bytes;
     };
 
     class Entry
@@ -548,6 +666,28 @@ private:
     using cache_type = hardened_hash_map <key_type, Entry, Hash, KeyEqual>;
     using cache_iterator = typename cache_type::iterator;
 
+    // Approximate bytes for a map node and a shared_ptr control block
+    static std::size_t constexpr entryOverhead =
+        sizeof (typename cache_type::value_type) + 4 * sizeof (void*);
+
+    // Buckets examined each time the sweep takes the lock
+    static std::size_t constexpr sweepBatchBuckets = 1024;
+
+    // The position and expiration of the sweep in progress
+    struct SweepState
+    {
+        std::size_t bucket = 0;
+        clock_type::time_point when_expire;
+        int cacheRemovals = 0;
+        int mapRemovals = 0;
+        std::vector <key_type> keys;
+    };
+
+    static std::size_t bytesOf (mapped_ptr const& p)
+    {
+        return p ? memoryUsed (*p) : 0;
+    }
+
     beast::Journal m_journal;
     clock_type& m_clock;
     Stats m_stats;
@@ -565,7 +705,11 @@ private:
 
     // Number of items cached
     int m_cache_count;
+
+    // Estimated bytes used by the cached items
+    std::size_t m_cache_bytes;
     cache_type m_cache;  // Hold strong reference to recent objects
+    SweepState m_sweep;
     std::uint64_t m_hits;
     std::uint64_t m_misses;
 };
@@ -20,8 +20,8 @@
 #include <BeastConfig.h>
 #include <ripple/basics/mulDiv.h>
 #include <ripple/basics/contract.h>
-#include <boost/multiprecision/cpp_int.hpp>
 #include <limits>
+#include <stdexcept>
 #include <utility>
 
 namespace ripple
@@ -30,19 +30,15 @@ namespace ripple
 std::pair<bool, std::uint64_t>
 mulDiv(std::uint64_t value, std::uint64_t mul, std::uint64_t div)
 {
-    using namespace boost::multiprecision;
+    if (div == 0)
+        Throw<std::overflow_error> ("division by zero");
 
-    uint128_t result;
-    result = multiply(result, value, mul);
+    std::uint64_t result;
 
-    result /= div;
+    if (! mulDivAdd (value, mul, 0, div, result))
+        return { false, std::numeric_limits<std::uint64_t>::max() };
 
-    auto const limit = std::numeric_limits<std::uint64_t>::max();
-
-    if (result > limit)
-        return { false, limit };
-
-    return { true, static_cast<std::uint64_t>(result) };
+    return { true, result };
 }
 
 } // ripple
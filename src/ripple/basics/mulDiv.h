@@ -23,9 +23,165 @@
 #include <cstdint>
 #include <utility>
 
+#if defined(__SIZEOF_INT128__) && !defined(RIPPLE_NO_INT128)
+#define RIPPLE_HAS_INT128 1
+#else
+#define RIPPLE_HAS_INT128 0
+#endif
+
 namespace ripple
 {
 
+namespace detail {
+
+/** Portable 64x64 to 128 bit multiply: returns the high word.
+    The low word is stored in `lo`.
+*/
+inline
+std::uint64_t
+mul64x64 (std::uint64_t a, std::uint64_t b, std::uint64_t& lo)
+{
+    std::uint64_t const mask = 0xffffffffull;
+
+    std::uint64_t const a0 = a & mask;
+    std::uint64_t const a1 = a >> 32;
+    std::uint64_t const b0 = b & mask;
+    std::uint64_t const b1 = b >> 32;
+
+    std::uint64_t const p00 = a0 * b0;
+    std::uint64_t const p01 = a0 * b1;
+    std::uint64_t const p10 = a1 * b0;
+    std::uint64_t const p11 = a1 * b1;
+
+    // Cannot overflow: each term is at most 2^32 - 1
+    std::uint64_t const mid = (p00 >> 32) + (p01 & mask) + (p10 & mask);
+
+    lo = (mid << 32) | (p00 & mask);
+    return p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+}
+
+/** Portable 128 by 64 bit divide.
+    Divides the 128 bit number hi:lo by `d`. Returns `false` if the
+    quotient does not fit in 64 bits (which includes `d == 0`).
+*/
+inline
+bool
+div128by64 (std::uint64_t hi, std::uint64_t lo,
+    std::uint64_t d, std::uint64_t& quotient)
+{
+    // The quotient fits in 64 bits if and only if hi < d
+    if (hi >= d)
+        return false;
+
+    if (hi == 0)
+    {
+        quotient = lo / d;
+        return true;
+    }
+
+    // Knuth's Algorithm D specialized for a two-digit divisor in
+    // base 2^32 (see Hacker's Delight, "divlu").
+    std::uint64_t const b = 1ull << 32;
+
+    // Normalize so that the high bit of the divisor is set
+    int s = 0;
+    if ((d >> 32) == 0) { s += 32; d <<= 32; }
+    if ((d >> 48) == 0) { s += 16; d <<= 16; }
+    if ((d >> 56) == 0) { s += 8; d <<= 8; }
+    if ((d >> 60) == 0) { s += 4; d <<= 4; }
+    if ((d >> 62) == 0) { s += 2; d <<= 2; }
+    if ((d >> 63) == 0) { s += 1; d <<= 1; }
+
+    std::uint64_t const vn1 = d >> 32;
+    std::uint64_t const vn0 = d & 0xffffffffull;
+
+    std::uint64_t const un32 = (s == 0) ? hi : ((hi << s) | (lo >> (64 - s)));
+    std::uint64_t const un10 = lo << s;
+
+    std::uint64_t const un1 = un10 >> 32;
+    std::uint64_t const un0 = un10 & 0xffffffffull;
+
+    std::uint64_t q1 = un32 / vn1;
+    std::uint64_t rhat = un32 - q1 * vn1;
+
+    while (q1 >= b || q1 * vn0 > ((rhat << 32) | un1))
+    {
+        --q1;
+        rhat += vn1;
+        if (rhat >= b)
+            break;
+    }
+
+    std::uint64_t const un21 = (un32 << 32) + un1 - q1 * d;
+
+    std::uint64_t q0 = un21 / vn1;
+    rhat = un21 - q0 * vn1;
+
+    while (q0 >= b || q0 * vn0 > ((rhat << 32) | un0))
+    {
+        --q0;
+        rhat += vn1;
+        if (rhat >= b)
+            break;
+    }
+
+    quotient = (q1 << 32) | q0;
+    return true;
+}
+
+/** Computes (value * mul + add) / div using the portable kernels. */
+inline
+bool
+mulDivAddPortable (std::uint64_t value, std::uint64_t mul,
+    std::uint64_t add, std::uint64_t div, std::uint64_t& result)
+{
+    std::uint64_t lo;
+    std::uint64_t hi = mul64x64 (value, mul, lo);
+
+    lo += add;
+    if (lo < add)
+        ++hi;
+
+    return div128by64 (hi, lo, div, result);
+}
+
+#if RIPPLE_HAS_INT128
+/** Computes (value * mul + add) / div using the compiler's 128 bit type. */
+inline
+bool
+mulDivAddNative (std::uint64_t value, std::uint64_t mul,
+    std::uint64_t add, std::uint64_t div, std::uint64_t& result)
+{
+    using u128 = unsigned __int128;
+
+    u128 const n = static_cast<u128>(value) * mul + add;
+
+    if ((n >> 64) >= div)
+        return false;
+
+    result = static_cast<std::uint64_t>(n / div);
+    return true;
+}
+#endif
+
+} // detail
+
+/** Computes (value * mul + add) / div without intermediate overflow.
+    Returns `false` if the result does not fit in 64 bits or if
+    `div` is zero; `result` is only written on success.
+*/
+inline
+bool
+mulDivAdd (std::uint64_t value, std::uint64_t mul,
+    std::uint64_t add, std::uint64_t div, std::uint64_t& result)
+{
+#if RIPPLE_HAS_INT128
+    return detail::mulDivAddNative (value, mul, add, div, result);
+#else
+    return detail::mulDivAddPortable (value, mul, add, div, result);
+#endif
+}
+
 /** Return value*mul/div accurately.
     Computes the result of the multiplication and division in
     a single step, avoiding overflow and retaining precision.
@@ -23,6 +23,7 @@
 #include <ripple/beast/clock/chrono_util.h>
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <mutex>
@@ -179,11 +180,11 @@ public:
 
         struct worker : detail::seconds_clock_worker
         {
-            time_point m_now;
-            std::mutex mutex_;
+            // The sampled time, read without a lock by every caller
+            std::atomic<rep> m_now;
 
             worker()
-                : m_now(Clock::now())
+                : m_now(Clock::now().time_since_epoch().count())
             {
                 detail::seconds_clock_thread::instance().add(*this);
             }
@@ -195,14 +196,14 @@ public:
 
             time_point now()
             {
-                std::lock_guard<std::mutex> lock (mutex_);
-                return m_now;
+                return time_point(duration(
+                    m_now.load(std::memory_order_relaxed)));
             }
 
             void sample()
             {
-                std::lock_guard<std::mutex> lock (mutex_);
-                m_now = Clock::now();
+                m_now.store(Clock::now().time_since_epoch().count(),
+                    std::memory_order_relaxed);
             }
         };
 
@@ -0,0 +1,330 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of Beast: https://github.com/vinniefalco/Beast
+    Copyright 2013, Vinnie Falco <vinnie.falco@gmail.com>
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef BEAST_INSIGHT_HISTOGRAM_H_INCLUDED
+#define BEAST_INSIGHT_HISTOGRAM_H_INCLUDED
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace beast {
+namespace insight {
+
+/** A recent distribution of non-negative values in log-linear buckets.
+
+    Values below 16 are counted exactly. Above that, each power of two is
+    split into 16 buckets of equal width, so a bucket is never wider than
+    1/16 of the smallest value it holds. Values of 2^36 or more are counted
+    in the last bucket.
+
+    Values are kept in two windows, the current one and the previous one.
+    Once a window has lasted the configured interval the previous window is
+    cleared and becomes current, so a snapshot describes the last one to two
+    intervals rather than the whole life of the process. The total count and
+    sum of every value ever recorded are kept as well.
+
+    Unlike the other instruments this is not reported through a Collector.
+    Recording is lock free, and callers read the distribution by taking a
+    Snapshot, which can be merged with snapshots of other histograms.
+
+    Durations are recorded in microseconds.
+*/
+class Histogram
+{
+public:
+    using value_type = std::uint64_t;
+    using clock_type = std::chrono::steady_clock;
+
+    enum
+    {
+        subBucketBits = 4,
+        subBucketCount = 1 << subBucketBits,
+        valueBits = 36,
+        bucketCount = (valueBits - subBucketBits + 1) * subBucketCount
+    };
+
+    /** A copy of the bucket counts at some point in time. */
+    class Snapshot
+    {
+    public:
+        Snapshot ()
+            : m_counts (bucketCount, 0)
+            , m_sum (0)
+            , m_max (0)
+            , m_totalCount (0)
+            , m_totalSum (0)
+        {
+        }
+
+        /** The number of values recorded in the window. */
+        std::uint64_t count () const
+        {
+            std::uint64_t total (0);
+            for (auto const c : m_counts)
+                total += c;
+            return total;
+        }
+
+        /** The sum of the values recorded in the window. */
+        std::uint64_t sum () const
+        {
+            return m_sum;
+        }
+
+        /** The largest value recorded in the window. */
+        value_type max () const
+        {
+            return m_max;
+        }
+
+        /** The number of values ever recorded. */
+        std::uint64_t totalCount () const
+        {
+            return m_totalCount;
+        }
+
+        /** The sum of the values ever recorded. */
+        std::uint64_t totalSum () const
+        {
+            return m_totalSum;
+        }
+
+        /** Return an upper bound of the given fraction of the values.
+
+            At least `fraction` of the values recorded in the window are
+            less than or equal to the result, which is the highest value of
+            the bucket holding that rank. Returns zero if nothing was
+            recorded.
+
+            @param fraction A number between 0 and 1, e.g. 0.99 for p99.
+        */
+        value_type percentile (double fraction) const
+        {
+            auto const total = count ();
+            if (total == 0)
+                return 0;
+
+            auto rank = static_cast <std::uint64_t> (
+                fraction * total + 0.5);
+            rank = std::max <std::uint64_t> (1, std::min (rank, total));
+
+            std::uint64_t seen (0);
+            for (std::size_t i = 0; i < m_counts.size (); ++i)
+            {
+                seen += m_counts[i];
+                if (seen >= rank)
+                    return std::min (highestEquivalent (i), m_max);
+            }
+            return m_max;
+        }
+
+        /** Add the values recorded in another snapshot to this one. */
+        Snapshot& operator+= (Snapshot const& other)
+        {
+            for (std::size_t i = 0; i < m_counts.size (); ++i)
+                m_counts[i] += other.m_counts[i];
+            m_sum += other.m_sum;
+            m_max = std::max (m_max, other.m_max);
+            m_totalCount += other.m_totalCount;
+            m_totalSum += other.m_totalSum;
+            return *this;
+        }
+
+    private:
+        friend class Histogram;
+
+        std::vector <std::uint64_t> m_counts;
+        std::uint64_t m_sum;
+        value_type m_max;
+        std::uint64_t m_totalCount;
+        std::uint64_t m_totalSum;
+    };
+
+    /** Create a histogram.
+
+        @param interval How long each window lasts.
+    */
+    explicit
+    Histogram (clock_type::duration interval = std::chrono::minutes (5))
+        : m_interval (interval)
+        , m_current (0)
+        , m_rotateAt (
+            (clock_type::now () + interval).time_since_epoch ().count ())
+        , m_totalCount (0)
+        , m_totalSum (0)
+    {
+        for (auto& w : m_windows)
+            w.clear ();
+    }
+
+    Histogram (Histogram const&) = delete;
+    Histogram& operator= (Histogram const&) = delete;
+
+    /** Record a value. */
+    void record (value_type value)
+    {
+        maybeRotate ();
+        m_windows[m_current.load (std::memory_order_relaxed)].record (value);
+        m_totalCount.fetch_add (1, std::memory_order_relaxed);
+        m_totalSum.fetch_add (value, std::memory_order_relaxed);
+    }
+
+    /** Record a duration, in microseconds. */
+    template <class Rep, class Period>
+    void record (std::chrono::duration <Rep, Period> const& value)
+    {
+        using namespace std::chrono;
+        auto const us = duration_cast <microseconds> (value).count ();
+        record (us > 0 ? static_cast <value_type> (us) : 0);
+    }
+
+    /** Return a copy of the recent distribution. */
+    Snapshot snapshot () const
+    {
+        maybeRotate ();
+        Snapshot s;
+        for (auto const& w : m_windows)
+        {
+            for (std::size_t i = 0; i < w.counts.size (); ++i)
+                s.m_counts[i] +=
+                    w.counts[i].load (std::memory_order_relaxed);
+            s.m_sum += w.sum.load (std::memory_order_relaxed);
+            s.m_max = std::max (
+                s.m_max, w.max.load (std::memory_order_relaxed));
+        }
+        s.m_totalCount = m_totalCount.load (std::memory_order_relaxed);
+        s.m_totalSum = m_totalSum.load (std::memory_order_relaxed);
+        return s;
+    }
+
+    /** Start a new window now, dropping the previous one. */
+    void rotate () const
+    {
+        auto const current = m_current.load (std::memory_order_relaxed);
+        m_windows[1 - current].clear ();
+        m_current.store (1 - current, std::memory_order_relaxed);
+    }
+
+    /** Return the bucket which counts a value. */
+    static std::size_t bucketIndex (value_type value)
+    {
+        if (value < subBucketCount)
+            return static_cast <std::size_t> (value);
+
+        value = std::min (value, (value_type (1) << valueBits) - 1);
+
+        int const exponent = highestBit (value);
+        int const shift = exponent - subBucketBits;
+        return static_cast <std::size_t> (
+            (shift + 1) * subBucketCount +
+                ((value >> shift) - subBucketCount));
+    }
+
+    /** Return the largest value counted by a bucket. */
+    static value_type highestEquivalent (std::size_t index)
+    {
+        if (index < subBucketCount)
+            return index;
+
+        int const shift = static_cast <int> (index / subBucketCount) - 1;
+        value_type const lowest =
+            (subBucketCount + index % subBucketCount) << shift;
+        return lowest + (value_type (1) << shift) - 1;
+    }
+
+private:
+    struct Window
+    {
+        // A window never holds more than 2^32 values in one bucket
+        std::array <std::atomic <std::uint32_t>, bucketCount> counts;
+        std::atomic <std::uint64_t> sum;
+        std::atomic <value_type> max;
+
+        void clear ()
+        {
+            for (auto& c : counts)
+                c.store (0, std::memory_order_relaxed);
+            sum.store (0, std::memory_order_relaxed);
+            max.store (0, std::memory_order_relaxed);
+        }
+
+        void record (value_type value)
+        {
+            counts[bucketIndex (value)].fetch_add (
+                1, std::memory_order_relaxed);
+            sum.fetch_add (value, std::memory_order_relaxed);
+
+            auto prev = max.load (std::memory_order_relaxed);
+            while (prev < value && ! max.compare_exchange_weak (
+                prev, value, std::memory_order_relaxed))
+                ;
+        }
+    };
+
+    // Rotate if the current window has run its interval. Only the thread
+    // which advances the deadline rotates; if a whole interval passed with
+    // nothing recorded, both windows are stale and both are cleared.
+    void maybeRotate () const
+    {
+        auto const now = clock_type::now ().time_since_epoch ().count ();
+        auto due = m_rotateAt.load (std::memory_order_relaxed);
+        if (now < due)
+            return;
+
+        auto const interval = m_interval.count ();
+        if (! m_rotateAt.compare_exchange_strong (
+                due, now + interval, std::memory_order_relaxed))
+            return;
+
+        rotate ();
+        if (now - due >= interval)
+            rotate ();
+    }
+
+    static int highestBit (value_type value)
+    {
+        int bit (0);
+        for (int step = 32; step != 0; step /= 2)
+        {
+            if (value >> step)
+            {
+                value >>= step;
+                bit += step;
+            }
+        }
+        return bit;
+    }
+
+    clock_type::duration const m_interval;
+    mutable std::array <Window, 2> m_windows;
+    mutable std::atomic <int> m_current;
+    mutable std::atomic <clock_type::rep> m_rotateAt;
+    std::atomic <std::uint64_t> m_totalCount;
+    std::atomic <std::uint64_t> m_totalSum;
+};
+
+}
+}
+
+#endif
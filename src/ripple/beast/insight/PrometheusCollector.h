@@ -0,0 +1,71 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of Beast: https://github.com/vinniefalco/Beast
+    Copyright 2013, Vinnie Falco <vinnie.falco@gmail.com>
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef BEAST_INSIGHT_PROMETHEUSCOLLECTOR_H_INCLUDED
+#define BEAST_INSIGHT_PROMETHEUSCOLLECTOR_H_INCLUDED
+
+#include <ripple/beast/insight/Collector.h>
+
+#include <ripple/beast/utility/Journal.h>
+#include <string>
+
+namespace beast {
+namespace insight {
+
+/** A Collector that keeps the current value of each metric to be pulled.
+
+    Nothing is sent anywhere. Instead a caller, such as an HTTP handler
+    answering a Prometheus scrape, asks for the text exposition of every
+    metric. Updating a metric only touches atomics. Once a second, on the
+    collector's own thread, hooks run and the text is built. A scrape is
+    answered from the latest text, without running any hooks.
+
+    Counters are reported as untyped, meters as counters, gauges as gauges
+    and events as summaries with the 0.5, 0.99 and 0.999 quantiles in
+    seconds. Metrics sharing a name are combined.
+
+    Reference:
+        https://prometheus.io/docs/instrumenting/exposition_formats/
+*/
+class PrometheusCollector : public Collector
+{
+public:
+    /** Create a Prometheus collector.
+        @param prefix A string pre-pended before each metric name.
+        @param journal Destination for logging output.
+    */
+    static
+    std::shared_ptr <PrometheusCollector>
+    New (std::string const& prefix, Journal journal);
+
+    /** Run the hooks and build the text now, on the calling thread. */
+    virtual void collect () = 0;
+
+    /** Append the text exposition of every metric, version 0.0.4.
+
+        The text is from the most recent collection, and is empty
+        before the first.
+    */
+    virtual void write (std::string& out) = 0;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,586 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of Beast: https://github.com/vinniefalco/Beast
+    Copyright 2013, Vinnie Falco <vinnie.falco@gmail.com>
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/insight/HookImpl.h>
+#include <ripple/beast/insight/CounterImpl.h>
+#include <ripple/beast/insight/EventImpl.h>
+#include <ripple/beast/insight/GaugeImpl.h>
+#include <ripple/beast/insight/Histogram.h>
+#include <ripple/beast/insight/MeterImpl.h>
+#include <ripple/beast/insight/PrometheusCollector.h>
+#include <ripple/beast/core/List.h>
+#include <boost/asio/basic_waitable_timer.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/optional.hpp>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+namespace beast {
+namespace insight {
+
+namespace detail {
+
+class PrometheusCollectorImp;
+
+//------------------------------------------------------------------------------
+
+enum class PrometheusType
+{
+    untyped,
+    counter,
+    gauge,
+    summary
+};
+
+static
+char const*
+to_string (PrometheusType type)
+{
+    switch (type)
+    {
+    case PrometheusType::counter: return "counter";
+    case PrometheusType::gauge: return "gauge";
+    case PrometheusType::summary: return "summary";
+    default:
+        break;
+    }
+    return "untyped";
+}
+
+/*  The values of all the metrics with one name, gathered for a scrape. */
+struct PrometheusFamily
+{
+    PrometheusType type = PrometheusType::untyped;
+    double value = 0;
+    Histogram::Snapshot latency;
+};
+
+using PrometheusFamilies = std::map <std::string, PrometheusFamily>;
+
+class PrometheusMetricBase : public List <PrometheusMetricBase>::Node
+{
+public:
+    virtual void do_process ()
+    {
+    }
+
+    virtual void do_collect (PrometheusFamilies& families)
+    {
+    }
+};
+
+//------------------------------------------------------------------------------
+
+class PrometheusHookImpl
+    : public HookImpl
+    , public PrometheusMetricBase
+{
+public:
+    PrometheusHookImpl (HandlerType const& handler,
+        std::shared_ptr <PrometheusCollectorImp> const& impl);
+
+    ~PrometheusHookImpl ();
+
+    void do_process () override;
+
+private:
+    PrometheusHookImpl& operator= (PrometheusHookImpl const&);
+
+    std::shared_ptr <PrometheusCollectorImp> m_impl;
+    HandlerType m_handler;
+};
+
+//------------------------------------------------------------------------------
+
+class PrometheusCounterImpl
+    : public CounterImpl
+    , public PrometheusMetricBase
+{
+public:
+    PrometheusCounterImpl (std::string const& name,
+        std::shared_ptr <PrometheusCollectorImp> const& impl);
+
+    ~PrometheusCounterImpl ();
+
+    void increment (CounterImpl::value_type amount) override;
+
+    void do_collect (PrometheusFamilies& families) override;
+
+private:
+    PrometheusCounterImpl& operator= (PrometheusCounterImpl const&);
+
+    std::shared_ptr <PrometheusCollectorImp> m_impl;
+    std::string m_name;
+    std::atomic <CounterImpl::value_type> m_value;
+};
+
+//------------------------------------------------------------------------------
+
+class PrometheusEventImpl
+    : public EventImpl
+    , public PrometheusMetricBase
+{
+public:
+    PrometheusEventImpl (std::string const& name,
+        std::shared_ptr <PrometheusCollectorImp> const& impl);
+
+    ~PrometheusEventImpl ();
+
+    void notify (EventImpl::value_type const& value) override;
+
+    void do_collect (PrometheusFamilies& families) override;
+
+private:
+    PrometheusEventImpl& operator= (PrometheusEventImpl const&);
+
+    std::shared_ptr <PrometheusCollectorImp> m_impl;
+    std::string m_name;
+    Histogram m_latency;
+};
+
+//------------------------------------------------------------------------------
+
+class PrometheusGaugeImpl
+    : public GaugeImpl
+    , public PrometheusMetricBase
+{
+public:
+    PrometheusGaugeImpl (std::string const& name,
+        std::shared_ptr <PrometheusCollectorImp> const& impl);
+
+    ~PrometheusGaugeImpl ();
+
+    void set (GaugeImpl::value_type value) override;
+    void increment (GaugeImpl::difference_type amount) override;
+
+    void do_collect (PrometheusFamilies& families) override;
+
+private:
+    PrometheusGaugeImpl& operator= (PrometheusGaugeImpl const&);
+
+    std::shared_ptr <PrometheusCollectorImp> m_impl;
+    std::string m_name;
+    std::atomic <GaugeImpl::value_type> m_value;
+};
+
+//------------------------------------------------------------------------------
+
+class PrometheusMeterImpl
+    : public MeterImpl
+    , public PrometheusMetricBase
+{
+public:
+    PrometheusMeterImpl (std::string const& name,
+        std::shared_ptr <PrometheusCollectorImp> const& impl);
+
+    ~PrometheusMeterImpl ();
+
+    void increment (MeterImpl::value_type amount) override;
+
+    void do_collect (PrometheusFamilies& families) override;
+
+private:
+    PrometheusMeterImpl& operator= (PrometheusMeterImpl const&);
+
+    std::shared_ptr <PrometheusCollectorImp> m_impl;
+    std::string m_name;
+    std::atomic <MeterImpl::value_type> m_value;
+};
+
+//------------------------------------------------------------------------------
+
+class PrometheusCollectorImp
+    : public PrometheusCollector
+    , public std::enable_shared_from_this <PrometheusCollectorImp>
+{
+private:
+    Journal m_journal;
+    std::string m_prefix;
+    boost::asio::io_service m_io_service;
+    boost::optional <boost::asio::io_service::work> m_work;
+    boost::asio::basic_waitable_timer<std::chrono::steady_clock> m_timer;
+    std::recursive_mutex metricsLock_;
+    List <PrometheusMetricBase> metrics_;
+    std::mutex snapshotLock_;
+    std::shared_ptr <std::string const> snapshot_;
+
+    // Must come last for order of init
+    std::thread m_thread;
+
+public:
+    PrometheusCollectorImp (std::string const& prefix, Journal journal)
+        : m_journal (journal)
+        , m_prefix (prefix)
+        , m_work (std::ref (m_io_service))
+        , m_timer (m_io_service)
+        , m_thread (&PrometheusCollectorImp::run, this)
+    {
+    }
+
+    ~PrometheusCollectorImp ()
+    {
+        boost::system::error_code ec;
+        m_timer.cancel (ec);
+
+        m_work = boost::none;
+        m_thread.join ();
+    }
+
+    Hook make_hook (HookImpl::HandlerType const& handler) override
+    {
+        return Hook (std::make_shared <detail::PrometheusHookImpl> (
+            handler, shared_from_this ()));
+    }
+
+    Counter make_counter (std::string const& name) override
+    {
+        return Counter (std::make_shared <detail::PrometheusCounterImpl> (
+            name, shared_from_this ()));
+    }
+
+    Event make_event (std::string const& name) override
+    {
+        return Event (std::make_shared <detail::PrometheusEventImpl> (
+            name, shared_from_this ()));
+    }
+
+    Gauge make_gauge (std::string const& name) override
+    {
+        return Gauge (std::make_shared <detail::PrometheusGaugeImpl> (
+            name, shared_from_this ()));
+    }
+
+    Meter make_meter (std::string const& name) override
+    {
+        return Meter (std::make_shared <detail::PrometheusMeterImpl> (
+            name, shared_from_this ()));
+    }
+
+    //--------------------------------------------------------------------------
+
+    void add (PrometheusMetricBase& metric)
+    {
+        std::lock_guard<std::recursive_mutex> _(metricsLock_);
+        metrics_.push_back (metric);
+    }
+
+    void remove (PrometheusMetricBase& metric)
+    {
+        std::lock_guard<std::recursive_mutex> _(metricsLock_);
+        metrics_.erase (metrics_.iterator_to (metric));
+    }
+
+    // Turns an insight name into a valid Prometheus metric name
+    std::string metric_name (std::string const& name) const
+    {
+        std::string result (m_prefix.empty () ? name : m_prefix + "_" + name);
+        for (auto& c : result)
+        {
+            if (! ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                    (c >= '0' && c <= '9') || c == '_' || c == ':'))
+                c = '_';
+        }
+        if (result.empty () || (result[0] >= '0' && result[0] <= '9'))
+            result.insert (0, 1, '_');
+        return result;
+    }
+
+    //--------------------------------------------------------------------------
+
+    void collect () override
+    {
+        PrometheusFamilies families;
+        {
+            std::lock_guard<std::recursive_mutex> _(metricsLock_);
+
+            for (auto& m : metrics_)
+                m.do_process ();
+
+            for (auto& m : metrics_)
+                m.do_collect (families);
+        }
+
+        auto snapshot = std::make_shared <std::string const> (
+            render (families));
+
+        std::lock_guard<std::mutex> _(snapshotLock_);
+        snapshot_ = std::move (snapshot);
+    }
+
+    void write (std::string& out) override
+    {
+        std::shared_ptr <std::string const> snapshot;
+        {
+            std::lock_guard<std::mutex> _(snapshotLock_);
+            snapshot = snapshot_;
+        }
+        if (snapshot)
+            out += *snapshot;
+    }
+
+private:
+    static std::string render (PrometheusFamilies const& families)
+    {
+        std::ostringstream ss;
+        ss << std::setprecision (std::numeric_limits <double>::digits10 + 2);
+        for (auto const& family : families)
+        {
+            auto const& name = family.first;
+            auto const& f = family.second;
+            ss << "# TYPE " << name << " " << to_string (f.type) << "\n";
+            if (f.type != PrometheusType::summary)
+            {
+                ss << name << " " << f.value << "\n";
+                continue;
+            }
+
+            // Durations are kept in microseconds, reported in seconds
+            auto const seconds = [](std::uint64_t us)
+            {
+                std::ostringstream s;
+                s << std::fixed << std::setprecision (6) << us / 1e6;
+                return s.str ();
+            };
+            for (auto const q : { 0.5, 0.99, 0.999 })
+                ss << name << "{quantile=\"" << q << "\"} " <<
+                    seconds (f.latency.percentile (q)) << "\n";
+            // Quantiles cover the recent window, but the sum and count
+            // are lifetime totals so they stay monotonic.
+            ss << name << "_sum " << seconds (f.latency.totalSum ()) << "\n";
+            ss << name << "_count " << f.latency.totalCount () << "\n";
+        }
+        return ss.str ();
+    }
+
+    void set_timer ()
+    {
+        using namespace std::chrono_literals;
+        m_timer.expires_from_now(1s);
+        m_timer.async_wait (std::bind (
+            &PrometheusCollectorImp::on_timer, this,
+                std::placeholders::_1));
+    }
+
+    void on_timer (boost::system::error_code ec)
+    {
+        if (ec == boost::asio::error::operation_aborted)
+            return;
+
+        if (ec)
+        {
+            if (auto stream = m_journal.error())
+                stream << "on_timer failed: " << ec.message();
+            return;
+        }
+
+        collect ();
+
+        set_timer ();
+    }
+
+    void run ()
+    {
+        set_timer ();
+
+        m_io_service.run ();
+    }
+};
+
+//------------------------------------------------------------------------------
+
+PrometheusHookImpl::PrometheusHookImpl (HandlerType const& handler,
+    std::shared_ptr <PrometheusCollectorImp> const& impl)
+    : m_impl (impl)
+    , m_handler (handler)
+{
+    m_impl->add (*this);
+}
+
+PrometheusHookImpl::~PrometheusHookImpl ()
+{
+    m_impl->remove (*this);
+}
+
+void PrometheusHookImpl::do_process ()
+{
+    m_handler ();
+}
+
+//------------------------------------------------------------------------------
+
+PrometheusCounterImpl::PrometheusCounterImpl (std::string const& name,
+    std::shared_ptr <PrometheusCollectorImp> const& impl)
+    : m_impl (impl)
+    , m_name (impl->metric_name (name))
+    , m_value (0)
+{
+    m_impl->add (*this);
+}
+
+PrometheusCounterImpl::~PrometheusCounterImpl ()
+{
+    m_impl->remove (*this);
+}
+
+void PrometheusCounterImpl::increment (CounterImpl::value_type amount)
+{
+    m_value.fetch_add (amount, std::memory_order_relaxed);
+}
+
+void PrometheusCounterImpl::do_collect (PrometheusFamilies& families)
+{
+    auto& f = families[m_name];
+    f.type = PrometheusType::untyped;
+    f.value += m_value.load (std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+
+PrometheusEventImpl::PrometheusEventImpl (std::string const& name,
+    std::shared_ptr <PrometheusCollectorImp> const& impl)
+    : m_impl (impl)
+    , m_name (impl->metric_name (name))
+{
+    m_impl->add (*this);
+}
+
+PrometheusEventImpl::~PrometheusEventImpl ()
+{
+    m_impl->remove (*this);
+}
+
+void PrometheusEventImpl::notify (EventImpl::value_type const& value)
+{
+    m_latency.record (value);
+}
+
+void PrometheusEventImpl::do_collect (PrometheusFamilies& families)
+{
+    auto& f = families[m_name];
+    f.type = PrometheusType::summary;
+    f.latency += m_latency.snapshot ();
+}
+
+//------------------------------------------------------------------------------
+
+PrometheusGaugeImpl::PrometheusGaugeImpl (std::string const& name,
+    std::shared_ptr <PrometheusCollectorImp> const& impl)
+    : m_impl (impl)
+    , m_name (impl->metric_name (name))
+    , m_value (0)
+{
+    m_impl->add (*this);
+}
+
+PrometheusGaugeImpl::~PrometheusGaugeImpl ()
+{
+    m_impl->remove (*this);
+}
+
+void PrometheusGaugeImpl::set (GaugeImpl::value_type value)
+{
+    m_value.store (value, std::memory_order_relaxed);
+}
+
+void PrometheusGaugeImpl::increment (GaugeImpl::difference_type amount)
+{
+    GaugeImpl::value_type current (
+        m_value.load (std::memory_order_relaxed));
+    GaugeImpl::value_type value;
+
+    do
+    {
+        value = current;
+
+        if (amount > 0)
+        {
+            GaugeImpl::value_type const d (
+                static_cast <GaugeImpl::value_type> (amount));
+            value +=
+                (d >= std::numeric_limits <GaugeImpl::value_type>::max() - current)
+                ? std::numeric_limits <GaugeImpl::value_type>::max() - current
+                : d;
+        }
+        else if (amount < 0)
+        {
+            GaugeImpl::value_type const d (
+                static_cast <GaugeImpl::value_type> (-amount));
+            value = (d >= value) ? 0 : value - d;
+        }
+    }
+    while (! m_value.compare_exchange_weak (current, value,
+        std::memory_order_relaxed));
+}
+
+void PrometheusGaugeImpl::do_collect (PrometheusFamilies& families)
+{
+    auto& f = families[m_name];
+    f.type = PrometheusType::gauge;
+    f.value += m_value.load (std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+
+PrometheusMeterImpl::PrometheusMeterImpl (std::string const& name,
+    std::shared_ptr <PrometheusCollectorImp> const& impl)
+    : m_impl (impl)
+    , m_name (impl->metric_name (name))
+    , m_value (0)
+{
+    m_impl->add (*this);
+}
+
+PrometheusMeterImpl::~PrometheusMeterImpl ()
+{
+    m_impl->remove (*this);
+}
+
+void PrometheusMeterImpl::increment (MeterImpl::value_type amount)
+{
+    m_value.fetch_add (amount, std::memory_order_relaxed);
+}
+
+void PrometheusMeterImpl::do_collect (PrometheusFamilies& families)
+{
+    auto& f = families[m_name];
+    f.type = PrometheusType::counter;
+    f.value += m_value.load (std::memory_order_relaxed);
+}
+
+}
+
+//------------------------------------------------------------------------------
+
+std::shared_ptr <PrometheusCollector> PrometheusCollector::New (
+    std::string const& prefix, Journal journal)
+{
+    return std::make_shared <detail::PrometheusCollectorImp> (
+        prefix, journal);
+}
+
+}
+}
@@ -28,6 +28,8 @@
 #include <ripple/beast/core/List.h>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/optional.hpp>
+#include <array>
+#include <atomic>
 #include <cassert>
 #include <climits>
 #include <deque>
@@ -36,6 +38,7 @@
 #include <set>
 #include <sstream>
 #include <thread>
+#include <vector>
 
 #ifndef BEAST_STATSDCOLLECTOR_TRACING_ENABLED
 #define BEAST_STATSDCOLLECTOR_TRACING_ENABLED 0
@@ -50,6 +53,63 @@ class StatsDCollectorImp;
 
 //------------------------------------------------------------------------------
 
+/*  Updates to instruments are spread over a fixed number of slots, each on
+    its own cache line. A thread always uses the same slot, so threads only
+    contend when more of them are updating than there are slots. The slots
+    are folded together on the collector's thread when the timer fires.
+*/
+enum
+{
+    stripeCount = 16,
+    cacheLineSize = 64
+};
+
+inline
+std::size_t
+stripeIndex ()
+{
+    static std::atomic <std::size_t> next (0);
+    thread_local std::size_t const index (
+        next.fetch_add (1, std::memory_order_relaxed) % stripeCount);
+    return index;
+}
+
+template <class Int>
+class StatsDStripes
+{
+public:
+    StatsDStripes ()
+    {
+        for (auto& stripe : m_stripes)
+            stripe.value.store (0, std::memory_order_relaxed);
+    }
+
+    void add (Int amount)
+    {
+        m_stripes[stripeIndex ()].value.fetch_add (
+            amount, std::memory_order_relaxed);
+    }
+
+    // Returns the sum of all slots and resets them to zero
+    Int exchange ()
+    {
+        Int sum (0);
+        for (auto& stripe : m_stripes)
+            sum += stripe.value.exchange (0, std::memory_order_relaxed);
+        return sum;
+    }
+
+private:
+    struct alignas(cacheLineSize) Stripe
+    {
+        std::atomic <Int> value;
+    };
+
+    std::array <Stripe, stripeCount> m_stripes;
+};
+
+//------------------------------------------------------------------------------
+
 class StatsDMetricBase : public List <StatsDMetricBase>::Node
 {
 public:
@@ -93,7 +153,6 @@ public:
     void increment (CounterImpl::value_type amount);
 
     void flush ();
-    void do_increment (CounterImpl::value_type amount);
     void do_process ();
 
 private:
@@ -101,14 +160,14 @@ private:
 
     std::shared_ptr <StatsDCollectorImp> m_impl;
     std::string m_name;
-    CounterImpl::value_type m_value;
-    bool m_dirty;
+    StatsDStripes <CounterImpl::value_type> m_value;
 };
 
 //------------------------------------------------------------------------------
 
 class StatsDEventImpl
     : public EventImpl
+    , public StatsDMetricBase
 {
 public:
     StatsDEventImpl (std::string const& name,
@@ -116,16 +175,43 @@ public:
 
     ~StatsDEventImpl ();
 
-    void notify (EventImpl::value_type const& alue);
+    void notify (EventImpl::value_type const& value);
 
-    void do_notify (EventImpl::value_type const& value);
+    void flush ();
     void do_process ();
 
 private:
     StatsDEventImpl& operator= (StatsDEventImpl const&);
 
+    enum
+    {
+        // Samples kept per slot between flushes. Any more are
+        // counted, and the kept ones are sent with a sample rate.
+        capacity = 32
+    };
+
+    struct alignas(cacheLineSize) Stripe
+    {
+        std::atomic_flag busy = ATOMIC_FLAG_INIT;
+        std::size_t size = 0;
+        std::size_t dropped = 0;
+        std::array <EventImpl::value_type::rep, capacity> samples;
+
+        void lock ()
+        {
+            while (busy.test_and_set (std::memory_order_acquire))
+                std::this_thread::yield ();
+        }
+
+        void unlock ()
+        {
+            busy.clear (std::memory_order_release);
+        }
+    };
+
     std::shared_ptr <StatsDCollectorImp> m_impl;
     std::string m_name;
+    std::array <Stripe, stripeCount> m_stripes;
 };
 
 //------------------------------------------------------------------------------
@@ -144,8 +230,6 @@ public:
     void increment (GaugeImpl::difference_type amount);
 
     void flush ();
-    void do_set (GaugeImpl::value_type value);
-    void do_increment (GaugeImpl::difference_type amount);
     void do_process ();
 
 private:
@@ -154,8 +238,7 @@ private:
     std::shared_ptr <StatsDCollectorImp> m_impl;
     std::string m_name;
     GaugeImpl::value_type m_last_value;
-    GaugeImpl::value_type m_value;
-    bool m_dirty;
+    std::atomic <GaugeImpl::value_type> m_value;
 };
 
 //------------------------------------------------------------------------------
@@ -173,7 +256,6 @@ public:
     void increment (MeterImpl::value_type amount);
 
     void flush ();
-    void do_increment (MeterImpl::value_type amount);
     void do_process ();
 
 private:
@@ -181,8 +263,7 @@ private:
 
     std::shared_ptr <StatsDCollectorImp> m_impl;
     std::string m_name;
-    MeterImpl::value_type m_value;
-    bool m_dirty;
+    StatsDStripes <MeterImpl::value_type> m_value;
 };
 
 //------------------------------------------------------------------------------
@@ -195,7 +276,11 @@ private:
     enum
     {
         //max_packet_size = 484
-        max_packet_size = 1472
+        max_packet_size = 1472,
+
+        // asio gathers at most this many buffers into one send,
+        // anything past it is silently left out of the datagram.
+        max_packet_buffers = 64
     };
 
     Journal m_journal;
@@ -203,7 +288,6 @@ private:
     std::string m_prefix;
     boost::asio::io_service m_io_service;
     boost::optional <boost::asio::io_service::work> m_work;
-    boost::asio::io_service::strand m_strand;
     boost::asio::basic_waitable_timer<std::chrono::steady_clock> m_timer;
     boost::asio::ip::udp::socket m_socket;
     std::deque <std::string> m_data;
@@ -238,7 +322,6 @@ public:
         , m_address (address)
         , m_prefix (prefix)
         , m_work (std::ref (m_io_service))
-        , m_strand (m_io_service)
         , m_timer (m_io_service)
         , m_socket (m_io_service)
         , m_thread (&StatsDCollectorImp::run, this)
@@ -310,16 +393,10 @@ public:
         return m_prefix;
     }
 
-    void do_post_buffer (std::string const& buffer)
-    {
-        m_data.emplace_back (buffer);
-    }
-
+    // Only called from the timer, on the collector's thread
     void post_buffer (std::string&& buffer)
     {
-        m_io_service.dispatch (m_strand.wrap (std::bind (
-            &StatsDCollectorImp::do_post_buffer, this,
-                std::move (buffer))));
+        m_data.emplace_back (std::move (buffer));
     }
 
     // The keepAlive parameter makes sure the buffers sent to
@@ -376,7 +453,8 @@ public:
         {
             std::size_t const length (s.size ());
             assert (! s.empty ());
-            if (! buffers.empty () && (size + length) > max_packet_size)
+            if (! buffers.empty () && ((size + length) > max_packet_size ||
+                buffers.size () >= max_packet_buffers))
             {
 #if BEAST_STATSDCOLLECTOR_TRACING_ENABLED
                 log (buffers);
@@ -486,8 +564,6 @@ StatsDCounterImpl::StatsDCounterImpl (std::string const& name,
     std::shared_ptr <StatsDCollectorImp> const& impl)
     : m_impl (impl)
     , m_name (name)
-    , m_value (0)
-    , m_dirty (false)
 {
     m_impl->add (*this);
 }
@@ -499,34 +575,24 @@ StatsDCounterImpl::~StatsDCounterImpl ()
 
 void StatsDCounterImpl::increment (CounterImpl::value_type amount)
 {
-    m_impl->get_io_service().dispatch (std::bind (
-        &StatsDCounterImpl::do_increment,
-            std::static_pointer_cast <StatsDCounterImpl> (
-                shared_from_this ()), amount));
+    m_value.add (amount);
 }
 
 void StatsDCounterImpl::flush ()
 {
-    if (m_dirty)
+    auto const value = m_value.exchange ();
+    if (value != 0)
     {
-        m_dirty = false;
         std::stringstream ss;
         ss <<
             m_impl->prefix() << "." <<
             m_name << ":" <<
-            m_value << "|c" <<
+            value << "|c" <<
             "\n";
-        m_value = 0;
         m_impl->post_buffer (ss.str ());
     }
 }
 
-void StatsDCounterImpl::do_increment (CounterImpl::value_type amount)
-{
-    m_value += amount;
-    m_dirty = true;
-}
-
 void StatsDCounterImpl::do_process ()
 {
     flush ();
@@ -539,29 +605,58 @@ StatsDEventImpl::StatsDEventImpl (std::string const& name,
     : m_impl (impl)
     , m_name (name)
 {
+    m_impl->add (*this);
 }
 
 StatsDEventImpl::~StatsDEventImpl ()
 {
+    m_impl->remove (*this);
 }
 
 void StatsDEventImpl::notify (EventImpl::value_type const& value)
 {
-    m_impl->get_io_service().dispatch (std::bind (
-        &StatsDEventImpl::do_notify,
-            std::static_pointer_cast <StatsDEventImpl> (
-                shared_from_this ()), value));
+    auto& stripe (m_stripes[stripeIndex ()]);
+    stripe.lock ();
+    if (stripe.size < capacity)
+        stripe.samples[stripe.size++] = value.count ();
+    else
+        ++stripe.dropped;
+    stripe.unlock ();
 }
 
-void StatsDEventImpl::do_notify (EventImpl::value_type const& value)
+void StatsDEventImpl::flush ()
 {
-    std::stringstream ss;
-    ss <<
-        m_impl->prefix() << "." <<
-        m_name << ":" <<
-        value.count() << "|ms" <<
-        "\n";
-    m_impl->post_buffer (ss.str ());
+    std::vector <EventImpl::value_type::rep> samples;
+    std::size_t dropped (0);
+    for (auto& stripe : m_stripes)
+    {
+        stripe.lock ();
+        samples.insert (samples.end (), stripe.samples.begin (),
+            stripe.samples.begin () + stripe.size);
+        dropped += stripe.dropped;
+        stripe.size = 0;
+        stripe.dropped = 0;
+        stripe.unlock ();
+    }
+
+    for (auto const sample : samples)
+    {
+        std::stringstream ss;
+        ss <<
+            m_impl->prefix() << "." <<
+            m_name << ":" <<
+            sample << "|ms";
+        if (dropped != 0)
+            ss << "|@" << double (samples.size ()) /
+                (samples.size () + dropped);
+        ss << "\n";
+        m_impl->post_buffer (ss.str ());
+    }
+}
+
+void StatsDEventImpl::do_process ()
+{
+    flush ();
 }
 
 //------------------------------------------------------------------------------
@@ -572,7 +667,6 @@ StatsDGaugeImpl::StatsDGaugeImpl (std::string const& name,
     , m_name (name)
     , m_last_value (0)
     , m_value (0)
-    , m_dirty (false)
 {
     m_impl->add (*this);
 }
@@ -584,69 +678,55 @@ StatsDGaugeImpl::~StatsDGaugeImpl ()
 
 void StatsDGaugeImpl::set (GaugeImpl::value_type value)
 {
-    m_impl->get_io_service().dispatch (std::bind (
-        &StatsDGaugeImpl::do_set,
-            std::static_pointer_cast <StatsDGaugeImpl> (
-                shared_from_this ()), value));
+    m_value.store (value, std::memory_order_relaxed);
 }
 
 void StatsDGaugeImpl::increment (GaugeImpl::difference_type amount)
 {
-    m_impl->get_io_service().dispatch (std::bind (
-        &StatsDGaugeImpl::do_increment,
-            std::static_pointer_cast <StatsDGaugeImpl> (
-                shared_from_this ()), amount));
+    GaugeImpl::value_type current (
+        m_value.load (std::memory_order_relaxed));
+    GaugeImpl::value_type value;
+
+    do
+    {
+        value = current;
+
+        if (amount > 0)
+        {
+            GaugeImpl::value_type const d (
+                static_cast <GaugeImpl::value_type> (amount));
+            value +=
+                (d >= std::numeric_limits <GaugeImpl::value_type>::max() - current)
+                ? std::numeric_limits <GaugeImpl::value_type>::max() - current
+                : d;
+        }
+        else if (amount < 0)
+        {
+            GaugeImpl::value_type const d (
+                static_cast <GaugeImpl::value_type> (-amount));
+            value = (d >= value) ? 0 : value - d;
+        }
+    }
+    while (! m_value.compare_exchange_weak (current, value,
+        std::memory_order_relaxed));
 }
 
 void StatsDGaugeImpl::flush ()
 {
-    if (m_dirty)
+    auto const value = m_value.load (std::memory_order_relaxed);
+    if (value != m_last_value)
     {
-        m_dirty = false;
+        m_last_value = value;
         std::stringstream ss;
         ss <<
             m_impl->prefix() << "." <<
             m_name << ":" <<
-            m_value << "|c" <<
+            value << "|c" <<
             "\n";
         m_impl->post_buffer (ss.str ());
     }
 }
 
-void StatsDGaugeImpl::do_set (GaugeImpl::value_type value)
-{
-    m_value = value;
-
-    if (m_value != m_last_value)
-    {
-        m_last_value = m_value;
-        m_dirty = true;
-    }
-}
-
-void StatsDGaugeImpl::do_increment (GaugeImpl::difference_type amount)
-{
-    GaugeImpl::value_type value (m_value);
-
-    if (amount > 0)
-    {
-        GaugeImpl::value_type const d (
-            static_cast <GaugeImpl::value_type> (amount));
-        value +=
-            (d >= std::numeric_limits <GaugeImpl::value_type>::max() - m_value)
-            ? std::numeric_limits <GaugeImpl::value_type>::max() - m_value
-            : d;
-    }
-    else if (amount < 0)
-    {
-        GaugeImpl::value_type const d (
-            static_cast <GaugeImpl::value_type> (-amount));
-        value = (d >= value) ? 0 : value - d;
-    }
-
-    do_set (value);
-}
-
 void StatsDGaugeImpl::do_process ()
 {
     flush ();
@@ -658,8 +738,6 @@ StatsDMeterImpl::StatsDMeterImpl (std::string const& name,
     std::shared_ptr <StatsDCollectorImp> const& impl)
     : m_impl (impl)
     , m_name (name)
-    , m_value (0)
-    , m_dirty (false)
 {
     m_impl->add (*this);
 }
@@ -671,34 +749,24 @@ StatsDMeterImpl::~StatsDMeterImpl ()
 
 void StatsDMeterImpl::increment (MeterImpl::value_type amount)
 {
-    m_impl->get_io_service().dispatch (std::bind (
-        &StatsDMeterImpl::do_increment,
-            std::static_pointer_cast <StatsDMeterImpl> (
-                shared_from_this ()), amount));
+    m_value.add (amount);
 }
 
 void StatsDMeterImpl::flush ()
 {
-    if (m_dirty)
+    auto const value = m_value.exchange ();
+    if (value != 0)
     {
-        m_dirty = false;
         std::stringstream ss;
         ss <<
             m_impl->prefix() << "." <<
             m_name << ":" <<
-            m_value << "|m" <<
+            value << "|m" <<
             "\n";
-        m_value = 0;
         m_impl->post_buffer (ss.str ());
     }
 }
 
-void StatsDMeterImpl::do_increment (MeterImpl::value_type amount)
-{
-    m_value += amount;
-    m_dirty = true;
-}
-
 void StatsDMeterImpl::do_process ()
 {
     flush ();
@@ -27,4 +27,5 @@
 #include <ripple/beast/insight/impl/Hook.cpp>
 #include <ripple/beast/insight/impl/Metric.cpp>
 #include <ripple/beast/insight/impl/NullCollector.cpp>
+#include <ripple/beast/insight/impl/PrometheusCollector.cpp>
 #include <ripple/beast/insight/impl/StatsDCollector.cpp>
@@ -58,7 +58,6 @@ enum SizedItemName
     siSLECacheAge,
     siLedgerSize,
     siLedgerAge,
-    siLedgerFetch,
     siHashNodeDBCache,
     siTxnDBCache,
     siLgrDBCache,
@@ -168,6 +167,7 @@ public:
     // Node storage configuration
     std::uint32_t                      LEDGER_HISTORY = 256;
     std::uint32_t                      FETCH_DEPTH = 1000000000;
+    std::uint32_t                      BACKFILL_WINDOW = 8;
     int                         NODE_SIZE = 0;
 
     bool                        SSL_VERIFY = true;
@@ -84,7 +84,9 @@ post()
             auto saved = detail::getLocalValues().release();
             detail::getLocalValues().reset(&lvs_);
             std::lock_guard<std::mutex> lock(mutex_);
+            auto const arena = Json::detail::exchangeArena(arena_);
             coro_();
+            arena_ = Json::detail::exchangeArena(arena);
             detail::getLocalValues().release();
             detail::getLocalValues().reset(saved);
             std::lock_guard<std::mutex> lk(mutex_run_);
@@ -23,8 +23,12 @@
 #include <ripple/core/Config.h>
 #include <ripple/core/SociDB.h>
 #include <boost/filesystem/path.hpp>
+#include <atomic>
+#include <cassert>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 
 namespace soci {
@@ -46,6 +50,11 @@ public:
     LockedPointer (T* it, mutex& m) : it_ (it), lock_ (m)
     {
     }
+    LockedPointer (T* it, std::unique_lock<mutex>&& lock)
+        : it_ (it), lock_ (std::move (lock))
+    {
+        assert (lock_.owns_lock ());
+    }
     LockedPointer (LockedPointer&& rhs) noexcept
         : it_ (rhs.it_), lock_ (std::move (rhs.lock_))
     {
@@ -82,6 +91,9 @@ public:
         Config::StartUpType startUp = Config::NORMAL;
         bool standAlone = false;
         boost::filesystem::path dataDir;
+
+        // Number of read-only connections for checkoutReadDb
+        std::size_t readConnections = 0;
     };
 
     DatabaseCon (Setup const& setup,
@@ -99,13 +111,36 @@ public:
         return LockedSociSession (&session_, lock_);
     }
 
+    /** Check out a session for queries which do not write.
+
+        With write-ahead logging, SQLite lets readers proceed
+        alongside each other and alongside the writer. If the
+        database has read-only connections, this returns the
+        first idle one, or waits for one; otherwise it returns
+        the same session as checkoutDb.
+
+        Readers see the database as of the start of their
+        query, which includes everything committed through
+        checkoutDb before the query starts.
+    */
+    LockedSociSession checkoutReadDb ();
+
     void setupCheckpointing (JobQueue*, Logs&);
 
 private:
+    struct Reader
+    {
+        LockedSociSession::mutex lock;
+        soci::session session;
+    };
+
     LockedSociSession::mutex lock_;
 
     soci::session session_;
     std::unique_ptr<Checkpointer> checkpointer_;
+
+    std::vector<std::unique_ptr<Reader>> readers_;
+    std::atomic<std::size_t> nextReader_ {0};
 };
 
 DatabaseCon::Setup
@@ -0,0 +1,130 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_CORE_JOBPROFILER_H_INCLUDED
+#define RIPPLE_CORE_JOBPROFILER_H_INCLUDED
+
+#include <ripple/json/json_value.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ripple {
+
+/** Samples what the JobQueue threads are doing.
+
+    Each attached thread keeps a short stack of names: the job type, the
+    job name, and any LoadEvent measured inside the job. While profiling is
+    on, a background thread looks at every stack at the configured
+    frequency and counts how often each one is seen. The counts are folded
+    stacks, names joined by ';', ready for a flame graph.
+
+    When the frequency is zero no thread runs and entering a scope costs
+    one relaxed atomic load.
+*/
+class JobProfiler
+{
+public:
+    struct Slot;
+
+    /** Names what the calling thread is doing until it leaves. */
+    class Scope
+    {
+    public:
+        Scope () = default;
+
+        explicit Scope (std::string const& frame)
+        {
+            enter (frame);
+        }
+
+        Scope (Scope const&) = delete;
+        Scope& operator= (Scope const&) = delete;
+
+        ~Scope ()
+        {
+            leave ();
+        }
+
+        /** Push a frame on the calling thread's stack.
+            Nothing happens unless the thread is attached, profiling is on
+            and the scope is not already entered. The string must outlive
+            the scope.
+        */
+        void enter (std::string const& frame);
+
+        /** Remove the frame. May be called from any thread. */
+        void leave ();
+
+        bool entered () const
+        {
+            return slot_ != nullptr;
+        }
+
+    private:
+        std::shared_ptr <Slot> slot_;
+        std::string const* frame_ = nullptr;
+    };
+
+    JobProfiler ();
+    ~JobProfiler ();
+
+    /** Give the calling thread a stack that will be sampled. */
+    void attach ();
+
+    /** Set the number of samples per second. Zero turns profiling off. */
+    void setFrequency (std::uint32_t frequency);
+
+    std::uint32_t frequency () const;
+
+    /** Return the sample counts, optionally starting over. */
+    Json::Value getJson (bool reset);
+
+    /** Take one sample of every attached thread. */
+    void sample ();
+
+private:
+    void run ();
+
+    // Requires mutex_
+    void doSample ();
+
+    std::uint64_t const id_;
+    std::atomic <std::uint32_t> frequency_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread thread_;
+    bool stop_ = false;
+
+    std::vector <std::shared_ptr <Slot>> slots_;
+    std::map <std::string, std::uint64_t> stacks_;
+    std::uint64_t samples_ = 0;
+    std::uint64_t idle_ = 0;
+};
+
+} // ripple
+
+#endif
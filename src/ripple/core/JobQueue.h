@@ -23,9 +23,11 @@
 #include <ripple/basics/LocalValue.h>
 #include <ripple/basics/win32_workaround.h>
 #include <ripple/core/Job.h>
+#include <ripple/core/JobProfiler.h>
 #include <ripple/core/JobTypes.h>
 #include <ripple/core/JobTypeData.h>
 #include <ripple/core/impl/Workers.h>
+#include <ripple/json/Arena.h>
 #include <ripple/json/json_value.h>
 #include <ripple/beast/insight/Collector.h>
 #include <ripple/core/Stoppable.h>
@@ -61,6 +63,8 @@ public:
     {
     private:
         detail::LocalValues lvs_;
+        // The Json::Arena of the coroutine while it is suspended
+        Json::detail::ArenaBlocks* arena_ = nullptr;
         JobQueue& jq_;
         JobType type_;
         std::string name_;
@@ -168,6 +172,13 @@ public:
     // Cannot be const because LoadMonitor has no const methods.
     Json::Value getJson (int c = 0);
 
+    /** Samples which job each worker thread is running. */
+    JobProfiler&
+    profiler ()
+    {
+        return m_profiler;
+    }
+
     /** Block until no tasks running. */
     void
     rendezvous();
@@ -190,6 +201,9 @@ private:
     // The number of suspended coroutines
     int nSuspend_ = 0;
 
+    // Declared before the workers, whose threads refer to it
+    JobProfiler m_profiler;
+
     Workers m_workers;
     Job::CancelCallback m_cancelCallback;
 
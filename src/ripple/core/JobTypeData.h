@@ -23,6 +23,7 @@
 #include <ripple/basics/Log.h>
 #include <ripple/core/JobTypeInfo.h>
 #include <ripple/beast/insight/Collector.h>
+#include <ripple/beast/insight/Histogram.h>
 
 namespace ripple
 {
@@ -52,6 +53,10 @@ public:
     beast::insight::Event dequeue;
     beast::insight::Event execute;
 
+    /* Time spent waiting in the queue, and running */
+    beast::insight::Histogram dequeueLatency;
+    beast::insight::Histogram executeLatency;
+
     JobTypeData (JobTypeInfo const& info_,
             beast::insight::Collector::ptr const& collector, Logs& logs) noexcept
         : m_load (logs.journal ("LoadMonitor"))
@@ -76,7 +81,7 @@ public:
     JobTypeData (JobTypeData const& other) = delete;
     JobTypeData& operator= (JobTypeData const& other) = delete;
 
-    std::string name () const
+    std::string const& name () const
     {
         return info.name ();
     }
@@ -0,0 +1,57 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_CORE_LATENCYJSON_H_INCLUDED
+#define RIPPLE_CORE_LATENCYJSON_H_INCLUDED
+
+#include <ripple/beast/insight/Histogram.h>
+#include <ripple/json/json_value.h>
+#include <algorithm>
+#include <limits>
+
+namespace ripple {
+
+/** Summarize a distribution of durations recorded in microseconds.
+
+    The tail percentiles are what we report, since the average hides
+    exactly the spikes that matter. Like the snapshot, they cover only the
+    histogram's recent windows.
+*/
+inline
+Json::Value
+getLatencyJson (beast::insight::Histogram::Snapshot const& latency)
+{
+    auto const clamp = [](std::uint64_t v)
+    {
+        return static_cast <Json::UInt> (std::min <std::uint64_t> (
+            v, std::numeric_limits <Json::UInt>::max ()));
+    };
+
+    Json::Value ret (Json::objectValue);
+    ret["count"] = clamp (latency.count ());
+    ret["p50_us"] = clamp (latency.percentile (0.5));
+    ret["p99_us"] = clamp (latency.percentile (0.99));
+    ret["p999_us"] = clamp (latency.percentile (0.999));
+    ret["max_us"] = clamp (latency.max ());
+    return ret;
+}
+
+} // ripple
+
+#endif
@@ -20,6 +20,7 @@
 #ifndef RIPPLE_CORE_LOADEVENT_H_INCLUDED
 #define RIPPLE_CORE_LOADEVENT_H_INCLUDED
 
+#include <ripple/core/JobProfiler.h>
 #include <chrono>
 #include <memory>
 #include <string>
@@ -83,6 +84,9 @@ private:
     // The time we spent waiting and running respectively
     std::chrono::steady_clock::duration timeWaiting_;
     std::chrono::steady_clock::duration timeRunning_;
+
+    // Names the running phase for the JobProfiler
+    JobProfiler::Scope scope_;
 };
 
 } // ripple
@@ -0,0 +1,74 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_CORE_RECLAIMER_H_INCLUDED
+#define RIPPLE_CORE_RECLAIMER_H_INCLUDED
+
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ripple {
+
+/** Releases references on a background thread.
+
+    Dropping the last reference to a large structure, such as a SHAMap
+    subtree evicted from a cache, can take a long time. Handing the
+    references to a Reclaimer moves that work off the calling thread.
+    The thread starts with the first release, and anything still pending
+    is released before the destructor returns.
+*/
+class Reclaimer
+{
+public:
+    using value_type = std::shared_ptr <void const>;
+
+    explicit
+    Reclaimer (std::string const& name);
+
+    Reclaimer (Reclaimer const&) = delete;
+    Reclaimer& operator= (Reclaimer const&) = delete;
+
+    ~Reclaimer ();
+
+    /** Release the references on the background thread. */
+    void release (std::vector <value_type>&& items);
+
+    /** Returns the number of references waiting to be released. */
+    std::size_t pending () const;
+
+private:
+    void run ();
+
+    std::string const name_;
+    std::mutex mutable mutex_;
+    std::condition_variable cond_;
+    std::vector <value_type> items_;
+    std::size_t pending_ = 0;
+    bool stop_ = false;
+    std::thread thread_;
+};
+
+} // ripple
+
+#endif
@@ -416,6 +416,16 @@ void Config::loadFromString (std::string const& fileContents)
             FETCH_DEPTH = 10;
     }
 
+    if (getSingleSection (secConfig, SECTION_BACKFILL_WINDOW, strTemp, j_))
+    {
+        BACKFILL_WINDOW = beast::lexicalCastThrow <std::uint32_t> (strTemp);
+
+        if (BACKFILL_WINDOW < 1)
+            BACKFILL_WINDOW = 1;
+        else if (BACKFILL_WINDOW > 256)
+            BACKFILL_WINDOW = 256;
+    }
+
     if (getSingleSection (secConfig, SECTION_PATH_SEARCH_OLD, strTemp, j_))
         PATH_SEARCH_OLD     = beast::lexicalCastThrow <int> (strTemp);
     if (getSingleSection (secConfig, SECTION_PATH_SEARCH, strTemp, j_))
@@ -540,8 +550,6 @@ int Config::getSize (SizedItemName item) const
 
         { siSweepInterval,      {   10,     30,     60,     90,         120     } },
 
-        { siLedgerFetch,        {   2,      2,      3,      3,          3       } },
-
         { siNodeCacheSize,      {   16384,  32768,  131072, 262144,     524288  } },
         { siNodeCacheAge,       {   60,     90,     120,    900,        1800    } },
 
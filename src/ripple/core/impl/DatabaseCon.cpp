@@ -22,6 +22,7 @@
 #include <ripple/core/SociDB.h>
 #include <ripple/basics/contract.h>
 #include <ripple/basics/Log.h>
+#include <cstring>
 #include <memory>
 
 namespace ripple {
@@ -55,6 +56,57 @@ DatabaseCon::DatabaseCon (
             // ignore errors
         }
     }
+
+    // A temporary database is private to its connection
+    if (useTempFiles)
+        return;
+
+    readers_.reserve (setup.readConnections);
+    for (std::size_t n = 0; n < setup.readConnections; ++n)
+    {
+        auto reader = std::make_unique<Reader>();
+        open (reader->session, "sqlite", pPath.string());
+
+        // The leading pragmas configure the connection
+        for (int i = 0; i < initCount &&
+            std::strncmp (initStrings[i], "PRAGMA ", 7) == 0; ++i)
+        {
+            try
+            {
+                reader->session << initStrings[i];
+            }
+            catch (soci::soci_error&)
+            {
+                // ignore errors
+            }
+        }
+        reader->session << "PRAGMA query_only=1;";
+
+        readers_.push_back (std::move (reader));
+    }
+}
+
+LockedSociSession
+DatabaseCon::checkoutReadDb ()
+{
+    if (readers_.empty ())
+        return checkoutDb ();
+
+    // Take the first idle reader, starting from a different
+    // one each time so that the load is spread evenly.
+    auto const first = nextReader_++ % readers_.size ();
+    for (std::size_t i = 0; i < readers_.size (); ++i)
+    {
+        auto& reader = *readers_[(first + i) % readers_.size ()];
+        std::unique_lock<LockedSociSession::mutex> lock (
+            reader.lock, std::try_to_lock);
+        if (lock.owns_lock ())
+            return LockedSociSession (
+                &reader.session, std::move (lock));
+    }
+
+    auto& reader = *readers_[first];
+    return LockedSociSession (&reader.session, reader.lock);
 }
 
 DatabaseCon::Setup setup_DatabaseCon (Config const& c)
@@ -64,6 +116,8 @@ DatabaseCon::Setup setup_DatabaseCon (Config const& c)
     setup.startUp = c.START_UP;
     setup.standAlone = c.standalone();
     setup.dataDir = c.legacy ("database_path");
+    setup.readConnections = get<std::size_t> (
+        c.section ("sqdb"), "read_connections", 4);
     if (!setup.standAlone && setup.dataDir.empty())
     {
         Throw<std::runtime_error>(
@@ -0,0 +1,268 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/core/JobProfiler.h>
+#include <ripple/beast/core/Thread.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <limits>
+
+namespace ripple {
+
+struct JobProfiler::Slot
+{
+    enum
+    {
+        maxDepth = 8
+    };
+
+    // Held only to change or copy the frames, never while blocking
+    void lock ()
+    {
+        while (busy.test_and_set (std::memory_order_acquire))
+            std::this_thread::yield ();
+    }
+
+    void unlock ()
+    {
+        busy.clear (std::memory_order_release);
+    }
+
+    // Set while the owning profiler is sampling. A thread may outlive
+    // the profiler, so the slot is shared and this is cleared first.
+    std::atomic <bool> enabled {false};
+    std::atomic_flag busy = ATOMIC_FLAG_INIT;
+    std::array <std::string const*, maxDepth> frames;
+    std::size_t depth = 0;
+};
+
+namespace detail {
+
+std::atomic <std::uint64_t> nextProfilerId {1};
+
+// The stack of the calling thread, if it was attached
+thread_local std::shared_ptr <JobProfiler::Slot> profilerSlot;
+thread_local std::uint64_t profilerOwner = 0;
+
+}
+
+//------------------------------------------------------------------------------
+
+void
+JobProfiler::Scope::enter (std::string const& frame)
+{
+    auto const& slot = detail::profilerSlot;
+    if (slot == nullptr || slot_ != nullptr ||
+            ! slot->enabled.load (std::memory_order_relaxed))
+        return;
+
+    slot->lock ();
+    if (slot->depth < Slot::maxDepth)
+    {
+        slot->frames[slot->depth++] = &frame;
+        slot_ = slot;
+        frame_ = &frame;
+    }
+    slot->unlock ();
+}
+
+void
+JobProfiler::Scope::leave ()
+{
+    if (slot_ == nullptr)
+        return;
+
+    // Scopes usually leave in reverse order, so search from the top
+    slot_->lock ();
+    for (auto i = slot_->depth; i-- > 0;)
+    {
+        if (slot_->frames[i] == frame_)
+        {
+            std::copy (slot_->frames.begin () + i + 1,
+                slot_->frames.begin () + slot_->depth,
+                slot_->frames.begin () + i);
+            --slot_->depth;
+            break;
+        }
+    }
+    slot_->unlock ();
+    slot_.reset ();
+    frame_ = nullptr;
+}
+
+//------------------------------------------------------------------------------
+
+JobProfiler::JobProfiler ()
+    : id_ (detail::nextProfilerId++)
+    , frequency_ (0)
+{
+}
+
+JobProfiler::~JobProfiler ()
+{
+    setFrequency (0);
+}
+
+void
+JobProfiler::attach ()
+{
+    if (detail::profilerOwner == id_)
+        return;
+
+    auto const slot = std::make_shared <Slot> ();
+
+    std::lock_guard <std::mutex> lock (mutex_);
+    slot->enabled = frequency_ > 0;
+    slots_.push_back (slot);
+    detail::profilerSlot = slot;
+    detail::profilerOwner = id_;
+}
+
+void
+JobProfiler::setFrequency (std::uint32_t frequency)
+{
+    frequency = std::min <std::uint32_t> (frequency, 1000);
+
+    std::thread stopped;
+    {
+        std::lock_guard <std::mutex> lock (mutex_);
+        frequency_ = frequency;
+        for (auto const& slot : slots_)
+            slot->enabled = frequency > 0;
+
+        if (frequency > 0 && ! thread_.joinable ())
+        {
+            stop_ = false;
+            thread_ = std::thread (&JobProfiler::run, this);
+        }
+        else if (frequency == 0 && thread_.joinable ())
+        {
+            stop_ = true;
+            stopped = std::move (thread_);
+        }
+    }
+
+    cv_.notify_all ();
+    if (stopped.joinable ())
+        stopped.join ();
+}
+
+std::uint32_t
+JobProfiler::frequency () const
+{
+    return frequency_.load ();
+}
+
+Json::Value
+JobProfiler::getJson (bool reset)
+{
+    auto const count = [](std::uint64_t n)
+    {
+        return static_cast <Json::UInt> (std::min <std::uint64_t> (
+            n, std::numeric_limits <Json::UInt>::max ()));
+    };
+
+    std::lock_guard <std::mutex> lock (mutex_);
+
+    Json::Value ret (Json::objectValue);
+    ret["frequency"] = frequency_.load ();
+    ret["samples"] = count (samples_);
+    ret["idle"] = count (idle_);
+
+    Json::Value& stacks = (ret["stacks"] = Json::objectValue);
+    for (auto const& stack : stacks_)
+        stacks[stack.first] = count (stack.second);
+
+    if (reset)
+    {
+        stacks_.clear ();
+        samples_ = 0;
+        idle_ = 0;
+    }
+
+    return ret;
+}
+
+void
+JobProfiler::sample ()
+{
+    std::lock_guard <std::mutex> lock (mutex_);
+    doSample ();
+}
+
+void
+JobProfiler::run ()
+{
+    beast::Thread::setCurrentThreadName ("JobProfiler");
+
+    std::unique_lock <std::mutex> lock (mutex_);
+    auto next = std::chrono::steady_clock::now ();
+    while (! stop_)
+    {
+        next += std::chrono::microseconds (1000000 / frequency_.load ());
+        if (cv_.wait_until (lock, next, [this]{ return stop_; }))
+            break;
+
+        // Don't try to catch up after a stall
+        next = std::max (next, std::chrono::steady_clock::now () -
+            std::chrono::seconds (1));
+
+        doSample ();
+    }
+}
+
+void
+JobProfiler::doSample ()
+{
+    // Bounds the memory used by jobs with many distinct names
+    std::size_t const maxStacks = 10000;
+
+    std::string stack;
+    for (auto const& slot : slots_)
+    {
+        stack.clear ();
+        slot->lock ();
+        for (std::size_t i = 0; i < slot->depth; ++i)
+        {
+            if (i != 0)
+                stack += ';';
+            stack += *slot->frames[i];
+        }
+        slot->unlock ();
+
+        ++samples_;
+        if (stack.empty ())
+        {
+            ++idle_;
+            continue;
+        }
+
+        auto iter = stacks_.find (stack);
+        if (iter != stacks_.end ())
+            ++iter->second;
+        else if (stacks_.size () < maxStacks)
+            stacks_.emplace (stack, 1);
+        else
+            ++stacks_["[other]"];
+    }
+}
+
+} // ripple
@@ -22,6 +22,7 @@
 #include <ripple/core/JobTypes.h>
 #include <ripple/core/JobTypeInfo.h>
 #include <ripple/core/JobTypeData.h>
+#include <ripple/core/LatencyJson.h>
 #include <ripple/beast/clock/chrono_util.h>
 #include <chrono>
 #include <memory>
@@ -262,8 +263,12 @@ JobQueue::getJson (int c)
         int waiting (data.waiting);
         int running (data.running);
 
+        auto const waitLatency (data.dequeueLatency.snapshot ());
+        auto const runLatency (data.executeLatency.snapshot ());
+
         if ((stats.count != 0) || (waiting != 0) ||
-            (stats.latencyPeak != 0) || (running != 0))
+            (stats.latencyPeak != 0) || (running != 0) ||
+            (runLatency.count () != 0))
         {
             Json::Value& pri = priorities.append (Json::objectValue);
 
@@ -286,6 +291,12 @@ JobQueue::getJson (int c)
 
             if (running != 0)
                 pri["in_progress"] = running;
+
+            if (waitLatency.count () != 0)
+                pri["wait_latency"] = getLatencyJson (waitLatency);
+
+            if (runLatency.count () != 0)
+                pri["run_latency"] = getLatencyJson (runLatency);
         }
     }
 
@@ -428,9 +439,12 @@ void JobQueue::on_dequeue (JobType type,
 {
     using namespace std::chrono;
     auto const ms (ceil <std::chrono::milliseconds> (value));
+    auto& data (getJobTypeData (type));
+
+    data.dequeueLatency.record (value);
 
     if (ms.count() >= 10)
-        getJobTypeData (type).dequeue.notify (ms);
+        data.dequeue.notify (ms);
 }
 
 template <class Rep, class Period>
@@ -439,9 +453,12 @@ void JobQueue::on_execute (JobType type,
 {
     using namespace std::chrono;
     auto const ms (ceil <std::chrono::milliseconds> (value));
+    auto& data (getJobTypeData (type));
+
+    data.executeLatency.record (value);
 
     if (ms.count() >= 10)
-        getJobTypeData (type).execute.notify (ms);
+        data.execute.notify (ms);
 }
 
 void
@@ -449,9 +466,12 @@ JobQueue::processTask ()
 {
     JobType type;
 
+    m_profiler.attach ();
+
     {
         Job::clock_type::time_point const start_time (
             Job::clock_type::now());
+        JobProfiler::Scope scope;
         {
             Job job;
             {
@@ -461,6 +481,7 @@ JobQueue::processTask ()
             }
             type = job.getType();
             JobTypeData& data(getJobTypeData(type));
+            scope.enter (data.name ());
             beast::Thread::setCurrentThreadName (data.name ());
             JLOG(m_journal.trace()) << "Doing " << data.name () << " job";
             on_dequeue (job.getType (), start_time - job.queue_time ());
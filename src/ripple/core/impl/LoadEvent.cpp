@@ -36,6 +36,8 @@ LoadEvent::LoadEvent (
     , timeWaiting_ {}
     , timeRunning_ {}
 {
+    if (running_)
+        scope_.enter (name_);
 }
 
 LoadEvent::~LoadEvent ()
@@ -63,7 +65,16 @@ LoadEvent::runTime() const
 
 void LoadEvent::reName (std::string const& name)
 {
+    if (! scope_.entered ())
+    {
+        name_ = name;
+        return;
+    }
+
+    // The profiler may be reading the name
+    scope_.leave ();
     name_ = name;
+    scope_.enter (name_);
 }
 
 void LoadEvent::start ()
@@ -76,6 +87,8 @@ void LoadEvent::start ()
     timeWaiting_ += now - mark_;
     mark_ = now;
     running_ = true;
+
+    scope_.enter (name_);
 }
 
 void LoadEvent::stop ()
@@ -88,6 +101,7 @@ void LoadEvent::stop ()
     mark_ = now;
     running_ = false;
 
+    scope_.leave ();
     monitor_.addLoadSample (*this);
 }
 
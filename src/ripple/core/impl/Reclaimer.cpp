@@ -0,0 +1,103 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/core/Reclaimer.h>
+#include <ripple/beast/core/Thread.h>
+
+namespace ripple {
+
+Reclaimer::Reclaimer (std::string const& name)
+    : name_ (name)
+{
+}
+
+Reclaimer::~Reclaimer ()
+{
+    {
+        std::lock_guard <std::mutex> lock (mutex_);
+        stop_ = true;
+    }
+    cond_.notify_one ();
+    if (thread_.joinable ())
+        thread_.join ();
+}
+
+void
+Reclaimer::release (std::vector <value_type>&& items)
+{
+    if (items.empty ())
+        return;
+
+    {
+        std::lock_guard <std::mutex> lock (mutex_);
+        if (! thread_.joinable ())
+            thread_ = std::thread (&Reclaimer::run, this);
+        pending_ += items.size ();
+        if (items_.empty ())
+        {
+            items_.swap (items);
+        }
+        else
+        {
+            items_.insert (items_.end (),
+                std::make_move_iterator (items.begin ()),
+                std::make_move_iterator (items.end ()));
+        }
+    }
+    cond_.notify_one ();
+    items.clear ();
+}
+
+std::size_t
+Reclaimer::pending () const
+{
+    std::lock_guard <std::mutex> lock (mutex_);
+    return pending_;
+}
+
+void
+Reclaimer::run ()
+{
+    beast::Thread::setCurrentThreadName (name_);
+
+    std::unique_lock <std::mutex> lock (mutex_);
+    for (;;)
+    {
+        cond_.wait (lock, [this]
+        {
+            return stop_ || ! items_.empty ();
+        });
+
+        if (items_.empty ())
+            break;
+
+        std::vector <value_type> items;
+        items.swap (items_);
+
+        lock.unlock ();
+        auto const count = items.size ();
+        items.clear ();
+        lock.lock ();
+
+        pending_ -= count;
+    }
+}
+
+} // ripple
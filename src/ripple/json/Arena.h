@@ -0,0 +1,134 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_JSON_ARENA_H_INCLUDED
+#define RIPPLE_JSON_ARENA_H_INCLUDED
+
+#include <cstddef>
+#include <new>
+
+namespace Json {
+
+namespace detail {
+
+class ArenaBlocks;
+
+/** Allocate memory for a Json::Value.
+
+    The memory comes from the Arena active on the calling thread, if
+    there is one, and from the heap otherwise. It may be released on
+    any thread.
+*/
+void*
+allocate (std::size_t bytes);
+
+/** Release memory from allocate. */
+void
+deallocate (void* p) noexcept;
+
+/** Make an Arena's blocks current on the calling thread.
+
+    Returns the blocks which were current. A coroutine calls this when
+    it is resumed and when it yields, so that its Arena follows it from
+    thread to thread.
+*/
+ArenaBlocks*
+exchangeArena (ArenaBlocks* blocks) noexcept;
+
+/** A standard allocator over allocate and deallocate. */
+template <class T>
+class Allocator
+{
+public:
+    using value_type = T;
+
+    Allocator () = default;
+
+    template <class U>
+    Allocator (Allocator<U> const&) noexcept
+    {
+    }
+
+    T*
+    allocate (std::size_t n)
+    {
+        return static_cast<T*> (detail::allocate (n * sizeof (T)));
+    }
+
+    void
+    deallocate (T* p, std::size_t) noexcept
+    {
+        detail::deallocate (p);
+    }
+
+    template <class U>
+    bool
+    operator== (Allocator<U> const&) const noexcept
+    {
+        return true;
+    }
+
+    template <class U>
+    bool
+    operator!= (Allocator<U> const&) const noexcept
+    {
+        return false;
+    }
+};
+
+} // detail
+
+/** Memory for the Json::Value objects built on one thread.
+
+    While an Arena exists, the objects, arrays and strings of the
+    Json::Value trees built on the thread which created it are carved
+    out of large blocks instead of being allocated one at a time, and
+    releasing them costs almost nothing. A handler building a large
+    response puts an Arena on its stack.
+
+    Values may outlive the Arena, be moved to other threads and keep
+    changing there: each block stays allocated until every value in it
+    has been released. Values built on other threads, or after the
+    Arena is destroyed, use the heap.
+
+    Arenas nest; the innermost one is used. An Arena must be destroyed
+    on the thread or coroutine which created it. An Arena created on a
+    JobQueue coroutine may be held across a yield.
+*/
+class Arena
+{
+public:
+    Arena ();
+    ~Arena ();
+
+    Arena (Arena const&) = delete;
+    Arena& operator= (Arena const&) = delete;
+
+    /** Returns the number of bytes handed out so far. */
+    std::size_t
+    size () const;
+
+private:
+    detail::ArenaBlocks* blocks_;
+    detail::ArenaBlocks* previous_;
+};
+
+} // Json
+
+#endif
@@ -24,7 +24,9 @@
 #include <ripple/basics/ToString.h>
 #include <ripple/json/Output.h>
 #include <ripple/json/json_value.h>
+#include <cstdint>
 #include <memory>
+#include <type_traits>
 
 namespace Json {
 
@@ -156,7 +158,7 @@ public:
      *  literal, nullptr or Json::Value
      */
     template <typename Scalar>
-    void append (Scalar t)
+    void append (Scalar const& t)
     {
         rawAppend();
         output (t);
@@ -178,7 +180,7 @@ public:
      *  the tag you use has already been used in this object.
      */
     template <typename Type>
-    void set (std::string const& tag, Type t)
+    void set (std::string const& tag, Type const& t)
     {
         rawSet (tag);
         output (t);
@@ -212,11 +214,11 @@ public:
     /** Output a bool. */
     void output (bool);
 
-    /** Output numbers or booleans. */
+    /** Output numbers. */
     template <typename Type>
     void output (Type t)
     {
-        implOutput (std::to_string (t));
+        outputNumber (t, std::is_integral<Type> (), std::is_signed<Type> ());
     }
 
     void output (Json::StaticString const& t)
@@ -229,6 +231,28 @@ private:
     std::unique_ptr <Impl> impl_;
 
     void implOutput (std::string const&);
+    void outputInteger (std::uint64_t magnitude, bool negative);
+
+    template <typename Type>
+    void outputNumber (Type t, std::true_type, std::false_type)
+    {
+        outputInteger (t, false);
+    }
+
+    template <typename Type>
+    void outputNumber (Type t, std::true_type, std::true_type)
+    {
+        if (t < 0)
+            outputInteger (0 - static_cast<std::uint64_t> (t), true);
+        else
+            outputInteger (t, false);
+    }
+
+    template <typename Type, typename Signed>
+    void outputNumber (Type t, std::false_type, Signed)
+    {
+        implOutput (std::to_string (t));
+    }
 };
 
 inline void check (bool condition, std::string const& message)
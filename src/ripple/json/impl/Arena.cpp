@@ -0,0 +1,181 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/json/Arena.h>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+
+namespace Json {
+namespace detail {
+
+// Each allocation is preceded by a header naming the ArenaBlocks it
+// came from, or null if it came from the heap. The header keeps the
+// allocation aligned for anything a Json::Value holds, which is less
+// than malloc guarantees.
+union Header
+{
+    ArenaBlocks* owner;
+    double real;
+    std::int64_t integer;
+};
+
+/** The blocks of one Arena.
+
+    The Arena holds one reference and each live allocation holds
+    another. Only the thread which created the Arena allocates, but
+    allocations may be released from any thread.
+*/
+class ArenaBlocks
+{
+private:
+    struct Block
+    {
+        Block* next;
+        Header align;
+    };
+
+    static std::size_t constexpr blockSize = 64 * 1024;
+
+    std::atomic<std::size_t> refs_ {1};
+    Block* blocks_ = nullptr;
+    char* avail_ = nullptr;
+    char* limit_ = nullptr;
+    std::size_t used_ = 0;
+
+public:
+    // Allocations larger than this go to the heap.
+    static std::size_t constexpr maxSize = blockSize / 8;
+
+    ArenaBlocks () = default;
+    ArenaBlocks (ArenaBlocks const&) = delete;
+    ArenaBlocks& operator= (ArenaBlocks const&) = delete;
+
+    ~ArenaBlocks ()
+    {
+        while (blocks_)
+        {
+            auto const next = blocks_->next;
+            std::free (blocks_);
+            blocks_ = next;
+        }
+    }
+
+    std::size_t
+    size () const
+    {
+        return used_;
+    }
+
+    Header*
+    allocate (std::size_t bytes)
+    {
+        bytes = sizeof (Header) *
+            ((bytes + 2 * sizeof (Header) - 1) / sizeof (Header));
+        if (static_cast<std::size_t> (limit_ - avail_) < bytes)
+        {
+            auto const block = static_cast<Block*> (
+                std::malloc (sizeof (Block) + blockSize));
+            if (! block)
+                throw std::bad_alloc ();
+            block->next = blocks_;
+            blocks_ = block;
+            avail_ = reinterpret_cast<char*> (block + 1);
+            limit_ = avail_ + blockSize;
+        }
+        auto const h = reinterpret_cast<Header*> (avail_);
+        avail_ += bytes;
+        used_ += bytes;
+        h->owner = this;
+        ++refs_;
+        return h;
+    }
+
+    void
+    release ()
+    {
+        if (--refs_ == 0)
+            delete this;
+    }
+};
+
+// The innermost Arena of the calling thread or coroutine. The Arena
+// owns it.
+static thread_local ArenaBlocks* currentArena = nullptr;
+
+ArenaBlocks*
+exchangeArena (ArenaBlocks* blocks) noexcept
+{
+    auto const previous = currentArena;
+    currentArena = blocks;
+    return previous;
+}
+
+void*
+allocate (std::size_t bytes)
+{
+    auto const arena = currentArena;
+    if (arena && bytes <= ArenaBlocks::maxSize)
+        return arena->allocate (bytes) + 1;
+
+    auto const h = static_cast<Header*> (
+        std::malloc (sizeof (Header) + bytes));
+    if (! h)
+        throw std::bad_alloc ();
+    h->owner = nullptr;
+    return h + 1;
+}
+
+void
+deallocate (void* p) noexcept
+{
+    if (! p)
+        return;
+    auto const h = static_cast<Header*> (p) - 1;
+    if (h->owner)
+        h->owner->release ();
+    else
+        std::free (h);
+}
+
+} // detail
+
+Arena::Arena ()
+    : blocks_ (new detail::ArenaBlocks)
+    , previous_ (detail::exchangeArena (blocks_))
+{
+}
+
+Arena::~Arena ()
+{
+    auto const blocks = detail::exchangeArena (previous_);
+    assert (blocks == blocks_);
+    (void) blocks;
+    blocks_->release ();
+}
+
+std::size_t
+Arena::size () const
+{
+    return blocks_->size ();
+}
+
+} // Json
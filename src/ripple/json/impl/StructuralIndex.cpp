@@ -0,0 +1,252 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/json/impl/StructuralIndex.h>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RIPPLE_JSON_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace Json {
+namespace detail {
+
+namespace {
+
+// Bit i of each mask describes byte i of a 64 byte block
+struct BlockMasks
+{
+    std::uint64_t quote;
+    std::uint64_t backslash;
+    std::uint64_t space;
+    // A comment or a NUL
+    std::uint64_t special;
+};
+
+#if defined(__AVX2__)
+
+inline
+std::uint64_t
+match32 (__m256i v, char c)
+{
+    return static_cast<std::uint32_t> (
+        _mm256_movemask_epi8 (_mm256_cmpeq_epi8 (v, _mm256_set1_epi8 (c))));
+}
+
+inline
+BlockMasks
+classify (char const* p)
+{
+    BlockMasks m {};
+    for (int i = 0; i < 2; ++i)
+    {
+        auto const v = _mm256_loadu_si256 (
+            reinterpret_cast<__m256i const*> (p + 32 * i));
+        int const shift = 32 * i;
+        m.quote |= match32 (v, '"') << shift;
+        m.backslash |= match32 (v, '\\') << shift;
+        m.space |= (match32 (v, ' ') | match32 (v, '\t') |
+            match32 (v, '\n') | match32 (v, '\r')) << shift;
+        m.special |= (match32 (v, '/') | match32 (v, 0)) << shift;
+    }
+    return m;
+}
+
+#elif defined(RIPPLE_JSON_SSE2)
+
+inline
+std::uint64_t
+match16 (__m128i v, char c)
+{
+    return static_cast<std::uint16_t> (
+        _mm_movemask_epi8 (_mm_cmpeq_epi8 (v, _mm_set1_epi8 (c))));
+}
+
+inline
+BlockMasks
+classify (char const* p)
+{
+    BlockMasks m {};
+    for (int i = 0; i < 4; ++i)
+    {
+        auto const v = _mm_loadu_si128 (
+            reinterpret_cast<__m128i const*> (p + 16 * i));
+        int const shift = 16 * i;
+        m.quote |= match16 (v, '"') << shift;
+        m.backslash |= match16 (v, '\\') << shift;
+        m.space |= (match16 (v, ' ') | match16 (v, '\t') |
+            match16 (v, '\n') | match16 (v, '\r')) << shift;
+        m.special |= (match16 (v, '/') | match16 (v, 0)) << shift;
+    }
+    return m;
+}
+
+#else
+
+inline
+BlockMasks
+classify (char const* p)
+{
+    BlockMasks m {};
+    for (int i = 0; i < 64; ++i)
+    {
+        std::uint64_t const bit = std::uint64_t (1) << i;
+        switch (p[i])
+        {
+        case '"':  m.quote |= bit; break;
+        case '\\': m.backslash |= bit; break;
+        case ' ':
+        case '\t':
+        case '\n':
+        case '\r': m.space |= bit; break;
+        case '/':
+        case 0:    m.special |= bit; break;
+        default:   break;
+        }
+    }
+    return m;
+}
+
+#endif
+
+inline
+int
+lowestBit (std::uint64_t x)
+{
+#ifdef _MSC_VER
+    unsigned long i;
+    _BitScanForward64 (&i, x);
+    return static_cast<int> (i);
+#else
+    return __builtin_ctzll (x);
+#endif
+}
+
+// Bit i of the result is the parity of bits 0 through i
+inline
+std::uint64_t
+prefixXor (std::uint64_t x)
+{
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+} // namespace
+
+bool
+buildStructuralIndex (char const* begin, char const* end,
+    std::vector<std::uint32_t>& index)
+{
+    index.clear ();
+
+    auto const size = static_cast<std::size_t> (end - begin);
+    if (size >= closingQuote)
+        return false;
+    index.reserve (size / 8);
+
+    // State carried from one block to the next
+    std::uint64_t inStringCarry = 0;
+    std::uint64_t spaceCarry = 0;
+    bool escapedCarry = false;
+
+    char padded[64];
+    for (std::size_t offset = 0; offset < size; offset += 64)
+    {
+        char const* block = begin + offset;
+        if (size - offset < 64)
+        {
+            std::memset (padded, ' ', sizeof (padded));
+            std::memcpy (padded, block, size - offset);
+            block = padded;
+        }
+
+        auto const m = classify (block);
+
+        // Each backslash escapes the next character, unless it is
+        // itself escaped. Backslashes are rare, so walk them.
+        std::uint64_t escaped = 0;
+        std::uint64_t backslash = m.backslash;
+        if (escapedCarry)
+        {
+            escaped = 1;
+            backslash &= ~std::uint64_t (1);
+        }
+        escapedCarry = false;
+        while (backslash != 0)
+        {
+            int const i = lowestBit (backslash);
+            backslash &= backslash - 1;
+            if (i == 63)
+            {
+                escapedCarry = true;
+            }
+            else
+            {
+                std::uint64_t const next = std::uint64_t (1) << (i + 1);
+                escaped |= next;
+                backslash &= ~next;
+            }
+        }
+
+        // Strings run from an opening quote up to, but not including,
+        // the closing quote
+        auto const quote = m.quote & ~escaped;
+        auto const inString = prefixXor (quote) ^ inStringCarry;
+        inStringCarry = 0 - (inString >> 63);
+
+        if ((m.special & ~inString) != 0)
+            return false;
+
+        auto const afterSpace = (m.space << 1) | spaceCarry;
+        spaceCarry = m.space >> 63;
+
+        auto const closing = quote & ~inString;
+        auto bits = quote |
+            (afterSpace & ~m.space & ~inString);
+
+        while (bits != 0)
+        {
+            int const i = lowestBit (bits);
+            bits &= bits - 1;
+            auto entry = static_cast<std::uint32_t> (offset + i);
+            if ((closing >> i) & 1)
+                entry |= closingQuote;
+            index.push_back (entry);
+        }
+    }
+
+    return inStringCarry == 0;
+}
+
+} // detail
+} // Json
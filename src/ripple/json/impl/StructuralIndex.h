@@ -0,0 +1,54 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_JSON_STRUCTURALINDEX_H_INCLUDED
+#define RIPPLE_JSON_STRUCTURALINDEX_H_INCLUDED
+
+#include <cstdint>
+#include <vector>
+
+namespace Json {
+namespace detail {
+
+/** Set on index entries which are the closing quote of a string. */
+std::uint32_t constexpr closingQuote = 0x80000000;
+
+/** Build the structural index of a JSON document.
+
+    The document is classified 64 bytes at a time, using SSE2 or
+    AVX2 where the compiler targets them. The index holds, in
+    order, the offset of every quote which delimits a string, and
+    of every other character outside a string which follows
+    whitespace. Closing quotes are marked with closingQuote.
+
+    With the index, a reader can step over whitespace and strings
+    without looking at each character.
+
+    @return `false` if the document cannot be indexed: it contains
+            a comment or a NUL outside of a string, ends inside a
+            string, or is 2GB or larger.
+*/
+bool
+buildStructuralIndex (char const* begin, char const* end,
+    std::vector<std::uint32_t>& index);
+
+} // detail
+} // Json
+
+#endif
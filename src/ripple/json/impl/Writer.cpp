@@ -20,25 +20,134 @@
 #include <BeastConfig.h>
 #include <ripple/json/Output.h>
 #include <ripple/json/Writer.h>
+#include <array>
+#include <cstring>
 #include <stack>
 #include <set>
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RIPPLE_JSON_WRITER_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 namespace Json {
 
 namespace {
 
-std::map <char, const char*> jsonSpecialCharacterEscape = {
-    {'"',  "\\\""},
-    {'\\', "\\\\"},
-    {'/',  "\\/"},
-    {'\b', "\\b"},
-    {'\f', "\\f"},
-    {'\n', "\\n"},
-    {'\r', "\\r"},
-    {'\t', "\\t"}
-};
+// The escape sequence for each character, or null if it is written as is.
+// Strings are escaped as FastWriter escapes them, so that a streamed
+// object matches the to_string of the same Json::Value: '/' is written
+// as is, and the other control characters as \u escapes.
+std::array <char const*, 256> const jsonSpecialCharacterEscape = []
+{
+    static char const hex[] = "0123456789ABCDEF";
+    static char controls[0x20][7];
+
+    std::array <char const*, 256> escapes {};
+    for (int c = 1; c < 0x20; ++c)
+    {
+        auto& e = controls[c];
+        std::memcpy (e, "\\u00", 4);
+        e[4] = hex[c >> 4];
+        e[5] = hex[c & 0xf];
+        e[6] = 0;
+        escapes[c] = e;
+    }
+    escapes['"'] = "\\\"";
+    escapes['\\'] = "\\\\";
+    escapes['\b'] = "\\b";
+    escapes['\f'] = "\\f";
+    escapes['\n'] = "\\n";
+    escapes['\r'] = "\\r";
+    escapes['\t'] = "\\t";
+    return escapes;
+}();
+
+inline
+bool
+mayNeedEscape (char c)
+{
+    return c == '"' || c == '\\' ||
+        static_cast<unsigned char> (c) < 0x20;
+}
+
+// Returns the position of the first character at or after position which
+// might need to be escaped, or size if there is none. The characters are
+// checked sixteen at a time where SSE2 is available.
+std::size_t
+findEscape (char const* data, std::size_t position, std::size_t size)
+{
+#ifdef RIPPLE_JSON_WRITER_SSE2
+    auto const quotes = _mm_set1_epi8 ('"');
+    auto const backslashes = _mm_set1_epi8 ('\\');
+    auto const controls = _mm_set1_epi8 (0x1f);
+
+    for (; position + 16 <= size; position += 16)
+    {
+        auto const v = _mm_loadu_si128 (
+            reinterpret_cast<__m128i const*> (data + position));
+        auto const m = _mm_or_si128 (
+            _mm_or_si128 (_mm_cmpeq_epi8 (v, quotes),
+                _mm_cmpeq_epi8 (v, backslashes)),
+            _mm_cmpeq_epi8 (_mm_max_epu8 (v, controls), controls));
+        if (auto const bits = static_cast<unsigned> (_mm_movemask_epi8 (m)))
+        {
+#ifdef _MSC_VER
+            unsigned long i;
+            _BitScanForward (&i, bits);
+            return position + i;
+#else
+            return position + __builtin_ctz (bits);
+#endif
+        }
+    }
+#endif
+
+    for (; position < size; ++position)
+    {
+        if (mayNeedEscape (data[position]))
+            break;
+    }
+    return position;
+}
+
+// Writes the decimal digits of value so that they end at end, and returns
+// where they start. Two digits are produced at a time.
+char*
+formatDecimal (char* end, std::uint64_t value)
+{
+    static char const digits[] =
+        "0001020304050607080910111213141516171819"
+        "2021222324252627282930313233343536373839"
+        "4041424344454647484950515253545556575859"
+        "6061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+
+    while (value >= 100)
+    {
+        auto const i = (value % 100) * 2;
+        value /= 100;
+        *--end = digits[i + 1];
+        *--end = digits[i];
+    }
 
-static size_t const jsonEscapeLength = 2;
+    if (value >= 10)
+    {
+        auto const i = value * 2;
+        *--end = digits[i + 1];
+        *--end = digits[i];
+    }
+    else
+    {
+        *--end = static_cast<char> ('0' + value);
+    }
+    return end;
+}
 
 // All other JSON punctuation.
 const char closeBrace = '}';
@@ -106,18 +215,21 @@ public:
 
         output_ ({&quote, 1});
         auto data = bytes.data();
-        for (; position < bytes.size(); ++position)
+        auto const size = bytes.size();
+        while ((position = findEscape (data, position, size)) < size)
         {
-            auto i = jsonSpecialCharacterEscape.find (data[position]);
-            if (i != jsonSpecialCharacterEscape.end ())
+            auto escape = jsonSpecialCharacterEscape[
+                static_cast<unsigned char> (data[position])];
+            if (escape)
             {
                 if (writtenUntil < position)
                 {
                     output_ ({data + writtenUntil, position - writtenUntil});
                 }
-                output_ ({i->second, jsonEscapeLength});
+                output_ ({escape, std::strlen (escape)});
                 writtenUntil = position + 1;
-            };
+            }
+            ++position;
         }
         if (writtenUntil < position)
             output_ ({data + writtenUntil, position - writtenUntil});
@@ -275,6 +387,16 @@ void Writer::implOutput (std::string const& s)
     impl_->output (s);
 }
 
+void Writer::outputInteger (std::uint64_t magnitude, bool negative)
+{
+    char buffer[24];
+    auto const end = buffer + sizeof (buffer);
+    auto begin = formatDecimal (end, magnitude);
+    if (negative)
+        *--begin = '-';
+    impl_->output ({begin, static_cast<std::size_t> (end - begin)});
+}
+
 void Writer::finishAll ()
 {
     if (impl_)
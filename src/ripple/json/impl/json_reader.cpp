@@ -20,9 +20,11 @@
 #include <BeastConfig.h>
 #include <ripple/basics/contract.h>
 #include <ripple/json/json_reader.h>
+#include <ripple/json/impl/StructuralIndex.h>
 #include <algorithm>
 #include <string>
 #include <cctype>
+#include <cstring>
 
 namespace Json
 {
@@ -72,6 +74,14 @@ codePointToUTF8 (unsigned int cp)
 // //////////////////////////////////////////////////////////////////
 
 Reader::Reader ()
+    : Reader (true)
+{
+}
+
+Reader::Reader (bool indexed)
+    : useIndex_ (indexed)
+    , indexed_ (false)
+    , next_ (0)
 {
 }
 
@@ -109,7 +119,32 @@ Reader::parse ( const char* beginDoc, const char* endDoc,
 {
     begin_ = beginDoc;
     end_ = endDoc;
+
+    if ( useIndex_  &&
+         detail::buildStructuralIndex ( beginDoc, endDoc, index_ ) )
+    {
+        indexed_ = true;
+        Value value;
+        bool const successful = readDocument ( value );
+        indexed_ = false;
+
+        if ( successful )
+        {
+            root.swap ( value );
+            return true;
+        }
+
+        // Scan again, so that errors are reported as they always were
+    }
+
+    return readDocument ( root );
+}
+
+bool
+Reader::readDocument ( Value& root )
+{
     current_ = begin_;
+    next_ = 0;
     lastValueEnd_ = 0;
     lastValue_ = 0;
     errors_.clear ();
@@ -127,8 +162,8 @@ Reader::parse ( const char* beginDoc, const char* endDoc,
     {
         // Set error location to start of doc, ideally should be first token found in doc
         token.type_ = tokenError;
-        token.start_ = beginDoc;
-        token.end_ = endDoc;
+        token.start_ = begin_;
+        token.end_ = end_;
         addError ( "A valid JSON document must be either an array or an object value.",
                    token );
         return false;
@@ -237,7 +272,7 @@ Reader::readToken ( Token& token )
 
     case '"':
         token.type_ = tokenString;
-        ok = readString ();
+        ok = indexed_ ? skipIndexedString () : readString ();
         break;
 
     case '/':
@@ -302,6 +337,32 @@ Reader::readToken ( Token& token )
 void
 Reader::skipSpaces ()
 {
+    if ( indexed_ )
+    {
+        if ( current_ == end_ )
+            return;
+
+        Char c = *current_;
+
+        if ( c != ' '  &&  c != '\t'  &&  c != '\r'  &&  c != '\n' )
+            return;
+
+        // The next character which is not a space follows a space,
+        // so it is the next entry in the index.
+        auto const offset = static_cast<std::uint32_t> ( current_ - begin_ );
+
+        while ( next_ != index_.size ()  &&
+                ( index_[next_] & ~detail::closingQuote ) < offset )
+            ++next_;
+
+        if ( next_ == index_.size () )
+            current_ = end_;
+        else
+            current_ = begin_ + ( index_[next_] & ~detail::closingQuote );
+
+        return;
+    }
+
     while ( current_ != end_ )
     {
         Char c = *current_;
@@ -426,6 +487,27 @@ Reader::readString ()
 }
 
 
+bool
+Reader::skipIndexedString ()
+{
+    // The opening quote has been consumed
+    auto const offset = static_cast<std::uint32_t> ( current_ - 1 - begin_ );
+
+    while ( next_ != index_.size ()  &&
+            ( index_[next_] & ~detail::closingQuote ) < offset )
+        ++next_;
+
+    if ( next_ + 1 >= index_.size ()  ||
+         index_[next_] != offset  ||
+         ( index_[next_ + 1] & detail::closingQuote ) == 0 )
+        return false;
+
+    current_ = begin_ + ( index_[next_ + 1] & ~detail::closingQuote ) + 1;
+    next_ += 2;
+    return true;
+}
+
+
 bool
 Reader::readObject ( Token& tokenStart )
 {
@@ -683,6 +765,13 @@ Reader::decodeString ( Token& token, std::string& decoded )
     Location current = token.start_ + 1; // skip '"'
     Location end = token.end_ - 1;      // do not include '"'
 
+    // Without escapes, the string is its own decoding
+    if ( std::memchr ( current, '\\', end - current ) == nullptr )
+    {
+        decoded.append ( current, end );
+        return true;
+    }
+
     while ( current != end )
     {
         Char c = *current++;
@@ -23,6 +23,7 @@
 #include <ripple/json/to_string.h>
 #include <ripple/json/json_writer.h>
 #include <ripple/beast/core/LexicalCast.h>
+#include <algorithm>
 
 namespace Json {
 
@@ -62,7 +63,7 @@ public:
         if ( length == unknown )
             length = (unsigned int)strlen (value);
 
-        char* newString = static_cast<char*> ( malloc ( length + 1 ) );
+        char* newString = static_cast<char*> ( detail::allocate ( length + 1 ) );
         memcpy ( newString, value, length );
         newString[length] = 0;
         return newString;
@@ -70,8 +71,7 @@ public:
 
     virtual void releaseStringValue ( char* value )
     {
-        if ( value )
-            free ( value );
+        detail::deallocate ( value );
     }
 };
 
@@ -122,6 +122,13 @@ Value::CZString::CZString ( const CZString& other )
 {
 }
 
+Value::CZString::CZString ( CZString&& other ) noexcept
+    : cstr_ ( other.cstr_ )
+    , index_ ( other.index_ )
+{
+    other.cstr_ = 0;
+}
+
 Value::CZString::~CZString ()
 {
     if ( cstr_  &&  index_ == duplicate )
@@ -143,6 +150,13 @@ Value::CZString::operator = ( const CZString& other )
     return *this;
 }
 
+Value::CZString&
+Value::CZString::operator = ( CZString&& other ) noexcept
+{
+    swap ( other );
+    return *this;
+}
+
 bool
 Value::CZString::operator< ( const CZString& other ) const
 {
@@ -181,6 +195,368 @@ Value::CZString::isStaticString () const
     return index_ == noDuplication;
 }
 
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+// class Value::ObjectValues
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+// //////////////////////////////////////////////////////////////////
+
+// The member Values are carved out of a list of chunks, each twice the
+// size of the last, so that they never move. Erased slots are reused.
+struct alignas (Value) Value::ObjectValues::Chunk
+{
+    Chunk* next;
+};
+
+// Sizes of the chunks, in Values
+static std::size_t const minChunk = 4;
+static std::size_t const maxChunk = 1024;
+
+// Objects at least this large which are not built in key order keep
+// their members in a tree.
+static std::size_t const treeSize = 256;
+
+Value::ObjectValues::ObjectValues ( ObjectValues const& other )
+{
+    auto const n = other.size ();
+
+    if ( n == 0 )
+        return;
+
+    try
+    {
+        grow ( n );
+
+        if ( other.tree_ )
+        {
+            makeTree ();
+
+            for ( auto const& member : *other.tree_ )
+            {
+                Value* value = makeValue ();
+
+                try
+                {
+                    tree_->emplace_hint ( tree_->end (), member.first, value );
+                }
+                catch (...)
+                {
+                    freeValue ( value );
+                    throw;
+                }
+
+                *value = *member.second;
+            }
+        }
+        else
+        {
+            entries_.reserve ( n );
+
+            for ( auto const& entry : other.entries_ )
+            {
+                Entry copy { entry.key, makeValue () };
+                entries_.push_back ( std::move ( copy ) );
+                *entries_.back ().value = *entry.value;
+            }
+        }
+    }
+    catch (...)
+    {
+        clear ();
+        throw;
+    }
+}
+
+Value::ObjectValues::~ObjectValues ()
+{
+    clear ();
+}
+
+void*
+Value::ObjectValues::operator new ( std::size_t bytes )
+{
+    return detail::allocate ( bytes );
+}
+
+void
+Value::ObjectValues::operator delete ( void* p ) noexcept
+{
+    detail::deallocate ( p );
+}
+
+Value::ObjectValues::Entries::iterator
+Value::ObjectValues::lowerBound ( CZString const& key ) const
+{
+    auto& entries = const_cast<Entries&> ( entries_ );
+
+    // Arrays are usually dense, so the element is where its index says.
+    if ( ! key.c_str () )
+    {
+        auto const index = static_cast<std::size_t> ( key.index () );
+
+        if ( index < entries.size ()  &&  entries[index].key.index () == key.index () )
+            return entries.begin () + index;
+    }
+
+    return std::lower_bound ( entries.begin (), entries.end (), key,
+        [] ( Entry const& entry, CZString const& k )
+        {
+            return entry.key < k;
+        });
+}
+
+Value*
+Value::ObjectValues::find ( CZString const& key ) const
+{
+    if ( tree_ )
+    {
+        auto const it = tree_->find ( key );
+        return it == tree_->end () ? nullptr : it->second;
+    }
+
+    auto const it = lowerBound ( key );
+
+    if ( it == entries_.end ()  ||  ! ( it->key == key ) )
+        return nullptr;
+
+    return it->value;
+}
+
+Value&
+Value::ObjectValues::insert ( CZString const& key )
+{
+    if ( tree_ )
+    {
+        auto it = tree_->lower_bound ( key );
+
+        if ( it != tree_->end ()  &&  it->first == key )
+            return *it->second;
+
+        Value* value = makeValue ();
+
+        try
+        {
+            tree_->emplace_hint ( it, key, value );
+        }
+        catch (...)
+        {
+            freeValue ( value );
+            throw;
+        }
+
+        return *value;
+    }
+
+    // Members are usually added in order.
+    auto it = entries_.end ();
+
+    if ( ! entries_.empty ()  &&  ! ( entries_.back ().key < key ) )
+    {
+        it = lowerBound ( key );
+
+        if ( it->key == key )
+            return *it->value;
+
+        if ( entries_.size () >= treeSize )
+        {
+            makeTree ();
+            return insert ( key );
+        }
+    }
+
+    Entry entry { key, makeValue () };
+
+    try
+    {
+        entries_.insert ( it, std::move ( entry ) );
+    }
+    catch (...)
+    {
+        freeValue ( entry.value );
+        throw;
+    }
+
+    return *entry.value;
+}
+
+bool
+Value::ObjectValues::erase ( CZString const& key, Value& removed )
+{
+    if ( tree_ )
+    {
+        auto const it = tree_->find ( key );
+
+        if ( it == tree_->end () )
+            return false;
+
+        removed = std::move ( *it->second );
+        freeValue ( it->second );
+        tree_->erase ( it );
+        return true;
+    }
+
+    auto const it = lowerBound ( key );
+
+    if ( it == entries_.end ()  ||  ! ( it->key == key ) )
+        return false;
+
+    removed = std::move ( *it->value );
+    freeValue ( it->value );
+    entries_.erase ( it );
+    return true;
+}
+
+void
+Value::ObjectValues::truncate ( UInt size )
+{
+    CZString const key ( size );
+
+    if ( tree_ )
+    {
+        for ( auto it = tree_->lower_bound ( key ); it != tree_->end (); )
+        {
+            freeValue ( it->second );
+            it = tree_->erase ( it );
+        }
+
+        return;
+    }
+
+    auto const first = lowerBound ( key );
+
+    for ( auto it = first; it != entries_.end (); ++it )
+        freeValue ( it->value );
+
+    entries_.erase ( first, entries_.end () );
+}
+
+void
+Value::ObjectValues::clear ()
+{
+    if ( tree_ )
+    {
+        for ( auto const& member : *tree_ )
+            member.second->~Value ();
+
+        tree_->~Tree ();
+        detail::deallocate ( tree_ );
+        tree_ = nullptr;
+    }
+
+    for ( auto const& entry : entries_ )
+        entry.value->~Value ();
+
+    Entries ().swap ( entries_ );
+
+    while ( chunks_ )
+    {
+        Chunk* next = chunks_->next;
+        detail::deallocate ( chunks_ );
+        chunks_ = next;
+    }
+
+    avail_ = limit_ = free_ = nullptr;
+    capacity_ = 0;
+}
+
+void
+Value::ObjectValues::grow ( std::size_t n )
+{
+    auto const chunk = static_cast<Chunk*> (
+        detail::allocate ( sizeof ( Chunk ) + n * sizeof ( Value ) ) );
+    chunk->next = chunks_;
+    chunks_ = chunk;
+    avail_ = reinterpret_cast<Value*> ( chunk + 1 );
+    limit_ = avail_ + n;
+    capacity_ += n;
+}
+
+Value*
+Value::ObjectValues::makeValue ()
+{
+    if ( free_ )
+    {
+        Value* value = free_;
+        free_ = *reinterpret_cast<Value**> ( value );
+        return new ( value ) Value;
+    }
+
+    if ( avail_ == limit_ )
+        grow ( std::min ( std::max ( capacity_, minChunk ), maxChunk ) );
+
+    return new ( avail_++ ) Value;
+}
+
+void
+Value::ObjectValues::freeValue ( Value* value )
+{
+    value->~Value ();
+    *reinterpret_cast<Value**> ( value ) = free_;
+    free_ = value;
+}
+
+void
+Value::ObjectValues::makeTree ()
+{
+    auto const tree = new ( detail::allocate ( sizeof ( Tree ) ) ) Tree;
+
+    try
+    {
+        for ( auto const& entry : entries_ )
+            tree->emplace_hint ( tree->end (), entry.key, entry.value );
+    }
+    catch (...)
+    {
+        tree->~Tree ();
+        detail::deallocate ( tree );
+        throw;
+    }
+
+    Entries ().swap ( entries_ );
+    tree_ = tree;
+}
+
+bool operator== ( Value::ObjectValues const& x, Value::ObjectValues const& y )
+{
+    if ( x.size () != y.size () )
+        return false;
+
+    for ( auto i = x.begin (), j = y.begin (), end = x.end (); i != end; ++i, ++j )
+    {
+        if ( ! ( i.key () == j.key () )  ||  i.value () != j.value () )
+            return false;
+    }
+
+    return true;
+}
+
+bool operator< ( Value::ObjectValues const& x, Value::ObjectValues const& y )
+{
+    auto i = x.begin ();
+    auto j = y.begin ();
+    auto const xEnd = x.end ();
+    auto const yEnd = y.end ();
+
+    for ( ; i != xEnd  &&  j != yEnd; ++i, ++j )
+    {
+        if ( i.key () < j.key () )
+            return true;
+
+        if ( j.key () < i.key () )
+            return false;
+
+        if ( i.value () < j.value () )
+            return true;
+
+        if ( j.value () < i.value () )
+            return false;
+    }
+
+    return i == xEnd  &&  j != yEnd;
+}
+
 // //////////////////////////////////////////////////////////////////
 // //////////////////////////////////////////////////////////////////
 // //////////////////////////////////////////////////////////////////
@@ -756,9 +1132,9 @@ Value::size () const
     case arrayValue:  // size of the array is highest index + 1
         if ( !value_.map_->empty () )
         {
-            ObjectValues::const_iterator itLast = value_.map_->end ();
+            auto itLast = value_.map_->end ();
             --itLast;
-            return (*itLast).first.index () + 1;
+            return itLast.key ().index () + 1;
         }
 
         return 0;
@@ -821,9 +1197,7 @@ Value::resize ( UInt newSize )
         (*this)[ newSize - 1 ];
     else
     {
-        for ( UInt index = newSize; index < oldSize; ++index )
-            value_.map_->erase ( index );
-
+        value_.map_->truncate ( newSize );
         assert ( size () == newSize );
     }
 }
@@ -837,15 +1211,7 @@ Value::operator[] ( UInt index )
     if ( type_ == nullValue )
         *this = Value ( arrayValue );
 
-    CZString key ( index );
-    ObjectValues::iterator it = value_.map_->lower_bound ( key );
-
-    if ( it != value_.map_->end ()  &&  (*it).first == key )
-        return (*it).second;
-
-    ObjectValues::value_type defaultValue ( key, null );
-    it = value_.map_->insert ( it, defaultValue );
-    return (*it).second;
+    return value_.map_->insert ( CZString ( index ) );
 }
 
 
@@ -857,13 +1223,8 @@ Value::operator[] ( UInt index ) const
     if ( type_ == nullValue )
         return null;
 
-    CZString key ( index );
-    ObjectValues::const_iterator it = value_.map_->find ( key );
-
-    if ( it == value_.map_->end () )
-        return null;
-
-    return (*it).second;
+    const Value* value = value_.map_->find ( CZString ( index ) );
+    return value ? *value : null;
 }
 
 
@@ -885,15 +1246,7 @@ Value::resolveReference ( const char* key,
 
     CZString actualKey ( key, isStatic ? CZString::noDuplication
                          : CZString::duplicateOnCopy );
-    ObjectValues::iterator it = value_.map_->lower_bound ( actualKey );
-
-    if ( it != value_.map_->end ()  &&  (*it).first == actualKey )
-        return (*it).second;
-
-    ObjectValues::value_type defaultValue ( actualKey, null );
-    it = value_.map_->insert ( it, defaultValue );
-    Value& value = (*it).second;
-    return value;
+    return value_.map_->insert ( actualKey );
 }
 
 
@@ -923,12 +1276,8 @@ Value::operator[] ( const char* key ) const
         return null;
 
     CZString actualKey ( key, CZString::noDuplication );
-    ObjectValues::const_iterator it = value_.map_->find ( actualKey );
-
-    if ( it == value_.map_->end () )
-        return null;
-
-    return (*it).second;
+    const Value* value = value_.map_->find ( actualKey );
+    return value ? *value : null;
 }
 
 
@@ -983,13 +1332,11 @@ Value::removeMember ( const char* key )
         return null;
 
     CZString actualKey ( key, CZString::noDuplication );
-    ObjectValues::iterator it = value_.map_->find ( actualKey );
+    Value old;
 
-    if ( it == value_.map_->end () )
+    if ( ! value_.map_->erase ( actualKey, old ) )
         return null;
 
-    Value old (it->second);
-    value_.map_->erase (it);
     return old;
 }
 
@@ -1027,11 +1374,11 @@ Value::getMemberNames () const
 
     Members members;
     members.reserve ( value_.map_->size () );
-    ObjectValues::const_iterator it = value_.map_->begin ();
-    ObjectValues::const_iterator itEnd = value_.map_->end ();
+    auto it = value_.map_->begin ();
+    auto const itEnd = value_.map_->end ();
 
     for ( ; it != itEnd; ++it )
-        members.push_back ( std::string ( (*it).first.c_str () ) );
+        members.push_back ( std::string ( it.key ().c_str () ) );
 
     return members;
 }
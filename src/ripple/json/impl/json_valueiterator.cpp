@@ -46,7 +46,7 @@ ValueIteratorBase::ValueIteratorBase ( const Value::ObjectValues::iterator& curr
 Value&
 ValueIteratorBase::deref () const
 {
-    return current_->second;
+    return current_.value ();
 }
 
 
@@ -69,8 +69,8 @@ ValueIteratorBase::computeDistance ( const SelfType& other ) const
 {
     // Iterator for null value are initialized using the default
     // constructor, which initialize current_ to the default
-    // std::map::iterator. As begin() and end() are two instance
-    // of the default std::map::iterator, they can not be compared.
+    // ObjectValues::iterator. As begin() and end() are two instance
+    // of the default iterator, they can not be compared.
     // To allow this, we handle this comparison specifically.
     if ( isNull_  &&  other.isNull_ )
     {
@@ -115,7 +115,7 @@ ValueIteratorBase::copy ( const SelfType& other )
 Value
 ValueIteratorBase::key () const
 {
-    const Value::CZString czstring = (*current_).first;
+    const Value::CZString& czstring = current_.key ();
 
     if ( czstring.c_str () )
     {
@@ -132,7 +132,7 @@ ValueIteratorBase::key () const
 UInt
 ValueIteratorBase::index () const
 {
-    const Value::CZString czstring = (*current_).first;
+    const Value::CZString& czstring = current_.key ();
 
     if ( !czstring.c_str () )
         return czstring.index ();
@@ -144,7 +144,7 @@ ValueIteratorBase::index () const
 const char*
 ValueIteratorBase::memberName () const
 {
-    const char* name = (*current_).first.c_str ();
+    const char* name = current_.key ().c_str ();
     return name ? name : "";
 }
 
@@ -25,7 +25,9 @@
 #include <ripple/json/json_forwards.h>
 #include <ripple/json/json_value.h>
 #include <boost/asio/buffer.hpp>
+#include <cstdint>
 #include <stack>
+#include <vector>
 
 namespace Json
 {
@@ -44,6 +46,14 @@ public:
      */
     Reader ();
 
+    /** \brief Constructs a Reader allowing all features
+     * for parsing.
+     * \param indexed If \c false, documents are always scanned one
+     *                character at a time instead of through a
+     *                structural index.
+     */
+    explicit Reader (bool indexed);
+
     /** \brief Read a Value from a <a HREF="http://www.json.org">JSON</a> document.
      * \param document UTF-8 encoded string containing the document to read.
      * \param root [out] Contains the root value of the document if it was
@@ -119,6 +129,7 @@ private:
 
     using Errors = std::deque<ErrorInfo>;
 
+    bool readDocument ( Value& root );
     bool expectToken ( TokenType type, Token& token, const char* message );
     bool readToken ( Token& token );
     void skipSpaces ();
@@ -128,6 +139,7 @@ private:
     bool readCStyleComment ();
     bool readCppStyleComment ();
     bool readString ();
+    bool skipIndexedString ();
     Reader::TokenType readNumber ();
     bool readValue ();
     bool readObject ( Token& token );
@@ -169,6 +181,13 @@ private:
     Location current_;
     Location lastValueEnd_;
     Value* lastValue_;
+
+    // Offsets of the strings and tokens in the document,
+    // from detail::buildStructuralIndex
+    bool const useIndex_;
+    bool indexed_;
+    std::vector<std::uint32_t> index_;
+    std::size_t next_;
 };
 
 template<class BufferSequence>
@@ -176,11 +195,12 @@ bool
 Reader::parse(Value& root, BufferSequence const& bs)
 {
     using namespace boost::asio;
-    std::string s;
-    s.reserve (buffer_size(bs));
+    // Gather the buffers straight into the copy the reader keeps
+    document_.clear();
+    document_.reserve (buffer_size(bs));
     for (auto const& b : bs)
-        s.append(buffer_cast<char const*>(b), buffer_size(b));
-    return parse(s, root);
+        document_.append(buffer_cast<char const*>(b), buffer_size(b));
+    return parse(document_.data(), document_.data() + document_.size(), root);
 }
 
 /** \brief Read from 'sin' into 'root'.
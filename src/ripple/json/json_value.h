@@ -21,6 +21,7 @@
 #define RIPPLE_JSON_JSON_VALUE_H_INCLUDED
 
 #include <ripple/json/json_forwards.h>
+#include <ripple/json/Arena.h>
 #include <cstring>
 #include <functional>
 #include <map>
@@ -179,8 +180,10 @@ private:
         CZString ( int index );
         CZString ( const char* cstr, DuplicationPolicy allocate );
         CZString ( const CZString& other );
+        CZString ( CZString&& other ) noexcept;
         ~CZString ();
         CZString& operator = ( const CZString& other );
+        CZString& operator = ( CZString&& other ) noexcept;
         bool operator< ( const CZString& other ) const;
         bool operator== ( const CZString& other ) const;
         int index () const;
@@ -193,7 +196,7 @@ private:
     };
 
 public:
-    using ObjectValues = std::map<CZString, Value>;
+    class ObjectValues;
 
 public:
     /** \brief Create a default Value of the given type.
@@ -391,6 +394,178 @@ private:
     int allocated_ : 1;     // Notes: if declared as bool, bitfield is useless.
 };
 
+/** \internal The members of an object or the elements of an array.
+
+    Members are kept in a vector sorted by key, so that small objects
+    cost a few allocations rather than one per member. Once an object
+    grows large and is not being built in key order, the members move
+    to a tree so that inserting stays logarithmic.
+
+    The member Values themselves never move: references to them stay
+    valid until the member is removed.
+*/
+class Value::ObjectValues
+{
+private:
+    struct Entry
+    {
+        CZString key;
+        Value* value;
+    };
+
+    using Entries = std::vector<Entry, detail::Allocator<Entry>>;
+    using Tree = std::map<CZString, Value*, std::less<CZString>,
+        detail::Allocator<std::pair<CZString const, Value*>>>;
+
+    struct Chunk;
+
+public:
+    class iterator
+    {
+    public:
+        iterator () = default;
+
+        CZString const&
+        key () const
+        {
+            return inTree_ ? node_->first : entry_->key;
+        }
+
+        Value&
+        value () const
+        {
+            return inTree_ ? *node_->second : *entry_->value;
+        }
+
+        iterator&
+        operator++ ()
+        {
+            if (inTree_)
+                ++node_;
+            else
+                ++entry_;
+            return *this;
+        }
+
+        iterator&
+        operator-- ()
+        {
+            if (inTree_)
+                --node_;
+            else
+                --entry_;
+            return *this;
+        }
+
+        bool
+        operator== (iterator const& other) const
+        {
+            return inTree_ ? node_ == other.node_ : entry_ == other.entry_;
+        }
+
+        bool
+        operator!= (iterator const& other) const
+        {
+            return ! (*this == other);
+        }
+
+    private:
+        friend class ObjectValues;
+
+        explicit
+        iterator (Entry const* entry)
+            : entry_ (entry)
+        {
+        }
+
+        explicit
+        iterator (Tree::const_iterator node)
+            : inTree_ (true)
+            , node_ (node)
+        {
+        }
+
+        bool inTree_ = false;
+        Entry const* entry_ = nullptr;
+        Tree::const_iterator node_;
+    };
+
+    ObjectValues () = default;
+    ObjectValues (ObjectValues const& other);
+    ObjectValues& operator= (ObjectValues const&) = delete;
+    ~ObjectValues ();
+
+    static void* operator new (std::size_t bytes);
+    static void operator delete (void* p) noexcept;
+
+    std::size_t
+    size () const
+    {
+        return tree_ ? tree_->size () : entries_.size ();
+    }
+
+    bool
+    empty () const
+    {
+        return size () == 0;
+    }
+
+    iterator
+    begin () const
+    {
+        return tree_ ? iterator (tree_->begin ())
+            : iterator (entries_.data ());
+    }
+
+    iterator
+    end () const
+    {
+        return tree_ ? iterator (tree_->end ())
+            : iterator (entries_.data () + entries_.size ());
+    }
+
+    /** Returns the member with the given key, or null. */
+    Value*
+    find (CZString const& key) const;
+
+    /** Returns the member with the given key, adding a null member if
+        there is none. The key is copied according to its policy.
+    */
+    Value&
+    insert (CZString const& key);
+
+    /** Moves the member with the given key to removed and erases it.
+        Returns false if there is no such member.
+    */
+    bool
+    erase (CZString const& key, Value& removed);
+
+    /** Erases the elements with an index of size or more. */
+    void
+    truncate (UInt size);
+
+    void
+    clear ();
+
+    friend bool operator== (ObjectValues const&, ObjectValues const&);
+    friend bool operator< (ObjectValues const&, ObjectValues const&);
+
+private:
+    Entries::iterator lowerBound (CZString const& key) const;
+    void grow (std::size_t n);
+    Value* makeValue ();
+    void freeValue (Value* value);
+    void makeTree ();
+
+    Entries entries_;
+    Tree* tree_ = nullptr;
+    Chunk* chunks_ = nullptr;
+    Value* avail_ = nullptr;
+    Value* limit_ = nullptr;
+    Value* free_ = nullptr;
+    std::size_t capacity_ = 0;
+};
+
 bool operator== (const Value&, const Value&);
 
 inline
@@ -23,8 +23,10 @@
 #include <ripple/basics/chrono.h>
 #include <ripple/protocol/STLedgerEntry.h>
 #include <ripple/beast/container/aged_unordered_map.h>
+#include <chrono>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 namespace ripple {
 
@@ -56,6 +58,17 @@ public:
     void
     expire();
 
+    /** Discard some expired entries, resuming where the last call stopped.
+
+        @param budget The time to spend before returning.
+        @param trash Receives the discarded entries, so the
+                     caller decides where they are destroyed.
+        @return `true` if every expired entry has been examined.
+    */
+    bool
+    expire (std::chrono::microseconds budget,
+        std::vector<std::shared_ptr<void const>>& trash);
+
     /** Fetch an item from the cache.
 
         If the digest was not found, Handler
@@ -91,6 +104,8 @@ public:
                 digest, std::move(sle));
         if (! result.second)
             map_.touch(result.first);
+        else
+            bytes_ += memoryUsed(*result.first->second);
         return  result.first->second;
     }
 
@@ -98,14 +113,30 @@ public:
     double
     rate() const;
 
+    /** Returns an estimate of the bytes held by the cache. */
+    std::size_t
+    getMemoryUsage() const;
+
 private:
+    static
+    std::size_t
+    memoryUsed (SLE const& sle);
+
+    using map_type = beast::aged_unordered_map <digest_type,
+        value_type, Stopwatch::clock_type,
+            hardened_hash<strong_hash>>;
+
     std::size_t hit_ = 0;
     std::size_t miss_ = 0;
+    std::size_t bytes_ = 0;
     std::mutex mutable mutex_;
     Stopwatch::duration timeToLive_;
-    beast::aged_unordered_map <digest_type,
-        value_type, Stopwatch::clock_type,
-            hardened_hash<strong_hash>> map_;
+    map_type map_;
+
+    // The position of the expiration in progress
+    bool expiring_ = false;
+    map_type::chronological_t::iterator cursor_;
+    Stopwatch::time_point expireTime_;
 };
 
 } // ripple
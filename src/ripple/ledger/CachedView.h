@@ -65,6 +65,9 @@ public:
     std::shared_ptr<SLE const>
     read (Keylet const& k) const override;
 
+    boost::optional<STLedgerEntryView>
+    readLazy (Keylet const& k) const override;
+
     bool
     open() const override
     {
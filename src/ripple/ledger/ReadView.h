@@ -26,6 +26,7 @@
 #include <ripple/protocol/IOUAmount.h>
 #include <ripple/protocol/Protocol.h>
 #include <ripple/protocol/STLedgerEntry.h>
+#include <ripple/protocol/STLedgerEntryView.h>
 #include <ripple/protocol/STTx.h>
 #include <ripple/protocol/XRPAmount.h>
 #include <ripple/beast/hash/uhash.h>
@@ -304,6 +305,22 @@ public:
     std::shared_ptr<SLE const>
     read (Keylet const& k) const = 0;
 
+    /** Return a read-only view of the state item associated with a key.
+
+        Unlike read, this need not deserialize the item: views
+        backed by a ledger locate fields in the serialized item
+        on demand. Prefer this for read-only access to a few
+        fields of an entry.
+
+        The default implementation wraps the result of read.
+
+        @return boost::none if the key is not present or
+                if the type does not match.
+    */
+    virtual
+    boost::optional<STLedgerEntryView>
+    readLazy (Keylet const& k) const;
+
     // Accounts in a payment are not allowed to use assets acquired during that
     // payment. The PaymentSandbox tracks the debits, credits, and owner count
     // changes that accounts make during a payment. `balanceHook` adjusts balances
@@ -24,6 +24,7 @@
 #include <ripple/ledger/RawView.h>
 #include <ripple/ledger/ReadView.h>
 #include <ripple/ledger/TxMeta.h>
+#include <ripple/ledger/detail/StateItems.h>
 #include <ripple/protocol/TER.h>
 #include <ripple/protocol/XRPAmount.h>
 #include <ripple/beast/utility/Journal.h>
@@ -47,7 +48,7 @@ private:
         modify,
     };
 
-    using items_t = std::map<key_type,
+    using items_t = StateItems<
         std::pair<Action, std::shared_ptr<SLE>>>;
 
     items_t items_;
@@ -83,6 +84,10 @@ public:
     read (ReadView const& base,
         Keylet const& k) const;
 
+    boost::optional<STLedgerEntryView>
+    readLazy (ReadView const& base,
+        Keylet const& k) const;
+
     std::shared_ptr<SLE>
     peek (ReadView const& base,
         Keylet const& k);
@@ -22,8 +22,7 @@
 
 #include <ripple/ledger/RawView.h>
 #include <ripple/ledger/ReadView.h>
-#include <ripple/basics/qalloc.h>
-#include <map>
+#include <ripple/ledger/detail/StateItems.h>
 #include <utility>
 
 namespace ripple {
@@ -67,6 +66,10 @@ public:
     read (ReadView const& base,
         Keylet const& k) const;
 
+    boost::optional<STLedgerEntryView>
+    readLazy (ReadView const& base,
+        Keylet const& k) const;
+
     void
     destroyXRP (XRPAmount const& fee);
 
@@ -89,10 +92,10 @@ private:
 
     class sles_iter_impl;
 
-    using items_t = std::map<key_type,
-        std::pair<Action, std::shared_ptr<SLE>>,
-        std::less<key_type>, qalloc_type<std::pair<key_type const,
-        std::pair<Action, std::shared_ptr<SLE>>>, false>>;
+    // Holds every change made to the open ledger, and is
+    // released with the OpenView when the ledger closes.
+    using items_t = StateItems<
+        std::pair<Action, std::shared_ptr<SLE>>>;
 
     items_t items_;
     XRPAmount dropsDestroyed_ = 0;
@@ -0,0 +1,460 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_LEDGER_STATEITEMS_H_INCLUDED
+#define RIPPLE_LEDGER_STATEITEMS_H_INCLUDED
+
+#include <ripple/basics/base_uint.h>
+#include <ripple/basics/hardened_hash.h>
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace ripple {
+namespace detail {
+
+/** The buffered entries of a state table, keyed by ledger index.
+
+    Entries are kept in one vector in the order they were first
+    added, so a table costs a handful of allocations however many
+    entries it holds, instead of one tree node per entry.
+
+    Lookups scan the vector while the table is small, and go
+    through an open addressing hash index once it grows.
+
+    Key order is only needed by succ(), by the sles iterators, and
+    to build metadata. Entries which are already in key order are
+    tracked by a sorted index, and newer entries are merged into
+    it as the table grows, so an insert costs O(sqrt(n)) amortized.
+    Ordered queries combine a binary search of the sorted index
+    with a scan of the unmerged entries, and never modify the
+    table: concurrent readers of a const table are safe.
+
+    Erasing an entry leaves a dead slot in place, which is
+    revived if the key is added again.
+
+    Pointers to entries are invalidated by emplace().
+*/
+template <class Mapped>
+class StateItems
+{
+public:
+    using key_type = uint256;
+    using mapped_type = Mapped;
+    using value_type = std::pair<key_type, Mapped>;
+
+private:
+    struct slot
+    {
+        value_type value;
+        bool live;
+
+        template <class... Args>
+        slot (key_type const& key, Args&&... args)
+            : value (std::piecewise_construct,
+                std::forward_as_tuple (key),
+                    std::forward_as_tuple (
+                        std::forward<Args>(args)...))
+            , live (true)
+        {
+        }
+    };
+
+    template <class Slot, class Value>
+    class iterator_impl
+    {
+    private:
+        Slot* pos_ = nullptr;
+        Slot* end_ = nullptr;
+
+        void
+        skip()
+        {
+            while (pos_ != end_ && ! pos_->live)
+                ++pos_;
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Value;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Value*;
+        using reference = Value&;
+
+        iterator_impl() = default;
+
+        iterator_impl (Slot* pos, Slot* end)
+            : pos_ (pos)
+            , end_ (end)
+        {
+            skip();
+        }
+
+        reference
+        operator*() const
+        {
+            return pos_->value;
+        }
+
+        pointer
+        operator->() const
+        {
+            return &pos_->value;
+        }
+
+        iterator_impl&
+        operator++()
+        {
+            ++pos_;
+            skip();
+            return *this;
+        }
+
+        iterator_impl
+        operator++(int)
+        {
+            auto const result = *this;
+            ++*this;
+            return result;
+        }
+
+        bool
+        operator== (iterator_impl const& other) const
+        {
+            return pos_ == other.pos_;
+        }
+
+        bool
+        operator!= (iterator_impl const& other) const
+        {
+            return pos_ != other.pos_;
+        }
+    };
+
+    // Tables up to this size are searched linearly
+    static std::size_t constexpr linearLimit = 8;
+
+    // Unmerged entries are never merged below this count
+    static std::size_t constexpr mergeLimit = 16;
+
+    using hasher = basic_hardened_hash<beast::xxhasher, true>;
+
+    std::vector<slot> slots_;
+
+    // Open addressing, power of two sized. Zero is an empty
+    // bucket, anything else is one plus the index of a slot.
+    std::vector<std::uint32_t> buckets_;
+
+    // Indexes of slots_[0, sorted_.size()) in key order
+    std::vector<std::uint32_t> sorted_;
+
+    std::size_t size_ = 0;
+
+public:
+    /** Iterates the live entries in the order they were added. */
+    using iterator = iterator_impl<slot, value_type>;
+    using const_iterator = iterator_impl<slot const, value_type const>;
+
+    StateItems() = default;
+    StateItems (StateItems const&) = default;
+    StateItems (StateItems&&) = default;
+    StateItems& operator= (StateItems const&) = default;
+    StateItems& operator= (StateItems&&) = default;
+
+    /** Returns the number of live entries. */
+    std::size_t
+    size() const
+    {
+        return size_;
+    }
+
+    bool
+    empty() const
+    {
+        return size_ == 0;
+    }
+
+    iterator
+    begin()
+    {
+        return { slots_.data(), slots_.data() + slots_.size() };
+    }
+
+    iterator
+    end()
+    {
+        auto const e = slots_.data() + slots_.size();
+        return { e, e };
+    }
+
+    const_iterator
+    begin() const
+    {
+        return { slots_.data(), slots_.data() + slots_.size() };
+    }
+
+    const_iterator
+    end() const
+    {
+        auto const e = slots_.data() + slots_.size();
+        return { e, e };
+    }
+
+    /** Returns the live entry with the key, or nullptr. */
+    value_type const*
+    find (key_type const& key) const
+    {
+        auto const i = locate (key);
+        if (i == slots_.size() || ! slots_[i].live)
+            return nullptr;
+        return &slots_[i].value;
+    }
+
+    value_type*
+    find (key_type const& key)
+    {
+        return const_cast<value_type*>(
+            static_cast<StateItems const&>(*this).find (key));
+    }
+
+    /** Adds an entry unless a live one has the key.
+
+        @return The entry with the key, and true if it was added.
+    */
+    template <class... Args>
+    std::pair<value_type*, bool>
+    emplace (key_type const& key, Args&&... args);
+
+    /** Removes the live entry with the key. */
+    void
+    erase (key_type const& key)
+    {
+        auto const i = locate (key);
+        assert (i != slots_.size() && slots_[i].live);
+        slots_[i].live = false;
+        slots_[i].value.second = Mapped{};
+        --size_;
+    }
+
+    /** Returns the live entry with the smallest key above `key`
+        for which `pred` returns true, or nullptr.
+    */
+    template <class Predicate>
+    value_type const*
+    next (key_type const& key, Predicate&& pred) const;
+
+    /** Returns the live entries in key order. */
+    std::vector<value_type const*>
+    ordered() const;
+
+private:
+    // Returns the slot holding the key, or slots_.size()
+    std::size_t
+    locate (key_type const& key) const;
+
+    void
+    rehash (std::size_t count);
+
+    void
+    merge();
+};
+
+//------------------------------------------------------------------------------
+
+template <class Mapped>
+std::size_t
+StateItems<Mapped>::locate (key_type const& key) const
+{
+    if (buckets_.empty())
+    {
+        for (std::size_t i = 0; i < slots_.size(); ++i)
+            if (slots_[i].value.first == key)
+                return i;
+        return slots_.size();
+    }
+
+    auto const mask = buckets_.size() - 1;
+    for (auto b = hasher{}(key) & mask;; b = (b + 1) & mask)
+    {
+        auto const n = buckets_[b];
+        if (n == 0)
+            return slots_.size();
+        if (slots_[n - 1].value.first == key)
+            return n - 1;
+    }
+}
+
+template <class Mapped>
+void
+StateItems<Mapped>::rehash (std::size_t count)
+{
+    buckets_.assign (count, 0);
+    auto const mask = count - 1;
+    for (std::size_t i = 0; i < slots_.size(); ++i)
+    {
+        auto b = hasher{}(slots_[i].value.first) & mask;
+        while (buckets_[b] != 0)
+            b = (b + 1) & mask;
+        buckets_[b] = static_cast<std::uint32_t>(i + 1);
+    }
+}
+
+template <class Mapped>
+void
+StateItems<Mapped>::merge()
+{
+    auto const less = [this](std::uint32_t a, std::uint32_t b)
+    {
+        return slots_[a].value.first < slots_[b].value.first;
+    };
+    auto const mid = sorted_.size();
+    for (auto i = mid; i < slots_.size(); ++i)
+        sorted_.push_back (static_cast<std::uint32_t>(i));
+    std::sort (sorted_.begin() + mid, sorted_.end(), less);
+    std::inplace_merge (sorted_.begin(),
+        sorted_.begin() + mid, sorted_.end(), less);
+}
+
+template <class Mapped>
+template <class... Args>
+auto
+StateItems<Mapped>::emplace (key_type const& key, Args&&... args) ->
+    std::pair<value_type*, bool>
+{
+    auto const i = locate (key);
+    if (i != slots_.size())
+    {
+        auto& s = slots_[i];
+        if (s.live)
+            return { &s.value, false };
+        // Revive the slot, which is already indexed
+        s.value.second = Mapped (std::forward<Args>(args)...);
+        s.live = true;
+        ++size_;
+        return { &s.value, true };
+    }
+
+    slots_.emplace_back (key, std::forward<Args>(args)...);
+    ++size_;
+
+    if (! buckets_.empty())
+    {
+        if (slots_.size() * 2 > buckets_.size())
+        {
+            rehash (buckets_.size() * 2);
+        }
+        else
+        {
+            auto const mask = buckets_.size() - 1;
+            auto b = hasher{}(key) & mask;
+            while (buckets_[b] != 0)
+                b = (b + 1) & mask;
+            buckets_[b] = static_cast<std::uint32_t>(slots_.size());
+        }
+    }
+    else if (slots_.size() > linearLimit)
+    {
+        rehash (4 * linearLimit);
+    }
+
+    // Keep the unmerged tail near the square root of the table
+    auto const tail = slots_.size() - sorted_.size();
+    if (tail > mergeLimit && tail * tail > sorted_.size())
+        merge();
+
+    return { &slots_.back().value, true };
+}
+
+template <class Mapped>
+template <class Predicate>
+auto
+StateItems<Mapped>::next (key_type const& key, Predicate&& pred) const ->
+    value_type const*
+{
+    value_type const* result = nullptr;
+
+    auto iter = std::upper_bound (sorted_.begin(), sorted_.end(), key,
+        [this](key_type const& k, std::uint32_t i)
+        {
+            return k < slots_[i].value.first;
+        });
+    for (; iter != sorted_.end(); ++iter)
+    {
+        auto const& s = slots_[*iter];
+        if (s.live && pred (s.value))
+        {
+            result = &s.value;
+            break;
+        }
+    }
+
+    for (auto i = sorted_.size(); i < slots_.size(); ++i)
+    {
+        auto const& s = slots_[i];
+        if (s.live && key < s.value.first &&
+            (! result || s.value.first < result->first) &&
+                pred (s.value))
+            result = &s.value;
+    }
+
+    return result;
+}
+
+template <class Mapped>
+auto
+StateItems<Mapped>::ordered() const ->
+    std::vector<value_type const*>
+{
+    auto const less = [](value_type const* a, value_type const* b)
+    {
+        return a->first < b->first;
+    };
+
+    std::vector<value_type const*> head;
+    head.reserve (sorted_.size());
+    for (auto const i : sorted_)
+        if (slots_[i].live)
+            head.push_back (&slots_[i].value);
+
+    std::vector<value_type const*> tail;
+    for (auto i = sorted_.size(); i < slots_.size(); ++i)
+        if (slots_[i].live)
+            tail.push_back (&slots_[i].value);
+    std::sort (tail.begin(), tail.end(), less);
+
+    if (tail.empty())
+        return head;
+
+    std::vector<value_type const*> result;
+    result.reserve (head.size() + tail.size());
+    std::merge (head.begin(), head.end(),
+        tail.begin(), tail.end(),
+            std::back_inserter (result), less);
+    return result;
+}
+
+} // detail
+} // ripple
+
+#endif
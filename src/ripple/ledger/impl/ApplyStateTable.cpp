@@ -31,6 +31,8 @@ namespace detail {
 void
 ApplyStateTable::apply (RawView& to) const
 {
+    // The order in which the changes are
+    // applied does not affect the result.
     to.rawDestroyXRP(dropsDestroyed_);
     for (auto const& item : items_)
     {
@@ -80,8 +82,9 @@ ApplyStateTable::visit (ReadView const& to,
         std::shared_ptr <SLE const> const& before,
         std::shared_ptr <SLE const> const& after)> const& func) const
 {
-    for (auto& item : items_)
+    for (auto const* p : items_.ordered())
     {
+        auto const& item = *p;
         switch (item.second.first)
         {
         case Action::erase:
@@ -124,8 +127,11 @@ ApplyStateTable::apply (OpenView& to,
         if (deliver)
             meta.setDeliveredAmount(*deliver);
         Mods newMod;
-        for (auto& item : items_)
+        // Visit the entries in key order, as
+        // the metadata is built in that order
+        for (auto const* p : items_.ordered())
         {
+            auto const& item = *p;
             SField const* type;
             switch (item.second.first)
             {
@@ -263,7 +269,7 @@ ApplyStateTable::exists (ReadView const& base,
     Keylet const& k) const
 {
     auto const iter = items_.find(k.key);
-    if (iter == items_.end())
+    if (! iter)
         return base.exists(k);
     auto const& item = iter->second;
     auto const& sle = item.second;
@@ -288,7 +294,7 @@ ApplyStateTable::succ (ReadView const& base,
             boost::optional<key_type>
 {
     boost::optional<key_type> next = key;
-    items_t::const_iterator iter;
+    items_t::value_type const* iter;
     // Find base successor that is
     // not also deleted in our list
     do
@@ -298,19 +304,19 @@ ApplyStateTable::succ (ReadView const& base,
             break;
         iter = items_.find(*next);
     }
-    while (iter != items_.end() &&
+    while (iter &&
         iter->second.first == Action::erase);
     // Find non-deleted successor in our list
-    for (iter = items_.upper_bound(key);
-        iter != items_.end (); ++iter)
-    {
-        if (iter->second.first != Action::erase)
+    iter = items_.next(key,
+        [](items_t::value_type const& item)
         {
-            // Found both, return the lower key
-            if (! next || next > iter->first)
-                next = iter->first;
-            break;
-        }
+            return item.second.first != Action::erase;
+        });
+    if (iter)
+    {
+        // Found both, return the lower key
+        if (! next || next > iter->first)
+            next = iter->first;
     }
     // Nothing in our list, return
     // what we got from the parent.
@@ -324,7 +330,7 @@ ApplyStateTable::read (ReadView const& base,
     Keylet const& k) const
 {
     auto const iter = items_.find(k.key);
-    if (iter == items_.end())
+    if (! iter)
         return base.read(k);
     auto const& item = iter->second;
     auto const& sle = item.second;
@@ -342,25 +348,34 @@ ApplyStateTable::read (ReadView const& base,
     return sle;
 }
 
+boost::optional<STLedgerEntryView>
+ApplyStateTable::readLazy (ReadView const& base,
+    Keylet const& k) const
+{
+    auto const iter = items_.find(k.key);
+    if (! iter)
+        return base.readLazy(k);
+    auto const& item = iter->second;
+    if (item.first == Action::erase)
+        return boost::none;
+    if (! k.check(*item.second))
+        return boost::none;
+    return STLedgerEntryView(item.second);
+}
+
 std::shared_ptr<SLE>
 ApplyStateTable::peek (ReadView const& base,
     Keylet const& k)
 {
-    auto iter = items_.lower_bound(k.key);
-    if (iter == items_.end() ||
-        iter->first != k.key)
+    auto const iter = items_.find(k.key);
+    if (! iter)
     {
         auto const sle = base.read(k);
         if (! sle)
             return nullptr;
         // Make our own copy
-        using namespace std;
-        iter = items_.emplace_hint (iter,
-            piecewise_construct,
-                forward_as_tuple(sle->key()),
-                    forward_as_tuple(Action::cache,
-                        make_shared<SLE>(*sle)));
-        return iter->second.second;
+        return items_.emplace(sle->key(), Action::cache,
+            std::make_shared<SLE>(*sle)).first->second.second;
     }
     auto const& item = iter->second;
     auto const& sle = item.second;
@@ -385,7 +400,7 @@ ApplyStateTable::erase(
 {
     auto const iter =
         items_.find(sle->key());
-    if (iter == items_.end())
+    if (! iter)
         LogicError("ApplyStateTable::erase: missing key");
     auto& item = iter->second;
     if (item.second != sle)
@@ -396,7 +411,7 @@ ApplyStateTable::erase(
         LogicError("ApplyStateTable::erase: double erase");
         break;
     case Action::insert:
-        items_.erase(iter);
+        items_.erase(sle->key());
         break;
     case Action::cache:
     case Action::modify:
@@ -409,11 +424,8 @@ void
 ApplyStateTable::rawErase (ReadView const& base,
     std::shared_ptr<SLE> const& sle)
 {
-    using namespace std;
     auto const result = items_.emplace(
-        piecewise_construct,
-            forward_as_tuple(sle->key()),
-                forward_as_tuple(Action::erase, sle));
+        sle->key(), Action::erase, sle);
     if (result.second)
         return;
     auto& item = result.first->second;
@@ -423,7 +435,7 @@ ApplyStateTable::rawErase (ReadView const& base,
         LogicError("ApplyStateTable::rawErase: double erase");
         break;
     case Action::insert:
-        items_.erase(result.first);
+        items_.erase(sle->key());
         break;
     case Action::cache:
     case Action::modify:
@@ -437,18 +449,11 @@ void
 ApplyStateTable::insert (ReadView const& base,
     std::shared_ptr<SLE> const& sle)
 {
-    auto const iter =
-        items_.lower_bound(sle->key());
-    if (iter == items_.end() ||
-        iter->first != sle->key())
-    {
-        using namespace std;
-        items_.emplace_hint(iter,
-            piecewise_construct,
-                forward_as_tuple(sle->key()),
-                    forward_as_tuple(Action::insert, sle));
+    auto const result = items_.emplace(
+        sle->key(), Action::insert, sle);
+    if (result.second)
         return;
-    }
+    auto const iter = result.first;
     auto& item = iter->second;
     switch(item.first)
     {
@@ -469,17 +474,11 @@ void
 ApplyStateTable::replace (ReadView const& base,
     std::shared_ptr<SLE> const& sle)
 {
-    auto const iter =
-        items_.lower_bound(sle->key());
-    if (iter == items_.end() ||
-        iter->first != sle->key())
-    {
-        using namespace std;
-        items_.emplace_hint(iter, piecewise_construct,
-            forward_as_tuple(sle->key()),
-                forward_as_tuple(Action::modify, sle));
+    auto const result = items_.emplace(
+        sle->key(), Action::modify, sle);
+    if (result.second)
         return;
-    }
+    auto const iter = result.first;
     auto& item = iter->second;
     switch (item.first)
     {
@@ -501,7 +500,7 @@ ApplyStateTable::update (ReadView const& base,
 {
     auto const iter =
         items_.find(sle->key());
-    if (iter == items_.end())
+    if (! iter)
         LogicError("ApplyStateTable::update: missing key");
     auto& item = iter->second;
     if (item.second != sle)
@@ -557,8 +556,8 @@ ApplyStateTable::getForMod (ReadView const& base,
         }
     }
     {
-        auto iter = items_.find (key);
-        if (iter != items_.end ())
+        auto const iter = items_.find (key);
+        if (iter)
         {
             auto const& item = iter->second;
             if (item.first == Action::erase)
@@ -77,6 +77,12 @@ ApplyViewBase::read (Keylet const& k) const
     return items_.read(*base_, k);
 }
 
+boost::optional<STLedgerEntryView>
+ApplyViewBase::readLazy (Keylet const& k) const
+{
+    return items_.readLazy(*base_, k);
+}
+
 auto
 ApplyViewBase::slesBegin() const ->
     std::unique_ptr<sles_type::iter_base>
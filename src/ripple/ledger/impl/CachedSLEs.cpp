@@ -29,22 +29,61 @@ CachedSLEs::expire()
     std::vector<
         std::shared_ptr<void const>> trash;
     {
-        auto const expireTime =
-            map_.clock().now() - timeToLive_;
         std::lock_guard<
             std::mutex> lock(mutex_);
-        for (auto iter = map_.chronological.begin();
-            iter != map_.chronological.end(); ++iter)
+        expiring_ = false;
+    }
+    while (! expire(
+            std::chrono::microseconds::zero(), trash))
+        ;
+}
+
+bool
+CachedSLEs::expire (std::chrono::microseconds budget,
+    std::vector<std::shared_ptr<void const>>& trash)
+{
+    // Entries examined each time the lock is taken
+    int const batch = 1024;
+
+    auto const deadline =
+        std::chrono::steady_clock::now() + budget;
+    for(;;)
+    {
         {
-            if (iter.when() > expireTime)
-                break;
-            if (iter->second.unique())
+            std::lock_guard<
+                std::mutex> lock(mutex_);
+            if (! expiring_)
+            {
+                expireTime_ =
+                    map_.clock().now() - timeToLive_;
+                cursor_ = map_.chronological.begin();
+                expiring_ = true;
+            }
+            // Touching the entry under the cursor moves it
+            // to the end, which only ends this pass early.
+            for (int i = 0; i < batch; ++i)
             {
-                trash.emplace_back(
-                    std::move(iter->second));
-                iter = map_.erase(iter);
+                if (cursor_ == map_.chronological.end() ||
+                    cursor_.when() > expireTime_)
+                {
+                    expiring_ = false;
+                    return true;
+                }
+                if (cursor_->second.unique())
+                {
+                    bytes_ -= memoryUsed(*cursor_->second);
+                    trash.emplace_back(
+                        std::move(cursor_->second));
+                    cursor_ = map_.erase(cursor_);
+                }
+                else
+                {
+                    ++cursor_;
+                }
             }
         }
+        if (std::chrono::steady_clock::now() >= deadline)
+            return false;
     }
 }
 
@@ -59,4 +98,22 @@ CachedSLEs::rate() const
     return double(hit_) / tot;
 }
 
+std::size_t
+CachedSLEs::getMemoryUsage() const
+{
+    std::lock_guard<
+        std::mutex> lock(mutex_);
+    // Each entry also pays for its hash node, its
+    // chronological links and a shared_ptr control block
+    return bytes_ + map_.size() * (sizeof(
+        decltype(map_)::value_type) + 6 * sizeof(void*));
+}
+
+std::size_t
+CachedSLEs::memoryUsed (SLE const& sle)
+{
+    return sizeof(sle) +
+        sle.getCount() * sizeof(detail::STVar);
+}
+
 } // ripple
@@ -66,5 +66,25 @@ CachedViewImpl::read (Keylet const& k) const
 
 }
 
+boost::optional<STLedgerEntryView>
+CachedViewImpl::readLazy (Keylet const& k) const
+{
+    {
+        std::lock_guard<
+            std::mutex> lock(mutex_);
+        auto const iter = map_.find(k.key);
+        if (iter != map_.end())
+        {
+            if (! iter->second ||
+                    ! k.check(*iter->second))
+                return boost::none;
+            return STLedgerEntryView(iter->second);
+        }
+    }
+    // Not worth caching: the base
+    // does not deserialize the entry.
+    return base_.readLazy(k);
+}
+
 } // detail
 } // ripple
@@ -20,6 +20,7 @@
 #include <BeastConfig.h>
 #include <ripple/ledger/detail/RawStateTable.h>
 #include <ripple/basics/contract.h>
+#include <algorithm>
 
 namespace ripple {
 namespace detail {
@@ -28,22 +29,27 @@ class RawStateTable::sles_iter_impl
     : public ReadView::sles_type::iter_base
 {
 private:
+    using ordered_t = std::vector<items_t::value_type const*>;
+
     std::shared_ptr<SLE const> sle0_;
     ReadView::sles_type::iterator iter0_;
     ReadView::sles_type::iterator end0_;
     std::shared_ptr<SLE const> sle1_;
-    items_t::const_iterator iter1_;
-    items_t::const_iterator end1_;
+    // Our entries in key order, shared by copies
+    std::shared_ptr<ordered_t const> items_;
+    std::size_t iter1_;
+    std::size_t end1_;
 
 public:
     sles_iter_impl (sles_iter_impl const&) = default;
 
-    sles_iter_impl (items_t::const_iterator iter1,
-        items_t::const_iterator end1,
+    sles_iter_impl (std::shared_ptr<ordered_t const> items,
+        std::size_t iter1, std::size_t end1,
             ReadView::sles_type::iterator iter0,
                 ReadView::sles_type::iterator end0)
         : iter0_ (iter0)
         , end0_ (end0)
+        , items_ (std::move(items))
         , iter1_ (iter1)
         , end1_ (end1)
     {
@@ -51,7 +57,7 @@ public:
             sle0_ = *iter0_;
         if (iter1_ != end1)
         {
-            sle1_ = iter1_->second.second;
+            sle1_ = item().second.second;
             skip ();
         }
     }
@@ -67,9 +73,13 @@ public:
     {
         auto const& other = dynamic_cast<
             sles_iter_impl const&>(impl);
-        assert(end1_ == other.end1_ &&
-            end0_ == other.end0_);
-        return iter1_ == other.iter1_ &&
+        assert(end0_ == other.end0_);
+        // The end iterator is cached by the view and outlives
+        // changes to the table, so it does not know our size.
+        bool const atEnd = iter1_ == end1_;
+        if (atEnd != (other.iter1_ == other.end1_))
+            return false;
+        return (atEnd || iter1_ == other.iter1_) &&
             iter0_ == other.iter0_;
     }
 
@@ -118,6 +128,12 @@ public:
         return sle0_;
     }
 private:
+    items_t::value_type const&
+    item() const
+    {
+        return *(*items_)[iter1_];
+    }
+
     void inc0()
     {
         ++iter0_;
@@ -133,13 +149,13 @@ private:
         if (iter1_ == end1_)
             sle1_ = nullptr;
         else
-            sle1_ = iter1_->second.second;
+            sle1_ = item().second.second;
     }
     
     void skip()
     {
         while (iter1_ != end1_ &&
-            iter1_->second.first == Action::erase &&
+            item().second.first == Action::erase &&
                sle0_->key() == sle1_->key())
         {
             inc1();
@@ -157,6 +173,8 @@ private:
 void
 RawStateTable::apply (RawView& to) const
 {
+    // The order in which the changes are
+    // applied does not affect the result.
     to.rawDestroyXRP(dropsDestroyed_);
     for (auto const& elem : items_)
     {
@@ -182,7 +200,7 @@ RawStateTable::exists (ReadView const& base,
 {
     assert(k.key.isNonZero());
     auto const iter = items_.find(k.key);
-    if (iter == items_.end())
+    if (! iter)
         return base.exists(k);
     auto const& item = iter->second;
     if (item.first == Action::erase)
@@ -203,7 +221,7 @@ RawStateTable::succ (ReadView const& base,
             boost::optional<key_type>
 {
     boost::optional<key_type> next = key;
-    items_t::const_iterator iter;
+    items_t::value_type const* iter;
     // Find base successor that is
     // not also deleted in our list
     do
@@ -213,19 +231,19 @@ RawStateTable::succ (ReadView const& base,
             break;
         iter = items_.find(*next);
     }
-    while (iter != items_.end() &&
+    while (iter &&
         iter->second.first == Action::erase);
     // Find non-deleted successor in our list
-    for (iter = items_.upper_bound(key);
-        iter != items_.end (); ++iter)
-    {
-        if (iter->second.first != Action::erase)
+    iter = items_.next(key,
+        [](items_t::value_type const& item)
         {
-            // Found both, return the lower key
-            if (! next || next > iter->first)
-                next = iter->first;
-            break;
-        }
+            return item.second.first != Action::erase;
+        });
+    if (iter)
+    {
+        // Found both, return the lower key
+        if (! next || next > iter->first)
+            next = iter->first;
     }
     // Nothing in our list, return
     // what we got from the parent.
@@ -240,10 +258,7 @@ RawStateTable::erase(
 {
     // The base invariant is checked during apply
     auto const result = items_.emplace(
-        std::piecewise_construct,
-            std::forward_as_tuple(sle->key()),
-                std::forward_as_tuple(
-                    Action::erase, sle));
+        sle->key(), Action::erase, sle);
     if (result.second)
         return;
     auto& item = result.first->second;
@@ -253,7 +268,7 @@ RawStateTable::erase(
         LogicError("RawStateTable::erase: already erased");
         break;
     case Action::insert:
-        items_.erase(result.first);
+        items_.erase(sle->key());
         break;
     case Action::replace:
         item.first = Action::erase;
@@ -267,10 +282,7 @@ RawStateTable::insert(
     std::shared_ptr<SLE> const& sle)
 {
     auto const result = items_.emplace(
-        std::piecewise_construct,
-            std::forward_as_tuple(sle->key()),
-                std::forward_as_tuple(
-                    Action::insert, sle));
+        sle->key(), Action::insert, sle);
     if (result.second)
         return;
     auto& item = result.first->second;
@@ -294,10 +306,7 @@ RawStateTable::replace(
     std::shared_ptr<SLE> const& sle)
 {
     auto const result = items_.emplace(
-        std::piecewise_construct,
-            std::forward_as_tuple(sle->key()),
-                std::forward_as_tuple(
-                    Action::replace, sle));
+        sle->key(), Action::replace, sle);
     if (result.second)
         return;
     auto& item = result.first->second;
@@ -319,7 +328,7 @@ RawStateTable::read (ReadView const& base,
 {
     auto const iter =
         items_.find(k.key);
-    if (iter == items_.end())
+    if (! iter)
         return base.read(k);
     auto const& item = iter->second;
     if (item.first == Action::erase)
@@ -332,6 +341,22 @@ RawStateTable::read (ReadView const& base,
     return sle;
 }
 
+boost::optional<STLedgerEntryView>
+RawStateTable::readLazy (ReadView const& base,
+    Keylet const& k) const
+{
+    auto const iter =
+        items_.find(k.key);
+    if (! iter)
+        return base.readLazy(k);
+    auto const& item = iter->second;
+    if (item.first == Action::erase)
+        return boost::none;
+    if (! k.check(*item.second))
+        return boost::none;
+    return STLedgerEntryView(item.second);
+}
+
 void
 RawStateTable::destroyXRP(XRPAmount const& fee)
 {
@@ -341,8 +366,12 @@ RawStateTable::destroyXRP(XRPAmount const& fee)
 std::unique_ptr<ReadView::sles_type::iter_base>
 RawStateTable::slesBegin (ReadView const& base) const
 {
+    auto items = std::make_shared<
+        std::vector<items_t::value_type const*>>(
+            items_.ordered());
+    auto const size = items->size();
     return std::make_unique<sles_iter_impl>(
-        items_.begin(), items_.end(),
+        std::move(items), 0, size,
             base.sles.begin(), base.sles.end());
 }
 
@@ -350,16 +379,27 @@ std::unique_ptr<ReadView::sles_type::iter_base>
 RawStateTable::slesEnd (ReadView const& base) const
 {
     return std::make_unique<sles_iter_impl>(
-        items_.end(), items_.end(),
+        nullptr, 0, 0,
             base.sles.end(), base.sles.end());
 }
 
 std::unique_ptr<ReadView::sles_type::iter_base>
 RawStateTable::slesUpperBound (ReadView const& base, uint256 const& key) const
 {
+    auto items = std::make_shared<
+        std::vector<items_t::value_type const*>>(
+            items_.ordered());
+    auto const iter = std::upper_bound(
+        items->begin(), items->end(), key,
+            [](uint256 const& k, items_t::value_type const* item)
+            {
+                return k < item->first;
+            });
+    auto const pos = iter - items->begin();
+    auto const size = items->size();
     return std::make_unique<sles_iter_impl>(
-            items_.upper_bound(key), items_.end(),
-                base.sles.upper_bound(key), base.sles.end());
+        std::move(items), pos, size,
+            base.sles.upper_bound(key), base.sles.end());
 }
 
 } // detail
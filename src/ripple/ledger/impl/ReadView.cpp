@@ -129,6 +129,17 @@ Rules::operator== (Rules const& other) const
 
 //------------------------------------------------------------------------------
 
+boost::optional<STLedgerEntryView>
+ReadView::readLazy (Keylet const& k) const
+{
+    auto sle = read(k);
+    if (! sle)
+        return boost::none;
+    return STLedgerEntryView(std::move(sle));
+}
+
+//------------------------------------------------------------------------------
+
 ReadView::sles_type::sles_type(
         ReadView const& view)
     : ReadViewFwdRange(view)
@@ -107,7 +107,7 @@ isGlobalFrozen (ReadView const& view,
     if (isXRP (issuer))
         return false;
     auto const sle =
-        view.read(keylet::account(issuer));
+        view.readLazy(keylet::account(issuer));
     if (sle && sle->isFlag (lsfGlobalFreeze))
         return true;
     return false;
@@ -123,13 +123,13 @@ isFrozen (ReadView const& view, AccountID const& account,
     if (isXRP (currency))
         return false;
     auto sle =
-        view.read(keylet::account(issuer));
+        view.readLazy(keylet::account(issuer));
     if (sle && sle->isFlag (lsfGlobalFreeze))
         return true;
     if (issuer != account)
     {
         // Check if the issuer froze the line
-        sle = view.read(keylet::line(
+        sle = view.readLazy(keylet::line(
             account, issuer, currency));
         if (sle && sle->isFlag(
             (issuer > account) ?
@@ -151,15 +151,14 @@ accountHolds (ReadView const& view,
         // XRP: return balance minus reserve
         if (amendmentRIPD1141 (view.info ().parentCloseTime))
         {
-            auto const sle = view.read(
+            auto const sle = view.readLazy(
                 keylet::account(account));
             auto const ownerCount =
-                view.ownerCountHook (account, sle->getFieldU32 (sfOwnerCount));
+                view.ownerCountHook (account, (*sle)[sfOwnerCount]);
             auto const reserve =
                     view.fees().accountReserve(ownerCount);
 
-            auto const fullBalance =
-                sle->getFieldAmount(sfBalance);
+            auto const fullBalance = (*sle)[sfBalance];
 
             auto const balance = view.balanceHook(
                 account, issuer, fullBalance).xrp();
@@ -182,13 +181,13 @@ accountHolds (ReadView const& view,
         {
             // pre-switchover
             // XRP: return balance minus reserve
-            auto const sle = view.read(
+            auto const sle = view.readLazy(
                 keylet::account(account));
             auto const reserve =
                     view.fees().accountReserve(
-                        sle->getFieldU32(sfOwnerCount));
+                        (*sle)[sfOwnerCount]);
             auto const balance =
-                    sle->getFieldAmount(sfBalance).xrp ();
+                    (*sle)[sfBalance].xrp ();
             if (balance < reserve)
                 amount.clear ();
             else
@@ -204,7 +203,7 @@ accountHolds (ReadView const& view,
     }
 
     // IOU: Return balance on trust line modulo freeze
-    auto const sle = view.read(keylet::line(
+    auto const sle = view.readLazy(keylet::line(
         account, issuer, currency));
     if (! sle)
     {
@@ -217,7 +216,7 @@ accountHolds (ReadView const& view,
     }
     else
     {
-        amount = sle->getFieldAmount (sfBalance);
+        amount = (*sle)[sfBalance];
         if (account > issuer)
         {
             // Put balance in account terms.
@@ -360,10 +359,13 @@ Rate
 transferRate (ReadView const& view,
     AccountID const& issuer)
 {
-    auto const sle = view.read(keylet::account(issuer));
+    auto const sle = view.readLazy(keylet::account(issuer));
 
-    if (sle && sle->isFieldPresent (sfTransferRate))
-        return Rate{ sle->getFieldU32 (sfTransferRate) };
+    if (sle)
+    {
+        if (auto const rate = (*sle)[~sfTransferRate])
+            return Rate{ *rate };
+    }
 
     return parityRate;
 }
@@ -589,6 +589,22 @@ private:
         return jvRequest;
     }
 
+    // job_profile [<frequency>] [reset]
+    Json::Value parseJobProfile (Json::Value const& jvParams)
+    {
+        Json::Value     jvRequest (Json::objectValue);
+
+        for (unsigned int i = 0; i < jvParams.size (); ++i)
+        {
+            if (jvParams[i].asString () == "reset")
+                jvRequest[jss::reset] = true;
+            else
+                jvRequest[jss::frequency] = jvParams[i].asUInt ();
+        }
+
+        return jvRequest;
+    }
+
     // log_level:                           Get log levels
     // log_level <severity>:                Set master log level to the specified severity
     // log_level <partition> <severity>:    Set specified partition to specified severity
@@ -1058,6 +1074,7 @@ public:
     //      {   "ledger_entry",         &RPCParser::parseLedgerEntry,          -1, -1   },
             {   "ledger_header",        &RPCParser::parseLedgerId,              1,  1   },
             {   "ledger_request",       &RPCParser::parseLedgerId,              1,  1   },
+            {   "job_profile",          &RPCParser::parseJobProfile,            0,  2   },
             {   "log_level",            &RPCParser::parseLogLevel,              0,  2   },
             {   "logrotate",            &RPCParser::parseAsIs,                  0,  0   },
             {   "owner_info",           &RPCParser::parseAccountItems,          1,  2   },
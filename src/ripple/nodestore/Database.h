@@ -23,6 +23,7 @@
 #include <ripple/nodestore/NodeObject.h>
 #include <ripple/nodestore/Backend.h>
 #include <ripple/basics/TaggedCache.h>
+#include <ripple/beast/insight/Histogram.h>
 
 namespace ripple {
 namespace NodeStore {
@@ -129,6 +130,9 @@ public:
     /** Get the positive cache hits to total attempts ratio. */
     virtual float getCacheHitRate () = 0;
 
+    /** Get an estimate of the bytes held by the positive and negative caches. */
+    virtual std::size_t getCacheMemoryUsage () const = 0;
+
     /** Set the maximum number of entries and maximum cache age for both caches.
 
         @param size Number of cache entries (0 = ignore)
@@ -139,6 +143,15 @@ public:
     /** Remove expired entries from the positive and negative caches. */
     virtual void sweep () = 0;
 
+    /** Remove some expired entries, resuming where the last call stopped.
+
+        @param budget The time to spend before returning.
+        @param trash Receives the objects released from the positive cache.
+        @return `true` when a pass over both caches has completed.
+    */
+    virtual bool sweep (std::chrono::microseconds budget,
+        std::vector <std::shared_ptr <void const>>& trash) = 0;
+
     /** Gather statistics pertaining to read and write activities.
         Return the reads and writes, and total read and written bytes.
      */
@@ -148,6 +161,9 @@ public:
     virtual std::uint32_t getStoreSize () const = 0;
     virtual std::uint32_t getFetchSize () const = 0;
 
+    /** Return the distribution of fetch times, in microseconds. */
+    virtual beast::insight::Histogram::Snapshot getFetchLatency () const = 0;
+
     /** Return the number of files needed by our backend */
     virtual int fdlimit() const = 0;
 };
@@ -106,6 +106,20 @@ std::unique_ptr <Backend>
 make_Backend (Section const& config,
     Scheduler& scheduler, beast::Journal journal);
 
+/** Wrap a Backend with a membership filter.
+
+    Fetches for objects which were never stored in the backend are
+    answered by the filter. The filter is saved with the backend, and
+    until one has been saved, only a backend known to be empty can be
+    filtered.
+
+    @param filterBytes The size of the filter.
+    @param fresh `true` if the backend was just created, and is empty.
+*/
+std::unique_ptr <Backend>
+make_FilteredBackend (std::unique_ptr <Backend> backend,
+    std::size_t filterBytes, bool fresh, beast::Journal journal);
+
 }
 }
 
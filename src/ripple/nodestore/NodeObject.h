@@ -105,6 +105,14 @@ private:
     Blob mData;
 };
 
+/** Returns an estimate of the bytes used by a NodeObject. */
+inline
+std::size_t
+memoryUsed (NodeObject const& object)
+{
+    return sizeof (object) + object.getData ().capacity ();
+}
+
 }
 
 #endif
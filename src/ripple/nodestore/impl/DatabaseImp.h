@@ -54,6 +54,9 @@ protected:
     // Negative cache
     KeyCache <uint256> m_negCache;
 private:
+    // Whether the incremental sweep has reached the negative cache
+    bool m_sweepNegative = false;
+
     std::mutex                m_readLock;
     std::condition_variable   m_readCondVar;
     std::condition_variable   m_readGenCondVar;
@@ -177,8 +180,10 @@ public:
 
         auto const before = std::chrono::steady_clock::now();
         std::shared_ptr<NodeObject> ret = doFetch (hash, report);
+        auto const elapsed = std::chrono::steady_clock::now() - before;
         report.elapsed = std::chrono::duration_cast <std::chrono::milliseconds>
-            (std::chrono::steady_clock::now() - before);
+            (elapsed);
+        m_fetchLatency.record (elapsed);
 
         report.wasFound = (ret != nullptr);
         m_scheduler.onFetch (report);
@@ -314,6 +319,11 @@ public:
         return m_cache.getHitRate ();
     }
 
+    std::size_t getCacheMemoryUsage () const override
+    {
+        return m_cache.getMemoryUsage () + m_negCache.getMemoryUsage ();
+    }
+
     void tune (int size, int age) override
     {
         m_cache.setTargetSize (size);
@@ -328,6 +338,27 @@ public:
         m_negCache.sweep ();
     }
 
+    bool sweep (std::chrono::microseconds budget,
+        std::vector <std::shared_ptr <void const>>& trash) override
+    {
+        using namespace std::chrono;
+        auto const deadline = steady_clock::now () + budget;
+
+        if (! m_sweepNegative)
+        {
+            if (! m_cache.sweep (budget, trash))
+                return false;
+            m_sweepNegative = true;
+        }
+
+        auto const left = duration_cast <microseconds> (
+            deadline - steady_clock::now ());
+        if (! m_negCache.sweep (std::max (left, microseconds::zero ())))
+            return false;
+        m_sweepNegative = false;
+        return true;
+    }
+
     std::int32_t getWriteLoad() const override
     {
         return m_backend->getWriteLoad();
@@ -445,6 +476,11 @@ public:
         return m_fetchSize;
     }
 
+    beast::insight::Histogram::Snapshot getFetchLatency () const override
+    {
+        return m_fetchLatency.snapshot ();
+    }
+
     int fdlimit() const override
     {
         return fdlimit_;
@@ -456,6 +492,7 @@ private:
     std::atomic <std::uint32_t> m_fetchHitCount;
     std::atomic <std::uint32_t> m_storeSize;
     std::atomic <std::uint32_t> m_fetchSize;
+    beast::insight::Histogram m_fetchLatency;
 };
 
 }
@@ -0,0 +1,250 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/nodestore/Manager.h>
+#include <ripple/nodestore/impl/MembershipFilter.h>
+#include <ripple/basics/contract.h>
+#include <ripple/beast/utility/Journal.h>
+#include <boost/filesystem.hpp>
+#include <atomic>
+#include <fstream>
+
+namespace ripple {
+namespace NodeStore {
+
+/** A Backend which answers for objects it never stored without
+    consulting the backend it wraps.
+
+    The filter is saved in the backend's directory on destruction,
+    and removed again as soon as it is loaded, so that a filter
+    is only ever loaded if no writes could have been missed since
+    it was saved. Without one, the filter is not consulted until
+    the backend is replaced.
+*/
+class FilteredBackend
+    : public Backend
+{
+private:
+    std::unique_ptr <Backend> backend_;
+    MembershipFilter filter_;
+    boost::filesystem::path const path_;
+    beast::Journal journal_;
+    bool active_;
+    bool deletePath_ = false;
+
+    boost::filesystem::path
+    filterFile () const
+    {
+        return path_ / "membership.filter";
+    }
+
+    bool
+    load ()
+    {
+        using namespace boost::filesystem;
+
+        boost::system::error_code ec;
+        if (! is_regular_file (filterFile (), ec))
+            return false;
+
+        bool loaded;
+        {
+            std::ifstream in (filterFile ().string (), std::ios::binary);
+            loaded = filter_.load (in);
+        }
+        remove (filterFile (), ec);
+        if (ec)
+        {
+            JLOG (journal_.error()) <<
+                "Unable to remove " << filterFile () << ": " << ec.message ();
+            return false;
+        }
+        return loaded;
+    }
+
+    void
+    save ()
+    {
+        boost::system::error_code ec;
+        if (! boost::filesystem::is_directory (path_, ec))
+            return;
+
+        std::ofstream out (filterFile ().string (),
+            std::ios::binary | std::ios::trunc);
+        filter_.save (out);
+        out.close ();
+        if (! out)
+        {
+            JLOG (journal_.warn()) << "Unable to save " << filterFile ();
+            boost::filesystem::remove (filterFile (), ec);
+        }
+    }
+
+public:
+    FilteredBackend (std::unique_ptr <Backend> backend,
+            std::size_t filterBytes, bool fresh, beast::Journal journal)
+        : backend_ (std::move (backend))
+        , filter_ (filterBytes)
+        , path_ (backend_->getName ())
+        , journal_ (journal)
+        , active_ (fresh)
+    {
+        if (! active_)
+            active_ = load ();
+
+        JLOG (journal_.info()) << getName () << " membership filter " <<
+            (active_ ? "enabled" : "unavailable until rotation");
+    }
+
+    ~FilteredBackend () override
+    {
+        // Any writes are complete once the backend is gone
+        backend_.reset ();
+
+        if (active_ && ! deletePath_)
+        {
+            try
+            {
+                save ();
+            }
+            catch (std::exception const& e)
+            {
+                JLOG (journal_.warn()) <<
+                    "Unable to save " << filterFile () << ": " << e.what ();
+            }
+        }
+    }
+
+    std::string
+    getName () override
+    {
+        return backend_->getName ();
+    }
+
+    void
+    close () override
+    {
+        backend_->close ();
+    }
+
+    Status
+    fetch (void const* key, std::shared_ptr<NodeObject>* pObject) override
+    {
+        if (active_ && ! filter_.mayContain (key))
+        {
+            pObject->reset ();
+            return notFound;
+        }
+        return backend_->fetch (key, pObject);
+    }
+
+    bool
+    canFetchBatch () override
+    {
+        return backend_->canFetchBatch ();
+    }
+
+    std::vector<std::shared_ptr<NodeObject>>
+    fetchBatch (std::size_t n, void const* const* keys) override
+    {
+        if (! active_)
+            return backend_->fetchBatch (n, keys);
+
+        std::vector<void const*> present;
+        std::vector<std::size_t> index;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if (filter_.mayContain (keys[i]))
+            {
+                present.push_back (keys[i]);
+                index.push_back (i);
+            }
+        }
+
+        std::vector<std::shared_ptr<NodeObject>> results (n);
+        if (present.empty ())
+            return results;
+
+        auto found = backend_->fetchBatch (present.size (), present.data ());
+        for (std::size_t i = 0; i < found.size (); ++i)
+            results[index[i]] = std::move (found[i]);
+        return results;
+    }
+
+    void
+    store (std::shared_ptr<NodeObject> const& object) override
+    {
+        // Insert first, so the object can be found as soon as it is stored
+        filter_.insert (object->getHash ().begin ());
+        backend_->store (object);
+    }
+
+    void
+    storeBatch (Batch const& batch) override
+    {
+        for (auto const& object : batch)
+            filter_.insert (object->getHash ().begin ());
+        backend_->storeBatch (batch);
+    }
+
+    void
+    for_each (std::function <void (std::shared_ptr<NodeObject>)> f) override
+    {
+        backend_->for_each (f);
+    }
+
+    int
+    getWriteLoad () override
+    {
+        return backend_->getWriteLoad ();
+    }
+
+    void
+    setDeletePath () override
+    {
+        deletePath_ = true;
+        backend_->setDeletePath ();
+    }
+
+    void
+    verify () override
+    {
+        backend_->verify ();
+    }
+
+    int
+    fdlimit () const override
+    {
+        return backend_->fdlimit ();
+    }
+};
+
+//------------------------------------------------------------------------------
+
+std::unique_ptr <Backend>
+make_FilteredBackend (std::unique_ptr <Backend> backend,
+    std::size_t filterBytes, bool fresh, beast::Journal journal)
+{
+    return std::make_unique <FilteredBackend> (
+        std::move (backend), filterBytes, fresh, journal);
+}
+
+}
+}
@@ -0,0 +1,119 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/nodestore/impl/MembershipFilter.h>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace ripple {
+namespace NodeStore {
+
+// Identifies a saved filter, and its byte order
+static std::uint64_t const filterMagic = 0x52504c4d46494c31ull;
+
+MembershipFilter::MembershipFilter (std::size_t bytes)
+    : blocks_ (std::max<std::size_t> (bytes / blockBytes, 1))
+    , words_ (new std::atomic<std::uint64_t>[blocks_ * wordsPerBlock])
+{
+    for (std::size_t i = 0; i < blocks_ * wordsPerBlock; ++i)
+        words_[i].store (0, std::memory_order_relaxed);
+}
+
+std::atomic<std::uint64_t>*
+MembershipFilter::block (void const* key) const
+{
+    std::uint64_t h;
+    std::memcpy (&h, key, sizeof (h));
+    return &words_[(h % blocks_) * wordsPerBlock];
+}
+
+// Each probe takes 9 bits of the key's second word: 3 select the
+// word in the block and 6 the bit in that word.
+void
+MembershipFilter::insert (void const* key)
+{
+    auto const b = block (key);
+    std::uint64_t h;
+    std::memcpy (&h, static_cast<std::uint8_t const*>(key) + 8, sizeof (h));
+    for (int i = 0; i < probes; ++i, h >>= 9)
+    {
+        auto const mask = std::uint64_t (1) << (h & 63);
+        auto& word = b[(h >> 6) & (wordsPerBlock - 1)];
+        if (! (word.load (std::memory_order_relaxed) & mask))
+            word.fetch_or (mask, std::memory_order_relaxed);
+    }
+}
+
+bool
+MembershipFilter::mayContain (void const* key) const
+{
+    auto const b = block (key);
+    std::uint64_t h;
+    std::memcpy (&h, static_cast<std::uint8_t const*>(key) + 8, sizeof (h));
+    for (int i = 0; i < probes; ++i, h >>= 9)
+    {
+        auto const mask = std::uint64_t (1) << (h & 63);
+        auto const& word = b[(h >> 6) & (wordsPerBlock - 1)];
+        if (! (word.load (std::memory_order_relaxed) & mask))
+            return false;
+    }
+    return true;
+}
+
+void
+MembershipFilter::save (std::ostream& out) const
+{
+    std::uint64_t const header[] = { filterMagic, blocks_ };
+    out.write (reinterpret_cast<char const*>(header), sizeof (header));
+
+    std::vector<std::uint64_t> buffer (wordsPerBlock * 1024);
+    auto const total = blocks_ * wordsPerBlock;
+    for (std::size_t i = 0; i < total; i += buffer.size ())
+    {
+        auto const n = std::min (buffer.size (), total - i);
+        for (std::size_t j = 0; j < n; ++j)
+            buffer[j] = words_[i + j].load (std::memory_order_relaxed);
+        out.write (reinterpret_cast<char const*>(buffer.data ()),
+            n * sizeof (std::uint64_t));
+    }
+}
+
+bool
+MembershipFilter::load (std::istream& in)
+{
+    std::uint64_t header[2];
+    if (! in.read (reinterpret_cast<char*>(header), sizeof (header)) ||
+        header[0] != filterMagic || header[1] != blocks_)
+        return false;
+
+    auto const total = blocks_ * wordsPerBlock;
+    std::vector<std::uint64_t> words (total);
+    if (! in.read (reinterpret_cast<char*>(words.data ()),
+            total * sizeof (std::uint64_t)))
+        return false;
+
+    for (std::size_t i = 0; i < total; ++i)
+        words_[i].store (words[i], std::memory_order_relaxed);
+    return true;
+}
+
+}
+}
@@ -0,0 +1,93 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_NODESTORE_MEMBERSHIPFILTER_H_INCLUDED
+#define RIPPLE_NODESTORE_MEMBERSHIPFILTER_H_INCLUDED
+
+#include <atomic>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <ostream>
+
+namespace ripple {
+namespace NodeStore {
+
+/** A blocked Bloom filter over node object keys.
+
+    Each key sets a few bits within one 64 byte block, so a lookup
+    touches a single cache line. The keys are already uniformly
+    distributed hashes, and their bytes are used as the bit positions
+    directly.
+
+    A lookup may report a key which was never inserted, but never the
+    reverse. Inserts and lookups may run concurrently.
+*/
+class MembershipFilter
+{
+public:
+    /** Create an empty filter using about `bytes` of memory. */
+    explicit
+    MembershipFilter (std::size_t bytes);
+
+    MembershipFilter (MembershipFilter const&) = delete;
+    MembershipFilter& operator= (MembershipFilter const&) = delete;
+
+    /** Add a key to the filter. */
+    void
+    insert (void const* key);
+
+    /** Returns `false` if the key was never inserted. */
+    bool
+    mayContain (void const* key) const;
+
+    /** Returns the size of the filter in bytes. */
+    std::size_t
+    size () const
+    {
+        return blocks_ * blockBytes;
+    }
+
+    /** Write the filter to a stream. */
+    void
+    save (std::ostream& out) const;
+
+    /** Replace the filter with one saved by save().
+        @return `false` if the stream does not hold a filter
+                of the same size, leaving this filter unchanged.
+    */
+    bool
+    load (std::istream& in);
+
+private:
+    static std::size_t const blockBytes = 64;
+    static std::size_t const wordsPerBlock = blockBytes / 8;
+    static int const probes = 6;
+
+    std::atomic<std::uint64_t>*
+    block (void const* key) const;
+
+    std::size_t const blocks_;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> words_;
+};
+
+}
+}
+
+#endif
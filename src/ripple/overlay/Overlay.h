@@ -164,6 +164,13 @@ public:
     relay (protocol::TMValidation& m,
         uint256 const& uid) = 0;
 
+    /** Returns the traffic and time spent per protocol message type,
+        summed over every peer since startup.
+    */
+    virtual
+    Json::Value
+    trafficJson() = 0;
+
     virtual
     void
     setupValidatorKeyManifests (BasicConfig const& config,
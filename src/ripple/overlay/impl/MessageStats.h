@@ -0,0 +1,196 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_OVERLAY_MESSAGESTATS_H_INCLUDED
+#define RIPPLE_OVERLAY_MESSAGESTATS_H_INCLUDED
+
+#include <ripple/overlay/impl/ProtocolMessage.h>
+#include <ripple/json/json_value.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace ripple {
+
+/** Traffic and time spent, for each protocol message type.
+
+    Every peer keeps one, and the overlay keeps one for all peers, so the
+    cost of a busy node can be pinned on a peer and on a message type.
+    Times are accumulated in microseconds.
+*/
+class MessageStats
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+
+    /** The totals for one message type. */
+    struct Totals
+    {
+        std::uint64_t bytesIn = 0;
+        std::uint64_t bytesOut = 0;
+        std::uint64_t messagesIn = 0;
+        std::uint64_t messagesOut = 0;
+
+        // Decoding inbound messages
+        std::uint64_t parseTime = 0;
+
+        // Running the handler on the peer's strand
+        std::uint64_t handlerTime = 0;
+
+        // From being queued to being written, for outbound messages
+        std::uint64_t sendQueueTime = 0;
+
+        // Jobs added while handling inbound messages, and their delay
+        std::uint64_t jobs = 0;
+        std::uint64_t jobQueueTime = 0;
+
+        explicit
+        operator bool () const
+        {
+            return messagesIn || messagesOut;
+        }
+    };
+
+    /** Message types at or above this are counted as type zero. */
+    static int const maxType = 64;
+
+    void
+    addIn (int type, std::size_t bytes,
+        clock_type::duration parse, clock_type::duration handler)
+    {
+        auto& e = entry (type);
+        e.bytesIn.fetch_add (bytes, std::memory_order_relaxed);
+        e.messagesIn.fetch_add (1, std::memory_order_relaxed);
+        e.parseTime.fetch_add (micros (parse), std::memory_order_relaxed);
+        e.handlerTime.fetch_add (micros (handler), std::memory_order_relaxed);
+    }
+
+    void
+    addOut (int type, std::size_t bytes)
+    {
+        auto& e = entry (type);
+        e.bytesOut.fetch_add (bytes, std::memory_order_relaxed);
+        e.messagesOut.fetch_add (1, std::memory_order_relaxed);
+    }
+
+    void
+    addSendQueue (int type, clock_type::duration wait)
+    {
+        entry (type).sendQueueTime.fetch_add (
+            micros (wait), std::memory_order_relaxed);
+    }
+
+    void
+    addJob (int type, clock_type::duration delay)
+    {
+        auto& e = entry (type);
+        e.jobs.fetch_add (1, std::memory_order_relaxed);
+        e.jobQueueTime.fetch_add (micros (delay), std::memory_order_relaxed);
+    }
+
+    Totals
+    get (int type) const
+    {
+        auto const& e = entries_[index (type)];
+        Totals t;
+        t.bytesIn = e.bytesIn.load (std::memory_order_relaxed);
+        t.bytesOut = e.bytesOut.load (std::memory_order_relaxed);
+        t.messagesIn = e.messagesIn.load (std::memory_order_relaxed);
+        t.messagesOut = e.messagesOut.load (std::memory_order_relaxed);
+        t.parseTime = e.parseTime.load (std::memory_order_relaxed);
+        t.handlerTime = e.handlerTime.load (std::memory_order_relaxed);
+        t.sendQueueTime = e.sendQueueTime.load (std::memory_order_relaxed);
+        t.jobs = e.jobs.load (std::memory_order_relaxed);
+        t.jobQueueTime = e.jobQueueTime.load (std::memory_order_relaxed);
+        return t;
+    }
+
+    /** Return the totals of every message type seen, by name.
+        The values are strings since they can exceed 32 bits.
+    */
+    Json::Value
+    json () const
+    {
+        Json::Value ret (Json::objectValue);
+        for (int type = 0; type < maxType; ++type)
+        {
+            auto const t = get (type);
+            if (! t)
+                continue;
+
+            Json::Value& v = ret[protocolMessageName (type)];
+            v["bytes_in"] = std::to_string (t.bytesIn);
+            v["bytes_out"] = std::to_string (t.bytesOut);
+            v["messages_in"] = std::to_string (t.messagesIn);
+            v["messages_out"] = std::to_string (t.messagesOut);
+            v["parse_us"] = std::to_string (t.parseTime);
+            v["handler_us"] = std::to_string (t.handlerTime);
+            v["send_queue_us"] = std::to_string (t.sendQueueTime);
+            v["jobs"] = std::to_string (t.jobs);
+            v["job_queue_us"] = std::to_string (t.jobQueueTime);
+        }
+        return ret;
+    }
+
+private:
+    using count_t = std::atomic <std::uint64_t>;
+
+    struct Entry
+    {
+        count_t bytesIn {0};
+        count_t bytesOut {0};
+        count_t messagesIn {0};
+        count_t messagesOut {0};
+        count_t parseTime {0};
+        count_t handlerTime {0};
+        count_t sendQueueTime {0};
+        count_t jobs {0};
+        count_t jobQueueTime {0};
+    };
+
+    static
+    std::size_t
+    index (int type)
+    {
+        return (type > 0 && type < maxType) ? type : 0;
+    }
+
+    static
+    std::uint64_t
+    micros (clock_type::duration d)
+    {
+        auto const us = std::chrono::duration_cast <
+            std::chrono::microseconds> (d).count ();
+        return us > 0 ? us : 0;
+    }
+
+    Entry&
+    entry (int type)
+    {
+        return entries_[index (type)];
+    }
+
+    std::array <Entry, maxType> entries_;
+};
+
+}
+
+#endif
@@ -18,6 +18,7 @@
 //==============================================================================
 
 #include <BeastConfig.h>
+#include <ripple/app/main/CollectorManager.h>
 #include <ripple/app/misc/HashRouter.h>
 #include <ripple/app/misc/NetworkOPs.h>
 #include <ripple/core/ConfigSections.h>
@@ -157,10 +158,33 @@ OverlayImpl::OverlayImpl (
     , timer_count_(0)
 {
     beast::PropertyStream::Source::add (m_peerFinder.get());
+
+    auto const& group (app_.getCollectorManager().group ("overlay"));
+    for (int type = 0; type < MessageStats::maxType; ++type)
+    {
+        auto const name = protocolMessageName (type);
+        if (type != 0 && name == "unknown")
+            continue;
+
+        auto& m = trafficMetrics_[type];
+        m.bytesIn = group->make_meter (name + "_bytes_in");
+        m.bytesOut = group->make_meter (name + "_bytes_out");
+        m.messagesIn = group->make_meter (name + "_messages_in");
+        m.messagesOut = group->make_meter (name + "_messages_out");
+        m.parseTime = group->make_meter (name + "_parse_us");
+        m.handlerTime = group->make_meter (name + "_handler_us");
+        m.sendQueueTime = group->make_meter (name + "_send_queue_us");
+        m.jobs = group->make_meter (name + "_jobs");
+        m.jobQueueTime = group->make_meter (name + "_job_queue_us");
+    }
+    hook_ = group->make_hook (std::bind (&OverlayImpl::collectMetrics, this));
 }
 
 OverlayImpl::~OverlayImpl ()
 {
+    // Must unhook before destroying
+    hook_ = beast::insight::Hook ();
+
     stop();
 
     // Block until dependent objects have been destroyed.
@@ -763,6 +787,28 @@ OverlayImpl::onManifests (
     }
 }
 
+void
+OverlayImpl::collectMetrics ()
+{
+    std::lock_guard <std::mutex> lock (metricsMutex_);
+
+    for (auto& item : trafficMetrics_)
+    {
+        auto& m = item.second;
+        auto const t = messageStats_.get (item.first);
+        m.bytesIn += t.bytesIn - m.last.bytesIn;
+        m.bytesOut += t.bytesOut - m.last.bytesOut;
+        m.messagesIn += t.messagesIn - m.last.messagesIn;
+        m.messagesOut += t.messagesOut - m.last.messagesOut;
+        m.parseTime += t.parseTime - m.last.parseTime;
+        m.handlerTime += t.handlerTime - m.last.handlerTime;
+        m.sendQueueTime += t.sendQueueTime - m.last.sendQueueTime;
+        m.jobs += t.jobs - m.last.jobs;
+        m.jobQueueTime += t.jobQueueTime - m.last.jobQueueTime;
+        m.last = t;
+    }
+}
+
 void
 OverlayImpl::reportTraffic (
     TrafficCount::category cat,
@@ -866,6 +912,12 @@ OverlayImpl::json ()
     return foreach (get_peer_json());
 }
 
+Json::Value
+OverlayImpl::trafficJson ()
+{
+    return messageStats_.json ();
+}
+
 bool
 OverlayImpl::processRequest (http_request_type const& req,
     Handoff& handoff)
@@ -24,6 +24,7 @@
 #include <ripple/core/Job.h>
 #include <ripple/overlay/Overlay.h>
 #include <ripple/overlay/impl/Manifest.h>
+#include <ripple/overlay/impl/MessageStats.h>
 #include <ripple/overlay/impl/TrafficCount.h>
 #include <ripple/server/Handoff.h>
 #include <ripple/rpc/ServerHandler.h>
@@ -41,6 +42,7 @@
 #include <cassert>
 #include <chrono>
 #include <condition_variable>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
@@ -113,6 +115,7 @@ private:
     Resource::Manager& m_resourceManager;
     std::unique_ptr <PeerFinder::Manager> m_peerFinder;
     TrafficCount m_traffic;
+    MessageStats messageStats_;
     hash_map <PeerFinder::Slot::ptr,
         std::weak_ptr <PeerImp>> m_peers;
     hash_map<Peer::id_t, std::weak_ptr<PeerImp>> ids_;
@@ -121,6 +124,24 @@ private:
     ManifestCache manifestCache_;
     int timer_count_;
 
+    // Reports messageStats_ to the insight collector
+    struct TrafficMetrics
+    {
+        beast::insight::Meter bytesIn;
+        beast::insight::Meter bytesOut;
+        beast::insight::Meter messagesIn;
+        beast::insight::Meter messagesOut;
+        beast::insight::Meter parseTime;
+        beast::insight::Meter handlerTime;
+        beast::insight::Meter sendQueueTime;
+        beast::insight::Meter jobs;
+        beast::insight::Meter jobQueueTime;
+        MessageStats::Totals last;
+    };
+    std::mutex metricsMutex_;
+    std::map<int, TrafficMetrics> trafficMetrics_;
+    beast::insight::Hook hook_;
+
     //--------------------------------------------------------------------------
 
 public:
@@ -273,12 +294,22 @@ public:
     std::string
     makePrefix (std::uint32_t id);
 
+    void
+    collectMetrics ();
+
     void
     reportTraffic (
         TrafficCount::category cat,
         bool isInbound,
         int bytes);
 
+    /** Traffic and time spent per message type, for all peers. */
+    MessageStats&
+    messageStats()
+    {
+        return messageStats_;
+    }
+
 private:
     std::shared_ptr<Writer>
     makeRedirectResponse (PeerFinder::Slot::ptr const& slot,
@@ -312,6 +343,9 @@ private:
     Json::Value
     json() override;
 
+    Json::Value
+    trafficJson() override;
+
     //--------------------------------------------------------------------------
 
     //
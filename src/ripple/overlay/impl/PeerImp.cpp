@@ -201,6 +201,10 @@ PeerImp::send (Message::pointer const& m)
         static_cast<TrafficCount::category>(m->getCategory()),
         false, static_cast<int>(m->getBuffer().size()));
 
+    auto const type = Message::getType (m->getBuffer());
+    stats_.addOut (type, m->getBuffer().size());
+    overlay_.messageStats().addOut (type, m->getBuffer().size());
+
     auto sendq_size = send_queue_.size();
 
     if (sendq_size < Tuning::targetSendQueue)
@@ -211,13 +215,14 @@ PeerImp::send (Message::pointer const& m)
         large_sendq_ = 0;
     }
 
-    send_queue_.push(m);
+    send_queue_.emplace(m, clock_type::now());
 
     if(sendq_size != 0)
         return;
 
+    onSendStart (send_queue_.front());
     boost::asio::async_write (stream_, boost::asio::buffer(
-        send_queue_.front()->getBuffer()), strand_.wrap(std::bind(
+        send_queue_.front().first->getBuffer()), strand_.wrap(std::bind(
             &PeerImp::onWriteMessage, shared_from_this(),
                 beast::asio::placeholders::error,
                     beast::asio::placeholders::bytes_transferred)));
@@ -357,6 +362,8 @@ PeerImp::json()
         }
     }
 
+    ret[jss::traffic] = stats_.json ();
+
     return ret;
 }
 
@@ -789,9 +796,11 @@ PeerImp::onWriteMessage (error_code ec, std::size_t bytes_transferred)
     send_queue_.pop();
     if (! send_queue_.empty())
     {
+        onSendStart (send_queue_.front());
+
         // Timeout on writes only
         return boost::asio::async_write (stream_, boost::asio::buffer(
-            send_queue_.front()->getBuffer()), strand_.wrap(std::bind(
+            send_queue_.front().first->getBuffer()), strand_.wrap(std::bind(
                 &PeerImp::onWriteMessage, shared_from_this(),
                     beast::asio::placeholders::error,
                         beast::asio::placeholders::bytes_transferred)));
@@ -822,8 +831,12 @@ PeerImp::onMessageUnknown (std::uint16_t type)
 PeerImp::error_code
 PeerImp::onMessageBegin (std::uint16_t type,
     std::shared_ptr <::google::protobuf::Message> const& m,
-    std::size_t size)
+    std::size_t size, clock_type::duration parseTime)
 {
+    messageType_ = type;
+    messageSize_ = size;
+    parseTime_ = parseTime;
+    messageStart_ = clock_type::now();
     load_event_ = app_.getJobQueue ().getLoadEventAP (
         jtPEER, protocolMessageName(type));
     fee_ = Resource::feeLightPeer;
@@ -833,11 +846,34 @@ PeerImp::onMessageBegin (std::uint16_t type,
 }
 
 void
-PeerImp::onMessageEnd (std::uint16_t,
+PeerImp::onMessageEnd (std::uint16_t type,
     std::shared_ptr <::google::protobuf::Message> const&)
 {
     load_event_.reset();
     charge (fee_);
+
+    auto const handlerTime = clock_type::now() - messageStart_;
+    stats_.addIn (type, messageSize_, parseTime_, handlerTime);
+    overlay_.messageStats().addIn (
+        type, messageSize_, parseTime_, handlerTime);
+    messageType_ = 0;
+}
+
+void
+PeerImp::onSendStart (
+    std::pair<Message::pointer, clock_type::time_point> const& queued)
+{
+    auto const type = Message::getType (queued.first->getBuffer());
+    auto const wait = clock_type::now() - queued.second;
+    stats_.addSendQueue (type, wait);
+    overlay_.messageStats().addSendQueue (type, wait);
+}
+
+void
+PeerImp::onJobStart (std::uint16_t messageType, clock_type::duration delay)
+{
+    stats_.addJob (messageType, delay);
+    overlay_.messageStats().addJob (messageType, delay);
 }
 
 void
@@ -851,7 +887,7 @@ PeerImp::onMessage (std::shared_ptr<protocol::TMManifests> const& m)
 {
     // VFALCO What's the right job type?
     auto that = shared_from_this();
-    app_.getJobQueue().addJob (
+    addJob (
         jtVALIDATION_ut, "receiveManifests",
         [this, that, m] (Job&) { overlay_.onManifests(m, that); });
 }
@@ -1104,7 +1140,7 @@ PeerImp::onMessage (std::shared_ptr <protocol::TMTransaction> const& m)
         }
         else
         {
-            app_.getJobQueue ().addJob (
+            addJob (
                 jtTRANSACTION, "recvTransaction->checkTransaction",
                 [weak = std::weak_ptr<PeerImp>(shared_from_this()),
                 flags, checkSignature, stx] (Job&) {
@@ -1126,7 +1162,7 @@ PeerImp::onMessage (std::shared_ptr <protocol::TMGetLedger> const& m)
 {
     fee_ = Resource::feeMediumBurdenPeer;
     std::weak_ptr<PeerImp> weak = shared_from_this();
-    app_.getJobQueue().addJob (
+    addJob (
         jtLEDGER_REQ, "recvGetLedger",
         [weak, m] (Job&) {
             if (auto peer = weak.lock())
@@ -1178,7 +1214,7 @@ PeerImp::onMessage (std::shared_ptr <protocol::TMLedgerData> const& m)
         // got data for a candidate transaction set
         std::weak_ptr<PeerImp> weak = shared_from_this();
         auto& journal = p_journal_;
-        app_.getJobQueue().addJob(
+        addJob (
             jtTXN_DATA, "recvPeerData",
             [weak, hash, journal, m] (Job&) {
                 if (auto peer = weak.lock())
@@ -1281,7 +1317,7 @@ PeerImp::onMessage (std::shared_ptr <protocol::TMProposeSet> const& m)
         signature, suppression);
 
     std::weak_ptr<PeerImp> weak = shared_from_this();
-    app_.getJobQueue ().addJob (
+    addJob (
         isTrusted ? jtPROPOSAL_t : jtPROPOSAL_ut, "recvPropose->checkPropose",
         [weak, m, proposal] (Job& job) {
             if (auto peer = weak.lock())
@@ -1593,7 +1629,7 @@ PeerImp::onMessage (std::shared_ptr <protocol::TMValidation> const& m)
         if (isTrusted || !app_.getFeeTrack ().isLoadedLocal ())
         {
             std::weak_ptr<PeerImp> weak = shared_from_this();
-            app_.getJobQueue ().addJob (
+            addJob (
                 isTrusted ? jtVALIDATION_t : jtVALIDATION_ut,
                 "recvValidation->checkValidation",
                 [weak, val, isTrusted, m] (Job&)
@@ -1795,7 +1831,7 @@ PeerImp::doFetchPack (const std::shared_ptr<protocol::TMGetObjectByHash>& packet
     std::weak_ptr<PeerImp> weak = shared_from_this();
     auto elapsed = UptimeTimer::getInstance().getElapsedSeconds();
     auto const pap = &app_;
-    app_.getJobQueue ().addJob (
+    addJob (
         jtPACK, "MakeFetchPack",
         [pap, weak, packet, hash, elapsed] (Job&) {
             pap->getLedgerMaster().makeFetchPack(
@@ -24,6 +24,7 @@
 #include <ripple/basics/Log.h> // deprecated
 #include <ripple/nodestore/Database.h>
 #include <ripple/overlay/predicates.h>
+#include <ripple/overlay/impl/MessageStats.h>
 #include <ripple/overlay/impl/ProtocolMessage.h>
 #include <ripple/overlay/impl/OverlayImpl.h>
 #include <ripple/resource/Fees.h>
@@ -156,13 +157,21 @@ private:
     http_response_type response_;
     beast::http::fields const& headers_;
     beast::streambuf write_buffer_;
-    std::queue<Message::pointer> send_queue_;
+    std::queue<std::pair<Message::pointer,
+        clock_type::time_point>> send_queue_;
     bool gracefulClose_ = false;
     int large_sendq_ = 0;
     int no_ping_ = 0;
     std::unique_ptr <LoadEvent> load_event_;
     bool hopsAware_ = false;
 
+    // The protocol message being handled, for accounting
+    std::uint16_t messageType_ = 0;
+    std::size_t messageSize_ = 0;
+    clock_type::duration parseTime_;
+    clock_type::time_point messageStart_;
+    MessageStats stats_;
+
     friend class OverlayImpl;
 
 public:
@@ -290,6 +299,13 @@ public:
     Json::Value
     json() override;
 
+    /** Traffic and time spent per message type on this connection. */
+    MessageStats const&
+    messageStats() const
+    {
+        return stats_;
+    }
+
     //
     // Ledger
     //
@@ -383,6 +399,11 @@ private:
     void
     onWriteMessage (error_code ec, std::size_t bytes_transferred);
 
+    // Called when a queued message starts to be written
+    void
+    onSendStart (
+        std::pair<Message::pointer, clock_type::time_point> const& queued);
+
 public:
     //--------------------------------------------------------------------------
     //
@@ -404,7 +425,7 @@ public:
     error_code
     onMessageBegin (std::uint16_t type,
         std::shared_ptr <::google::protobuf::Message> const& m,
-        std::size_t size);
+        std::size_t size, clock_type::duration parseTime);
 
     void
     onMessageEnd (std::uint16_t type,
@@ -439,6 +460,15 @@ private:
 
     //--------------------------------------------------------------------------
 
+    // Adds a job, charging its queue delay to the message being handled
+    template <class Function>
+    void
+    addJob (JobType type, std::string const& name, Function&& f);
+
+    // Called when a job added while handling a message starts
+    void
+    onJobStart (std::uint16_t messageType, clock_type::duration delay);
+
     void
     addLedger (uint256 const& hash);
 
@@ -508,6 +538,22 @@ PeerImp::PeerImp (Application& app, std::unique_ptr<beast::asio::ssl_bundle>&& s
         boost::asio::buffer_size(buffers)), buffers));
 }
 
+template <class Function>
+void
+PeerImp::addJob (JobType type, std::string const& name, Function&& f)
+{
+    std::weak_ptr<PeerImp> weak = shared_from_this();
+    auto const messageType = messageType_;
+    auto const queued = clock_type::now();
+    app_.getJobQueue().addJob (type, name,
+        [weak, messageType, queued, f = std::forward<Function>(f)] (Job& job)
+        {
+            if (auto peer = weak.lock())
+                peer->onJobStart (messageType, clock_type::now() - queued);
+            f (job);
+        });
+}
+
 template <class FwdIt, class>
 void
 PeerImp::sendEndpoints (FwdIt first, FwdIt last)
@@ -27,6 +27,7 @@
 #include <boost/asio/buffers_iterator.hpp>
 #include <boost/system/error_code.hpp>
 #include <cassert>
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <type_traits>
@@ -72,6 +73,7 @@ std::enable_if_t<std::is_base_of<
 invoke (int type, Buffers const& buffers,
     Handler& handler)
 {
+    auto const start = std::chrono::steady_clock::now();
     ZeroCopyInputStream<Buffers> stream(buffers);
     stream.Skip(Message::kHeaderBytes);
     auto const m (std::make_shared<T>());
@@ -79,7 +81,8 @@ invoke (int type, Buffers const& buffers,
         return boost::system::errc::make_error_code(
             boost::system::errc::invalid_argument);
     auto ec = handler.onMessageBegin (type, m,
-       Message::kHeaderBytes + Message::size (buffers));
+       Message::kHeaderBytes + Message::size (buffers),
+       std::chrono::steady_clock::now() - start);
     if (! ec)
     {
         handler.onMessage (m);
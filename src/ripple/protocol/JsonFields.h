@@ -87,6 +87,7 @@ JSS ( assets );                     // out: GatewayBalances
 JSS ( authorized );                 // out: AccountLines
 JSS ( auth_change );                // out: AccountInfo
 JSS ( auth_change_queued );         // out: AccountInfo
+JSS ( backfill_rate );              // out: GetCounts
 JSS ( balance );                    // out: AccountLines
 JSS ( balances );                   // out: GatewayBalances
 JSS ( base );                       // out: LogLevel
@@ -181,6 +182,7 @@ JSS ( flags );                      // out: paths/Node, AccountOffers,
                                     //      NetworkOPs
 JSS ( forward );                    // in: AccountTx
 JSS ( freeze );                     // out: AccountLines
+JSS ( frequency );                  // in: JobProfile
 JSS ( freeze_peer );                // out: AccountLines
 JSS ( frozen_balances );            // out: GatewayBalances
 JSS ( full );                       // in: LedgerClearer, handlers/Ledger
@@ -272,6 +274,8 @@ JSS ( max_spend_drops );            // out: AccountInfo
 JSS ( max_spend_drops_total );      // out: AccountInfo
 JSS ( median_fee );                 // out: TxQ
 JSS ( median_level );               // out: TxQ
+JSS ( memory );                     // out: GetCounts
+JSS ( memory_budget );              // out: GetCounts
 JSS ( message );                    // error.
 JSS ( meta );                       // out: NetworkOPs, AccountTx*, Tx
 JSS ( metaData );
@@ -347,6 +351,7 @@ JSS ( reserve_base );               // out: NetworkOPs
 JSS ( reserve_base_xrp );           // out: NetworkOPs
 JSS ( reserve_inc );                // out: NetworkOPs
 JSS ( reserve_inc_xrp );            // out: NetworkOPs
+JSS ( reset );                      // in: JobProfile
 JSS ( response );                   // websocket
 JSS ( result );                     // RPC
 JSS ( ripple_lines );               // out: NetworkOPs
@@ -404,7 +409,7 @@ JSS ( taker_pays_funded );          // out: NetworkOPs
 JSS ( threshold );                  // in: Blacklist
 JSS ( ticket );                     // in: AccountObjects
 JSS ( timeouts );                   // out: InboundLedger
-JSS ( traffic );                    // out: Overlay
+JSS ( traffic );                    // out: Overlay, Peers
 JSS ( totalCoins );                 // out: LedgerToJson
 JSS ( total_coins );                // out: LedgerToJson
 JSS ( transTreeHash );              // out: ledger/Ledger.cpp
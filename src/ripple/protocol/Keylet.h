@@ -50,6 +50,10 @@ struct Keylet
     /** Returns true if the SLE matches the type */
     bool
     check (STLedgerEntry const&) const;
+
+    /** Returns true if an SLE of the given type matches */
+    bool
+    check (LedgerEntryType sleType) const;
 };
 
 }
@@ -0,0 +1,203 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_PROTOCOL_STLEDGERENTRYVIEW_H_INCLUDED
+#define RIPPLE_PROTOCOL_STLEDGERENTRYVIEW_H_INCLUDED
+
+#include <ripple/basics/Slice.h>
+#include <ripple/protocol/LedgerFormats.h>
+#include <ripple/protocol/STBlob.h>
+#include <ripple/protocol/STLedgerEntry.h>
+#include <boost/optional.hpp>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+namespace ripple {
+
+/** A read-only ledger entry which is not deserialized up front.
+
+    Ledger entries are stored in the state map in their serialized
+    form, but most read-only callers only need two or three fields.
+    Instead of building an STLedgerEntry, with an STVar for every
+    field, this view locates the requested field in the serialized
+    bytes each time it is accessed.
+
+    A view can also wrap an entry which is already deserialized, so
+    that views which buffer modified entries can hand them out without
+    serializing them again.
+
+    Field access follows the rules of the const STObject accessors:
+    a missing field whose template style is SOE_DEFAULT yields the
+    default value, and any other missing field is an error.
+
+    @note Slices returned for blob fields point into memory owned by
+          the view, and remain valid only as long as the view does.
+*/
+class STLedgerEntryView
+{
+public:
+    /** Create a view over a serialized ledger entry.
+
+        @param holder Owns the memory referenced by `data`.
+
+        Throws:
+            std::runtime_error if `data` does not hold a
+                known type of ledger entry.
+    */
+    STLedgerEntryView (uint256 const& key, Slice const& data,
+        std::shared_ptr<void const> holder);
+
+    /** Create a view over a deserialized ledger entry. */
+    explicit
+    STLedgerEntryView (std::shared_ptr<STLedgerEntry const> sle);
+
+    /** Returns the key of this entry in the state map. */
+    uint256 const&
+    key() const
+    {
+        return key_;
+    }
+
+    LedgerEntryType
+    getType() const
+    {
+        return type_;
+    }
+
+    bool
+    isFieldPresent (SField const& field) const;
+
+    /** Returns the flags, or zero if the entry has none. */
+    std::uint32_t
+    getFlags() const
+    {
+        return (*this)[~sfFlags].value_or (0);
+    }
+
+    bool
+    isFlag (std::uint32_t flag) const
+    {
+        return (getFlags() & flag) == flag;
+    }
+
+    /** Return the value of a field.
+
+        Throws:
+            missing_field_error if the field is absent and has
+                no default value.
+    */
+    template <class T>
+    std::decay_t<typename T::value_type>
+    operator[] (TypedField<T> const& f) const;
+
+    /** Return the value of a field, if present. */
+    template <class T>
+    boost::optional<std::decay_t<typename T::value_type>>
+    operator[] (OptionaledField<T> const& of) const;
+
+    /** Return the entry as an STLedgerEntry.
+
+        This deserializes the entry unless the view
+        was constructed from one.
+    */
+    std::shared_ptr<STLedgerEntry const>
+    sle() const;
+
+private:
+    // Returns the offset of the field's value within
+    // data_, skipping fields which are not in the template.
+    boost::optional<std::size_t>
+    find (SField const& field) const;
+
+    // Returns the offset of the field's value within data_
+    boost::optional<std::size_t>
+    locate (SField const& field) const;
+
+    // Returns true if a missing field reads as its default value
+    bool
+    hasDefault (SField const& field) const;
+
+    template <class T>
+    static
+    std::decay_t<typename T::value_type>
+    extract (SerialIter& sit, TypedField<T> const& f)
+    {
+        return T (sit, f).value();
+    }
+
+    // Blobs are returned without copying them out of the entry
+    static
+    Slice
+    extract (SerialIter& sit, TypedField<STBlob> const&)
+    {
+        return sit.getSlice (sit.getVLDataLength ());
+    }
+
+    uint256 key_;
+    LedgerEntryType type_;
+    SOTemplate const* format_;
+    Slice data_;
+    std::shared_ptr<void const> holder_;
+    std::shared_ptr<STLedgerEntry const> sle_;
+};
+
+//------------------------------------------------------------------------------
+
+template <class T>
+std::decay_t<typename T::value_type>
+STLedgerEntryView::operator[] (TypedField<T> const& f) const
+{
+    if (sle_)
+        return (*sle_)[f];
+
+    auto const offset = find (f);
+    if (! offset)
+    {
+        if (! hasDefault (f))
+            Throw<missing_field_error> (f);
+        return std::decay_t<typename T::value_type>{};
+    }
+
+    SerialIter sit (data_.data() + *offset, data_.size() - *offset);
+    return extract (sit, f);
+}
+
+template <class T>
+boost::optional<std::decay_t<typename T::value_type>>
+STLedgerEntryView::operator[] (OptionaledField<T> const& of) const
+{
+    if (sle_)
+        return (*sle_)[of];
+
+    auto const offset = find (*of.f);
+    if (! offset)
+    {
+        if (! hasDefault (*of.f))
+            return boost::none;
+        return std::decay_t<typename T::value_type>{};
+    }
+
+    SerialIter sit (data_.data() + *offset, data_.size() - *offset);
+    return extract (sit, *of.f);
+}
+
+} // ripple
+
+#endif
@@ -36,6 +36,10 @@
 #include <type_traits>
 #include <utility>
 
+namespace Json {
+class Object;
+}
+
 namespace ripple {
 
 class STArray;
@@ -269,6 +273,12 @@ private:
     list_type v_;
     SOTemplate const* mType;
 
+    // `true` if the fields in v_ are in strictly increasing fieldCode
+    // order, which is always the case for canonically serialized free
+    // objects. This lets getFieldIndex use a binary search instead of
+    // a linear scan when there is no template.
+    bool sorted_ = true;
+
 public:
     using iterator = boost::transform_iterator<
         Transform, STObject::list_type::const_iterator>;
@@ -374,12 +384,23 @@ public:
     // TODO(tom): options should be an enum.
     virtual Json::Value getJson (int options) const override;
 
+    /** Add the fields of this object to a JSON object being written.
+
+        The fields are rendered as getJson renders them, but are written
+        out as they are visited, without building a Json::Value.
+    */
+    void addJson (Json::Object& to, int options) const;
+
     template <class... Args>
     std::size_t
     emplace_back(Args&&... args)
     {
         v_.emplace_back(std::forward<Args>(args)...);
-        return v_.size() - 1;
+        auto const n = v_.size();
+        if (sorted_ && n > 1)
+            sorted_ = v_[n - 2]->getFName().fieldCode <
+                v_[n - 1]->getFName().fieldCode;
+        return n - 1;
     }
 
     int getCount () const
@@ -536,6 +557,9 @@ public:
 private:
     void add (Serializer & s, bool withSigningFields) const;
 
+    // Locate a field in v_ without consulting the template
+    int findField (SField const& field) const;
+
     // Sort the entries in an STObject into the order that they will be
     // serialized.  Note: they are not sorted into pointer value order, they
     // are sorted by SField::fieldCode.
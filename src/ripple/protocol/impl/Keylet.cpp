@@ -25,6 +25,12 @@ namespace ripple {
 
 bool
 Keylet::check (SLE const& sle) const
+{
+    return check (sle.getType());
+}
+
+bool
+Keylet::check (LedgerEntryType sleType) const
 {
     if (type == ltANY)
         return true;
@@ -32,11 +38,11 @@ Keylet::check (SLE const& sle) const
         return false;
     if (type == ltCHILD)
     {
-        assert(sle.getType() != ltDIR_NODE);
-        return sle.getType() != ltDIR_NODE;
+        assert(sleType != ltDIR_NODE);
+        return sleType != ltDIR_NODE;
     }
-    assert(sle.getType() == type);
-    return sle.getType() == type;
+    assert(sleType == type);
+    return sleType == type;
 }
 
 } // ripple
@@ -21,6 +21,7 @@
 
 #include <ripple/basics/contract.h>
 #include <ripple/basics/Log.h>
+#include <ripple/basics/mulDiv.h>
 #include <ripple/protocol/JsonFields.h>
 #include <ripple/protocol/SystemParameters.h>
 #include <ripple/protocol/STAmount.h>
@@ -28,7 +29,6 @@
 #include <ripple/beast/core/LexicalCast.h>
 #include <boost/regex.hpp>
 #include <boost/algorithm/string.hpp>
-#include <boost/multiprecision/cpp_int.hpp>
 #include <iterator>
 #include <memory>
 #include <iostream>
@@ -981,20 +981,20 @@ muldiv(
     std::uint64_t multiplicand,
     std::uint64_t divisor)
 {
-    boost::multiprecision::uint128_t ret;
+    std::uint64_t ret;
 
-    boost::multiprecision::multiply(ret, multiplier, multiplicand);
-    ret /= divisor;
-
-    if (ret > std::numeric_limits<std::uint64_t>::max())
+    if (! mulDivAdd (multiplier, multiplicand, 0, divisor, ret))
     {
+        if (divisor == 0)
+            Throw<std::overflow_error> ("division by zero");
+
         Throw<std::overflow_error> ("overflow: (" +
             std::to_string (multiplier) + " * " +
             std::to_string (multiplicand) + ") / " +
             std::to_string (divisor));
     }
 
-    return static_cast<uint64_t>(ret);
+    return ret;
 }
 
 static
@@ -1005,14 +1005,13 @@ muldiv_round(
     std::uint64_t divisor,
     std::uint64_t rounding)
 {
-    boost::multiprecision::uint128_t ret;
+    std::uint64_t ret;
 
-    boost::multiprecision::multiply(ret, multiplier, multiplicand);
-    ret += rounding;
-    ret /= divisor;
-
-    if (ret > std::numeric_limits<std::uint64_t>::max())
+    if (! mulDivAdd (multiplier, multiplicand, rounding, divisor, ret))
     {
+        if (divisor == 0)
+            Throw<std::overflow_error> ("division by zero");
+
         Throw<std::overflow_error> ("overflow: ((" +
             std::to_string (multiplier) + " * " +
             std::to_string (multiplicand) + ") + " +
@@ -1020,7 +1019,7 @@ muldiv_round(
             std::to_string (divisor));
     }
 
-    return static_cast<uint64_t>(ret);
+    return ret;
 }
 
 STAmount
@@ -153,8 +153,11 @@ Json::Value STArray::getJson (int p) const
         {
             Json::Value& inner = v.append (Json::objectValue);
             auto const& fname = object.getFName ();
-            auto k = fname.hasName () ? fname.fieldName : std::to_string(index);
-            inner[k] = object.getJson (p);
+            if (fname.hasName ())
+                inner[Json::StaticString (fname.fieldName.c_str ())] =
+                    object.getJson (p);
+            else
+                inner[std::to_string (index)] = object.getJson (p);
             index++;
         }
     }
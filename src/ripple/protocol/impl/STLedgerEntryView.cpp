@@ -0,0 +1,144 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/protocol/STLedgerEntryView.h>
+#include <ripple/basics/contract.h>
+#include <ripple/protocol/impl/STVar.h>
+
+namespace ripple {
+
+STLedgerEntryView::STLedgerEntryView (uint256 const& key,
+        Slice const& data, std::shared_ptr<void const> holder)
+    : key_ (key)
+    , data_ (data)
+    , holder_ (std::move (holder))
+{
+    auto const offset = locate (sfLedgerEntryType);
+    if (! offset)
+        Throw<std::runtime_error> ("invalid ledger entry type");
+
+    SerialIter sit (data_.data() + *offset, data_.size() - *offset);
+    auto const format = LedgerFormats::getInstance().findByType (
+        static_cast <LedgerEntryType> (sit.get16 ()));
+
+    if (format == nullptr)
+        Throw<std::runtime_error> ("invalid ledger entry type");
+
+    type_ = format->getType ();
+    format_ = &format->elements;
+}
+
+STLedgerEntryView::STLedgerEntryView (
+        std::shared_ptr<STLedgerEntry const> sle)
+    : key_ (sle->key ())
+    , type_ (sle->getType ())
+    , format_ (nullptr)
+    , sle_ (std::move (sle))
+{
+}
+
+bool
+STLedgerEntryView::isFieldPresent (SField const& field) const
+{
+    if (sle_)
+        return sle_->isFieldPresent (field);
+    return static_cast<bool> (find (field));
+}
+
+std::shared_ptr<STLedgerEntry const>
+STLedgerEntryView::sle() const
+{
+    if (sle_)
+        return sle_;
+    return std::make_shared<STLedgerEntry const> (
+        SerialIter{data_}, key_);
+}
+
+boost::optional<std::size_t>
+STLedgerEntryView::find (SField const& field) const
+{
+    // STLedgerEntry discards fields which are not part of its
+    // template, so they are never visible through the view either.
+    if (format_->getIndex (field) == -1)
+        return boost::none;
+    return locate (field);
+}
+
+boost::optional<std::size_t>
+STLedgerEntryView::locate (SField const& field) const
+{
+    SerialIter sit (data_);
+
+    while (! sit.empty ())
+    {
+        int type;
+        int name;
+        sit.getFieldID (type, name);
+
+        if (type == field.fieldType && name == field.fieldValue)
+            return data_.size() - sit.getBytesLeft();
+
+        // Skip over the value of this field
+        switch (type)
+        {
+        case STI_UINT8:     sit.skip (1); break;
+        case STI_UINT16:    sit.skip (2); break;
+        case STI_UINT32:    sit.skip (4); break;
+        case STI_UINT64:    sit.skip (8); break;
+        case STI_HASH128:   sit.skip (16); break;
+        case STI_HASH160:   sit.skip (20); break;
+        case STI_HASH256:   sit.skip (32); break;
+
+        case STI_AMOUNT:
+            // The high bit is set for non-native amounts, which
+            // are followed by a currency and an issuer.
+            sit.skip ((sit.get8 () & 0x80) ? 47 : 7);
+            break;
+
+        case STI_VL:
+        case STI_ACCOUNT:
+        case STI_VECTOR256:
+            sit.skip (sit.getVLDataLength ());
+            break;
+
+        default:
+        {
+            // Objects, arrays and path sets have no length prefix,
+            // so consume them by deserializing.
+            auto const& fn = SField::getField (type, name);
+            if (fn.isInvalid ())
+                Throw<std::runtime_error> ("Unknown field");
+            detail::STVar const skipped (sit, fn);
+            break;
+        }
+        }
+    }
+
+    return boost::none;
+}
+
+bool
+STLedgerEntryView::hasDefault (SField const& field) const
+{
+    return format_->getIndex (field) != -1 &&
+        format_->style (field) == SOE_DEFAULT;
+}
+
+} // ripple
@@ -23,7 +23,11 @@
 #include <ripple/protocol/STAccount.h>
 #include <ripple/protocol/STArray.h>
 #include <ripple/protocol/STBlob.h>
+#include <ripple/protocol/JsonFields.h>
 #include <ripple/basics/Log.h>
+#include <ripple/json/Object.h>
+#include <algorithm>
+#include <vector>
 
 namespace ripple {
 
@@ -40,6 +44,7 @@ STObject::STObject(STObject&& other)
     : STBase(other.getFName())
     , v_(std::move(other.v_))
     , mType(other.mType)
+    , sorted_(other.sorted_)
 {
 }
 
@@ -80,6 +85,7 @@ STObject::operator= (STObject&& other)
     setFName(other.getFName());
     mType = other.mType;
     v_ = std::move(other.v_);
+    sorted_ = other.sorted_;
     return *this;
 }
 
@@ -88,6 +94,7 @@ void STObject::set (const SOTemplate& type)
     v_.clear();
     v_.reserve(type.size());
     mType = &type;
+    sorted_ = false;
 
     for (auto const& elem : type.all())
     {
@@ -101,25 +108,37 @@ void STObject::set (const SOTemplate& type)
 bool STObject::setType (const SOTemplate& type)
 {
     bool valid = true;
+
+    // Locate every template field before moving anything, since
+    // findField may binary search the existing fields.
+    std::vector<int> found;
+    found.reserve(type.size());
+    std::vector<bool> consumed (v_.size(), false);
+    for (auto const& e : type.all())
+    {
+        auto const index = findField (e->e_field);
+        if (index != -1)
+            consumed[index] = true;
+        found.push_back(index);
+    }
+
     mType = &type;
     decltype(v_) v;
     v.reserve(type.size());
+    auto index = found.cbegin();
     for (auto const& e : type.all())
     {
-        auto const iter = std::find_if(
-            v_.begin(), v_.end(), [&](detail::STVar const& b)
-                { return b.get().getFName() == e->e_field; });
-        if (iter != v_.end())
+        if (*index != -1)
         {
-            if ((e->flags == SOE_DEFAULT) && iter->get().isDefault())
+            auto& elem = v_[*index];
+            if ((e->flags == SOE_DEFAULT) && elem.get().isDefault())
             {
                 JLOG (debugLog().error())
                     << "setType(" << getFName().getName()
                     << "): explicit default " << e->e_field.fieldName;
                 valid = false;
             }
-            v.emplace_back(std::move(*iter));
-            v_.erase(iter);
+            v.emplace_back(std::move(elem));
         }
         else
         {
@@ -132,21 +151,27 @@ bool STObject::setType (const SOTemplate& type)
             }
             v.emplace_back(detail::nonPresentObject, e->e_field);
         }
+        ++index;
     }
-    for (auto const& e : v_)
+    for (std::size_t i = 0; i < v_.size(); ++i)
     {
+        if (consumed[i])
+            continue;
+
         // Anything left over in the object must be discardable
-        if (! e->getFName().isDiscardable())
+        if (! v_[i]->getFName().isDiscardable())
         {
             JLOG (debugLog().error())
                 << "setType(" << getFName().getName()
-                << "): non-discardable leftover " << e->getFName().getName ();
+                << "): non-discardable leftover "
+                << v_[i]->getFName().getName ();
             valid = false;
         }
     }
     // Swap the template matching data in for the old data,
     // freeing any leftover junk
     v_.swap(v);
+    sorted_ = false;
     return valid;
 }
 
@@ -170,6 +195,7 @@ bool STObject::set (SerialIter& sit, int depth)
     bool reachedEndOfObject = false;
 
     v_.clear();
+    sorted_ = true;
 
     // Consume data in the pipe until we run out or reach the end
     //
@@ -206,7 +232,7 @@ bool STObject::set (SerialIter& sit, int depth)
             }
 
             // Unflatten the field
-            v_.emplace_back(sit, fn);
+            emplace_back(sit, fn);
 
             // If the object type has a known SOTemplate then set it.
             STObject* const obj = dynamic_cast <STObject*> (&(v_.back().get()));
@@ -311,12 +337,30 @@ int STObject::getFieldIndex (SField const& field) const
     if (mType != nullptr)
         return mType->getIndex (field);
 
-    int i = 0;
-    for (auto const& elem : v_)
+    return findField (field);
+}
+
+int STObject::findField (SField const& field) const
+{
+    // Short objects are faster to scan than to bisect
+    if (sorted_ && v_.size () > 8)
+    {
+        auto const iter = std::lower_bound (v_.begin (), v_.end (),
+            field.fieldCode, [](detail::STVar const& elem, int code)
+            {
+                return elem->getFName ().fieldCode < code;
+            });
+
+        if (iter == v_.end () || (*iter)->getFName () != field)
+            return -1;
+
+        return static_cast<int> (iter - v_.begin ());
+    }
+
+    for (std::size_t i = 0, n = v_.size (); i != n; ++i)
     {
-        if (elem->getFName () == field)
-            return i;
-        ++i;
+        if (v_[i]->getFName () == field)
+            return static_cast<int> (i);
     }
     return -1;
 }
@@ -567,7 +611,7 @@ STObject::set (std::unique_ptr<STBase> v)
         if (! isFree())
             Throw<std::runtime_error> (
                 "missing field in templated STObject");
-        v_.emplace_back(std::move(*v));
+        emplace_back(std::move(*v));
     }
 }
 
@@ -642,15 +686,128 @@ Json::Value STObject::getJson (int options) const
     {
         if (elem->getSType () != STI_NOTPRESENT)
         {
+            // Fields live for the life of the process, so their names
+            // are used as keys without being copied.
             auto const& n = elem->getFName ();
-            auto key = n.hasName () ? std::string(n.getJsonName ()) :
-                    std::to_string (index);
-            ret[key] = elem->getJson (options);
+            if (n.hasName ())
+                ret[Json::StaticString (n.getJsonName ().c_str ())] =
+                    elem->getJson (options);
+            else
+                ret[std::to_string (index)] = elem->getJson (options);
         }
     }
     return ret;
 }
 
+namespace {
+
+void
+addJson (Json::Object& to, std::string const& key,
+    STBase const& field, int options)
+{
+    switch (field.getSType ())
+    {
+    case STI_OBJECT:
+    {
+        auto&& object = to.setObject (key);
+        static_cast<STObject const&> (field).addJson (object, options);
+        break;
+    }
+
+    case STI_ARRAY:
+    {
+        // Each element is an object holding the element under its name,
+        // as in STArray::getJson.
+        auto&& array = to.setArray (key);
+        int index = 1;
+        for (auto const& element : static_cast<STArray const&> (field))
+        {
+            if (element.getSType () == STI_NOTPRESENT)
+                continue;
+
+            auto&& inner = array.appendObject ();
+            auto const& name = element.getFName ();
+            if (name.hasName ())
+            {
+                auto&& object = inner.setObject (name.fieldName);
+                element.addJson (object, options);
+            }
+            else
+            {
+                auto&& object = inner.setObject (std::to_string (index));
+                element.addJson (object, options);
+            }
+            ++index;
+        }
+        break;
+    }
+
+    case STI_AMOUNT:
+    {
+        auto const& amount = static_cast<STAmount const&> (field);
+        if (amount.native ())
+        {
+            to.set (key, amount.getText ());
+        }
+        else
+        {
+            auto&& object = to.setObject (key);
+            object[jss::currency] = to_string (amount.getCurrency ());
+            object[jss::issuer] = to_string (amount.getIssuer ());
+            object[jss::value] = amount.getText ();
+        }
+        break;
+    }
+
+    default:
+        to.set (key, field.getJson (options));
+        break;
+    }
+}
+
+} // namespace
+
+void STObject::addJson (Json::Object& to, int options) const
+{
+    // The fields are written in key order, as a Json::Value keeps them.
+    // getJson gives every unnamed field the same key, "1", so only the
+    // last of them appears.
+    using field = std::pair<std::string const*, STBase const*>;
+    static std::string const unnamed ("1");
+
+    std::vector<field> fields;
+    fields.reserve (v_.size ());
+    for (auto const& elem : v_)
+    {
+        if (elem->getSType () == STI_NOTPRESENT)
+            continue;
+
+        auto const& n = elem->getFName ();
+        if (n.hasName ())
+        {
+            fields.emplace_back (&n.getJsonName (), &*elem);
+        }
+        else
+        {
+            auto const iter = std::find_if (fields.begin (), fields.end (),
+                [](field const& f) { return f.first == &unnamed; });
+            if (iter == fields.end ())
+                fields.emplace_back (&unnamed, &*elem);
+            else
+                iter->second = &*elem;
+        }
+    }
+
+    std::sort (fields.begin (), fields.end (),
+        [](field const& a, field const& b)
+        {
+            return *a.first < *b.first;
+        });
+
+    for (auto const& f : fields)
+        ripple::addJson (to, *f.first, *f.second, options);
+}
+
 bool STObject::operator== (const STObject& obj) const
 {
     // This is not particularly efficient, and only compares data elements
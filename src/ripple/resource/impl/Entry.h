@@ -25,6 +25,7 @@
 #include <ripple/resource/impl/Tuning.h>
 #include <ripple/beast/clock/abstract_clock.h>
 #include <ripple/beast/core/List.h>
+#include <atomic>
 #include <cassert>
 
 namespace ripple {
@@ -33,11 +34,18 @@ namespace Resource {
 using clock_type = beast::abstract_clock <std::chrono::steady_clock>;
 
 // An entry in the table
+//
+// The balances and the warning time may be read and updated from any
+// thread without holding the Logic lock. The key, refcount, list
+// membership and expiration time are only touched under the lock.
+//
 // VFALCO DEPRECATED using boost::intrusive list
 struct Entry
     : public beast::List <Entry>::Node
 {
     Entry () = delete;
+    Entry (Entry const&) = delete;
+    Entry& operator= (Entry const&) = delete;
 
     /**
        @param now Construction time of Entry.
@@ -76,16 +84,16 @@ struct Entry
     }
 
     // Balance including remote contributions
-    int balance (clock_type::time_point const now)
+    int balance (clock_type::time_point const now) const
     {
-        return local_balance.value (now) + remote_balance;
+        return local_balance.value (now) + remote_balance.load ();
     }
 
     // Add a charge and return normalized balance
     // including contributions from imports.
     int add (int charge, clock_type::time_point const now)
     {
-        return local_balance.add (charge, now) + remote_balance;
+        return local_balance.add (charge, now) + remote_balance.load ();
     }
 
     // Back pointer to the map key (bit of a hack here)
@@ -95,13 +103,13 @@ struct Entry
     int refcount;
 
     // Exponentially decaying balance of resource consumption
-    DecayingSample <decayWindowSeconds, clock_type> local_balance;
+    AtomicDecayingSample <decayWindowSeconds, clock_type> local_balance;
 
     // Normalized balance contribution from imports
-    int remote_balance;
+    std::atomic <int> remote_balance;
 
     // Time of the last warning
-    clock_type::rep lastWarningTime;
+    std::atomic <clock_type::rep> lastWarningTime;
 
     // For inactive entries, time after which this entry will be erased
     clock_type::rep whenExpires;
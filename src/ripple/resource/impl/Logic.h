@@ -61,6 +61,8 @@ private:
     Stopwatch& m_clock;
     beast::Journal m_journal;
 
+    // Guards the table, the lists and the imports. Charging an entry
+    // and checking its balance do not take the lock.
     std::recursive_mutex lock_;
 
     // Table of all entries
@@ -221,7 +223,7 @@ public:
             {
                 Json::Value& entry = (ret[inboundEntry.to_string()] = Json::objectValue);
                 entry[jss::local] = localBalance;
-                entry[jss::remote] = inboundEntry.remote_balance;
+                entry[jss::remote] = inboundEntry.remote_balance.load ();
                 entry[jss::type] = "inbound";
             }
 
@@ -233,7 +235,7 @@ public:
             {
                 Json::Value& entry = (ret[outboundEntry.to_string()] = Json::objectValue);
                 entry[jss::local] = localBalance;
-                entry[jss::remote] = outboundEntry.remote_balance;
+                entry[jss::remote] = outboundEntry.remote_balance.load ();
                 entry[jss::type] = "outbound";
             }
 
@@ -245,7 +247,7 @@ public:
             {
                 Json::Value& entry = (ret[adminEntry.to_string()] = Json::objectValue);
                 entry[jss::local] = localBalance;
-                entry[jss::remote] = adminEntry.remote_balance;
+                entry[jss::remote] = adminEntry.remote_balance.load ();
                 entry[jss::type] = "admin";
             }
 
@@ -441,8 +443,12 @@ public:
 
     Disposition charge (Entry& entry, Charge const& fee)
     {
-        std::lock_guard<std::recursive_mutex> _(lock_);
-        clock_type::time_point const now (m_clock.now());
+        return charge (entry, fee, m_clock.now());
+    }
+
+    Disposition charge (Entry& entry, Charge const& fee,
+        clock_type::time_point const now)
+    {
         int const balance (entry.add (fee.cost(), now));
         JLOG(m_journal.trace()) <<
             "Charging " << entry << " for " << fee;
@@ -454,22 +460,21 @@ public:
         if (entry.isUnlimited())
             return false;
 
-        std::lock_guard<std::recursive_mutex> _(lock_);
-        bool notify (false);
-        clock_type::rep const elapsed (m_clock.now().time_since_epoch().count());
-        if (entry.balance (m_clock.now()) >= warningThreshold &&
-            elapsed != entry.lastWarningTime)
-        {
-            charge (entry, feeWarning);
-            notify = true;
-            entry.lastWarningTime = elapsed;
-        }
-        if (notify)
-        {
-            JLOG(m_journal.info()) << "Load warning: " << entry;
-            ++m_stats.warn;
-        }
-        return notify;
+        clock_type::time_point const now (m_clock.now());
+        clock_type::rep const elapsed (now.time_since_epoch().count());
+        if (entry.balance (now) < warningThreshold)
+            return false;
+
+        // Only one caller is warned at any instant.
+        auto last = entry.lastWarningTime.load ();
+        if (last == elapsed ||
+                ! entry.lastWarningTime.compare_exchange_strong (last, elapsed))
+            return false;
+
+        charge (entry, feeWarning, now);
+        JLOG(m_journal.info()) << "Load warning: " << entry;
+        ++m_stats.warn;
+        return true;
     }
 
     bool disconnect (Entry& entry)
@@ -477,30 +482,26 @@ public:
         if (entry.isUnlimited())
             return false;
 
-        std::lock_guard<std::recursive_mutex> _(lock_);
-        bool drop (false);
         clock_type::time_point const now (m_clock.now());
         int const balance (entry.balance (now));
-        if (balance >= dropThreshold)
-        {
-            JLOG(m_journal.warn()) <<
-                "Consumer entry " << entry <<
-                " dropped with balance " << balance <<
-                " at or above drop threshold " << dropThreshold;
-
-            // Adding feeDrop at this point keeps the dropped connection
-            // from re-connecting for at least a little while after it is
-            // dropped.
-            charge (entry, feeDrop);
-            ++m_stats.drop;
-            drop = true;
-        }
-        return drop;
+        if (balance < dropThreshold)
+            return false;
+
+        JLOG(m_journal.warn()) <<
+            "Consumer entry " << entry <<
+            " dropped with balance " << balance <<
+            " at or above drop threshold " << dropThreshold;
+
+        // Adding feeDrop at this point keeps the dropped connection
+        // from re-connecting for at least a little while after it is
+        // dropped.
+        charge (entry, feeDrop, now);
+        ++m_stats.drop;
+        return true;
     }
 
     int balance (Entry& entry)
     {
-        std::lock_guard<std::recursive_mutex> _(lock_);
         return entry.balance (m_clock.now());
     }
 
@@ -518,8 +519,9 @@ public:
                 item ["count"] = entry.refcount;
             item ["name"] = entry.to_string();
             item ["balance"] = entry.balance(now);
-            if (entry.remote_balance != 0)
-                item ["remote_balance"] = entry.remote_balance;
+            int const remote = entry.remote_balance.load ();
+            if (remote != 0)
+                item ["remote_balance"] = remote;
         }
     }
 
@@ -26,6 +26,7 @@
 #include <ripple/rpc/Role.h>
 
 #include <ripple/beast/utility/Journal.h>
+#include <chrono>
 
 namespace ripple {
 
@@ -58,6 +59,9 @@ struct Context
     std::shared_ptr<JobQueue::Coro> coro;
     InfoSub::pointer infoSub;
     Headers headers;
+
+    // Time spent suspended on coro, which is not counted as latency
+    std::chrono::steady_clock::duration suspended {};
 };
 
 } // RPC
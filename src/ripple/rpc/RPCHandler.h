@@ -33,8 +33,19 @@ struct Context;
 /** Execute an RPC command and store the results in a Json::Value. */
 Status doCommand (RPC::Context&, Json::Value&);
 
-/** Execute an RPC command and store the results in an std::string. */
-void executeRPC (RPC::Context&, std::string&);
+/** Execute an RPC command and store its result, with its status, in an
+    std::string.
+
+    A handler which can write to a Json::Object streams its result without
+    building a Json::Value. The output is the same, byte for byte, as the
+    to_string of the result filled by doCommand with its status added.
+
+    @param request The request as received, reported with an error.
+                   Defaults to the context's params.
+    @return true if the command succeeded.
+*/
+bool executeRPC (RPC::Context&, std::string&);
+bool executeRPC (RPC::Context&, std::string&, Json::Value const& request);
 
 Role roleRequired (std::string const& method );
 
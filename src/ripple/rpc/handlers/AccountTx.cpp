@@ -18,6 +18,7 @@
 //==============================================================================
 
 #include <BeastConfig.h>
+#include <ripple/rpc/handlers/AccountTxHandler.h>
 #include <ripple/app/ledger/LedgerMaster.h>
 #include <ripple/app/main/Application.h>
 #include <ripple/app/misc/NetworkOPs.h>
@@ -35,45 +36,57 @@
 
 namespace ripple {
 
-// {
-//   account: account,
-//   ledger_index_min: ledger_index  // optional, defaults to earliest
-//   ledger_index_max: ledger_index, // optional, defaults to latest
-//   binary: boolean,                // optional, defaults to false
-//   forward: boolean,               // optional, defaults to false
-//   limit: integer,                 // optional
-//   marker: opaque                  // optional, resume previous query
-// }
-Json::Value doAccountTx (RPC::Context& context)
+Json::Value doAccountTxOld (RPC::Context& context);
+
+namespace RPC {
+
+AccountTxHandler::AccountTxHandler (Context& context) : context_ (context)
 {
-    auto& params = context.params;
+}
 
-    int limit = params.isMember (jss::limit) ?
+Status AccountTxHandler::check ()
+{
+    auto& params = context_.params;
+
+    // Temporary switching code until the old account_tx is removed
+    if (params.isMember (jss::offset) ||
+        params.isMember (jss::count) ||
+        params.isMember (jss::descending) ||
+        params.isMember (jss::ledger_max) ||
+        params.isMember (jss::ledger_min))
+    {
+        old_ = doAccountTxOld (context_);
+        if (old_.isMember (jss::error))
+        {
+            return Status (
+                error_code_i (old_[jss::error_code].asInt ()),
+                old_[jss::error_message].asString ());
+        }
+        return Status::OK;
+    }
+
+    limit_ = params.isMember (jss::limit) ?
             params[jss::limit].asUInt () : -1;
-    bool bBinary = params.isMember (jss::binary) && params[jss::binary].asBool ();
+    binary_ = params.isMember (jss::binary) && params[jss::binary].asBool ();
     bool bForward = params.isMember (jss::forward) && params[jss::forward].asBool ();
-    std::uint32_t   uLedgerMin;
-    std::uint32_t   uLedgerMax;
-    std::uint32_t   uValidatedMin;
-    std::uint32_t   uValidatedMax;
-    bool bValidated = context.ledgerMaster.getValidatedRange (
-        uValidatedMin, uValidatedMax);
-
-    if (!bValidated)
+
+    if (!context_.ledgerMaster.getValidatedRange (
+        validatedMin_, validatedMax_))
     {
         // Don't have a validated ledger range.
-        return rpcError (rpcLGR_IDXS_INVALID);
+        return rpcLGR_IDXS_INVALID;
     }
 
     if (!params.isMember (jss::account))
-        return rpcError (rpcINVALID_PARAMS);
+        return rpcINVALID_PARAMS;
 
     auto const account = parseBase58<AccountID>(
         params[jss::account].asString());
     if (! account)
-        return rpcError (rpcACT_MALFORMED);
+        return rpcACT_MALFORMED;
+    account_ = *account;
 
-    context.loadType = Resource::feeMediumBurdenRPC;
+    context_.loadType = Resource::feeMediumBurdenRPC;
 
     if (params.isMember (jss::ledger_index_min) ||
         params.isMember (jss::ledger_index_max))
@@ -83,114 +96,63 @@ Json::Value doAccountTx (RPC::Context& context)
         std::int64_t iLedgerMax  = params.isMember (jss::ledger_index_max)
                 ? params[jss::ledger_index_max].asInt () : -1;
 
-        uLedgerMin  = iLedgerMin == -1 ? uValidatedMin :
-            ((iLedgerMin >= uValidatedMin) ? iLedgerMin : uValidatedMin);
-        uLedgerMax  = iLedgerMax == -1 ? uValidatedMax :
-            ((iLedgerMax <= uValidatedMax) ? iLedgerMax : uValidatedMax);
+        ledgerMin_  = iLedgerMin == -1 ? validatedMin_ :
+            ((iLedgerMin >= validatedMin_) ? iLedgerMin : validatedMin_);
+        ledgerMax_  = iLedgerMax == -1 ? validatedMax_ :
+            ((iLedgerMax <= validatedMax_) ? iLedgerMax : validatedMax_);
 
-        if (uLedgerMax < uLedgerMin)
-            return rpcError (rpcLGR_IDXS_INVALID);
+        if (ledgerMax_ < ledgerMin_)
+            return rpcLGR_IDXS_INVALID;
     }
     else
     {
         std::shared_ptr<ReadView const> ledger;
-        auto ret = RPC::lookupLedger (ledger, context);
+        Json::Value result;
+        if (auto s = lookupLedger (ledger, context_, result))
+            return s;
 
-        if (! ledger)
-            return ret;
-
-        if (! ret[jss::validated].asBool() ||
-            (ledger->info().seq > uValidatedMax) ||
-            (ledger->info().seq < uValidatedMin))
+        if (! result[jss::validated].asBool() ||
+            (ledger->info().seq > validatedMax_) ||
+            (ledger->info().seq < validatedMin_))
         {
-            return rpcError (rpcLGR_NOT_VALIDATED);
+            return rpcLGR_NOT_VALIDATED;
         }
 
-        uLedgerMin = uLedgerMax = ledger->info().seq;
+        ledgerMin_ = ledgerMax_ = ledger->info().seq;
     }
 
-    Json::Value resumeToken;
-
     if (params.isMember(jss::marker))
-         resumeToken = params[jss::marker];
+         marker_ = params[jss::marker];
 
+    // The transactions are fetched here, so that a failure is reported
+    // before any of the result has been written.
 #ifndef BEAST_DEBUG
 
     try
     {
 #endif
-        Json::Value ret (Json::objectValue);
-
-        ret[jss::account] = context.app.accountIDCache().toBase58(*account);
-        Json::Value& jvTxns = (ret[jss::transactions] = Json::arrayValue);
-
-        if (bBinary)
+        if (binary_)
         {
-            auto txns = context.netOps.getTxsAccountB (
-                *account, uLedgerMin, uLedgerMax, bForward, resumeToken, limit,
-                isUnlimited (context.role));
-
-            for (auto& it: txns)
-            {
-                Json::Value& jvObj = jvTxns.append (Json::objectValue);
-
-                jvObj[jss::tx_blob] = std::get<0> (it);
-                jvObj[jss::meta] = std::get<1> (it);
-
-                std::uint32_t uLedgerIndex = std::get<2> (it);
-
-                jvObj[jss::ledger_index] = uLedgerIndex;
-                jvObj[jss::validated] = bValidated &&
-                    uValidatedMin <= uLedgerIndex &&
-                    uValidatedMax >= uLedgerIndex;
-            }
+            binaryTxns_ = context_.netOps.getTxsAccountB (
+                account_, ledgerMin_, ledgerMax_, bForward, marker_, limit_,
+                isUnlimited (context_.role));
         }
         else
         {
-            auto txns = context.netOps.getTxsAccount (
-                *account, uLedgerMin, uLedgerMax, bForward, resumeToken, limit,
-                isUnlimited (context.role));
-
-            for (auto& it: txns)
-            {
-                Json::Value& jvObj = jvTxns.append (Json::objectValue);
-
-                if (it.first)
-                    jvObj[jss::tx] = it.first->getJson (1);
-
-                if (it.second)
-                {
-                    auto meta = it.second->getJson (1);
-                    addPaymentDeliveredAmount (meta, context, it.first, it.second);
-                    jvObj[jss::meta] = std::move(meta);
-
-                    std::uint32_t uLedgerIndex = it.second->getLgrSeq ();
-
-                    jvObj[jss::validated] = bValidated &&
-                        uValidatedMin <= uLedgerIndex &&
-                        uValidatedMax >= uLedgerIndex;
-                }
-
-            }
+            txns_ = context_.netOps.getTxsAccount (
+                account_, ledgerMin_, ledgerMax_, bForward, marker_, limit_,
+                isUnlimited (context_.role));
         }
-
-        //Add information about the original query
-        ret[jss::ledger_index_min] = uLedgerMin;
-        ret[jss::ledger_index_max] = uLedgerMax;
-        if (params.isMember (jss::limit))
-            ret[jss::limit]        = limit;
-        if (resumeToken)
-            ret[jss::marker] = resumeToken;
-
-        return ret;
 #ifndef BEAST_DEBUG
     }
     catch (std::exception const&)
     {
-        return rpcError (rpcINTERNAL);
+        return rpcINTERNAL;
     }
 
 #endif
+    return Status::OK;
 }
 
+} // RPC
 } // ripple
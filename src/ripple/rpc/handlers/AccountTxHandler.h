@@ -0,0 +1,173 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012-2014 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#ifndef RIPPLE_RPC_HANDLERS_ACCOUNTTX_H_INCLUDED
+#define RIPPLE_RPC_HANDLERS_ACCOUNTTX_H_INCLUDED
+
+#include <ripple/app/ledger/LedgerMaster.h>
+#include <ripple/app/misc/NetworkOPs.h>
+#include <ripple/app/misc/Transaction.h>
+#include <ripple/json/Object.h>
+#include <ripple/protocol/AccountID.h>
+#include <ripple/protocol/JsonFields.h>
+#include <ripple/rpc/Context.h>
+#include <ripple/rpc/Status.h>
+#include <ripple/rpc/impl/Handler.h>
+#include <ripple/rpc/impl/RPCHelpers.h>
+#include <ripple/rpc/Role.h>
+#include <cstring>
+
+namespace ripple {
+namespace RPC {
+
+// {
+//   account: account,
+//   ledger_index_min: ledger_index  // optional, defaults to earliest
+//   ledger_index_max: ledger_index, // optional, defaults to latest
+//   binary: boolean,                // optional, defaults to false
+//   forward: boolean,               // optional, defaults to false
+//   limit: integer,                 // optional
+//   marker: opaque                  // optional, resume previous query
+// }
+//
+// Requests with offset, count, descending, ledger_max or ledger_min are
+// answered by the deprecated doAccountTxOld.
+
+class AccountTxHandler {
+public:
+    explicit AccountTxHandler (Context&);
+
+    Status check ();
+
+    template <class Object>
+    void writeResult (Object&);
+
+    static const char* const name()
+    {
+        return "account_tx";
+    }
+
+    static Role role()
+    {
+        return Role::USER;
+    }
+
+    static Condition condition()
+    {
+        return NO_CONDITION;
+    }
+
+private:
+    bool validated (std::uint32_t ledgerIndex) const
+    {
+        return validatedMin_ <= ledgerIndex && validatedMax_ >= ledgerIndex;
+    }
+
+    Context& context_;
+    Json::Value old_;
+    AccountID account_;
+    bool binary_ = false;
+    int limit_ = -1;
+    std::uint32_t ledgerMin_ = 0;
+    std::uint32_t ledgerMax_ = 0;
+    std::uint32_t validatedMin_ = 0;
+    std::uint32_t validatedMax_ = 0;
+    Json::Value marker_;
+    NetworkOPs::AccountTxs txns_;
+    NetworkOPs::MetaTxsList binaryTxns_;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+//
+// Implementation.
+
+template <class Object>
+void AccountTxHandler::writeResult (Object& value)
+{
+    // Members are written in key order, so that the streamed result matches
+    // the Json::Value one: see setSuccess.
+    if (old_)
+    {
+        bool status = false;
+        for (auto iter = old_.begin(); iter != old_.end(); ++iter)
+        {
+            auto const key = iter.memberName();
+            if (! status && std::strcmp (jss::status, key) < 0)
+            {
+                setSuccess (value);
+                status = true;
+            }
+            value[key] = *iter;
+        }
+        if (! status)
+            setSuccess (value);
+        return;
+    }
+
+    value[jss::account] = context_.app.accountIDCache().toBase58 (account_);
+    value[jss::ledger_index_max] = ledgerMax_;
+    value[jss::ledger_index_min] = ledgerMin_;
+    if (context_.params.isMember (jss::limit))
+        value[jss::limit] = limit_;
+    if (marker_)
+        value[jss::marker] = marker_;
+    setSuccess (value);
+
+    auto&& transactions = Json::setArray (value, jss::transactions);
+    if (binary_)
+    {
+        for (auto const& it : binaryTxns_)
+        {
+            auto&& entry = Json::appendObject (transactions);
+            std::uint32_t const ledgerIndex = std::get<2> (it);
+            entry[jss::ledger_index] = ledgerIndex;
+            entry[jss::meta] = std::get<1> (it);
+            entry[jss::tx_blob] = std::get<0> (it);
+            entry[jss::validated] = validated (ledgerIndex);
+        }
+    }
+    else
+    {
+        for (auto const& it : txns_)
+        {
+            auto&& entry = Json::appendObject (transactions);
+            if (it.second)
+            {
+                auto&& meta = Json::addObject (entry, jss::meta);
+                addFields (meta, it.second->getAsObject (), 1);
+                addPaymentDeliveredAmount (meta, context_, it.first, it.second);
+            }
+            if (it.first)
+            {
+                auto&& tx = Json::addObject (entry, jss::tx);
+                addFields (tx, *it.first->getSTransaction (), 0);
+                addTransactionDetails (tx, *it.first, context_.ledgerMaster);
+            }
+            if (it.second)
+                entry[jss::validated] = validated (it.second->getLgrSeq ());
+        }
+    }
+}
+
+} // RPC
+} // ripple
+
+#endif
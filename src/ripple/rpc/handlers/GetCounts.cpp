@@ -22,9 +22,11 @@
 #include <ripple/app/ledger/InboundLedgers.h>
 #include <ripple/app/ledger/LedgerMaster.h>
 #include <ripple/app/main/Application.h>
+#include <ripple/app/main/MemoryBudget.h>
 #include <ripple/app/misc/NetworkOPs.h>
 #include <ripple/basics/UptimeTimer.h>
 #include <ripple/core/DatabaseCon.h>
+#include <ripple/core/LatencyJson.h>
 #include <ripple/json/json_value.h>
 #include <ripple/ledger/CachedSLEs.h>
 #include <ripple/net/RPCErr.h>
@@ -32,6 +34,7 @@
 #include <ripple/protocol/ErrorCodes.h>
 #include <ripple/protocol/JsonFields.h>
 #include <ripple/rpc/Context.h>
+#include <ripple/rpc/impl/Handler.h>
 
 namespace ripple {
 
@@ -101,6 +104,8 @@ Json::Value doGetCounts (RPC::Context& context)
 
     ret[jss::historical_perminute] = static_cast<int>(
         context.app.getInboundLedgers().fetchRate());
+    ret[jss::backfill_rate] =
+        context.app.getLedgerMaster().getBackfillRate();
     ret[jss::SLE_hit_rate] = context.app.cachedSLEs().rate();
     ret[jss::node_hit_rate] = context.app.getNodeStore ().getCacheHitRate ();
     ret[jss::ledger_hit_rate] = context.app.getLedgerMaster ().getCacheHitRate ();
@@ -110,6 +115,28 @@ Json::Value doGetCounts (RPC::Context& context)
     ret[jss::treenode_cache_size] = context.app.family().treecache().getCacheSize();
     ret[jss::treenode_track_size] = context.app.family().treecache().getTrackSize();
 
+    {
+        auto& app = context.app;
+        Json::Value& memory = (ret[jss::memory] = Json::objectValue);
+        memory["treenode_cache"] = std::to_string (
+            app.family().treecache().getMemoryUsage());
+        memory["fullbelow_cache"] = std::to_string (
+            app.family().fullbelow().getMemoryUsage());
+        memory["node_cache"] = std::to_string (
+            app.getNodeStore().getCacheMemoryUsage());
+        memory["ledger_cache"] = std::to_string (
+            app.getLedgerMaster().getCacheMemoryUsage());
+        memory["sle_cache"] = std::to_string (
+            app.cachedSLEs().getMemoryUsage());
+        memory["inbound_ledgers"] = std::to_string (
+            app.getInboundLedgers().getMemoryUsage());
+        if (auto const rss = MemoryBudget::residentBytes ())
+            memory["resident"] = std::to_string (*rss);
+
+        if (app.getMemoryBudget().budget() != 0)
+            ret[jss::memory_budget] = app.getMemoryBudget().getJson();
+    }
+
     std::string uptime;
     int s = UptimeTimer::getInstance ().getElapsedSeconds ();
     textTime (uptime, s, "year", 365 * 24 * 60 * 60);
@@ -125,6 +152,18 @@ Json::Value doGetCounts (RPC::Context& context)
     ret[jss::node_written_bytes] = context.app.getNodeStore().getStoreSize();
     ret[jss::node_read_bytes] = context.app.getNodeStore().getFetchSize();
 
+    ret["node_fetch_latency"] = getLatencyJson (
+        context.app.getNodeStore().getFetchLatency());
+
+    Json::Value rpcLatency (Json::objectValue);
+    for (auto const handler : RPC::getHandlers ())
+    {
+        auto const latency = handler->latency_->snapshot ();
+        if (latency.count () != 0)
+            rpcLatency[handler->name_] = getLatencyJson (latency);
+    }
+    ret["rpc_latency"] = rpcLatency;
+
     return ret;
 }
 
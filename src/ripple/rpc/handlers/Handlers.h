@@ -20,7 +20,9 @@
 #ifndef RIPPLE_RPC_HANDLERS_HANDLERS_H_INCLUDED
 #define RIPPLE_RPC_HANDLERS_HANDLERS_H_INCLUDED
 
+#include <ripple/rpc/handlers/AccountTxHandler.h>
 #include <ripple/rpc/handlers/LedgerHandler.h>
+#include <ripple/rpc/handlers/TxHandler.h>
 
 namespace ripple {
 
@@ -30,8 +32,6 @@ Json::Value doAccountLines          (RPC::Context&);
 Json::Value doAccountChannels       (RPC::Context&);
 Json::Value doAccountObjects        (RPC::Context&);
 Json::Value doAccountOffers         (RPC::Context&);
-Json::Value doAccountTx             (RPC::Context&);
-Json::Value doAccountTxSwitch       (RPC::Context&);
 Json::Value doAccountTxOld          (RPC::Context&);
 Json::Value doBookOffers            (RPC::Context&);
 Json::Value doBlackList             (RPC::Context&);
@@ -45,6 +45,7 @@ Json::Value doFee                   (RPC::Context&);
 Json::Value doFetchInfo             (RPC::Context&);
 Json::Value doGatewayBalances       (RPC::Context&);
 Json::Value doGetCounts             (RPC::Context&);
+Json::Value doJobProfile            (RPC::Context&);
 Json::Value doLedgerAccept          (RPC::Context&);
 Json::Value doLedgerCleaner         (RPC::Context&);
 Json::Value doLedgerClosed          (RPC::Context&);
@@ -74,7 +75,6 @@ Json::Value doSubmit                (RPC::Context&);
 Json::Value doSubmitMultiSigned     (RPC::Context&);
 Json::Value doSubscribe             (RPC::Context&);
 Json::Value doTransactionEntry      (RPC::Context&);
-Json::Value doTx                    (RPC::Context&);
 Json::Value doTxHistory             (RPC::Context&);
 Json::Value doUnlAdd                (RPC::Context&);
 Json::Value doUnlDelete             (RPC::Context&);
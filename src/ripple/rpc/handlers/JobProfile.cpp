@@ -18,29 +18,41 @@
 //==============================================================================
 
 #include <BeastConfig.h>
+#include <ripple/app/main/Application.h>
+#include <ripple/core/JobQueue.h>
 #include <ripple/json/json_value.h>
-#include <ripple/net/RPCErr.h>
+#include <ripple/protocol/ErrorCodes.h>
 #include <ripple/protocol/JsonFields.h>
-#include <ripple/resource/Fees.h>
 #include <ripple/rpc/Context.h>
 
 namespace ripple {
 
-Json::Value doAccountTxOld (RPC::Context& context);
-        Json::Value doAccountTx (RPC::Context& context);
-
-// Temporary switching code until the old account_tx is removed
-Json::Value doAccountTxSwitch (RPC::Context& context)
+// {
+//   frequency: <number>   // optional, samples per second, 0 stops
+//   reset: <bool>         // optional, clear the counts after reporting
+// }
+Json::Value doJobProfile (RPC::Context& context)
 {
-    if (context.params.isMember(jss::offset) ||
-        context.params.isMember(jss::count) ||
-        context.params.isMember(jss::descending) ||
-        context.params.isMember(jss::ledger_max) ||
-        context.params.isMember(jss::ledger_min))
+    auto& profiler = context.app.getJobQueue ().profiler ();
+
+    if (context.params.isMember (jss::frequency))
+    {
+        auto const& frequency = context.params[jss::frequency];
+        if (! frequency.isConvertibleTo (Json::uintValue))
+            return RPC::expected_field_error (
+                jss::frequency, "unsigned integer");
+        profiler.setFrequency (frequency.asUInt ());
+    }
+
+    bool reset = false;
+    if (context.params.isMember (jss::reset))
     {
-        return doAccountTxOld(context);
+        if (! context.params[jss::reset].isBool ())
+            return RPC::expected_field_error (jss::reset, "bool");
+        reset = context.params[jss::reset].asBool ();
     }
-    return doAccountTx(context);
+
+    return profiler.getJson (reset);
 }
 
 } // ripple
@@ -29,7 +29,9 @@
 #include <ripple/rpc/Context.h>
 #include <ripple/rpc/Status.h>
 #include <ripple/rpc/impl/Handler.h>
+#include <ripple/rpc/impl/RPCHelpers.h>
 #include <ripple/rpc/Role.h>
+#include <cstring>
 
 namespace Json {
 class Object;
@@ -85,10 +87,25 @@ private:
 template <class Object>
 void LedgerHandler::writeResult (Object& value)
 {
+    // Members are written in key order: see setSuccess.
     if (ledger_)
     {
-        Json::copyFrom (value, result_);
+        // lookupLedger only adds members which sort after "ledger"
         addJson (value, {*ledger_, options_});
+
+        bool status = false;
+        for (auto iter = result_.begin(); iter != result_.end(); ++iter)
+        {
+            auto const key = iter.memberName();
+            if (! status && std::strcmp (jss::status, key) < 0)
+            {
+                setSuccess (value);
+                status = true;
+            }
+            value[key] = *iter;
+        }
+        if (! status)
+            setSuccess (value);
     }
     else
     {
@@ -101,6 +118,7 @@ void LedgerHandler::writeResult (Object& value)
             auto&& open = Json::addObject (value, jss::open);
             addJson (open, {*master.getCurrentLedger(), 0});
         }
+        setSuccess (value);
     }
 }
 
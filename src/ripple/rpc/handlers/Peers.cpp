@@ -37,6 +37,7 @@ Json::Value doPeers (RPC::Context& context)
         auto lock = make_lock(context.app.getMasterMutex());
 
         jvResult[jss::peers] = context.app.overlay ().json ();
+        jvResult[jss::traffic] = context.app.overlay ().trafficJson ();
 
         auto const now = context.app.timeKeeper().now();
         auto const self = context.app.nodeIdentity().first;
@@ -60,7 +60,10 @@ Json::Value doRipplePathFind (RPC::Context& context)
                 context.consumer, lpLedger, context.params);
         if (request)
         {
+            auto const suspendedAt = std::chrono::steady_clock::now ();
             context.coro->yield();
+            context.suspended +=
+                std::chrono::steady_clock::now () - suspendedAt;
             jvResult = request->doStatus (context.params);
         }
 
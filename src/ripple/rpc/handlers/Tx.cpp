@@ -18,6 +18,7 @@
 //==============================================================================
 
 #include <BeastConfig.h>
+#include <ripple/rpc/handlers/TxHandler.h>
 #include <ripple/app/ledger/LedgerMaster.h>
 #include <ripple/app/ledger/TransactionMaster.h>
 #include <ripple/app/main/Application.h>
@@ -31,10 +32,6 @@
 
 namespace ripple {
 
-// {
-//   transaction: <hex>
-// }
-
 static
 bool
 isHexTxID (std::string const& txid)
@@ -84,64 +81,60 @@ getMetaHex (Ledger const& ledger,
     return true;
 }
 
-Json::Value doTx (RPC::Context& context)
+namespace RPC {
+
+TxHandler::TxHandler (Context& context) : context_ (context)
+{
+}
+
+Status TxHandler::check ()
 {
-    if (!context.params.isMember (jss::transaction))
-        return rpcError (rpcINVALID_PARAMS);
+    auto const& params = context_.params;
+    if (!params.isMember (jss::transaction))
+        return rpcINVALID_PARAMS;
 
-    bool binary = context.params.isMember (jss::binary)
-            && context.params[jss::binary].asBool ();
+    binary_ = params.isMember (jss::binary) && params[jss::binary].asBool ();
 
-    auto const txid  = context.params[jss::transaction].asString ();
+    auto const txid  = params[jss::transaction].asString ();
 
     if (!isHexTxID (txid))
-        return rpcError (rpcNOT_IMPL);
+        return rpcNOT_IMPL;
 
-    auto txn = context.app.getMasterTransaction ().fetch (
+    txn_ = context_.app.getMasterTransaction ().fetch (
         from_hex_text<uint256>(txid), true);
 
-    if (!txn)
-        return rpcError (rpcTXN_NOT_FOUND);
+    if (!txn_)
+        return rpcTXN_NOT_FOUND;
 
-    Json::Value ret = txn->getJson (1, binary);
+    if (txn_->getLedger () == 0)
+        return Status::OK;
 
-    if (txn->getLedger () == 0)
-        return ret;
-
-    if (auto lgr = context.ledgerMaster.getLedgerBySeq (txn->getLedger ()))
+    if (auto lgr = context_.ledgerMaster.getLedgerBySeq (txn_->getLedger ()))
     {
         bool okay = false;
 
-        if (binary)
+        if (binary_)
         {
-            std::string meta;
-
-            if (getMetaHex (*lgr, txn->getID (), meta))
-            {
-                ret[jss::meta] = meta;
-                okay = true;
-            }
+            okay = getMetaHex (*lgr, txn_->getID (), metaHex_);
         }
         else
         {
-            auto rawMeta = lgr->txRead (txn->getID()).second;
+            auto rawMeta = lgr->txRead (txn_->getID()).second;
             if (rawMeta)
             {
-                auto txMeta = std::make_shared<TxMeta> (txn->getID (),
-                    lgr->seq (), *rawMeta, context.app.journal ("TxMeta"));
+                meta_ = std::make_shared<TxMeta> (txn_->getID (),
+                    lgr->seq (), *rawMeta, context_.app.journal ("TxMeta"));
                 okay = true;
-                auto meta = txMeta->getJson (0);
-                addPaymentDeliveredAmount (meta, context, txn, txMeta);
-                ret[jss::meta] = meta;
             }
         }
 
         if (okay)
-            ret[jss::validated] = isValidated (
-                context, lgr->info().seq, lgr->info().hash);
+            validated_ = isValidated (
+                context_, lgr->info().seq, lgr->info().hash);
     }
 
-    return ret;
+    return Status::OK;
 }
 
+} // RPC
 } // ripple
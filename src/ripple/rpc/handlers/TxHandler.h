@@ -0,0 +1,117 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012-2014 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#ifndef RIPPLE_RPC_HANDLERS_TX_H_INCLUDED
+#define RIPPLE_RPC_HANDLERS_TX_H_INCLUDED
+
+#include <ripple/app/ledger/LedgerMaster.h>
+#include <ripple/app/misc/Transaction.h>
+#include <ripple/json/Object.h>
+#include <ripple/ledger/TxMeta.h>
+#include <ripple/protocol/JsonFields.h>
+#include <ripple/rpc/Context.h>
+#include <ripple/rpc/Status.h>
+#include <ripple/rpc/impl/Handler.h>
+#include <ripple/rpc/impl/RPCHelpers.h>
+#include <ripple/rpc/Role.h>
+#include <boost/optional.hpp>
+
+namespace ripple {
+namespace RPC {
+
+// {
+//   transaction: <hex>
+//   binary: true | false    // optional, defaults to false.
+// }
+
+class TxHandler {
+public:
+    explicit TxHandler (Context&);
+
+    Status check ();
+
+    template <class Object>
+    void writeResult (Object&);
+
+    static const char* const name()
+    {
+        return "tx";
+    }
+
+    static Role role()
+    {
+        return Role::USER;
+    }
+
+    static Condition condition()
+    {
+        return NEEDS_NETWORK_CONNECTION;
+    }
+
+private:
+    Context& context_;
+    Transaction::pointer txn_;
+    bool binary_ = false;
+    std::string metaHex_;
+    TxMeta::pointer meta_;
+    boost::optional<bool> validated_;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+//
+// Implementation.
+
+template <class Object>
+void TxHandler::writeResult (Object& value)
+{
+    // Members are written in the key order of Transaction::getJson (1),
+    // so that the streamed result matches the Json::Value one: see setSuccess.
+    auto const& stx = *txn_->getSTransaction ();
+    if (binary_)
+    {
+        addTransactionDetails (value, *txn_, context_.ledgerMaster);
+        if (validated_)
+            value[jss::meta] = metaHex_;
+        setSuccess (value);
+        value[jss::tx] = strHex (stx.getSerializer ().peekData ());
+    }
+    else
+    {
+        addFields (value, stx, 0);
+        addTransactionDetails (value, *txn_, context_.ledgerMaster);
+        if (validated_)
+        {
+            // The meta object must be closed before "status" is written.
+            auto&& meta = Json::addObject (value, jss::meta);
+            addFields (meta, meta_->getAsObject (), 0);
+            addPaymentDeliveredAmount (meta, context_, txn_, meta_);
+        }
+        setSuccess (value);
+    }
+
+    if (validated_)
+        value[jss::validated] = *validated_;
+}
+
+} // RPC
+} // ripple
+
+#endif
@@ -38,6 +38,7 @@ public:
     template <class Object>
     void writeResult (Object& obj)
     {
+        setSuccess (obj);
         setVersion (obj);
     }
 
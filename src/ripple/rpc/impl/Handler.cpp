@@ -70,8 +70,14 @@ class HandlerTable {
         }
 
         // This is where the new-style handlers are added.
+        addHandler<AccountTxHandler>();
         addHandler<LedgerHandler>();
+        addHandler<TxHandler>();
         addHandler<VersionHandler>();
+
+        for (auto& entry : table_)
+            entry.second.latency_ =
+                std::make_shared<beast::insight::Histogram>();
     }
 
     const Handler* getHandler(std::string name) const {
@@ -79,6 +85,14 @@ class HandlerTable {
         return i == table_.end() ? nullptr : &i->second;
     }
 
+    std::vector<Handler const*> getHandlers() const {
+        std::vector<Handler const*> ret;
+        ret.reserve(table_.size());
+        for (auto const& entry : table_)
+            ret.push_back(&entry.second);
+        return ret;
+    }
+
   private:
     std::map<std::string, Handler> table_;
 
@@ -107,7 +121,6 @@ Handler handlerArray[] {
     {   "account_channels",     byRef (&doAccountChannels),     Role::USER,  NO_CONDITION  },
     {   "account_objects",      byRef (&doAccountObjects),      Role::USER,  NO_CONDITION  },
     {   "account_offers",       byRef (&doAccountOffers),       Role::USER,  NO_CONDITION  },
-    {   "account_tx",           byRef (&doAccountTxSwitch),     Role::USER,  NO_CONDITION  },
     {   "blacklist",            byRef (&doBlackList),           Role::ADMIN,   NO_CONDITION     },
     {   "book_offers",          byRef (&doBookOffers),          Role::USER,  NO_CONDITION  },
     {   "can_delete",           byRef (&doCanDelete),           Role::ADMIN,   NO_CONDITION     },
@@ -117,6 +130,7 @@ Handler handlerArray[] {
     {   "consensus_info",       byRef (&doConsensusInfo),       Role::ADMIN,   NO_CONDITION     },
     {   "gateway_balances",     byRef (&doGatewayBalances),     Role::USER,  NO_CONDITION  },
     {   "get_counts",           byRef (&doGetCounts),           Role::ADMIN,   NO_CONDITION     },
+    {   "job_profile",          byRef (&doJobProfile),          Role::ADMIN,   NO_CONDITION     },
     {   "feature",              byRef (&doFeature),             Role::ADMIN,   NO_CONDITION     },
     {   "fee",                  byRef (&doFee),                 Role::USER,    NO_CONDITION     },
     {   "fetch_info",           byRef (&doFetchInfo),           Role::ADMIN,   NO_CONDITION     },
@@ -147,7 +161,6 @@ Handler handlerArray[] {
     {   "server_state",         byRef (&doServerState),         Role::USER,  NO_CONDITION     },
     {   "stop",                 byRef (&doStop),                Role::ADMIN,   NO_CONDITION     },
     {   "transaction_entry",    byRef (&doTransactionEntry),    Role::USER,  NO_CONDITION  },
-    {   "tx",                   byRef (&doTx),                  Role::USER,  NEEDS_NETWORK_CONNECTION  },
     {   "tx_history",           byRef (&doTxHistory),           Role::USER,  NO_CONDITION     },
     {   "unl_add",              byRef (&doUnlAdd),              Role::ADMIN,   NO_CONDITION     },
     {   "unl_delete",           byRef (&doUnlDelete),           Role::ADMIN,   NO_CONDITION     },
@@ -162,11 +175,19 @@ Handler handlerArray[] {
     {   "unsubscribe",          byRef (&doUnsubscribe),         Role::USER,  NO_CONDITION     },
 };
 
+HandlerTable const& getHandlerTable() {
+    static HandlerTable const handlers(handlerArray);
+    return handlers;
+}
+
 } // namespace
 
 const Handler* getHandler(std::string const& name) {
-    static HandlerTable const handlers(handlerArray);
-    return handlers.getHandler(name);
+    return getHandlerTable().getHandler(name);
+}
+
+std::vector<Handler const*> getHandlers() {
+    return getHandlerTable().getHandlers();
 }
 
 } // RPC
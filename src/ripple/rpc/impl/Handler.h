@@ -23,6 +23,9 @@
 #include <ripple/core/Config.h>
 #include <ripple/rpc/RPCHandler.h>
 #include <ripple/rpc/Status.h>
+#include <ripple/beast/insight/Histogram.h>
+#include <memory>
+#include <vector>
 
 namespace Json {
 class Object;
@@ -49,10 +52,16 @@ struct Handler
     Role role_;
     RPC::Condition condition_;
     Method<Json::Object> objectMethod_;
+
+    // How long calls to this command run, excluding time suspended
+    std::shared_ptr<beast::insight::Histogram> latency_;
 };
 
 const Handler* getHandler (std::string const&);
 
+/** Return every handler, in name order. */
+std::vector<Handler const*> getHandlers ();
+
 /** Return a Json::objectValue with a single entry. */
 template <class Value>
 Json::Value makeObjectValue (
@@ -190,13 +190,18 @@ error_code_i fillHandler (Context& context,
 
 template <class Object, class Method>
 Status callMethod (
-    Context& context, Method method, std::string const& name, Object& result)
+    Context& context, Method method, Handler const& handler, Object& result)
 {
+    // Latency is the time the command held a thread, so any time it spent
+    // suspended (for example, waiting for a path request) is left out.
+    auto const start = std::chrono::steady_clock::now ();
+    auto const suspended = context.suspended;
+    Status status;
     try
     {
         auto v = context.app.getJobQueue().getLoadEventAP(
-            jtGENERIC, "cmd:" + name);
-        return method (context, result);
+            jtGENERIC, std::string ("cmd:") + handler.name_);
+        status = method (context, result);
     }
     catch (std::exception& e)
     {
@@ -206,25 +211,31 @@ Status callMethod (
             context.loadType = Resource::feeExceptionRPC;
 
         inject_error (rpcINTERNAL, result);
-        return rpcINTERNAL;
+        status = rpcINTERNAL;
     }
+    handler.latency_->record (std::chrono::steady_clock::now () - start -
+        (context.suspended - suspended));
+    return status;
 }
 
-template <class Method, class Object>
-void getResult (
-    Context& context, Method method, Object& object, std::string const& name)
+template <class Object, class Method>
+Status runMethod (
+    Context& context, Method method, Handler const& handler, Object& result)
 {
-    auto&& result = Json::addObject (object, jss::result);
-    if (auto status = callMethod (context, method, name, result))
-    {
-        JLOG (context.j.debug()) << "rpcError: " << status.toString();
-        result[jss::status] = jss::error;
-        result[jss::request] = context.params;
-    }
-    else
-    {
-        result[jss::status] = jss::success;
-    }
+    if (context.headers.user.empty() && context.headers.forwardedFor.empty())
+        return callMethod (context, method, handler, result);
+
+    JLOG(context.j.debug()) << "start command: " << handler.name_ <<
+        ", X-User: " << context.headers.user << ", X-Forwarded-For: " <<
+            context.headers.forwardedFor;
+
+    auto ret = callMethod (context, method, handler, result);
+
+    JLOG(context.j.debug()) << "finish command: " << handler.name_ <<
+        ", X-User: " << context.headers.user << ", X-Forwarded-For: " <<
+            context.headers.forwardedFor;
+
+    return ret;
 }
 
 } // namespace
@@ -240,52 +251,44 @@ Status doCommand (
     }
 
     if (auto method = handler->valueMethod_)
-    {
-        if (! context.headers.user.empty() ||
-            ! context.headers.forwardedFor.empty())
-        {
-            JLOG(context.j.debug()) << "start command: " << handler->name_ <<
-                ", X-User: " << context.headers.user << ", X-Forwarded-For: " <<
-                    context.headers.forwardedFor;
-
-            auto ret = callMethod (context, method, handler->name_, result);
-
-            JLOG(context.j.debug()) << "finish command: " << handler->name_ <<
-                ", X-User: " << context.headers.user << ", X-Forwarded-For: " <<
-                    context.headers.forwardedFor;
-
-            return ret;
-        }
-        else
-        {
-            return callMethod (context, method, handler->name_, result);
-        }
-    }
+        return runMethod (context, method, *handler, result);
 
     return rpcUNKNOWN_COMMAND;
 }
 
-/** Execute an RPC command and store the results in a string. */
-void executeRPC (
-    RPC::Context& context, std::string& output)
+bool executeRPC (
+    RPC::Context& context, std::string& result)
+{
+    return executeRPC (context, result, context.params);
+}
+
+bool executeRPC (
+    RPC::Context& context, std::string& result, Json::Value const& request)
 {
+    Json::Value jvResult (Json::objectValue);
+
     boost::optional <Handler const&> handler;
     if (auto error = fillHandler (context, handler))
     {
-        auto wo = Json::stringWriterObject (output);
-        auto&& sub = Json::addObject (*wo, jss::result);
-        inject_error (error, sub);
+        inject_error (error, jvResult);
     }
     else if (auto method = handler->objectMethod_)
     {
-        auto wo = Json::stringWriterObject (output);
-        getResult (context, method, *wo, handler->name_);
+        Status status;
+        {
+            auto wo = Json::stringWriterObject (result);
+            status = runMethod (context, method, *handler, *wo);
+        }
+        if (! status)
+            return true;
+
+        // The error may have been written part way through the result.
+        result.clear ();
+        status.inject (jvResult);
     }
     else if (auto method = handler->valueMethod_)
     {
-        auto object = Json::Value (Json::objectValue);
-        getResult (context, method, object, handler->name_);
-        output = to_string (object);
+        runMethod (context, method, *handler, jvResult);
     }
     else
     {
@@ -293,6 +296,23 @@ void executeRPC (
         assert (false);
         Throw<std::logic_error> ("RPC handler with no method");
     }
+
+    // Always report "status".  On an error report the request as received.
+    bool const success = ! jvResult.isMember (jss::error);
+    if (success)
+    {
+        jvResult[jss::status] = jss::success;
+    }
+    else
+    {
+        jvResult[jss::status] = jss::error;
+        jvResult[jss::request] = request;
+        JLOG (context.j.debug())  <<
+            "rpcError: " << jvResult [jss::error] <<
+            ": " << jvResult [jss::error_message];
+    }
+    result = to_string (jvResult);
+    return success;
 }
 
 Role roleRequired (std::string const& method)
@@ -21,6 +21,7 @@
 #include <ripple/app/ledger/LedgerMaster.h>
 #include <ripple/app/misc/Transaction.h>
 #include <ripple/ledger/View.h>
+#include <ripple/json/Object.h>
 #include <ripple/net/RPCErr.h>
 #include <ripple/protocol/AccountID.h>
 #include <ripple/rpc/Context.h>
@@ -453,6 +454,68 @@ addPaymentDeliveredAmount(Json::Value& meta, RPC::Context& context,
     meta[jss::delivered_amount] = Json::Value ("unavailable");
 }
 
+void
+addPaymentDeliveredAmount(Json::Object& meta, RPC::Context& context,
+    std::shared_ptr<Transaction> transaction, TxMeta::pointer transactionMeta)
+{
+    Json::Value delivered (Json::objectValue);
+    addPaymentDeliveredAmount (delivered, context,
+        std::move (transaction), std::move (transactionMeta));
+    if (delivered.isMember (jss::delivered_amount))
+        meta[jss::delivered_amount] = delivered[jss::delivered_amount];
+}
+
+void
+addFields(Json::Value& to, STObject const& from, int options)
+{
+    if (! to)
+        to = from.STObject::getJson (options);
+    else
+        Json::copyFrom (to, from.STObject::getJson (options));
+}
+
+void
+addFields(Json::Object& to, STObject const& from, int options)
+{
+    from.addJson (to, options);
+}
+
+template <class Object>
+static
+void
+addDetails(Object& json, Transaction const& transaction,
+    LedgerMaster& ledgerMaster)
+{
+    auto const seq = transaction.getLedger ();
+    if (seq)
+    {
+        if (auto const ct = ledgerMaster.getCloseTimeBySeq (seq))
+            json[jss::date] = ct->time_since_epoch().count();
+    }
+
+    json[jss::hash] = to_string (transaction.getID ());
+
+    if (seq)
+    {
+        json[jss::inLedger] = seq;        // Deprecated.
+        json[jss::ledger_index] = seq;
+    }
+}
+
+void
+addTransactionDetails(Json::Value& json, Transaction const& transaction,
+    LedgerMaster& ledgerMaster)
+{
+    addDetails (json, transaction, ledgerMaster);
+}
+
+void
+addTransactionDetails(Json::Object& json, Transaction const& transaction,
+    LedgerMaster& ledgerMaster)
+{
+    addDetails (json, transaction, ledgerMaster);
+}
+
 void
 injectSLE(Json::Value& jv, SLE const& sle)
 {
@@ -664,6 +727,12 @@ keypairForSignature(Json::Value const& params, Json::Value& error)
     return generateKeyPair (keyType, *seed);
 }
 
+void
+setSuccess(Json::Object& object)
+{
+    object[jss::status] = jss::success;
+}
+
 beast::SemanticVersion const firstVersion ("1.0.0");
 beast::SemanticVersion const goodVersion ("1.0.0");
 beast::SemanticVersion const lastVersion ("1.0.0");
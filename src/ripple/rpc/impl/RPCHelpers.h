@@ -28,12 +28,15 @@
 #include <boost/optional.hpp>
 
 namespace Json {
+class Object;
 class Value;
 }
 
 namespace ripple {
 
+class LedgerMaster;
 class ReadView;
+class STObject;
 class Transaction;
 
 namespace RPC {
@@ -90,6 +93,34 @@ void
 addPaymentDeliveredAmount(Json::Value&, Context&,
     std::shared_ptr<Transaction>, TxMeta::pointer);
 
+/** Add "delivered_amount" to metadata being streamed.
+
+    It sorts after every metadata field, so it is written last.
+*/
+void
+addPaymentDeliveredAmount(Json::Object&, Context&,
+    std::shared_ptr<Transaction>, TxMeta::pointer);
+
+/** Add the fields of an STObject to a result, as getJson gives them.
+
+    A Json::Object is written to directly, without building a Json::Value.
+*/
+void
+addFields(Json::Value&, STObject const&, int options);
+
+void
+addFields(Json::Object&, STObject const&, int options);
+
+/** Add what Transaction::getJson (1) adds to the transaction's fields.
+
+    These are "date", "hash", "inLedger" and "ledger_index", in key order.
+*/
+void
+addTransactionDetails(Json::Value&, Transaction const&, LedgerMaster&);
+
+void
+addTransactionDetails(Json::Object&, Transaction const&, LedgerMaster&);
+
 /** Inject JSON describing ledger entry
 
     Effects:
@@ -119,6 +150,22 @@ extern beast::SemanticVersion const firstVersion;
 extern beast::SemanticVersion const goodVersion;
 extern beast::SemanticVersion const lastVersion;
 
+/** Add "status": "success" to a result being streamed.
+
+    A handler which writes to a Json::Object writes its whole result,
+    status included, in key order, so that it matches the to_string of
+    the Json::Value result. The status of a Json::Value result is added
+    by the caller, so nothing is added to one here.
+*/
+inline
+void
+setSuccess(Json::Value&)
+{
+}
+
+void
+setSuccess(Json::Object&);
+
 template <class Object>
 void
 setVersion(Object& parent)
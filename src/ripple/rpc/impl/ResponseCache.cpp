@@ -0,0 +1,207 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/rpc/impl/ResponseCache.h>
+#include <ripple/app/ledger/LedgerMaster.h>
+#include <ripple/app/main/Application.h>
+#include <ripple/basics/chrono.h>
+#include <ripple/core/Config.h>
+#include <ripple/json/to_string.h>
+#include <ripple/protocol/digest.h>
+#include <ripple/protocol/JsonFields.h>
+#include <ripple/rpc/impl/Tuning.h>
+
+namespace ripple {
+namespace RPC {
+
+namespace {
+
+// Commands whose result depends only on their parameters and the ledger.
+bool
+isCacheable (std::string const& command)
+{
+    return command == "account_info" ||
+        command == "book_offers" ||
+        command == "ledger" ||
+        command == "ledger_data";
+}
+
+// The hash of the validated ledger a request resolves to, if any.
+// Requests for the open or closed ledger, or for ledgers which are not
+// yet validated, are not cacheable.
+boost::optional<uint256>
+validatedHash (Json::Value const& params, Application& app)
+{
+    auto& ledgerMaster = app.getLedgerMaster ();
+    auto const& hashValue = params[jss::ledger_hash];
+    auto const& indexValue = params[jss::ledger_index];
+
+    if (hashValue)
+    {
+        uint256 hash;
+        if (! hashValue.isString () || ! hash.SetHex (hashValue.asString ()))
+            return boost::none;
+
+        auto const ledger = ledgerMaster.getLedgerByHash (hash);
+        if (! ledger ||
+            ledger->info().seq > ledgerMaster.getValidLedgerIndex () ||
+            ledgerMaster.getHashBySeq (ledger->info().seq) != hash)
+            return boost::none;
+        return hash;
+    }
+
+    if (indexValue.isNumeric ())
+    {
+        // asUInt throws on a negative or oversized index.
+        if (! indexValue.isConvertibleTo (Json::uintValue))
+            return boost::none;
+
+        LedgerIndex const seq = indexValue.asUInt ();
+        if (seq == 0 || seq > ledgerMaster.getValidLedgerIndex ())
+            return boost::none;
+
+        auto const hash = ledgerMaster.getHashBySeq (seq);
+        if (hash.isZero ())
+            return boost::none;
+        return hash;
+    }
+
+    if (indexValue.isString () && indexValue.asString () == "validated")
+    {
+        // A stale validated ledger is reported as an error, not served.
+        if (! app.config().standalone() &&
+            ledgerMaster.getValidatedLedgerAge () >
+                Tuning::maxValidatedLedgerAge)
+            return boost::none;
+
+        auto const ledger = ledgerMaster.getValidatedLedger ();
+        if (! ledger)
+            return boost::none;
+        return ledger->info().hash;
+    }
+
+    return boost::none;
+}
+
+} // namespace
+
+ResponseCache::ResponseCache (
+        beast::insight::Collector::ptr const& collector,
+        beast::Journal journal)
+    : cache_ ("response_cache", 0, 0, stopwatch (), journal, collector)
+    , maxBytes_ (0)
+    , enabled_ (false)
+{
+}
+
+void
+ResponseCache::configure (
+    int size, std::chrono::seconds age, std::size_t maxBytes)
+{
+    enabled_ = size > 0 && age.count () > 0 && maxBytes > 0;
+    maxBytes_ = maxBytes;
+    cache_.setTargetSize (size);
+    cache_.setTargetAge (age.count ());
+}
+
+std::string
+ResponseCache::serve (Json::Value const& params, Role role,
+    Application& app, Resource::Charge& loadType,
+    std::function<bool (Json::Value const&, std::string&)> const& execute)
+{
+    std::string result;
+
+    uint256 ledgerHash;
+    auto const key = getKey (params, role, app, ledgerHash);
+    if (! key)
+    {
+        execute (params, result);
+        return result;
+    }
+
+    if (auto const cached = fetch (*key))
+    {
+        loadType = cached->charge;
+        return cached->result;
+    }
+
+    // "validated" may name a newer ledger by the time the command runs.
+    Json::Value pinned (params);
+    pinned.removeMember (jss::ledger_index);
+    pinned[jss::ledger_hash] = to_string (ledgerHash);
+
+    if (execute (pinned, result))
+        insert (*key, result, loadType);
+    return result;
+}
+
+boost::optional<ResponseCache::key_type>
+ResponseCache::getKey (Json::Value const& params, Role role,
+    Application& app, uint256& ledgerHash)
+{
+    if (! enabled_ || ! params.isObject ())
+        return boost::none;
+
+    auto const command = params[jss::command].asString ();
+    if (! isCacheable (command) || params.isMember (jss::ledger))
+        return boost::none;
+
+    auto const hash = validatedHash (params, app);
+    if (! hash)
+        return boost::none;
+    ledgerHash = *hash;
+
+    // The ledger is identified by its hash, however it was requested.
+    Json::Value normalized (params);
+    normalized.removeMember (jss::command);
+    normalized.removeMember (jss::ledger_hash);
+    normalized.removeMember (jss::ledger_index);
+
+    return sha512Half (command, static_cast<int> (role), *hash,
+        to_string (normalized));
+}
+
+std::shared_ptr<ResponseCache::Entry const>
+ResponseCache::fetch (key_type const& key)
+{
+    return cache_.fetch (key);
+}
+
+void
+ResponseCache::insert (key_type const& key, std::string result,
+    Resource::Charge const& charge)
+{
+    if (! enabled_ || result.size () > maxBytes_)
+        return;
+
+    auto entry = std::make_shared<Entry const> (
+        Entry {std::move (result), charge});
+    cache_.canonicalize (key, entry);
+}
+
+void
+ResponseCache::sweep ()
+{
+    if (enabled_)
+        cache_.sweep ();
+}
+
+} // RPC
+} // ripple
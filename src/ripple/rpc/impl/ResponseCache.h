@@ -0,0 +1,122 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_RPC_RESPONSECACHE_H_INCLUDED
+#define RIPPLE_RPC_RESPONSECACHE_H_INCLUDED
+
+#include <ripple/basics/base_uint.h>
+#include <ripple/basics/TaggedCache.h>
+#include <ripple/beast/insight/Collector.h>
+#include <ripple/beast/utility/Journal.h>
+#include <ripple/json/json_value.h>
+#include <ripple/resource/Charge.h>
+#include <ripple/rpc/Role.h>
+#include <boost/optional.hpp>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace ripple {
+
+class Application;
+
+namespace RPC {
+
+/** Serialized results of read-only commands against validated ledgers.
+
+    A validated ledger never changes, so the result of a read-only command
+    run against one depends only on the command, its parameters and the
+    ledger. Entries are keyed on all three: once a new ledger validates,
+    requests for "validated" resolve to a new key and the old entries
+    simply age out.
+
+    A cacheable request runs pinned to the ledger its key names, so a
+    ledger which validates while it runs cannot change the ledger it
+    answers for. Each entry keeps the charge of the run which produced it,
+    and a hit costs the same.
+*/
+class ResponseCache
+{
+public:
+    using key_type = uint256;
+
+    ResponseCache (beast::insight::Collector::ptr const& collector,
+        beast::Journal journal);
+
+    /** Set the limits on the cache. A size of zero disables it. */
+    void
+    configure (int size, std::chrono::seconds age, std::size_t maxBytes);
+
+    /** The serialized result of a request and what it was charged. */
+    struct Entry
+    {
+        std::string result;
+        Resource::Charge charge;
+    };
+
+    /** Return the serialized result of a request.
+
+        A cached result is returned, and its charge stored in `loadType`,
+        if there is one. Otherwise `execute` writes the result of the
+        request it is passed, and returns true if the request succeeded,
+        in which case a cacheable result is stored with `loadType`.
+
+        @param params The request, including the command. If its result
+                      may be cached, `execute` is passed a copy pinned to
+                      the ledger it resolves to: the ledger_index is
+                      replaced by that ledger's ledger_hash.
+    */
+    std::string
+    serve (Json::Value const& params, Role role, Application& app,
+        Resource::Charge& loadType,
+        std::function<bool (Json::Value const&, std::string&)> const&
+            execute);
+
+    /** Return the key for a request, if its result may be cached.
+
+        @param ledgerHash Set to the hash of the ledger the request
+                          resolves to if a key is returned.
+    */
+    boost::optional<key_type>
+    getKey (Json::Value const& params, Role role, Application& app,
+        uint256& ledgerHash);
+
+    /** Return a previously stored result, or nullptr. */
+    std::shared_ptr<Entry const>
+    fetch (key_type const& key);
+
+    /** Remember the serialized result of a successful request. */
+    void
+    insert (key_type const& key, std::string result,
+        Resource::Charge const& charge);
+
+    void
+    sweep ();
+
+private:
+    TaggedCache<key_type, Entry const> cache_;
+    std::size_t maxBytes_;
+    bool enabled_;
+};
+
+} // RPC
+} // ripple
+
+#endif
@@ -22,6 +22,7 @@
 #include <ripple/app/misc/NetworkOPs.h>
 #include <ripple/beast/rfc2616.h>
 #include <ripple/beast/net/IPAddressConversion.h>
+#include <ripple/json/Arena.h>
 #include <ripple/json/json_reader.h>
 #include <ripple/rpc/json_body.h>
 #include <ripple/rpc/ServerHandler.h>
@@ -48,6 +49,7 @@
 #include <boost/optional.hpp>
 #include <boost/regex.hpp>
 #include <algorithm>
+#include <cassert>
 #include <stdexcept>
 
 namespace ripple {
@@ -74,6 +76,16 @@ isStatusRequest(
             request.body.size() == 0 && request.method == "GET";
 }
 
+static
+bool
+isMetricsRequest(
+    http_request_type const& request)
+{
+    return request.body.size() == 0 && request.method == "GET" &&
+        (request.url == "/metrics" ||
+            boost::starts_with(request.url, "/metrics?"));
+}
+
 static
 Handoff
 unauthorizedResponse(
@@ -130,6 +142,7 @@ ServerHandlerImp::ServerHandlerImp (Application& app, Stoppable& parent,
     , m_server (make_Server(
         *this, io_service, app_.journal("Server")))
     , m_jobQueue (jobQueue)
+    , responseCache_ (cm.group ("rpc"), app_.journal ("RPC"))
 {
     auto const& group (cm.group ("rpc"));
     rpc_requests_ = group->make_counter ("requests");
@@ -146,9 +159,17 @@ void
 ServerHandlerImp::setup (Setup const& setup, beast::Journal journal)
 {
     setup_ = setup;
+    responseCache_.configure (setup.response_cache.size,
+        setup.response_cache.age, setup.response_cache.max_bytes);
     m_server->ports (setup.ports);
 }
 
+void
+ServerHandlerImp::sweep()
+{
+    responseCache_.sweep();
+}
+
 //------------------------------------------------------------------------------
 
 void
@@ -217,6 +238,10 @@ ServerHandlerImp::onHandoff (Session& session,
     if (session.port().protocol.count("wss2") > 0 && isStatusRequest(request))
         return statusResponse(request);
 
+    if (session.port().protocol.count("metrics") > 0 &&
+            isMetricsRequest(request))
+        return metricsResponse(session.port(), request, remote_address);
+
     // Pass to legacy onRequest
     return {};
 }
@@ -253,6 +278,10 @@ ServerHandlerImp::onHandoff (Session& session,
        isStatusRequest(request))
         return statusResponse(request);
 
+    if (session.port().protocol.count("metrics") > 0 &&
+            isMetricsRequest(request))
+        return metricsResponse(session.port(), request, remote_address);
+
     // Otherwise pass to legacy onRequest or websocket
     return {};
 }
@@ -532,6 +561,43 @@ ServerHandlerImp::processSession (std::shared_ptr<Session> const& session,
         session->close (true);
 }
 
+// Add the load warning to a serialized result object.
+static
+void
+addWarning (std::string& result)
+{
+    assert (result.size () > 2 && result[0] == '{');
+    result.insert (1, "\"warning\":\"load\",");
+}
+
+// Wrap a serialized result in the reply to a JSON-RPC request. The
+// members appear in the order to_string would write them.
+static
+std::string
+makeReply (Json::Value const& jsonRPC, std::string const& result)
+{
+    std::string reply ("{");
+    auto const add = [&reply](Json::StaticString name, std::string const& text)
+    {
+        if (reply.size () > 1)
+            reply += ',';
+        reply += '"';
+        reply += name.c_str ();
+        reply += "\":";
+        reply += text;
+    };
+
+    if (jsonRPC.isMember (jss::id))
+        add (jss::id, to_string (jsonRPC[jss::id]));
+    if (jsonRPC.isMember (jss::jsonrpc))
+        add (jss::jsonrpc, to_string (jsonRPC[jss::jsonrpc]));
+    add (jss::result, result);
+    if (jsonRPC.isMember (jss::ripplerpc))
+        add (jss::ripplerpc, to_string (jsonRPC[jss::ripplerpc]));
+    reply += '}';
+    return reply;
+}
+
 void
 ServerHandlerImp::processRequest (Port const& port,
     std::string const& request, beast::IP::Endpoint const& remoteIPAddress,
@@ -540,6 +606,10 @@ ServerHandlerImp::processRequest (Port const& port,
 {
     auto rpcJ = app_.journal ("RPC");
 
+    // The request, the handler's result and the reply are all built in
+    // one arena. It follows the coroutine if the handler yields.
+    Json::Arena arena;
+
     Json::Value jsonRPC;
     {
         Json::Reader reader;
@@ -666,39 +736,24 @@ ServerHandlerImp::processRequest (Port const& port,
     Resource::Charge loadType = Resource::feeReferenceRPC;
     auto const start (std::chrono::high_resolution_clock::now ());
 
-    RPC::Context context {m_journal, params, app_, loadType, m_networkOPs,
-        app_.getLedgerMaster(), usage, role, coro, InfoSub::pointer(),
-        {user, forwardedFor}};
-    Json::Value result;
-    RPC::doCommand (context, result);
-
-    // Always report "status".  On an error report the request as received.
-    if (result.isMember (jss::error))
-    {
-        result[jss::status] = jss::error;
-        result[jss::request] = params;
-        JLOG (m_journal.debug())  <<
-            "rpcError: " << result [jss::error] <<
-            ": " << result [jss::error_message];
-    }
-    else
-    {
-        result[jss::status]  = jss::success;
-    }
+    // Read-only commands against a validated ledger always produce the
+    // same result, which may already have been serialized.
+    auto result = responseCache_.serve (params, role, app_, loadType,
+        [&](Json::Value const& request, std::string& output)
+        {
+            RPC::Context context {m_journal, request, app_, loadType,
+                m_networkOPs, app_.getLedgerMaster(), usage, role, coro,
+                    InfoSub::pointer(), {user, forwardedFor}};
+            // Handlers which can stream their result do so, without
+            // building a Json::Value. Errors report the request as sent.
+            return RPC::executeRPC (context, output, params);
+        });
 
     usage.charge (loadType);
     if (usage.warn())
-        result[jss::warning] = jss::load;
-
-    Json::Value reply (Json::objectValue);
-    reply[jss::result] = std::move (result);
-    if (jsonRPC.isMember(jss::jsonrpc))
-        reply[jss::jsonrpc] = jsonRPC[jss::jsonrpc];
-    if (jsonRPC.isMember(jss::ripplerpc))
-        reply[jss::ripplerpc] = jsonRPC[jss::ripplerpc];
-    if (jsonRPC.isMember(jss::id))
-        reply[jss::id] = jsonRPC[jss::id];
-    auto response = to_string (reply);
+        addWarning (result);
+
+    auto response = makeReply (jsonRPC, result);
 
     rpc_time_.notify (static_cast <beast::insight::Event::value_type> (
         std::chrono::duration_cast <std::chrono::milliseconds> (
@@ -759,6 +814,47 @@ ServerHandlerImp::statusResponse(
     return handoff;
 }
 
+Handoff
+ServerHandlerImp::metricsResponse(Port const& port,
+    http_request_type const& request,
+        boost::asio::ip::tcp::endpoint const& remote_address) const
+{
+    using namespace beast::http;
+    Handoff handoff;
+    response<string_body> msg;
+    boost::optional<std::string> metrics;
+    // Metrics are only served to admin addresses
+    if (! authorized (port, build_map(request.fields)) ||
+        requestRole (Role::ADMIN, port, Json::Value(),
+            beast::IPAddressConversion::from_asio(remote_address),
+                "") != Role::ADMIN)
+    {
+        msg.status = 403;
+        msg.reason = "Forbidden";
+        msg.fields.insert("Content-Type", "text/plain");
+        msg.body = "Forbidden";
+    }
+    else if (! (metrics = app_.getCollectorManager().metrics()))
+    {
+        msg.status = 404;
+        msg.reason = "Not Found";
+        msg.fields.insert("Content-Type", "text/plain");
+        msg.body = "Metrics require [insight] server=prometheus";
+    }
+    else
+    {
+        msg.status = 200;
+        msg.reason = "OK";
+        msg.fields.insert("Content-Type", "text/plain; version=0.0.4");
+        msg.body = std::move(*metrics);
+    }
+    msg.version = request.version;
+    msg.fields.insert("Server", BuildInfo::getFullVersionString());
+    prepare(msg, beast::http::connection::close);
+    handoff.response = std::make_shared<SimpleWriter>(msg);
+    return handoff;
+}
+
 //------------------------------------------------------------------------------
 
 void
@@ -953,6 +1049,31 @@ setup_Overlay (ServerHandler::Setup& setup)
     setup.overlay.port = iter->port;
 }
 
+// Fill out the response cache portion of the Setup
+static
+void
+setup_ResponseCache (ServerHandler::Setup& setup, Config const& config)
+{
+    auto const& section = config.section ("rpc_response_cache");
+    auto& cache = setup.response_cache;
+
+    set (cache.size, "size", section);
+    if (cache.size < 0)
+        Throw<std::runtime_error> (
+            "Invalid [rpc_response_cache] size");
+
+    int age = 0;
+    if (set (age, "age", section))
+    {
+        if (age < 0)
+            Throw<std::runtime_error> (
+                "Invalid [rpc_response_cache] age");
+        cache.age = std::chrono::seconds (age);
+    }
+
+    set (cache.max_bytes, "max_bytes", section);
+}
+
 ServerHandler::Setup
 setup_ServerHandler(
     Config const& config,
@@ -963,6 +1084,7 @@ setup_ServerHandler(
 
     setup_Client(setup);
     setup_Overlay(setup);
+    setup_ResponseCache(setup, config);
 
     return setup;
 }
@@ -21,12 +21,14 @@
 #define RIPPLE_RPC_SERVERHANDLERIMP_H_INCLUDED
 
 #include <ripple/core/JobQueue.h>
+#include <ripple/rpc/impl/ResponseCache.h>
 #include <ripple/rpc/impl/WSInfoSub.h>
 #include <ripple/server/Server.h>
 #include <ripple/server/Session.h>
 #include <ripple/server/WSSession.h>
 #include <ripple/rpc/RPCHandler.h>
 #include <ripple/app/main/CollectorManager.h>
+#include <chrono>
 #include <map>
 #include <mutex>
 #include <vector>
@@ -71,6 +73,17 @@ public:
 
         overlay_t overlay;
 
+        // Configuration for the RPC response cache, which is off unless
+        // a size is configured
+        struct response_cache_t
+        {
+            int size = 0;
+            std::chrono::seconds age = std::chrono::seconds (60);
+            std::size_t max_bytes = 4 * 1024 * 1024;
+        };
+
+        response_cache_t response_cache;
+
         void
         makeContexts();
     };
@@ -87,6 +100,7 @@ private:
     beast::insight::Counter rpc_requests_;
     beast::insight::Event rpc_size_;
     beast::insight::Event rpc_time_;
+    RPC::ResponseCache responseCache_;
     std::mutex countlock_;
     std::map<std::reference_wrapper<Port const>, int> count_;
 
@@ -109,6 +123,10 @@ public:
         return setup_;
     }
 
+    /** Expire old entries from the response cache. */
+    void
+    sweep();
+
     //
     // Stoppable
     //
@@ -168,6 +186,10 @@ private:
     Handoff
     statusResponse(http_request_type const& request) const;
 
+    Handoff
+    metricsResponse(Port const& port, http_request_type const& request,
+        boost::asio::ip::tcp::endpoint const& remote_address) const;
+
 
 };
 
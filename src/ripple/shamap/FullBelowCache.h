@@ -83,6 +83,25 @@ public:
         return m_cache.size ();
     }
 
+    /** Returns an estimate of the bytes held by the cache.
+        Thread safety:
+            Safe to call from any thread.
+    */
+    std::size_t getMemoryUsage () const
+    {
+        return m_cache.getMemoryUsage ();
+    }
+
+    /** Set the target size and expiration of the cache.
+        Thread safety:
+            Safe to call from any thread.
+    */
+    void tune (size_type size, size_type age)
+    {
+        m_cache.setTargetSize (size);
+        m_cache.setTargetAge (age);
+    }
+
     /** Remove expired cache items.
         Thread safety:
             Safe to call from any thread.
@@ -92,6 +111,17 @@ public:
         m_cache.sweep ();
     }
 
+    /** Remove some expired cache items, resuming where the last call stopped.
+        Thread safety:
+            Safe to call from any thread.
+        @param budget The time to spend before returning.
+        @return `true` if the pass completed.
+    */
+    bool sweep (std::chrono::microseconds budget)
+    {
+        return m_cache.sweep (budget);
+    }
+
     /** Refresh the last access time of an item, if it exists.
         Thread safety:
             Safe to call from any thread.
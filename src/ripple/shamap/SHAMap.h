@@ -178,6 +178,25 @@ public:
     const_iterator upper_bound(uint256 const& id) const;
 
     void visitNodes (std::function<bool (SHAMapAbstractNode&)> const&) const;
+
+    /** What visitNodesParallel does below a visited node. */
+    enum class Visit
+    {
+        descend,    // Visit the children of an inner node
+        skip        // Do not visit the children
+    };
+
+    /** Visit every node in the map, sharing the work among threads.
+
+        The subtrees near the root are divided among `threads` threads,
+        so `function` may be called concurrently. Unlike visitNodes,
+        which stops when its function returns `true`, the function
+        decides for each inner node whether its subtree is walked.
+        Nodes are not stored in the map as they are fetched.
+    */
+    void visitNodesParallel (
+        std::function<Visit (SHAMapAbstractNode&)> const& function,
+        int threads) const;
     void
         visitLeaves(
             std::function<void(std::shared_ptr<SHAMapItem const> const&)> const&) const;
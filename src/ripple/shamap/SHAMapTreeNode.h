@@ -258,6 +258,10 @@ public:  // public only to SHAMap
     bool updateHash () override;
 };
 
+/** Returns an estimate of the bytes used by a tree node. */
+std::size_t
+memoryUsed (SHAMapAbstractNode const& node);
+
 // SHAMapAbstractNode
 
 inline
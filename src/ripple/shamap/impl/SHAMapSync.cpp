@@ -21,6 +21,10 @@
 #include <ripple/basics/random.h>
 #include <ripple/shamap/SHAMap.h>
 #include <ripple/nodestore/Database.h>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
 
 namespace ripple {
 
@@ -100,6 +104,97 @@ void SHAMap::visitNodes(std::function<bool (SHAMapAbstractNode&)> const& functio
     }
 }
 
+void
+SHAMap::visitNodesParallel (
+    std::function<Visit (SHAMapAbstractNode&)> const& function,
+    int threads) const
+{
+    assert (root_->isValid ());
+
+    if (!root_ || function (*root_) == Visit::skip || !root_->isInner ())
+        return;
+
+    // Expand the top of the tree until there are enough
+    // subtrees to keep every thread busy
+    std::vector<std::shared_ptr<SHAMapInnerNode>> subtrees;
+    subtrees.push_back (std::static_pointer_cast<SHAMapInnerNode>(root_));
+
+    auto expand = [this, &function](
+        std::shared_ptr<SHAMapInnerNode> const& node,
+        std::vector<std::shared_ptr<SHAMapInnerNode>>& next)
+    {
+        for (int branch = 0; branch < 16; ++branch)
+        {
+            if (node->isEmptyBranch (branch))
+                continue;
+
+            auto child = descendNoStore (node, branch);
+            if (function (*child) == Visit::descend && child->isInner ())
+                next.push_back (
+                    std::static_pointer_cast<SHAMapInnerNode>(child));
+        }
+    };
+
+    std::size_t const wanted = 8 * std::max (threads, 1);
+    for (int depth = 0; depth < 2 && subtrees.size () < wanted; ++depth)
+    {
+        std::vector<std::shared_ptr<SHAMapInnerNode>> next;
+        for (auto const& node : subtrees)
+            expand (node, next);
+        subtrees.swap (next);
+    }
+
+    // Each subtree is walked depth first, like visitNodes
+    auto walk = [&](std::shared_ptr<SHAMapInnerNode> const& top)
+    {
+        std::stack <std::shared_ptr<SHAMapInnerNode>,
+            std::vector<std::shared_ptr<SHAMapInnerNode>>> stack;
+        stack.push (top);
+
+        while (!stack.empty ())
+        {
+            auto node = std::move (stack.top ());
+            stack.pop ();
+
+            std::vector<std::shared_ptr<SHAMapInnerNode>> next;
+            expand (node, next);
+            for (auto& child : next)
+                stack.push (std::move (child));
+        }
+    };
+
+    std::atomic<std::size_t> nextSubtree {0};
+    std::exception_ptr error;
+    std::mutex errorMutex;
+
+    auto work = [&]()
+    {
+        try
+        {
+            std::size_t i;
+            while ((i = nextSubtree++) < subtrees.size ())
+                walk (subtrees[i]);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock (errorMutex);
+            if (!error)
+                error = std::current_exception ();
+            nextSubtree = subtrees.size ();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int i = 1; i < threads; ++i)
+        workers.emplace_back (work);
+    work ();
+    for (auto& t : workers)
+        t.join ();
+
+    if (error)
+        std::rethrow_exception (error);
+}
+
 /** Get a list of node IDs and hashes for nodes that are part of this SHAMap
     but not available locally.  The filter can hold alternate sources of
     nodes that are not permanently stored locally
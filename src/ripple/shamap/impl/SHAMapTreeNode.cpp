@@ -943,4 +943,22 @@ SHAMapTreeNode::invariants(bool, bool) const
     assert(mItem != nullptr);
 }
 
+std::size_t
+memoryUsed (SHAMapAbstractNode const& node)
+{
+    if (node.isInner ())
+    {
+        if (dynamic_cast<SHAMapInnerNodeV2 const*> (&node))
+            return sizeof (SHAMapInnerNodeV2);
+        return sizeof (SHAMapInnerNode);
+    }
+    auto const& item =
+        static_cast<SHAMapTreeNode const&> (node).peekItem ();
+    if (! item)
+        return sizeof (SHAMapTreeNode);
+    // Items can be shared between leaves, so this may overcount
+    return sizeof (SHAMapTreeNode) + sizeof (SHAMapItem) +
+        item->peekData ().capacity ();
+}
+
 } // ripple
@@ -28,3 +28,4 @@
 #include <ripple/app/main/NodeStoreScheduler.cpp>
 #include <ripple/app/main/DBInit.cpp>
 #include <ripple/app/main/LoadManager.cpp>
+#include <ripple/app/main/MemoryBudget.cpp>
@@ -26,9 +26,11 @@
 #include <ripple/app/misc/SHAMapStoreImp.cpp>
 #include <ripple/app/misc/Validations.cpp>
 
+#include <ripple/app/misc/impl/AccountTxIndex.cpp>
 #include <ripple/app/misc/impl/AccountTxPaging.cpp>
 #include <ripple/app/misc/impl/AmendmentTable.cpp>
 #include <ripple/app/misc/impl/LoadFeeTrack.cpp>
 #include <ripple/app/misc/impl/Transaction.cpp>
 #include <ripple/app/misc/impl/TxQ.cpp>
+#include <ripple/app/misc/impl/ValidationArchive.cpp>
 #include <ripple/app/misc/impl/ValidatorList.cpp>
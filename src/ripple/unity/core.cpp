@@ -24,7 +24,9 @@
 #include <ripple/core/impl/DeadlineTimer.cpp>
 #include <ripple/core/impl/LoadEvent.cpp>
 #include <ripple/core/impl/LoadMonitor.cpp>
+#include <ripple/core/impl/Reclaimer.cpp>
 #include <ripple/core/impl/Job.cpp>
+#include <ripple/core/impl/JobProfiler.cpp>
 #include <ripple/core/impl/JobQueue.cpp>
 #include <ripple/core/impl/SNTPClock.cpp>
 #include <ripple/core/impl/Stoppable.cpp>
@@ -25,7 +25,9 @@
 #include <sstream>
 #include <string>
 
+#include <ripple/json/impl/Arena.cpp>
 #include <ripple/json/impl/json_reader.cpp>
+#include <ripple/json/impl/StructuralIndex.cpp>
 #include <ripple/json/impl/json_value.cpp>
 #include <ripple/json/impl/json_valueiterator.cpp>
 #include <ripple/json/impl/json_writer.cpp>
@@ -31,6 +31,8 @@
 #include <ripple/nodestore/impl/DummyScheduler.cpp>
 #include <ripple/nodestore/impl/DecodedBlob.cpp>
 #include <ripple/nodestore/impl/EncodedBlob.cpp>
+#include <ripple/nodestore/impl/FilteredBackend.cpp>
 #include <ripple/nodestore/impl/ManagerImp.cpp>
+#include <ripple/nodestore/impl/MembershipFilter.cpp>
 #include <ripple/nodestore/impl/NodeObject.cpp>
 
@@ -52,6 +52,7 @@
 #include <ripple/protocol/impl/STBlob.cpp>
 #include <ripple/protocol/impl/STInteger.cpp>
 #include <ripple/protocol/impl/STLedgerEntry.cpp>
+#include <ripple/protocol/impl/STLedgerEntryView.cpp>
 #include <ripple/protocol/impl/STObject.cpp>
 #include <ripple/protocol/impl/STParsedJSON.cpp>
 #include <ripple/protocol/impl/InnerObjectFormats.cpp>
@@ -38,7 +38,6 @@
 #include <ripple/rpc/handlers/AccountOffers.cpp>
 #include <ripple/rpc/handlers/AccountTx.cpp>
 #include <ripple/rpc/handlers/AccountTxOld.cpp>
-#include <ripple/rpc/handlers/AccountTxSwitch.cpp>
 #include <ripple/rpc/handlers/BlackList.cpp>
 #include <ripple/rpc/handlers/BookOffers.cpp>
 #include <ripple/rpc/handlers/CanDelete.cpp>
@@ -49,6 +48,7 @@
 #include <ripple/rpc/handlers/FetchInfo.cpp>
 #include <ripple/rpc/handlers/GatewayBalances.cpp>
 #include <ripple/rpc/handlers/GetCounts.cpp>
+#include <ripple/rpc/handlers/JobProfile.cpp>
 #include <ripple/rpc/handlers/LedgerHandler.cpp>
 #include <ripple/rpc/handlers/LedgerAccept.cpp>
 #include <ripple/rpc/handlers/LedgerCleanerHandler.cpp>
@@ -91,6 +91,7 @@
 
 #include <ripple/rpc/impl/Handler.cpp>
 #include <ripple/rpc/impl/LegacyPathFind.cpp>
+#include <ripple/rpc/impl/ResponseCache.cpp>
 #include <ripple/rpc/impl/Role.cpp>
 #include <ripple/rpc/impl/RPCHelpers.cpp>
 #include <ripple/rpc/impl/ServerHandlerImp.cpp>
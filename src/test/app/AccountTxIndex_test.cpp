@@ -0,0 +1,423 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/app/misc/AccountTxIndex.h>
+#include <ripple/app/misc/impl/AccountTxPaging.h>
+#include <ripple/app/main/DBInit.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/utility/temp_dir.h>
+#include <ripple/core/SociDB.h>
+#include <ripple/protocol/AccountID.h>
+#include <ripple/protocol/JsonFields.h>
+#include <ripple/protocol/STArray.h>
+#include <ripple/protocol/STObject.h>
+#include <ripple/protocol/TER.h>
+#include <boost/format.hpp>
+#include <chrono>
+#include <thread>
+
+namespace ripple {
+namespace test {
+
+class AccountTxIndex_test : public beast::unit_test::suite
+{
+    using Page = std::vector<std::pair<std::uint32_t, uint256>>;
+
+    static
+    uint256
+    txID (std::uint32_t ledgerSeq, std::uint32_t txnSeq)
+    {
+        return uint256 (std::uint64_t (ledgerSeq) * 1000 + txnSeq);
+    }
+
+    static
+    DatabaseCon::Setup
+    setup (beast::temp_dir const& dir)
+    {
+        DatabaseCon::Setup setup;
+        setup.dataDir = dir.path ();
+        setup.readConnections = 2;
+        return setup;
+    }
+
+    // Two transactions per ledger affecting alice; the second
+    // also affects bob.
+    static
+    void
+    fillAccountTransactions (DatabaseCon& txnDB,
+        AccountID const& alice, AccountID const& bob,
+        std::uint32_t first, std::uint32_t last)
+    {
+        auto db = txnDB.checkoutDb ();
+        soci::transaction tr (*db);
+        for (auto seq = first; seq <= last; ++seq)
+        {
+            for (std::uint32_t txnSeq = 0; txnSeq < 2; ++txnSeq)
+            {
+                auto row = [&](AccountID const& account)
+                {
+                    *db << boost::str (boost::format (
+                        "INSERT INTO AccountTransactions "
+                        "(TransID, Account, LedgerSeq, TxnSeq) "
+                        "VALUES ('%s','%s',%u,%u);")
+                            % to_string (txID (seq, txnSeq))
+                            % toBase58 (account)
+                            % seq
+                            % txnSeq);
+                };
+                row (alice);
+                if (txnSeq == 1)
+                    row (bob);
+            }
+        }
+        tr.commit ();
+    }
+
+    Page
+    page (AccountTxIndex& index, AccountID const& account,
+        std::uint32_t minLedger, std::uint32_t maxLedger, bool forward,
+        boost::optional<AccountTxIndex::Marker>& marker,
+        std::uint32_t limit)
+    {
+        Page result;
+        marker = index.page (account, minLedger, maxLedger,
+            forward, marker, limit,
+            [&result](std::uint32_t ledgerSeq, std::uint32_t,
+                uint256 const& id)
+            {
+                result.emplace_back (ledgerSeq, id);
+            });
+        return result;
+    }
+
+    static
+    bool
+    waitReady (AccountTxIndex const& index)
+    {
+        using namespace std::chrono_literals;
+        for (int i = 0; i < 500 && ! index.ready (); ++i)
+            std::this_thread::sleep_for (10ms);
+        return index.ready ();
+    }
+
+    void
+    testImport ()
+    {
+        testcase ("import");
+
+        beast::temp_dir dir;
+        AccountID const alice (1);
+        AccountID const bob (2);
+
+        DatabaseCon txnDB (setup (dir), "transaction.db",
+            TxnDBInit, TxnDBCount);
+        fillAccountTransactions (txnDB, alice, bob, 10, 19);
+
+        {
+            AccountTxIndex index (setup (dir), txnDB, beast::Journal ());
+            BEAST_EXPECT(waitReady (index));
+
+            boost::optional<AccountTxIndex::Marker> marker;
+            auto const all = page (index, alice, 0, 100, true, marker, 100);
+            BEAST_EXPECT(! marker);
+            BEAST_EXPECT(all.size () == 20);
+            BEAST_EXPECT(all.front () == std::make_pair (10u, txID (10, 0)));
+            BEAST_EXPECT(all.back () == std::make_pair (19u, txID (19, 1)));
+            BEAST_EXPECT(page (index, bob, 0, 100,
+                true, marker, 100).size () == 10);
+        }
+
+        // The completed import is not repeated
+        {
+            AccountTxIndex index (setup (dir), txnDB, beast::Journal ());
+            BEAST_EXPECT(index.ready ());
+        }
+    }
+
+    void
+    testImportWithoutTxnSeq ()
+    {
+        testcase ("import without TxnSeq");
+
+        beast::temp_dir dir;
+        AccountID const alice (1);
+
+        DatabaseCon txnDB (setup (dir), "transaction.db",
+            TxnDBInit, TxnDBCount);
+        {
+            auto db = txnDB.checkoutDb ();
+            for (std::uint32_t i = 0; i < 3; ++i)
+            {
+                *db << boost::str (boost::format (
+                    "INSERT INTO AccountTransactions "
+                    "(TransID, Account, LedgerSeq, TxnSeq) "
+                    "VALUES ('%s','%s',10,NULL);")
+                        % to_string (txID (10, i))
+                        % toBase58 (alice));
+            }
+
+            // The first two have metadata, which gives their position
+            for (std::uint32_t i = 0; i < 2; ++i)
+            {
+                STObject meta (sfTransactionMetaData);
+                meta.setFieldU8 (sfTransactionResult, tesSUCCESS);
+                meta.setFieldU32 (sfTransactionIndex, i + 4);
+                meta.setFieldArray (sfAffectedNodes, STArray ());
+                Serializer s;
+                meta.add (s);
+                *db << boost::str (boost::format (
+                    "INSERT INTO Transactions "
+                    "(TransID, LedgerSeq, Status, RawTxn, TxnMeta) "
+                    "VALUES ('%s',10,'V',X'00',X'%s');")
+                        % to_string (txID (10, i))
+                        % strHex (s.slice ()));
+            }
+        }
+
+        AccountTxIndex index (setup (dir), txnDB, beast::Journal ());
+        BEAST_EXPECT(waitReady (index));
+
+        // Each keeps its own row; the one without metadata is skipped
+        std::vector<std::pair<std::uint32_t, uint256>> found;
+        index.page (alice, 0, 100, true, boost::none, 100,
+            [&found](std::uint32_t, std::uint32_t txnSeq, uint256 const& id)
+            {
+                found.emplace_back (txnSeq, id);
+            });
+        BEAST_EXPECT(found.size () == 2);
+        BEAST_EXPECT(found.size () == 2 &&
+            found[0] == std::make_pair (4u, txID (10, 0)) &&
+                found[1] == std::make_pair (5u, txID (10, 1)));
+    }
+
+    void
+    testPaging ()
+    {
+        testcase ("paging");
+
+        beast::temp_dir dir;
+        AccountID const alice (1);
+        AccountID const bob (2);
+
+        DatabaseCon txnDB (setup (dir), "transaction.db",
+            TxnDBInit, TxnDBCount);
+        AccountTxIndex index (setup (dir), txnDB, beast::Journal ());
+        BEAST_EXPECT(index.ready ());
+
+        for (std::uint32_t seq = 10; seq < 20; ++seq)
+        {
+            std::vector<AccountTxIndex::Entry> entries;
+            entries.push_back ({alice, 0, txID (seq, 0)});
+            entries.push_back ({alice, 1, txID (seq, 1)});
+            entries.push_back ({bob, 1, txID (seq, 1)});
+            index.saveLedger (seq, entries);
+        }
+
+        // Forward, three at a time
+        {
+            boost::optional<AccountTxIndex::Marker> marker;
+            Page all;
+            int pages = 0;
+            do
+            {
+                auto const p = page (index, alice, 0, 100, true, marker, 3);
+                all.insert (all.end (), p.begin (), p.end ());
+                ++pages;
+            }
+            while (marker && pages < 100);
+
+            BEAST_EXPECT(pages == 7);
+            BEAST_EXPECT(all.size () == 20);
+            for (std::size_t i = 0; i < all.size (); ++i)
+                BEAST_EXPECT(all[i].second == txID (10 + i / 2, i % 2));
+        }
+
+        // Backward, within a range
+        {
+            boost::optional<AccountTxIndex::Marker> marker;
+            auto p = page (index, alice, 12, 14, false, marker, 4);
+            BEAST_EXPECT(p.size () == 4);
+            BEAST_EXPECT(p.front ().second == txID (14, 1));
+            BEAST_EXPECT(p.back ().second == txID (13, 0));
+            BEAST_EXPECT(marker &&
+                *marker == AccountTxIndex::Marker (12, 1));
+
+            p = page (index, alice, 12, 14, false, marker, 4);
+            BEAST_EXPECT(p.size () == 2);
+            BEAST_EXPECT(p.front ().second == txID (12, 1));
+            BEAST_EXPECT(p.back ().second == txID (12, 0));
+            BEAST_EXPECT(! marker);
+        }
+
+        // Saving a ledger again replaces its entries
+        {
+            std::vector<AccountTxIndex::Entry> entries;
+            entries.push_back ({bob, 0, txID (15, 7)});
+            index.saveLedger (15, entries);
+
+            boost::optional<AccountTxIndex::Marker> marker;
+            BEAST_EXPECT(page (index, alice, 15, 15,
+                true, marker, 10).empty ());
+            auto const p = page (index, bob, 15, 15, true, marker, 10);
+            BEAST_EXPECT(p.size () == 1 && p[0].second == txID (15, 7));
+        }
+    }
+
+    void
+    testMinLedger ()
+    {
+        testcase ("online delete");
+
+        beast::temp_dir dir;
+        AccountID const alice (1);
+        AccountID const bob (2);
+
+        DatabaseCon txnDB (setup (dir), "transaction.db",
+            TxnDBInit, TxnDBCount);
+        fillAccountTransactions (txnDB, alice, bob, 10, 19);
+
+        AccountTxIndex index (setup (dir), txnDB, beast::Journal ());
+
+        // Trim as online delete does, possibly while importing
+        index.setMinLedger (15);
+        *index.getDB ().checkoutDb () <<
+            "DELETE FROM AccountTx WHERE LedgerSeq < 15;";
+        BEAST_EXPECT(waitReady (index));
+
+        boost::optional<AccountTxIndex::Marker> marker;
+        auto const all = page (index, alice, 0, 100, true, marker, 100);
+        BEAST_EXPECT(all.size () == 10);
+        BEAST_EXPECT(all.front () == std::make_pair (15u, txID (15, 0)));
+    }
+
+    void
+    testMissingTransactions ()
+    {
+        testcase ("missing transactions");
+
+        beast::temp_dir dir;
+        AccountID const alice (1);
+
+        DatabaseCon txnDB (setup (dir), "transaction.db",
+            TxnDBInit, TxnDBCount);
+        AccountTxIndex index (setup (dir), txnDB, beast::Journal ());
+        BEAST_EXPECT(index.ready ());
+
+        auto store = [&](std::uint32_t seq, std::uint32_t txnSeq)
+        {
+            *txnDB.checkoutDb () << boost::str (boost::format (
+                "INSERT INTO Transactions "
+                "(TransID, LedgerSeq, Status, RawTxn, TxnMeta) "
+                "VALUES ('%s',%u,'V',X'%02X',X'01');")
+                    % to_string (txID (seq, txnSeq))
+                    % seq
+                    % txnSeq);
+        };
+
+        for (std::uint32_t seq = 10; seq < 14; ++seq)
+        {
+            std::vector<AccountTxIndex::Entry> entries;
+            entries.push_back ({alice, 0, txID (seq, 0)});
+            entries.push_back ({alice, 1, txID (seq, 1)});
+            index.saveLedger (seq, entries);
+
+            store (seq, 0);
+            if (seq != 11 && seq != 12)
+                store (seq, 1);
+        }
+
+        // Whether the ledgers can be saved again
+        bool saving = true;
+        std::vector<std::uint32_t> unsaved;
+        std::vector<std::pair<std::uint32_t, std::uint8_t>> seen;
+        auto accountTx = [&](Json::Value& token)
+        {
+            unsaved.clear ();
+            seen.clear ();
+            accountTxPage (index, txnDB,
+                [&](std::uint32_t seq)
+                {
+                    unsaved.push_back (seq);
+                    return saving;
+                },
+                [&seen](std::uint32_t seq, std::string const& status,
+                    Blob const& rawTxn, Blob const& rawMeta)
+                {
+                    if (status == "V" && rawTxn.size () == 1 &&
+                            rawMeta.size () == 1)
+                        seen.emplace_back (seq, rawTxn[0]);
+                },
+                alice, 0, 100, true, token, 100, false, 200);
+        };
+
+        // The page stops at the missing transaction while its ledger
+        // is saved again
+        Json::Value token;
+        accountTx (token);
+        BEAST_EXPECT(seen.size () == 3);
+        BEAST_EXPECT(unsaved == std::vector<std::uint32_t> {11});
+        BEAST_EXPECT(token.isObject () &&
+            token[jss::ledger].asUInt () == 11 &&
+                token[jss::seq].asUInt () == 1);
+
+        // Once the ledger is saved, the next page resumes there
+        store (11, 1);
+        accountTx (token);
+        BEAST_EXPECT(seen.size () == 2);
+        BEAST_EXPECT(! seen.empty () &&
+            seen.front () == std::make_pair (11u, std::uint8_t (1)));
+        BEAST_EXPECT(unsaved == std::vector<std::uint32_t> {12});
+        BEAST_EXPECT(token.isObject () &&
+            token[jss::ledger].asUInt () == 12 &&
+                token[jss::seq].asUInt () == 1);
+
+        // A transaction which can't be recovered is skipped, and
+        // paging ends
+        saving = false;
+        accountTx (token);
+        BEAST_EXPECT(token.isNull ());
+        BEAST_EXPECT(unsaved == std::vector<std::uint32_t> {12});
+        BEAST_EXPECT(seen.size () == 2);
+        BEAST_EXPECT(! seen.empty () &&
+            seen.front () == std::make_pair (13u, std::uint8_t (0)));
+
+        // Without a marker, the same holds from the start
+        accountTx (token);
+        BEAST_EXPECT(token.isNull ());
+        BEAST_EXPECT(seen.size () == 7);
+        BEAST_EXPECT(unsaved == std::vector<std::uint32_t> {12});
+    }
+
+public:
+    void
+    run ()
+    {
+        testImport ();
+        testImportWithoutTxnSeq ();
+        testPaging ();
+        testMinLedger ();
+        testMissingTransactions ();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(AccountTxIndex,app,ripple);
+
+} // test
+} // ripple
@@ -0,0 +1,170 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/app/ledger/LedgerHashIndex.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/utility/temp_dir.h>
+#include <fstream>
+
+namespace ripple {
+namespace test {
+
+class LedgerHashIndex_test : public beast::unit_test::suite
+{
+    static
+    LedgerHash
+    hashOf (LedgerIndex seq)
+    {
+        return LedgerHash (std::uint64_t (seq) * 7 + 1);
+    }
+
+    void
+    testInsert ()
+    {
+        testcase ("insert");
+
+        beast::temp_dir dir;
+        LedgerHashIndex index (
+            boost::filesystem::path (dir.path ()) / "hashes",
+                beast::Journal ());
+
+        BEAST_EXPECT(! index.getHash (5));
+        BEAST_EXPECT(! index.getHash (100000000));
+
+        index.insert (5, hashOf (5), hashOf (4));
+        BEAST_EXPECT(index.getHash (5) == hashOf (5));
+        BEAST_EXPECT(! index.getHash (4));
+        BEAST_EXPECT(! index.getHash (6));
+
+        // Far past the initial size of the file
+        index.insert (200000, hashOf (200000), hashOf (199999));
+        BEAST_EXPECT(index.getHash (200000) == hashOf (200000));
+        BEAST_EXPECT(index.getHash (5) == hashOf (5));
+
+        index.clear ();
+        BEAST_EXPECT(! index.getHash (5));
+        BEAST_EXPECT(! index.getHash (200000));
+        index.insert (7, hashOf (7), hashOf (6));
+        BEAST_EXPECT(index.getHash (7) == hashOf (7));
+    }
+
+    void
+    testCheck ()
+    {
+        testcase ("check");
+
+        beast::temp_dir dir;
+        LedgerHashIndex index (
+            boost::filesystem::path (dir.path ()) / "hashes",
+                beast::Journal ());
+
+        BEAST_EXPECT(index.check (10, hashOf (10)));
+        BEAST_EXPECT(! index.check (10, hashOf (10)));
+        BEAST_EXPECT(index.getHash (10) == hashOf (10));
+
+        // A conflicting hash replaces the entry
+        index.insert (20, hashOf (20), hashOf (19));
+        BEAST_EXPECT(index.check (20, hashOf (1000)));
+        BEAST_EXPECT(index.getHash (20) == hashOf (1000));
+    }
+
+    void
+    testExtend ()
+    {
+        testcase ("extend");
+
+        beast::temp_dir dir;
+        LedgerHashIndex index (
+            boost::filesystem::path (dir.path ()) / "hashes",
+                beast::Journal ());
+
+        // Nothing links an unknown ledger to the index
+        BEAST_EXPECT(! index.extend (50, hashOf (50), hashOf (49)));
+        BEAST_EXPECT(! index.getHash (50));
+
+        // A validated ledger names its parent
+        index.insert (100, hashOf (100), hashOf (99));
+        BEAST_EXPECT(index.extend (99, hashOf (99), hashOf (98)));
+        BEAST_EXPECT(index.extend (98, hashOf (98), hashOf (97)));
+        BEAST_EXPECT(index.getHash (97) == hashOf (97));
+
+        // A ledger which is not the one the chain names is refused
+        BEAST_EXPECT(! index.extend (97, hashOf (1000), hashOf (96)));
+        BEAST_EXPECT(index.getHash (97) == hashOf (97));
+        BEAST_EXPECT(! index.getHash (96));
+
+        // The next ledger's parent hash also links a ledger
+        index.insert (200, hashOf (200), hashOf (199));
+        BEAST_EXPECT(index.extend (199, hashOf (199), hashOf (198)));
+        BEAST_EXPECT(index.getHash (199) == hashOf (199));
+    }
+
+    void
+    testReopen ()
+    {
+        testcase ("reopen");
+
+        beast::temp_dir dir;
+        auto const file =
+            boost::filesystem::path (dir.path ()) / "hashes";
+        {
+            LedgerHashIndex index (file, beast::Journal ());
+            for (LedgerIndex seq = 1000; seq < 1100; ++seq)
+                index.insert (seq, hashOf (seq), hashOf (seq - 1));
+            index.insert (70000, hashOf (70000), hashOf (69999));
+        }
+        {
+            LedgerHashIndex index (file, beast::Journal ());
+            bool ok = true;
+            for (LedgerIndex seq = 1000; seq < 1100; ++seq)
+                ok = ok && index.getHash (seq) == hashOf (seq);
+            BEAST_EXPECT(ok);
+            BEAST_EXPECT(index.getHash (70000) == hashOf (70000));
+            BEAST_EXPECT(! index.getHash (999));
+        }
+
+        // An unrecognized file is replaced
+        {
+            std::ofstream out (file.string (), std::ios::trunc);
+            out << "not an index";
+        }
+        {
+            LedgerHashIndex index (file, beast::Journal ());
+            BEAST_EXPECT(! index.getHash (1000));
+            index.insert (1000, hashOf (1000), hashOf (999));
+            BEAST_EXPECT(index.getHash (1000) == hashOf (1000));
+        }
+    }
+
+public:
+    void
+    run ()
+    {
+        testInsert ();
+        testCheck ();
+        testExtend ();
+        testReopen ();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(LedgerHashIndex,app,ripple);
+
+} // test
+} // ripple
@@ -0,0 +1,207 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/app/main/MemoryBudget.h>
+#include <ripple/beast/unit_test.h>
+#include <map>
+
+namespace ripple {
+
+class MemoryBudget_test : public beast::unit_test::suite
+{
+    struct Targets
+    {
+        int size = -1;
+        int age = -1;
+    };
+
+    // The estimated bytes of each cache
+    using Bytes = std::map <std::string, std::size_t>;
+
+    void
+    add (MemoryBudget& budget, std::string const& name,
+        int size, int age, int cost,
+        std::map <std::string, Targets>& targets, Bytes& bytes)
+    {
+        budget.add (name, size, age, cost,
+            [&targets, name](int s, int a)
+            {
+                targets[name].size = s;
+                targets[name].age = a;
+            },
+            [&bytes, name] { return bytes[name]; });
+    }
+
+public:
+    void
+    testNoBudget ()
+    {
+        testcase ("no budget");
+
+        std::map <std::string, Targets> targets;
+        Bytes bytes {{"a", 1000}};
+        MemoryBudget budget (0, beast::Journal{});
+        add (budget, "a", 100, 60, 1, targets, bytes);
+
+        budget.update (1ull << 40);
+        BEAST_EXPECT(targets.empty ());
+        BEAST_EXPECT(budget.level ("a") == 0);
+
+        auto const json = budget.getJson ();
+        BEAST_EXPECT(json["used"] == std::to_string (1ull << 40));
+        BEAST_EXPECT(json["cached"] == "1000");
+        BEAST_EXPECT(json["caches"]["a"]["bytes"] == "1000");
+    }
+
+    void
+    testShedOrder ()
+    {
+        testcase ("shed order");
+
+        std::map <std::string, Targets> targets;
+        Bytes bytes {{"cheap", 10}, {"costly", 1000}};
+        MemoryBudget budget (2000, beast::Journal{});
+        add (budget, "cheap", 100, 60, 1, targets, bytes);
+        add (budget, "costly", 0, 600, 4, targets, bytes);
+
+        // Within the budget nothing changes
+        budget.update (1900);
+        BEAST_EXPECT(targets.empty ());
+
+        // Over it, the caches may hold 710 bytes. The cheap cache holds
+        // too little to be worth shedding.
+        budget.update (2300);
+        BEAST_EXPECT(budget.level ("costly") == 1);
+        BEAST_EXPECT(targets["costly"].size == 0);
+        BEAST_EXPECT(targets["costly"].age == 300);
+        BEAST_EXPECT(targets.count ("cheap") == 0);
+
+        // Once the costly cache frees less per unit of cost, the cheap
+        // one goes.
+        bytes["costly"] = 40;
+        bytes["cheap"] = 1000;
+        budget.update (2300);
+        BEAST_EXPECT(budget.level ("cheap") == 1);
+        BEAST_EXPECT(budget.level ("costly") == 1);
+        BEAST_EXPECT(targets["cheap"].size == 50);
+        BEAST_EXPECT(targets["cheap"].age == 30);
+
+        // Between three quarters of the allowance and the allowance,
+        // hold
+        bytes["cheap"] = 600;
+        budget.update (2300);
+        BEAST_EXPECT(budget.level ("cheap") == 1);
+        BEAST_EXPECT(budget.level ("costly") == 1);
+
+        // Below it, restore the costliest first
+        bytes["cheap"] = 400;
+        budget.update (2300);
+        BEAST_EXPECT(budget.level ("costly") == 0);
+        BEAST_EXPECT(targets["costly"].age == 600);
+        budget.update (2300);
+        BEAST_EXPECT(budget.level ("cheap") == 0);
+        BEAST_EXPECT(targets["cheap"].size == 100);
+    }
+
+    void
+    testRecovery ()
+    {
+        testcase ("recovery");
+
+        std::map <std::string, Targets> targets;
+        Bytes bytes {{"a", 800}};
+        MemoryBudget budget (1000, beast::Journal{});
+        add (budget, "a", 64, 64, 1, targets, bytes);
+
+        // The allowance is cut to 300 bytes
+        budget.update (1500);
+        BEAST_EXPECT(budget.level ("a") == 1);
+        BEAST_EXPECT(budget.getJson ()["allowance"] == "300");
+
+        // The allocator keeps what the cache frees, so the resident
+        // size stays put. That is not a reason to cut again.
+        bytes["a"] = 400;
+        budget.update (1500);
+        BEAST_EXPECT(budget.level ("a") == 2);
+        BEAST_EXPECT(budget.getJson ()["allowance"] == "300");
+
+        bytes["a"] = 200;
+        budget.update (1500);
+        BEAST_EXPECT(budget.level ("a") == 1);
+        budget.update (1500);
+        BEAST_EXPECT(budget.level ("a") == 0);
+        BEAST_EXPECT(targets["a"].size == 64);
+
+        // Growing past the last peak cuts the allowance again
+        budget.update (1600);
+        BEAST_EXPECT(budget.getJson ()["allowance"] == "0");
+        BEAST_EXPECT(budget.level ("a") == 1);
+    }
+
+    void
+    testFloor ()
+    {
+        testcase ("floor");
+
+        std::map <std::string, Targets> targets;
+        Bytes bytes {{"a", 1000}};
+        MemoryBudget budget (1000, beast::Journal{});
+        add (budget, "a", 3, 1, 1, targets, bytes);
+
+        for (int i = 0; i < 2 * MemoryBudget::maxLevel; ++i)
+            budget.update (2000);
+        BEAST_EXPECT(budget.level ("a") == MemoryBudget::maxLevel);
+        BEAST_EXPECT(targets["a"].size == 1);
+        BEAST_EXPECT(targets["a"].age == 1);
+
+        for (int i = 0; i < 2 * MemoryBudget::maxLevel; ++i)
+            budget.update (0);
+        BEAST_EXPECT(budget.level ("a") == 0);
+        BEAST_EXPECT(targets["a"].size == 3);
+        BEAST_EXPECT(targets["a"].age == 1);
+    }
+
+    void
+    testResident ()
+    {
+        testcase ("resident");
+
+        auto const rss = MemoryBudget::residentBytes ();
+#ifdef __linux__
+        BEAST_EXPECT(rss && *rss > 0);
+#else
+        BEAST_EXPECT(! rss);
+#endif
+    }
+
+    void
+    run ()
+    {
+        testNoBudget ();
+        testShedOrder ();
+        testRecovery ();
+        testFloor ();
+        testResident ();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(MemoryBudget,app,ripple);
+
+} // ripple
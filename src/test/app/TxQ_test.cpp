@@ -21,7 +21,11 @@
 #include <ripple/app/misc/LoadFeeTrack.h>
 #include <ripple/app/misc/TxQ.h>
 #include <ripple/app/ledger/LedgerConsensus.h>
+#include <ripple/app/ledger/LedgerMaster.h>
+#include <ripple/app/misc/NetworkOPs.h>
+#include <ripple/app/misc/Transaction.h>
 #include <ripple/app/tx/apply.h>
+#include <ripple/app/tx/applySteps.h>
 #include <ripple/basics/Log.h>
 #include <ripple/basics/mulDiv.h>
 #include <test/jtx/TestSuite.h>
@@ -642,6 +646,143 @@ public:
             ter(terINSUF_FEE_B));
     }
 
+    void testPreflightReuse()
+    {
+        using namespace jtx;
+
+        Env env(*this, makeConfig(), features(featureFeeEscalation));
+
+        auto alice = Account("alice");
+        auto bob = Account("bob");
+
+        env.fund(XRP(1000), noripple(alice));
+
+        // Run preflight before taking the open ledger lock,
+        // as NetworkOPs does, and hand the result to the queue.
+        auto const apply = [&](JTx const& jt)
+        {
+            auto const pf = preflight(env.app(), env.current()->rules(),
+                *jt.stx, tapNONE, env.journal);
+
+            std::pair<TER, bool> result;
+            env.app().openLedger().modify(
+                [&](OpenView& view, beast::Journal j)
+                {
+                    result = env.app().getTxQ().apply(
+                        env.app(), view, jt.stx, pf);
+                    return result.second;
+                });
+            return result;
+        };
+
+        auto const good = env.jt(noop(alice));
+        auto result = apply(good);
+        BEAST_EXPECT(result.first == tesSUCCESS);
+        BEAST_EXPECT(result.second);
+
+        // A preflight failure is reported without touching the view
+        result = apply(env.jt(pay(alice, bob, XRP(-1000))));
+        BEAST_EXPECT(result.first == temBAD_AMOUNT);
+        BEAST_EXPECT(!result.second);
+
+        // Preclaim still runs against the locked view
+        result = apply(good);
+        BEAST_EXPECT(result.first == tefALREADY);
+        BEAST_EXPECT(!result.second);
+    }
+
+    void testPrecheckReuse()
+    {
+        using namespace jtx;
+        using namespace std::chrono_literals;
+
+        Env env(*this, makeConfig(), features(featureFeeEscalation));
+
+        auto alice = Account("alice");
+        auto bob = Account("bob");
+
+        env.fund(XRP(1000), noripple(alice, bob));
+        env.close();
+
+        auto const check = [&](JTx const& jt)
+        {
+            return precheck(env.app(), *env.current(), *jt.stx,
+                tapNONE, env.journal);
+        };
+
+        auto const applied = env.jt(noop(alice));
+        env(applied);
+
+        // A transaction already in the open ledger
+        auto const already = check(applied);
+        BEAST_EXPECT(already.preflight.ter == tesSUCCESS);
+        BEAST_EXPECT(already.ter == tefALREADY);
+        BEAST_EXPECT(already.reuse(*env.current()) == tefALREADY);
+
+        // A sequence that was used by another transaction
+        auto const stale = env.jt(noop(alice),
+            seq(env.seq(alice) - 1), fee(20));
+        auto const past = check(stale);
+        BEAST_EXPECT(past.ter == tefPAST_SEQ);
+
+        // Other results are left to the locked view
+        auto const pending = env.jt(noop(bob));
+        auto const fresh = check(pending);
+        BEAST_EXPECT(fresh.preflight.ter == tesSUCCESS);
+        BEAST_EXPECT(! fresh.ter);
+        BEAST_EXPECT(! fresh.reuse(*env.current()));
+        BEAST_EXPECT(! check(env.jt(pay(alice, bob, XRP(-1)))).ter);
+
+        // The open ledger only grows
+        env(pending);
+        BEAST_EXPECT(already.reuse(*env.current()) == tefALREADY);
+        BEAST_EXPECT(past.reuse(*env.current()) == tefPAST_SEQ);
+
+        // New rules
+        {
+            OpenView const view(open_ledger,
+                Rules(std::unordered_set<uint256, beast::uhash<>>{}),
+                    env.closed());
+            BEAST_EXPECT(view.seq() == env.current()->seq());
+            BEAST_EXPECT(! already.reuse(view));
+        }
+
+        // A ledger switch: the same sequence on another parent
+        {
+            auto const closed = env.closed();
+            auto const parent = env.app().getLedgerMaster().getLedgerBySeq(
+                closed->seq() - 1);
+            if (BEAST_EXPECT(parent))
+            {
+                auto const other = std::make_shared<Ledger>(
+                    *parent, closed->info().closeTime + 10s);
+                other->setImmutable(env.app().config());
+
+                OpenView const view(open_ledger,
+                    env.current()->rules(), other);
+                BEAST_EXPECT(view.seq() == env.current()->seq());
+                BEAST_EXPECT(view.info().parentHash !=
+                    closed->info().hash);
+                BEAST_EXPECT(! already.reuse(view));
+            }
+        }
+
+        // A new open ledger
+        env.close();
+        BEAST_EXPECT(! already.reuse(*env.current()));
+        BEAST_EXPECT(! past.reuse(*env.current()));
+
+        // NetworkOPs reports a reused result without applying
+        auto const parentHash = env.current()->info().parentHash;
+        std::string reason;
+        auto tx = std::make_shared<Transaction>(stale.stx, reason, env.app());
+        env.app().getOPs().processTransaction(
+            tx, false, true, NetworkOPs::FailHard::no);
+        BEAST_EXPECT(tx->getResult() == tefPAST_SEQ);
+        BEAST_EXPECT(env.current()->txCount() == 0);
+        BEAST_EXPECT(env.current()->info().parentHash == parentHash);
+    }
+
     void testQueuedFailure()
     {
         using namespace jtx;
@@ -2630,6 +2771,8 @@ public:
         testLastLedgerSeq();
         testZeroFeeTxn();
         testPreclaimFailures();
+        testPreflightReuse();
+        testPrecheckReuse();
         testQueuedFailure();
         testMultiTxnPerAccount();
         testTieBreaking();
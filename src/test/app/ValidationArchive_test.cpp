@@ -0,0 +1,297 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/app/misc/ValidationArchive.h>
+#include <ripple/app/main/DBInit.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/utility/temp_dir.h>
+#include <ripple/core/SociDB.h>
+#include <ripple/protocol/SecretKey.h>
+#include <ripple/protocol/Serializer.h>
+#include <fstream>
+#include <iterator>
+
+namespace ripple {
+namespace test {
+
+class ValidationArchive_test : public beast::unit_test::suite
+{
+    static
+    DatabaseCon::Setup
+    setup (beast::temp_dir const& dir)
+    {
+        DatabaseCon::Setup setup;
+        setup.dataDir = dir.path ();
+        return setup;
+    }
+
+    // Trusted validations of ledger 1, which is known, and of ledger 2,
+    // which is not, and an untrusted validation of ledger 3, which is
+    // known. Each carries its ledger's sequence.
+    static
+    std::vector<STValidation::pointer>
+    makeValidations ()
+    {
+        auto const keys = randomKeyPair (KeyType::secp256k1);
+        std::vector<STValidation::pointer> validations;
+        for (std::uint32_t seq = 1; seq <= 3; ++seq)
+        {
+            auto v = std::make_shared<STValidation> (ledgerHash (seq),
+                NetClock::time_point{NetClock::duration{1000 + seq}},
+                    keys.first, true);
+            v->setFieldU32 (sfLedgerSequence, seq);
+            v->sign (keys.second);
+            if (seq != 3)
+                v->setTrusted ();
+            validations.push_back (v);
+        }
+        return validations;
+    }
+
+    static
+    boost::optional<std::uint32_t>
+    knownSeq (uint256 const& hash)
+    {
+        for (std::uint32_t seq : {1, 3})
+        {
+            if (hash == ledgerHash (seq))
+                return seq;
+        }
+        return boost::none;
+    }
+
+    static
+    uint256
+    ledgerHash (std::uint32_t seq)
+    {
+        return uint256 (seq * 7);
+    }
+
+    static
+    Blob
+    serialize (STValidation const& v)
+    {
+        Serializer s;
+        v.add (s);
+        return s.peekData ();
+    }
+
+    Section
+    section (std::string const& type, std::string const& path = "")
+    {
+        Section s ("validation_archive");
+        s.set ("type", type);
+        if (! path.empty ())
+            s.set ("path", path);
+        return s;
+    }
+
+    void
+    testLedgerDB ()
+    {
+        testcase ("ledger_db");
+
+        beast::temp_dir dir;
+        DatabaseCon ledgerDB (setup (dir), "ledger.db",
+            LedgerDBInit, LedgerDBCount);
+        auto archive = make_ValidationArchive (section ("ledger_db"),
+            setup (dir), ledgerDB, beast::Journal ());
+        BEAST_EXPECT(archive->getDB () == nullptr);
+
+        auto const validations = makeValidations ();
+        archive->write (validations, 100, knownSeq);
+
+        auto db = ledgerDB.checkoutDb ();
+        boost::optional<std::uint64_t> ledgerSeq;
+        std::uint64_t initialSeq = 0;
+        std::string hash;
+        std::string nodePubKey;
+        std::uint64_t signTime = 0;
+        soci::blob raw (*db);
+        soci::statement st = (db->prepare <<
+            "SELECT LedgerSeq, InitialSeq, LedgerHash, NodePubKey, "
+            "SignTime, RawData FROM Validations ORDER BY SignTime;",
+                soci::into (ledgerSeq),
+                soci::into (initialSeq),
+                soci::into (hash),
+                soci::into (nodePubKey),
+                soci::into (signTime),
+                soci::into (raw));
+        st.execute ();
+
+        std::size_t rows = 0;
+        Blob data;
+        while (st.fetch ())
+        {
+            auto const& v = *validations[rows++];
+            auto const seq = static_cast<std::uint32_t> (rows);
+            // Only the trusted validation of a known ledger has a sequence
+            BEAST_EXPECT(ledgerSeq == (seq == 1 ?
+                boost::make_optional<std::uint64_t> (seq) : boost::none));
+            BEAST_EXPECT(initialSeq == (seq == 1 ? seq : 100));
+            BEAST_EXPECT(hash == to_string (ledgerHash (seq)));
+            BEAST_EXPECT(nodePubKey == toBase58 (
+                TokenType::TOKEN_NODE_PUBLIC, v.getSignerPublic ()));
+            BEAST_EXPECT(signTime == 1000 + seq);
+            convert (raw, data);
+            BEAST_EXPECT(data == serialize (v));
+        }
+        BEAST_EXPECT(rows == 3);
+    }
+
+    void
+    testValidationsDB ()
+    {
+        testcase ("validations_db");
+
+        beast::temp_dir dir;
+        DatabaseCon ledgerDB (setup (dir), "ledger.db",
+            LedgerDBInit, LedgerDBCount);
+        auto archive = make_ValidationArchive (section ("validations_db"),
+            setup (dir), ledgerDB, beast::Journal ());
+        auto const db = archive->getDB ();
+        if (! BEAST_EXPECT(db != nullptr))
+            return;
+
+        auto const validations = makeValidations ();
+        archive->write (validations, 100, knownSeq);
+        archive->ledgerSaved (2, ledgerHash (2));
+        archive->ledgerSaved (3, ledgerHash (3));
+
+        auto session = db->checkoutDb ();
+        boost::optional<std::uint64_t> ledgerSeq;
+        std::uint64_t initialSeq = 0;
+        soci::blob hash (*session);
+        soci::blob nodePubKey (*session);
+        soci::blob raw (*session);
+        soci::statement st = (session->prepare <<
+            "SELECT LedgerSeq, InitialSeq, LedgerHash, NodePubKey, RawData "
+            "FROM Validations ORDER BY SignTime;",
+                soci::into (ledgerSeq),
+                soci::into (initialSeq),
+                soci::into (hash),
+                soci::into (nodePubKey),
+                soci::into (raw));
+        st.execute ();
+
+        std::size_t rows = 0;
+        Blob data;
+        while (st.fetch ())
+        {
+            auto const& v = *validations[rows++];
+            auto const seq = static_cast<std::uint32_t> (rows);
+            BEAST_EXPECT(ledgerSeq && *ledgerSeq == seq);
+            BEAST_EXPECT(initialSeq == seq);
+            convert (hash, data);
+            BEAST_EXPECT(data.size () == 32 &&
+                uint256::fromVoid (data.data ()) == ledgerHash (seq));
+            convert (nodePubKey, data);
+            BEAST_EXPECT(makeSlice (data) == v.getSignerPublic ().slice ());
+            convert (raw, data);
+            BEAST_EXPECT(data == serialize (v));
+        }
+        BEAST_EXPECT(rows == 3);
+    }
+
+    void
+    testFile ()
+    {
+        testcase ("file");
+
+        beast::temp_dir dir;
+        DatabaseCon ledgerDB (setup (dir), "ledger.db",
+            LedgerDBInit, LedgerDBCount);
+        auto const validations = makeValidations ();
+
+        // Reopening the file appends to it
+        for (int i = 0; i < 2; ++i)
+        {
+            auto archive = make_ValidationArchive (
+                section ("file", "validations.bin"),
+                    setup (dir), ledgerDB, beast::Journal ());
+            BEAST_EXPECT(archive->getDB () == nullptr);
+            archive->write (validations, 100, knownSeq);
+        }
+
+        std::ifstream in (dir.file ("validations.bin"), std::ios::binary);
+        Blob const contents {std::istreambuf_iterator<char> (in),
+            std::istreambuf_iterator<char> ()};
+
+        SerialIter sit (makeSlice (contents));
+        std::size_t records = 0;
+        while (! sit.empty ())
+        {
+            auto const size = sit.get32 ();
+            auto const initialSeq = sit.get32 ();
+            auto const raw = sit.getRaw (size);
+            auto const& v = *validations[records++ % validations.size ()];
+            BEAST_EXPECT(initialSeq == (records % 3 == 1 ? 1 : 100));
+            BEAST_EXPECT(raw == serialize (v));
+
+            SerialIter vit (makeSlice (raw));
+            STValidation const copy (vit);
+            BEAST_EXPECT(copy.getLedgerHash () == v.getLedgerHash ());
+        }
+        BEAST_EXPECT(records == 6);
+    }
+
+    void
+    testBadConfig ()
+    {
+        testcase ("configuration");
+
+        beast::temp_dir dir;
+        DatabaseCon ledgerDB (setup (dir), "ledger.db",
+            LedgerDBInit, LedgerDBCount);
+
+        auto fails = [&](Section const& s)
+        {
+            try
+            {
+                make_ValidationArchive (s, setup (dir),
+                    ledgerDB, beast::Journal ());
+            }
+            catch (std::runtime_error const&)
+            {
+                return true;
+            }
+            return false;
+        };
+
+        BEAST_EXPECT(fails (section ("tape")));
+        BEAST_EXPECT(fails (section ("file")));
+        BEAST_EXPECT(! fails (Section ("validation_archive")));
+    }
+
+public:
+    void
+    run ()
+    {
+        testLedgerDB ();
+        testValidationsDB ();
+        testFile ();
+        testBadConfig ();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(ValidationArchive,app,ripple);
+
+} // test
+} // ripple
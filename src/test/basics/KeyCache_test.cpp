@@ -89,6 +89,23 @@ public:
             c.sweep ();
             BEAST_EXPECT(c.size () < 3);
         }
+
+        // Sweep a large cache a batch at a time
+        {
+            Cache c ("test", clock, 0, 1);
+
+            for (int i = 0; i < 10000; ++i)
+                c.insert (std::to_string (i));
+            BEAST_EXPECT(c.size () == 10000);
+            ++clock;
+            ++clock;
+
+            int calls = 1;
+            while (! c.sweep (std::chrono::microseconds::zero ()))
+                ++calls;
+            BEAST_EXPECT(calls > 1);
+            BEAST_EXPECT(c.size () == 0);
+        }
     }
 };
 
@@ -144,6 +144,101 @@ public:
             BEAST_EXPECT(c.getCacheSize() == 0);
             BEAST_EXPECT(c.getTrackSize() == 0);
         }
+
+        testMemoryUsage ();
+        testIncremental ();
+    }
+
+    void testIncremental ()
+    {
+        beast::Journal const j;
+
+        TestStopwatch clock;
+        clock.set (0);
+
+        using Cache = TaggedCache <int, std::string>;
+
+        Cache c ("test", 0, 1, clock, j);
+
+        for (int i = 0; i < 10000; ++i)
+            c.insert (i, std::to_string (i));
+        BEAST_EXPECT(c.getCacheSize () == 10000);
+
+        // Referenced elsewhere, so it stays weakly tracked
+        Cache::mapped_ptr const kept (c.fetch (0));
+
+        ++clock;
+        ++clock;
+
+        std::vector <std::shared_ptr <void const>> trash;
+        int calls = 1;
+        while (! c.sweep (std::chrono::microseconds::zero (), trash))
+            ++calls;
+
+        BEAST_EXPECT(calls > 1);
+        BEAST_EXPECT(trash.size () == 9999);
+        BEAST_EXPECT(c.getCacheSize () == 0);
+        BEAST_EXPECT(c.getTrackSize () == 1);
+
+        // A full sweep abandons a pass in progress
+        c.sweep (std::chrono::microseconds::zero (), trash);
+        c.sweep ();
+        BEAST_EXPECT(c.getTrackSize () == 1);
+        BEAST_EXPECT(trash.size () == 9999);
+    }
+
+    void testMemoryUsage ()
+    {
+        beast::Journal const j;
+
+        TestStopwatch clock;
+        clock.set (0);
+
+        using Cache = TaggedCache <int, std::string>;
+
+        Cache c ("test", 1, 1, clock, j);
+        std::string const big (1000, 'x');
+
+        // Let the table allocate its buckets, which it keeps
+        BEAST_EXPECT(! c.insert (1, big));
+        c.clear ();
+        auto const empty = c.getMemoryUsage ();
+
+        BEAST_EXPECT(! c.insert (1, big));
+        auto const one = c.getMemoryUsage ();
+        BEAST_EXPECT(one >= empty + memoryUsed (big));
+
+        // Replacing the object accounts for the new size
+        {
+            Cache::mapped_ptr p (std::make_shared <std::string> (
+                std::string (5000, 'y')));
+            BEAST_EXPECT(c.canonicalize (1, p, true));
+            BEAST_EXPECT(c.getMemoryUsage () >= one + 4000);
+        }
+
+        // Weakly tracked objects are owned elsewhere
+        {
+            Cache::mapped_ptr p (c.fetch (1));
+            ++clock;
+            c.sweep ();
+            BEAST_EXPECT(c.getCacheSize () == 0);
+            BEAST_EXPECT(c.getMemoryUsage () < one);
+            BEAST_EXPECT(c.getMemoryUsage () > empty);
+
+            // Refreshing makes it cached again
+            BEAST_EXPECT(c.refreshIfPresent (1));
+            BEAST_EXPECT(c.getMemoryUsage () >= one + 4000);
+            BEAST_EXPECT(c.del (1, true));
+        }
+
+        ++clock;
+        c.sweep ();
+        BEAST_EXPECT(c.getTrackSize () == 0);
+        BEAST_EXPECT(c.getMemoryUsage () == empty);
+
+        BEAST_EXPECT(! c.insert (2, big));
+        c.clear ();
+        BEAST_EXPECT(c.getMemoryUsage () == empty);
     }
 };
 
@@ -20,14 +20,143 @@
 #include <BeastConfig.h>
 #include <ripple/basics/mulDiv.h>
 #include <ripple/beast/unit_test.h>
+#include <ripple/beast/xor_shift_engine.h>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <chrono>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
 
 namespace ripple {
 namespace test {
 
+namespace {
+
+// The boost::multiprecision implementation that the 64 bit kernels
+// replaced. The kernels must agree with it bit for bit.
+bool
+referenceMulDivAdd (std::uint64_t value, std::uint64_t mul,
+    std::uint64_t add, std::uint64_t div, std::uint64_t& result)
+{
+    boost::multiprecision::uint128_t ret;
+
+    boost::multiprecision::multiply (ret, value, mul);
+    ret += add;
+    ret /= div;
+
+    if (ret > std::numeric_limits<std::uint64_t>::max())
+        return false;
+
+    result = static_cast<std::uint64_t>(ret);
+    return true;
+}
+
+// Produces operands that exercise the interesting corners of the
+// kernels: small values, values near a power of two and values with
+// only a few significant bits.
+std::uint64_t
+randomOperand (beast::xor_shift_engine& g)
+{
+    auto const max = std::numeric_limits<std::uint64_t>::max();
+    std::uniform_int_distribution<std::uint64_t> dist;
+
+    switch (g() % 6)
+    {
+    case 0: return dist (g) & 0xff;
+    case 1: return dist (g) & 0xffffffffull;
+    case 2: return max - (dist (g) & 0xff);
+    case 3: return (1ull << (g() % 64)) + (dist (g) & 0x3) - 1;
+    case 4: return dist (g) >> (g() % 64);
+    default: break;
+    }
+
+    return dist (g);
+}
+
+} // namespace
+
 struct mulDiv_test : beast::unit_test::suite
 {
-    void run()
+    void
+    check (std::uint64_t value, std::uint64_t mul,
+        std::uint64_t add, std::uint64_t div)
+    {
+        std::uint64_t expected = 0;
+        bool const ok = referenceMulDivAdd (value, mul, add, div, expected);
+
+        std::uint64_t portable = 0;
+        bool const portableOk = detail::mulDivAddPortable (
+            value, mul, add, div, portable);
+
+        if (! expect (ok == portableOk && (! ok || expected == portable)))
+        {
+            log << "portable mismatch: ((" << value << " * " << mul <<
+                ") + " << add << ") / " << div << std::endl;
+        }
+
+#if RIPPLE_HAS_INT128
+        std::uint64_t native = 0;
+        bool const nativeOk = detail::mulDivAddNative (
+            value, mul, add, div, native);
+
+        if (! expect (ok == nativeOk && (! ok || expected == native)))
+        {
+            log << "native mismatch: ((" << value << " * " << mul <<
+                ") + " << add << ") / " << div << std::endl;
+        }
+#endif
+    }
+
+    void testEquivalence ()
+    {
+        testcase ("equivalence");
+
+        auto const max = std::numeric_limits<std::uint64_t>::max();
+        std::uint64_t const tenTo14 = 100000000000000ull;
+        std::uint64_t const tenTo17 = tenTo14 * 1000;
+
+        std::vector<std::uint64_t> const edges =
+        {
+            1, 2, 3, 5, 7, 10, 0xffffffffull, 0x100000000ull,
+            0x100000001ull, tenTo14 - 1, tenTo14, tenTo17,
+            9999999999999999ull, 1000000000000000ull,
+            (1ull << 63) - 1, 1ull << 63, (1ull << 63) + 1,
+            max - 1, max
+        };
+
+        for (auto const v : edges)
+            for (auto const m : edges)
+                for (auto const d : edges)
+                    for (auto const a : { std::uint64_t(0),
+                        std::uint64_t(7), tenTo14 - 1, d - 1, max })
+                    {
+                        check (v, m, a, d);
+                    }
+
+        beast::xor_shift_engine g (20161213);
+
+        for (int i = 0; i < 250000; ++i)
+        {
+            auto const d = randomOperand (g);
+            if (d == 0)
+                continue;
+
+            check (randomOperand (g), randomOperand (g),
+                (i & 1) ? randomOperand (g) : 0, d);
+        }
+
+        // Results that sit exactly on the 64 bit boundary
+        check (max, max, 0, max);
+        check (max, max, max, max);
+        check (max, 2, 1, 2);
+        check (max, 2, 2, 2);
+    }
+
+    void testMulDiv ()
     {
+        testcase ("mulDiv");
+
         const auto max = std::numeric_limits<std::uint64_t>::max();
         const std::uint64_t max32 = std::numeric_limits<std::uint32_t>::max();
 
@@ -53,10 +182,97 @@ struct mulDiv_test : beast::unit_test::suite
         // Overflow
         result = mulDiv(max - 1, max - 2, 5);
         BEAST_EXPECT(!result.first && result.second == max);
+
+        try
+        {
+            mulDiv(1, 1, 0);
+            fail ("division by zero did not throw");
+        }
+        catch (std::overflow_error const&)
+        {
+            pass ();
+        }
+    }
+
+    void run()
+    {
+        testMulDiv ();
+        testEquivalence ();
     }
 };
 
 BEAST_DEFINE_TESTSUITE(mulDiv, ripple_basics, ripple);
 
+//------------------------------------------------------------------------------
+
+// Measures the cost of the 128 bit kernels against the
+// boost::multiprecision implementation they replaced.
+class mulDiv_timing_test : public beast::unit_test::suite
+{
+    struct Operands
+    {
+        std::uint64_t value;
+        std::uint64_t mul;
+        std::uint64_t add;
+        std::uint64_t div;
+    };
+
+    std::vector<Operands> dataset_;
+
+    template <class Function>
+    void
+    measure (char const* name, Function&& f)
+    {
+        using namespace std::chrono;
+
+        std::uint64_t sink = 0;
+        auto const start = high_resolution_clock::now ();
+
+        for (int i = 0; i != 16; ++i)
+        {
+            for (auto const& x : dataset_)
+            {
+                std::uint64_t r;
+                if (f (x.value, x.mul, x.add, x.div, r))
+                    sink += r;
+            }
+        }
+
+        auto const elapsed = duration_cast<nanoseconds>(
+            high_resolution_clock::now () - start);
+
+        log << "    " << name << ": " <<
+            (double(elapsed.count()) / (16 * dataset_.size())) <<
+            " ns/op (" << sink << ")" << std::endl;
+    }
+
+public:
+    void run()
+    {
+        // Operands shaped like those produced by STAmount
+        // multiplication and division of normalized mantissas.
+        beast::xor_shift_engine g (1991);
+        std::uniform_int_distribution<std::uint64_t> mantissa (
+            1000000000000000ull, 9999999999999999ull);
+
+        dataset_.reserve (1000000);
+        for (int i = 0; i < 1000000; ++i)
+        {
+            dataset_.push_back ({ mantissa (g), (i & 1) ?
+                100000000000000000ull : mantissa (g), 7, (i & 1) ?
+                    mantissa (g) : 100000000000000ull });
+        }
+
+        measure ("boost::multiprecision", referenceMulDivAdd);
+        measure ("portable", detail::mulDivAddPortable);
+#if RIPPLE_HAS_INT128
+        measure ("native", detail::mulDivAddNative);
+#endif
+        pass ();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(mulDiv_timing, ripple_basics, ripple);
+
 }  // namespace test
 }  // namespace ripple
@@ -0,0 +1,220 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of Beast: https://github.com/vinniefalco/Beast
+    Copyright 2013, Vinnie Falco <vinnie.falco@gmail.com>
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+
+#include <ripple/beast/insight/Histogram.h>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace beast {
+namespace insight {
+
+class Histogram_test : public unit_test::suite
+{
+public:
+    void
+    testBuckets ()
+    {
+        testcase ("buckets");
+
+        using value_type = Histogram::value_type;
+
+        // Small values are exact
+        for (value_type v = 0; v < 2 * Histogram::subBucketCount; ++v)
+        {
+            BEAST_EXPECT(Histogram::bucketIndex (v) == v);
+            BEAST_EXPECT(Histogram::highestEquivalent (v) == v);
+        }
+
+        // Every value falls in a bucket whose range contains it, and
+        // that range is narrow relative to the value.
+        for (value_type v = 1; v < (value_type (1) << Histogram::valueBits);
+            v = v * 3 / 2 + 1)
+        {
+            auto const i = Histogram::bucketIndex (v);
+            BEAST_EXPECT(i < Histogram::bucketCount);
+            BEAST_EXPECT(Histogram::highestEquivalent (i) >= v);
+            BEAST_EXPECT(i == 0 ||
+                Histogram::highestEquivalent (i - 1) < v);
+            BEAST_EXPECT(Histogram::highestEquivalent (i) - v <=
+                v / Histogram::subBucketCount);
+        }
+
+        // Buckets are contiguous
+        for (std::size_t i = 1; i < Histogram::bucketCount; ++i)
+        {
+            auto const high = Histogram::highestEquivalent (i - 1);
+            BEAST_EXPECT(Histogram::bucketIndex (high) == i - 1);
+            BEAST_EXPECT(Histogram::bucketIndex (high + 1) == i);
+        }
+
+        // Huge values land in the last bucket
+        BEAST_EXPECT(Histogram::bucketIndex (
+            std::numeric_limits <value_type>::max ()) ==
+                Histogram::bucketCount - 1);
+    }
+
+    void
+    testPercentiles ()
+    {
+        testcase ("percentiles");
+
+        Histogram h;
+        BEAST_EXPECT(h.snapshot ().count () == 0);
+        BEAST_EXPECT(h.snapshot ().percentile (0.99) == 0);
+
+        for (Histogram::value_type v = 1; v <= 100000; ++v)
+            h.record (v);
+
+        auto const s = h.snapshot ();
+        BEAST_EXPECT(s.count () == 100000);
+        BEAST_EXPECT(s.sum () == 100000ull * 100001 / 2);
+        BEAST_EXPECT(s.max () == 100000);
+
+        auto const near = [](Histogram::value_type got,
+            Histogram::value_type want)
+        {
+            return got >= want &&
+                got - want <= want / Histogram::subBucketCount;
+        };
+        BEAST_EXPECT(near (s.percentile (0.5), 50000));
+        BEAST_EXPECT(near (s.percentile (0.99), 99000));
+        BEAST_EXPECT(near (s.percentile (0.999), 99900));
+        BEAST_EXPECT(s.percentile (1.0) == 100000);
+
+        // A single outlier shows up in the tail but not the median
+        Histogram tail;
+        for (int i = 0; i < 999; ++i)
+            tail.record (std::chrono::milliseconds (2));
+        tail.record (std::chrono::seconds (3));
+        auto const t = tail.snapshot ();
+        BEAST_EXPECT(near (t.percentile (0.5), 2000));
+        BEAST_EXPECT(near (t.percentile (0.999), 2000));
+        BEAST_EXPECT(t.percentile (1.0) == 3000000);
+    }
+
+    void
+    testMerge ()
+    {
+        testcase ("merge");
+
+        Histogram a;
+        Histogram b;
+        for (int i = 0; i < 100; ++i)
+        {
+            a.record (10);
+            b.record (1000);
+        }
+
+        auto s = a.snapshot ();
+        s += b.snapshot ();
+        BEAST_EXPECT(s.count () == 200);
+        BEAST_EXPECT(s.sum () == 100 * 10 + 100 * 1000);
+        BEAST_EXPECT(s.max () == 1000);
+        BEAST_EXPECT(s.totalCount () == 200);
+        BEAST_EXPECT(s.percentile (0.5) == 10);
+        BEAST_EXPECT(s.percentile (0.99) >= 1000);
+    }
+
+    void
+    testConcurrent ()
+    {
+        testcase ("concurrent");
+
+        Histogram h;
+        int const threads = 4;
+        int const values = 100000;
+
+        std::vector <std::thread> workers;
+        for (int i = 0; i < threads; ++i)
+        {
+            workers.emplace_back ([&h, i]
+            {
+                for (int j = 0; j < values; ++j)
+                    h.record (j % 1000 + i);
+            });
+        }
+        for (auto& worker : workers)
+            worker.join ();
+
+        auto const s = h.snapshot ();
+        BEAST_EXPECT(s.count () == threads * values);
+        BEAST_EXPECT(s.max () == 999 + threads - 1);
+    }
+
+    void
+    testRotate ()
+    {
+        testcase ("rotate");
+
+        Histogram h;
+        for (int i = 0; i < 100; ++i)
+            h.record (3000);
+
+        // The previous window is still reported after one rotation
+        h.rotate ();
+        for (int i = 0; i < 100; ++i)
+            h.record (10);
+        auto s = h.snapshot ();
+        BEAST_EXPECT(s.count () == 200);
+        BEAST_EXPECT(s.max () == 3000);
+        BEAST_EXPECT(s.percentile (0.99) >= 3000);
+
+        // and dropped after the next
+        h.rotate ();
+        s = h.snapshot ();
+        BEAST_EXPECT(s.count () == 100);
+        BEAST_EXPECT(s.sum () == 100 * 10);
+        BEAST_EXPECT(s.max () == 10);
+        BEAST_EXPECT(s.percentile (0.99) == 10);
+
+        // Totals cover every value ever recorded
+        h.rotate ();
+        s = h.snapshot ();
+        BEAST_EXPECT(s.count () == 0);
+        BEAST_EXPECT(s.percentile (0.5) == 0);
+        BEAST_EXPECT(s.totalCount () == 200);
+        BEAST_EXPECT(s.totalSum () == 100 * 3000 + 100 * 10);
+
+        // Windows rotate on their own once the interval passes
+        Histogram timed (std::chrono::milliseconds (20));
+        timed.record (5);
+        BEAST_EXPECT(timed.snapshot ().count () == 1);
+        std::this_thread::sleep_for (std::chrono::milliseconds (50));
+        BEAST_EXPECT(timed.snapshot ().count () == 0);
+        BEAST_EXPECT(timed.snapshot ().totalCount () == 1);
+    }
+
+    void
+    run ()
+    {
+        testBuckets ();
+        testPercentiles ();
+        testMerge ();
+        testConcurrent ();
+        testRotate ();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(Histogram,insight,beast);
+
+}
+}
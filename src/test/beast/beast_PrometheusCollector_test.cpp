@@ -0,0 +1,173 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of Beast: https://github.com/vinniefalco/Beast
+    Copyright 2013, Vinnie Falco <vinnie.falco@gmail.com>
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+
+#include <ripple/beast/insight/PrometheusCollector.h>
+#include <ripple/beast/insight/Counter.h>
+#include <ripple/beast/insight/Event.h>
+#include <ripple/beast/insight/Gauge.h>
+#include <ripple/beast/insight/Hook.h>
+#include <ripple/beast/insight/Meter.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+namespace beast {
+namespace insight {
+
+class PrometheusCollector_test : public unit_test::suite
+{
+public:
+    static
+    bool
+    contains (std::string const& text, std::string const& line)
+    {
+        return text.find (line + "\n") != std::string::npos;
+    }
+
+    void
+    testFormat ()
+    {
+        testcase ("format");
+
+        auto const collector = PrometheusCollector::New (
+            "rippled", Journal ());
+
+        std::string text;
+        collector->collect ();
+        collector->write (text);
+        BEAST_EXPECT(text.empty ());
+
+        {
+            Counter counter (collector->make_counter ("peers.counter"));
+            Meter meter (collector->make_meter ("bytes"));
+            Gauge gauge (collector->make_gauge ("size"));
+            Event event (collector->make_event ("latency"));
+
+            counter.increment (5);
+            counter.increment (-2);
+            meter.increment (7);
+            gauge.set (10);
+            gauge.increment (-20);
+            gauge.increment (4);
+            for (int i = 0; i < 100; ++i)
+                event.notify (std::chrono::milliseconds (2));
+
+            collector->collect ();
+            collector->write (text);
+            BEAST_EXPECT(contains (text, "# TYPE rippled_peers_counter untyped"));
+            BEAST_EXPECT(contains (text, "rippled_peers_counter 3"));
+            BEAST_EXPECT(contains (text, "# TYPE rippled_bytes counter"));
+            BEAST_EXPECT(contains (text, "rippled_bytes 7"));
+            BEAST_EXPECT(contains (text, "# TYPE rippled_size gauge"));
+            BEAST_EXPECT(contains (text, "rippled_size 4"));
+            BEAST_EXPECT(contains (text, "# TYPE rippled_latency summary"));
+            BEAST_EXPECT(contains (text,
+                "rippled_latency{quantile=\"0.5\"} 0.002000"));
+            BEAST_EXPECT(contains (text,
+                "rippled_latency{quantile=\"0.999\"} 0.002000"));
+            BEAST_EXPECT(contains (text, "rippled_latency_sum 0.200000"));
+            BEAST_EXPECT(contains (text, "rippled_latency_count 100"));
+        }
+
+        // Destroyed metrics are no longer reported
+        text.clear ();
+        collector->collect ();
+        collector->write (text);
+        BEAST_EXPECT(text.empty ());
+    }
+
+    void
+    testMerge ()
+    {
+        testcase ("merge");
+
+        auto const collector = PrometheusCollector::New ("", Journal ());
+
+        std::atomic<int> calls {0};
+        Gauge gauge (collector->make_gauge ("9lives"));
+        Hook hook (collector->make_hook ([&]
+        {
+            ++calls;
+            gauge.set (9);
+        }));
+        Meter a (collector->make_meter ("jobs.count"));
+        Meter b (collector->make_meter ("jobs-count"));
+        a.increment (1);
+        b.increment (2);
+
+        std::string text;
+        collector->collect ();
+        collector->write (text);
+        BEAST_EXPECT(calls >= 1);
+        BEAST_EXPECT(contains (text, "_9lives 9"));
+        BEAST_EXPECT(contains (text, "jobs_count 3"));
+        BEAST_EXPECT(text.find ("# TYPE jobs_count counter") ==
+            text.rfind ("# TYPE jobs_count counter"));
+    }
+
+    void
+    testSnapshot ()
+    {
+        testcase ("snapshot");
+
+        auto const collector = PrometheusCollector::New ("", Journal ());
+
+        std::atomic<int> calls {0};
+        Gauge gauge (collector->make_gauge ("size"));
+        Hook hook (collector->make_hook ([&]
+        {
+            ++calls;
+            gauge.set (calls);
+        }));
+
+        // A scrape doesn't run the hooks
+        std::string text;
+        collector->write (text);
+        collector->write (text);
+        BEAST_EXPECT(calls == 0);
+        BEAST_EXPECT(text.empty ());
+
+        // The collector's thread collects once a second
+        using namespace std::chrono;
+        auto const deadline = steady_clock::now () + seconds (10);
+        while (text.empty () && steady_clock::now () < deadline)
+        {
+            std::this_thread::sleep_for (milliseconds (50));
+            collector->write (text);
+        }
+        BEAST_EXPECT(calls >= 1);
+        BEAST_EXPECT(contains (text, "# TYPE size gauge"));
+    }
+
+    void
+    run ()
+    {
+        testFormat ();
+        testMerge ();
+        testSnapshot ();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(PrometheusCollector,insight,beast);
+
+}
+}
@@ -0,0 +1,195 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of Beast: https://github.com/vinniefalco/Beast
+    Copyright 2013, Vinnie Falco <vinnie.falco@gmail.com>
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/beast/unit_test.h>
+
+#include <ripple/beast/insight/StatsDCollector.h>
+#include <ripple/beast/insight/Counter.h>
+#include <ripple/beast/insight/Event.h>
+#include <ripple/beast/insight/Gauge.h>
+#include <ripple/beast/insight/Meter.h>
+#include <boost/asio/ip/udp.hpp>
+#include <boost/asio/io_service.hpp>
+#include <chrono>
+#include <map>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace beast {
+namespace insight {
+
+class StatsDCollector_test : public unit_test::suite
+{
+public:
+    // Collects what the collector sends until `done` returns true
+    // or the deadline passes.
+    class Receiver
+    {
+    public:
+        Receiver ()
+            : m_socket (m_io_service, boost::asio::ip::udp::endpoint (
+                boost::asio::ip::address_v4::loopback (), 0))
+        {
+            m_socket.non_blocking (true);
+        }
+
+        IP::Endpoint endpoint () const
+        {
+            return IP::Endpoint::from_string ("127.0.0.1:" +
+                std::to_string (m_socket.local_endpoint ().port ()));
+        }
+
+        template <class Predicate>
+        void receive (Predicate done)
+        {
+            using namespace std::chrono;
+            auto const deadline = steady_clock::now () + seconds (10);
+            char buffer [2048];
+            while (! done () && steady_clock::now () < deadline)
+            {
+                boost::system::error_code ec;
+                auto const n = m_socket.receive (
+                    boost::asio::buffer (buffer), 0, ec);
+                if (ec)
+                {
+                    std::this_thread::sleep_for (milliseconds (10));
+                    continue;
+                }
+                std::istringstream ss (std::string (buffer, n));
+                std::string line;
+                while (std::getline (ss, line))
+                    lines.push_back (line);
+            }
+        }
+
+        std::vector <std::string> lines;
+
+    private:
+        boost::asio::io_service m_io_service;
+        boost::asio::ip::udp::socket m_socket;
+    };
+
+    // Splits "prefix.name:value|type|@rate" into its parts
+    struct Line
+    {
+        std::string name;
+        std::string value;
+        std::string type;
+        double rate = 1.0;
+
+        explicit Line (std::string const& s)
+        {
+            auto const colon = s.find (':');
+            auto const bar = s.find ('|', colon);
+            auto const at = s.find ("|@", bar);
+            name = s.substr (0, colon);
+            value = s.substr (colon + 1, bar - colon - 1);
+            type = s.substr (bar + 1, at == std::string::npos ?
+                std::string::npos : at - bar - 1);
+            if (at != std::string::npos)
+                rate = std::stod (s.substr (at + 2));
+        }
+    };
+
+    void
+    testAggregation ()
+    {
+        testcase ("aggregation");
+
+        Receiver receiver;
+        auto const collector = StatsDCollector::New (
+            receiver.endpoint (), "test", Journal ());
+
+        auto const counter = collector->make_counter ("counter");
+        auto const meter = collector->make_meter ("meter");
+        auto const gauge = collector->make_gauge ("gauge");
+        auto const event = collector->make_event ("event");
+
+        int const threads = 4;
+        int const updates = 10000;
+        int const events = 100;
+
+        std::vector <std::thread> workers;
+        for (int i = 0; i < threads; ++i)
+        {
+            workers.emplace_back ([&]
+            {
+                for (int j = 0; j < updates; ++j)
+                {
+                    ++gauge;
+                    ++counter;
+                    ++meter;
+                }
+                for (int j = 0; j < events; ++j)
+                    event.notify (std::chrono::milliseconds (7));
+            });
+        }
+        for (auto& worker : workers)
+            worker.join ();
+
+        std::map <std::string, std::int64_t> totals;
+        double eventCount = 0;
+        std::string gaugeValue;
+
+        receiver.receive ([&]
+        {
+            for (auto const& s : receiver.lines)
+            {
+                Line const line (s);
+                if (line.type == "ms")
+                {
+                    BEAST_EXPECT(line.value == "7");
+                    eventCount += 1 / line.rate;
+                }
+                else if (line.name == "test.gauge")
+                {
+                    gaugeValue = line.value;
+                }
+                else
+                {
+                    totals[line.name + "|" + line.type] +=
+                        std::stoll (line.value);
+                }
+            }
+            receiver.lines.clear ();
+            return totals["test.counter|c"] == threads * updates &&
+                totals["test.meter|m"] == threads * updates &&
+                ! gaugeValue.empty () &&
+                eventCount > threads * events - 0.5;
+        });
+
+        BEAST_EXPECT(totals["test.counter|c"] == threads * updates);
+        BEAST_EXPECT(totals["test.meter|m"] == threads * updates);
+        BEAST_EXPECT(gaugeValue == std::to_string (threads * updates));
+        BEAST_EXPECT(eventCount > threads * events - 0.5 &&
+            eventCount < threads * events + 0.5);
+    }
+
+    void
+    run ()
+    {
+        testAggregation ();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(StatsDCollector,insight,beast);
+
+}
+}
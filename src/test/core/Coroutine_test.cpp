@@ -19,6 +19,7 @@
 
 #include <BeastConfig.h>
 #include <ripple/core/JobQueue.h>
+#include <ripple/json/Arena.h>
 #include <test/jtx.h>
 #include <chrono>
 #include <condition_variable>
@@ -170,12 +171,62 @@ public:
         BEAST_EXPECT(*lv == -1);
     }
 
+    void
+    json_arena()
+    {
+        using namespace std::chrono_literals;
+        using namespace jtx;
+        Env env(*this);
+        auto& jq = env.app().getJobQueue();
+        jq.setThreadCount(0, false);
+        gate g;
+        std::shared_ptr<JobQueue::Coro> c;
+        Json::Arena* arena = nullptr;
+        std::size_t before = 0;
+        jq.postCoro(jtCLIENT, "Coroutine-Test",
+            [&](auto const& cr)
+            {
+                c = cr;
+                Json::Arena a;
+                arena = &a;
+                Json::Value v;
+                v["before"] = std::string(100, 'x');
+                before = a.size();
+                g.signal();
+                c->yield();
+
+                // The arena is current again after resuming
+                v["after"] = std::string(100, 'y');
+                this->BEAST_EXPECT(a.size() > before);
+                g.signal();
+            });
+        BEAST_EXPECT(g.wait_for(5s));
+        c->join();
+        BEAST_EXPECT(before != 0);
+
+        // While the coroutine is suspended its arena is not used
+        jq.addJob(jtCLIENT, "Arena-Test",
+            [&](auto const& job)
+            {
+                Json::Value v;
+                v["job"] = std::string(100, 'z');
+                this->BEAST_EXPECT(arena->size() == before);
+                g.signal();
+            });
+        BEAST_EXPECT(g.wait_for(5s));
+
+        c->post();
+        BEAST_EXPECT(g.wait_for(5s));
+        c->join();
+    }
+
     void
     run()
     {
         correct_order();
         incorrect_order();
         thread_specific_storage();
+        json_arena();
     }
 };
 
@@ -0,0 +1,132 @@
+//------------------------------------------------------------------------------
+/*
+This file is part of rippled: https://github.com/ripple/rippled
+Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+Permission to use, copy, modify, and/or distribute this software for any
+purpose  with  or without fee is hereby granted, provided that the above
+copyright notice and this permission notice appear in all copies.
+
+THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <ripple/core/JobProfiler.h>
+#include <ripple/core/LoadEvent.h>
+#include <ripple/core/LoadMonitor.h>
+#include <ripple/beast/unit_test.h>
+#include <chrono>
+#include <thread>
+
+namespace ripple {
+
+class JobProfiler_test : public beast::unit_test::suite
+{
+public:
+    void testStacks ()
+    {
+        testcase ("stacks");
+
+        JobProfiler profiler;
+        std::string const type ("ledgerData");
+        std::string const name ("InboundLedger");
+
+        // Nothing is recorded for threads that are not attached
+        {
+            JobProfiler::Scope scope (type);
+            BEAST_EXPECT(! scope.entered ());
+        }
+
+        std::thread ([&]
+        {
+            profiler.attach ();
+
+            // Off until a frequency is set
+            {
+                JobProfiler::Scope scope (type);
+                BEAST_EXPECT(! scope.entered ());
+            }
+
+            profiler.setFrequency (1);
+            profiler.sample ();
+
+            JobProfiler::Scope outer (type);
+            {
+                JobProfiler::Scope inner (name);
+                profiler.sample ();
+                profiler.sample ();
+            }
+            profiler.sample ();
+
+            LoadMonitor monitor ((beast::Journal ()));
+            {
+                LoadEvent event (monitor, "ValidationWrite", true);
+                profiler.sample ();
+                event.reName ("ProcessTXN");
+                profiler.sample ();
+            }
+
+            profiler.setFrequency (0);
+        }).join ();
+
+        auto const result = profiler.getJson (true);
+        BEAST_EXPECT(result["samples"] == 6);
+        BEAST_EXPECT(result["idle"] == 1);
+        auto const& stacks = result["stacks"];
+        BEAST_EXPECT(stacks.size () == 4);
+        BEAST_EXPECT(stacks["ledgerData"] == 1);
+        BEAST_EXPECT(stacks["ledgerData;InboundLedger"] == 2);
+        BEAST_EXPECT(stacks["ledgerData;ValidationWrite"] == 1);
+        BEAST_EXPECT(stacks["ledgerData;ProcessTXN"] == 1);
+
+        auto const cleared = profiler.getJson (false);
+        BEAST_EXPECT(cleared["samples"] == 0);
+        BEAST_EXPECT(cleared["stacks"].size () == 0);
+    }
+
+    void testSampler ()
+    {
+        testcase ("sampler");
+
+        JobProfiler profiler;
+        std::string const type ("clientCommand");
+
+        std::thread ([&]
+        {
+            profiler.attach ();
+            profiler.setFrequency (1000);
+            BEAST_EXPECT(profiler.frequency () == 1000);
+
+            JobProfiler::Scope scope (type);
+            auto const deadline =
+                std::chrono::steady_clock::now () + std::chrono::seconds (10);
+            while (profiler.getJson (false)["samples"].asUInt () < 10 &&
+                    std::chrono::steady_clock::now () < deadline)
+                std::this_thread::sleep_for (std::chrono::milliseconds (1));
+
+            profiler.setFrequency (0);
+        }).join ();
+
+        auto const result = profiler.getJson (false);
+        BEAST_EXPECT(result["frequency"] == 0);
+        BEAST_EXPECT(result["samples"].asUInt () >= 10);
+        BEAST_EXPECT(result["stacks"]["clientCommand"].asUInt () ==
+            result["samples"].asUInt ());
+    }
+
+    void run ()
+    {
+        testStacks ();
+        testSampler ();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(JobProfiler, core, ripple);
+
+}
@@ -0,0 +1,129 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/core/Reclaimer.h>
+#include <ripple/beast/unit_test.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace ripple {
+
+class Reclaimer_test : public beast::unit_test::suite
+{
+    // Records the thread which destroys it
+    struct Tracked
+    {
+        std::atomic <std::thread::id>& destroyedOn;
+
+        explicit
+        Tracked (std::atomic <std::thread::id>& on)
+            : destroyedOn (on)
+        {
+        }
+
+        ~Tracked ()
+        {
+            destroyedOn = std::this_thread::get_id ();
+        }
+    };
+
+    static
+    bool
+    waitFor (Reclaimer const& reclaimer)
+    {
+        using namespace std::chrono;
+        auto const deadline = steady_clock::now () + seconds (10);
+        while (reclaimer.pending () != 0)
+        {
+            if (steady_clock::now () > deadline)
+                return false;
+            std::this_thread::sleep_for (milliseconds (1));
+        }
+        return true;
+    }
+
+public:
+    void testBackground ()
+    {
+        testcase ("background");
+
+        std::atomic <std::thread::id> destroyedOn {std::thread::id ()};
+        Reclaimer reclaimer ("test");
+
+        std::vector <Reclaimer::value_type> items;
+        items.push_back (std::make_shared <Tracked> (destroyedOn));
+        items.push_back (std::make_shared <int> (1));
+        reclaimer.release (std::move (items));
+        BEAST_EXPECT(items.empty ());
+
+        BEAST_EXPECT(waitFor (reclaimer));
+        BEAST_EXPECT(destroyedOn.load () != std::thread::id ());
+        BEAST_EXPECT(destroyedOn.load () != std::this_thread::get_id ());
+
+        // Releasing nothing is harmless
+        reclaimer.release (std::move (items));
+        BEAST_EXPECT(reclaimer.pending () == 0);
+    }
+
+    void testShared ()
+    {
+        testcase ("shared");
+
+        std::atomic <std::thread::id> destroyedOn {std::thread::id ()};
+        Reclaimer reclaimer ("test");
+
+        // An object still referenced elsewhere is left alone
+        auto const kept = std::make_shared <Tracked> (destroyedOn);
+        std::vector <Reclaimer::value_type> items {kept};
+        reclaimer.release (std::move (items));
+        BEAST_EXPECT(waitFor (reclaimer));
+        BEAST_EXPECT(kept.use_count () == 1);
+        BEAST_EXPECT(destroyedOn.load () == std::thread::id ());
+    }
+
+    void testDrain ()
+    {
+        testcase ("drain");
+
+        std::atomic <std::thread::id> destroyedOn {std::thread::id ()};
+        {
+            Reclaimer reclaimer ("test");
+            std::vector <Reclaimer::value_type> items;
+            for (int i = 0; i < 1000; ++i)
+                items.push_back (std::make_shared <int> (i));
+            items.push_back (std::make_shared <Tracked> (destroyedOn));
+            reclaimer.release (std::move (items));
+        }
+        // Everything pending was released before destruction finished
+        BEAST_EXPECT(destroyedOn.load () != std::thread::id ());
+    }
+
+    void run ()
+    {
+        testBackground ();
+        testShared ();
+        testDrain ();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(Reclaimer,core,ripple);
+
+} // ripple
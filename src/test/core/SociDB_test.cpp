@@ -20,6 +20,7 @@
 #include <BeastConfig.h>
 
 #include <ripple/core/ConfigSections.h>
+#include <ripple/core/DatabaseCon.h>
 #include <ripple/core/SociDB.h>
 #include <ripple/basics/contract.h>
 #include <test/jtx/TestSuite.h>
@@ -361,12 +362,83 @@ public:
         if (bfs::is_regular_file (dbPath))
             bfs::remove (dbPath);
     }
+    void testReadConnections ()
+    {
+        testcase ("readConnections");
+        const char* dbInit[] = {
+            "PRAGMA synchronous=NORMAL;",
+            "PRAGMA journal_mode=WAL;",
+            "BEGIN TRANSACTION;",
+            "CREATE TABLE IF NOT EXISTS Ledgers (       \
+                LedgerHash      CHARACTER(64) PRIMARY KEY,  \
+                LedgerSeq       BIGINT UNSIGNED             \
+            );",
+            "END TRANSACTION;"};
+        int const dbInitCount = std::extent<decltype(dbInit)>::value;
+
+        DatabaseCon::Setup setup;
+        setup.dataDir = getDatabasePath ();
+        setup.readConnections = 2;
+        {
+            DatabaseCon con (setup, "SociReadTestDB", dbInit, dbInitCount);
+            {
+                auto db = con.checkoutDb ();
+                *db << "INSERT INTO Ledgers (LedgerHash, LedgerSeq) "
+                    "VALUES ('A', 1);";
+            }
+
+            // Readers proceed while the writer is checked out
+            auto writer = con.checkoutDb ();
+            auto r1 = con.checkoutReadDb ();
+            auto r2 = con.checkoutReadDb ();
+            BEAST_EXPECT(r1.get () != writer.get ());
+            BEAST_EXPECT(r2.get () != writer.get ());
+            BEAST_EXPECT(r1.get () != r2.get ());
+
+            *writer << "INSERT INTO Ledgers (LedgerHash, LedgerSeq) "
+                "VALUES ('B', 2);";
+            int count = 0;
+            *r1 << "SELECT COUNT(*) FROM Ledgers;", soci::into (count);
+            BEAST_EXPECT(count == 2);
+
+            // Readers may not write
+            try
+            {
+                *r2 << "DELETE FROM Ledgers;";
+                fail ("write through a reader");
+            }
+            catch (soci::soci_error const&)
+            {
+                pass ();
+            }
+            *r2 << "SELECT COUNT(*) FROM Ledgers;", soci::into (count);
+            BEAST_EXPECT(count == 2);
+        }
+
+        // A temporary database can not be shared
+        setup.standAlone = true;
+        {
+            DatabaseCon con (setup, "SociReadTestDB", dbInit, dbInitCount);
+            auto db = con.checkoutReadDb ();
+            BEAST_EXPECT(db.get () == &con.getSession ());
+        }
+
+        namespace bfs = boost::filesystem;
+        for (auto const ext : {"", "-wal", "-shm"})
+        {
+            bfs::path const dbPath (getDatabasePath () /
+                (std::string ("SociReadTestDB") + ext));
+            if (bfs::is_regular_file (dbPath))
+                bfs::remove (dbPath);
+        }
+    }
     void testSQLite ()
     {
         testSQLiteFileNames ();
         testSQLiteSession ();
         testSQLiteSelect ();
         testSQLiteDeleteWithSubselect();
+        testReadConnections ();
     }
     void run ()
     {
@@ -22,6 +22,8 @@
 #include <ripple/json/Writer.h>
 #include <test/json/TestOutputSuite.h>
 #include <ripple/beast/unit_test.h>
+#include <cstdint>
+#include <limits>
 
 namespace Json {
 
@@ -110,6 +112,83 @@ public:
         expectResult ("\"\\b\\f\\n\\r\\t\"");
     }
 
+    void testLongEscaping ()
+    {
+        // Escapes at every position of strings long enough to be
+        // scanned in blocks.
+        for (std::size_t size : {15, 16, 17, 33})
+        {
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                std::string s (size, 'x');
+                s[i] = '"';
+                std::string expected = "\"" + s + "\"";
+                expected.replace (i + 1, 1, "\\\"");
+
+                setup ("escape at " + std::to_string (i) +
+                    " of " + std::to_string (size));
+                writer_->output (s);
+                expectResult (expected);
+            }
+        }
+
+        setup ("many escapes");
+        writer_->output ("/path/to\\a \"file\"\n/with/slashes/and\ttabs/");
+        expectResult ("\"/path/to\\\\a \\\"file\\\"\\n"
+            "/with/slashes/and\\ttabs/\"");
+
+        setup ("control and high characters");
+        writer_->output ("\x01\x1f\x7f\xc3\xa9\xff long enough to use a block");
+        expectResult ("\"\\u0001\\u001F\x7f\xc3\xa9\xff long enough to use a block\"");
+    }
+
+    void testFastWriterEscaping ()
+    {
+        // Strings are escaped exactly as FastWriter escapes them
+        std::string all;
+        for (int c = 1; c < 256; ++c)
+            all += static_cast<char> (c);
+        for (auto const& s : {all, all + all + "tail"})
+        {
+            setup ("as FastWriter");
+            writer_->output (s);
+            expectResult (Json::FastWriter ().write (Json::Value (s)));
+        }
+    }
+
+    void testIntegers ()
+    {
+        setup ("zero");
+        writer_->output (0u);
+        expectResult ("0");
+
+        setup ("negative");
+        writer_->output (-1);
+        expectResult ("-1");
+
+        setup ("int min");
+        writer_->output (std::numeric_limits<std::int32_t>::min ());
+        expectResult ("-2147483648");
+
+        setup ("int64 min");
+        writer_->output (std::numeric_limits<std::int64_t>::min ());
+        expectResult ("-9223372036854775808");
+
+        setup ("uint64 max");
+        writer_->output (std::numeric_limits<std::uint64_t>::max ());
+        expectResult ("18446744073709551615");
+
+        for (std::uint64_t i = 1, n = 1; i < 20; ++i, n *= 10)
+        {
+            setup ("power " + std::to_string (i));
+            writer_->output (n);
+            expectResult (std::to_string (n));
+            setup ("below power " + std::to_string (i));
+            writer_->output (n - 1);
+            expectResult (std::to_string (n - 1));
+        }
+    }
+
     void testArray ()
     {
         setup ("empty array");
@@ -191,6 +270,9 @@ public:
         testPrimitives ();
         testEmpty ();
         testEscaping ();
+        testLongEscaping ();
+        testFastWriterEscaping ();
+        testIntegers ();
         testArray ();
         testLongArray ();
         testEmbeddedArraySimple ();
@@ -0,0 +1,372 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/json/json_reader.h>
+#include <ripple/json/json_writer.h>
+#include <ripple/json/impl/StructuralIndex.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/xor_shift_engine.h>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace ripple {
+
+namespace {
+
+class Generator
+{
+    beast::xor_shift_engine rng_;
+
+    int
+    pick (int n)
+    {
+        return std::uniform_int_distribution<int> (0, n - 1) (rng_);
+    }
+
+public:
+    explicit
+    Generator (std::uint64_t seed)
+        : rng_ (seed)
+    {
+    }
+
+    std::string
+    string ()
+    {
+        static char const chars[] =
+            "abcdefghijklmnopqrstuvwxyz0123456789 \"\\/\b\f\n\r\t{}[]:,";
+        std::string s;
+        int const length = pick (3) == 0 ? pick (200) : pick (12);
+        for (int i = 0; i < length; ++i)
+        {
+            if (pick (20) == 0)
+                s += "\xc3\xa9";
+            else
+                s += chars[pick (sizeof (chars) - 1)];
+        }
+        return s;
+    }
+
+    Json::Value
+    value (int depth)
+    {
+        switch (pick (depth > 4 ? 6 : 8))
+        {
+        case 0: return Json::Value ();
+        case 1: return pick (2) == 0;
+        case 2: return pick (1000000) - 500000;
+        // Smaller unsigned values are read back as signed
+        case 3: return static_cast<Json::UInt> (rng_ ()) | 0x80000000u;
+        // Whole numbers are read back as integers
+        case 4: return (pick (1000) * 2 + 1) / 16.0;
+        case 5: return string ();
+        case 6:
+        {
+            Json::Value a (Json::arrayValue);
+            for (int i = pick (6); i > 0; --i)
+                a.append (value (depth + 1));
+            return a;
+        }
+        default:
+        {
+            Json::Value o (Json::objectValue);
+            for (int i = pick (6); i > 0; --i)
+                o[string ()] = value (depth + 1);
+            return o;
+        }
+        }
+    }
+
+    Json::Value
+    document ()
+    {
+        // A null value is both an empty object and an empty array
+        Json::Value v;
+        while (v.type () != Json::objectValue &&
+                v.type () != Json::arrayValue)
+            v = value (0);
+        return v;
+    }
+
+    // Insert, remove or replace a few characters
+    std::string
+    mutate (std::string s)
+    {
+        static char const chars[] = "\"\\/{}[]:, \nx0-.e";
+        for (int i = pick (3) + 1; i > 0 && ! s.empty (); --i)
+        {
+            auto const pos = pick (static_cast<int> (s.size ()));
+            switch (pick (3))
+            {
+            case 0: s.erase (pos, 1); break;
+            case 1: s.insert (pos, 1, chars[pick (sizeof (chars) - 1)]); break;
+            default: s[pos] = chars[pick (sizeof (chars) - 1)]; break;
+            }
+        }
+        return s;
+    }
+};
+
+} // namespace
+
+class json_reader_test : public beast::unit_test::suite
+{
+    // The indexed reader must agree with the character at a time one
+    bool
+    agree (std::string const& doc)
+    {
+        Json::Value indexed;
+        Json::Value scanned;
+        Json::Reader r1;
+        Json::Reader r2 (false);
+
+        bool const ok1 = r1.parse (doc, indexed);
+        bool const ok2 = r2.parse (doc, scanned);
+
+        return ok1 == ok2 &&
+            indexed == scanned &&
+            r1.getFormatedErrorMessages () == r2.getFormatedErrorMessages ();
+    }
+
+    void
+    testIndex ()
+    {
+        testcase ("structural index");
+
+        using Json::detail::closingQuote;
+        std::vector<std::uint32_t> index;
+
+        auto build = [&index](std::string const& s)
+        {
+            return Json::detail::buildStructuralIndex (
+                s.data (), s.data () + s.size (), index);
+        };
+
+        BEAST_EXPECT(build (R"({"a": [1, "b\"c"], "d":true})"));
+        std::vector<std::uint32_t> const expected {
+            1, 3 | closingQuote, 6, 10, 15 | closingQuote,
+            19, 21 | closingQuote};
+        BEAST_EXPECT(index == expected);
+
+        BEAST_EXPECT(build (""));
+        BEAST_EXPECT(index.empty ());
+
+        // Comments, NULs and unterminated strings are not indexed
+        BEAST_EXPECT(! build ("{} // comment"));
+        BEAST_EXPECT(! build (std::string ("{\0}", 3)));
+        BEAST_EXPECT(! build ("{\"a"));
+        BEAST_EXPECT(! build ("{\"a\\\"}"));
+
+        // But may appear inside strings
+        BEAST_EXPECT(build ("{\"/*\":\"//\"}"));
+        BEAST_EXPECT(build (std::string ("[\"\0\"]", 5)));
+
+        // Runs of backslashes across block boundaries
+        for (int n = 0; n < 8; ++n)
+        {
+            for (int pad = 56; pad < 72; ++pad)
+            {
+                std::string const s = "[\"" + std::string (pad, 'x') +
+                    std::string (n, '\\') + "\"]";
+                BEAST_EXPECT(build (s) == (n % 2 == 0));
+            }
+        }
+    }
+
+    void
+    testConformance ()
+    {
+        testcase ("conformance");
+
+        std::vector<std::string> const docs {
+            "{}",
+            "[]",
+            " \t\r\n{ } ",
+            R"({"method":"submit","params":[{"tx_blob":"1200002280000000"}]})",
+            R"({"a":"\"\\\/\b\f\n\r\t","b":"\u00e9\u4e2d","c":"\ud83d\ude00"})",
+            R"([1, -1, 0, 4294967295, -2147483648, 1.5, -2.5e10, 1E3])",
+            R"([true, false, null, [], {}, [[[]]], {"a":{"b":{}}}])",
+            R"({"a" : 1 , "b" :[ 2 ,3 ] })",
+            "{\"a\":\t\"x\"\r\n,\n\"b\"\n:\n[\n]\n}",
+            R"([4294967296])",
+            R"([-2147483649])",
+            R"([1e300])",
+            R"({"a":1,"a":2})",
+            R"({"a":1 /* comment */, "b":2} // trailing)",
+            R"({} trailing)",
+            R"({} "unterminated)",
+            R"({"a":1,})",
+            R"([1,])",
+            R"({"a" 1})",
+            R"({"a":tru})",
+            R"({"a":truex})",
+            R"({"a":1"b"})",
+            R"(["a"x"b"])",
+            R"(["\x"])",
+            R"(["\u12"])",
+            R"(["\ud83d"])",
+            R"(["\ud83d\u"])",
+            R"(\"a")",
+            R"({\"a":1})",
+            R"("string")",
+            "12",
+            "",
+            "   ",
+            "[",
+            "{\"a\":[",
+            std::string ("[\"\0\"]", 5),
+            std::string ("[1\0]", 4),
+        };
+
+        for (auto const& doc : docs)
+        {
+            // Move the document across block boundaries
+            for (int pad = 0; pad < 70; ++pad)
+            {
+                if (! agree (std::string (pad, ' ') + doc))
+                {
+                    fail ("disagree on '" + doc + "'", __FILE__, __LINE__);
+                    break;
+                }
+            }
+        }
+        pass ();
+    }
+
+    void
+    testRandom ()
+    {
+        testcase ("random documents");
+
+        Generator g (42);
+        Json::FastWriter fast;
+        Json::StyledWriter styled;
+
+        int failures = 0;
+        for (int i = 0; i < 2000; ++i)
+        {
+            auto const v = g.document ();
+            auto const doc = (i % 2) ? fast.write (v) : styled.write (v);
+
+            Json::Value parsed;
+            if (! Json::Reader ().parse (doc, parsed) || parsed != v)
+                ++failures;
+
+            if (! agree (doc))
+                ++failures;
+
+            for (int j = 0; j < 5; ++j)
+            {
+                if (! agree (g.mutate (doc)))
+                    ++failures;
+            }
+        }
+        BEAST_EXPECT(failures == 0);
+    }
+
+public:
+    void
+    run ()
+    {
+        testIndex ();
+        testConformance ();
+        testRandom ();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(json_reader,json,ripple);
+
+//------------------------------------------------------------------------------
+
+class json_reader_timing_test : public beast::unit_test::suite
+{
+    void
+    time (std::string const& name, std::vector<std::string> const& docs)
+    {
+        using namespace std::chrono;
+
+        std::size_t bytes = 0;
+        for (auto const& doc : docs)
+            bytes += doc.size ();
+
+        for (auto const indexed : { false, true })
+        {
+            Json::Reader reader (indexed);
+            auto const start = steady_clock::now ();
+            for (auto const& doc : docs)
+            {
+                Json::Value v;
+                reader.parse (doc, v);
+            }
+            auto const elapsed = duration_cast<duration<double>> (
+                steady_clock::now () - start);
+
+            log << name << (indexed ? " indexed: " : " scanned: ") <<
+                (bytes / (1024.0 * 1024.0)) / elapsed.count () <<
+                " MB/s" << std::endl;
+        }
+    }
+
+public:
+    void
+    run ()
+    {
+        std::size_t const target = 16 * 1024 * 1024;
+
+        {
+            Generator g (7);
+            Json::FastWriter writer;
+            std::vector<std::string> docs;
+            for (std::size_t bytes = 0; bytes < target;)
+            {
+                docs.push_back (writer.write (g.document ()));
+                bytes += docs.back ().size ();
+            }
+            time ("random", docs);
+        }
+
+        {
+            // Transaction submissions, as sent by busy clients
+            Json::StyledWriter writer;
+            std::vector<std::string> docs;
+            for (std::size_t bytes = 0; bytes < target;)
+            {
+                Json::Value params (Json::objectValue);
+                params["tx_blob"] = std::string (
+                    400 + (docs.size () % 7) * 100, 'A' + docs.size () % 6);
+                params["fail_hard"] = false;
+                Json::Value request (Json::objectValue);
+                request["method"] = "submit";
+                request["params"].append (params);
+                docs.push_back (writer.write (request));
+                bytes += docs.back ().size ();
+            }
+            time ("submit", docs);
+        }
+
+        pass ();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(json_reader_timing,json,ripple);
+
+} // ripple
@@ -20,8 +20,14 @@
 #include <BeastConfig.h>
 #include <ripple/json/json_value.h>
 #include <ripple/json/json_reader.h>
+#include <ripple/json/to_string.h>
 #include <ripple/beast/unit_test.h>
 #include <ripple/beast/type_name.h>
+#include <boost/optional.hpp>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <thread>
 
 namespace ripple {
 
@@ -217,6 +223,156 @@ struct json_value_test : beast::unit_test::suite
         testGreaterThan ("big");
     }
 
+    void
+    test_members ()
+    {
+        // Members keep their address as others are added
+        Json::Value object;
+        Json::Value& first = object["m"];
+        first = 1;
+        for (int i = 0; i < 1000; ++i)
+            object[std::to_string (i)] = i;
+        BEAST_EXPECT(&object["m"] == &first);
+        BEAST_EXPECT(first == 1);
+        BEAST_EXPECT(object.size () == 1001);
+
+        // Members are visited in key order however they were added
+        Json::Value forward, backward;
+        for (int i = 0; i < 1000; ++i)
+        {
+            forward[std::to_string (i)] = i;
+            backward[std::to_string (999 - i)] = 999 - i;
+        }
+        BEAST_EXPECT(forward == backward);
+        BEAST_EXPECT(! (forward < backward) && ! (backward < forward));
+        {
+            std::string last;
+            bool sorted = true;
+            for (auto it = backward.begin (); it != backward.end (); ++it)
+            {
+                std::string const name = it.memberName ();
+                sorted = sorted && (last.empty () || last < name);
+                sorted = sorted &&
+                    (*it).asInt () == std::stoi (name);
+                last = name;
+            }
+            BEAST_EXPECT(sorted);
+            BEAST_EXPECT(backward.getMemberNames ().size () == 1000);
+        }
+
+        // Removing members
+        for (int i = 0; i < 1000; i += 2)
+        {
+            BEAST_EXPECT(forward.removeMember (std::to_string (i)) == i);
+            BEAST_EXPECT(backward.removeMember (std::to_string (i)) == i);
+        }
+        BEAST_EXPECT(forward.removeMember ("missing").isNull ());
+        BEAST_EXPECT(forward.size () == 500);
+        BEAST_EXPECT(! forward.isMember ("0"));
+        BEAST_EXPECT(forward.isMember ("1"));
+        BEAST_EXPECT(forward == backward);
+
+        // Copies compare equal and are independent
+        Json::Value copy (backward);
+        BEAST_EXPECT(copy == backward);
+        copy["1"] = "changed";
+        BEAST_EXPECT(copy != backward);
+        BEAST_EXPECT(backward["1"] == 1);
+        BEAST_EXPECT(copy < backward || backward < copy);
+
+        // Static keys are not copied
+        static char const name[] = "static";
+        Json::Value statics;
+        statics[Json::StaticString (name)] = 1;
+        BEAST_EXPECT(statics.begin ().memberName () == name);
+        BEAST_EXPECT(statics["static"] == 1);
+
+        object.clear ();
+        BEAST_EXPECT(object.isObject ());
+        BEAST_EXPECT(object.size () == 0);
+        BEAST_EXPECT(object.begin () == object.end ());
+    }
+
+    void
+    test_arrays ()
+    {
+        Json::Value array;
+        array.resize (10);
+        BEAST_EXPECT(array.isArray ());
+        BEAST_EXPECT(array.size () == 10);
+        BEAST_EXPECT(array[9u].isNull ());
+        for (Json::UInt i = 0; i < 10; ++i)
+            array[i] = i;
+        Json::UInt count = 0;
+        for (auto const& element : array)
+            BEAST_EXPECT(element == count++);
+        BEAST_EXPECT(count == 10);
+
+        array.resize (4);
+        BEAST_EXPECT(array.size () == 4);
+        BEAST_EXPECT(array[3u] == 3);
+        Json::Value const& constArray = array;
+        BEAST_EXPECT(constArray[4u].isNull ());
+
+        // Elements added out of order
+        Json::Value sparse (Json::arrayValue);
+        for (Json::UInt i = 0; i < 1000; ++i)
+            sparse[999 - i] = i;
+        BEAST_EXPECT(sparse.size () == 1000);
+        Json::Value& element = sparse[500u];
+        sparse.append ("end");
+        BEAST_EXPECT(&sparse[500u] == &element);
+        BEAST_EXPECT(sparse[1000u] == "end");
+        bool ordered = true;
+        Json::UInt index = 0;
+        for (auto it = sparse.begin (); it != sparse.end (); ++it, ++index)
+            ordered = ordered && it.index () == index;
+        BEAST_EXPECT(ordered);
+        BEAST_EXPECT(index == 1001);
+
+        sparse.resize (2);
+        BEAST_EXPECT(sparse.size () == 2);
+        BEAST_EXPECT(sparse[1u] == 998);
+    }
+
+    void
+    test_arena ()
+    {
+        Json::Value outer;
+        std::thread other;
+        {
+            Json::Arena arena;
+            BEAST_EXPECT(arena.size () == 0);
+
+            Json::Value inner;
+            {
+                Json::Arena nested;
+                inner["a"] = "nested";
+                BEAST_EXPECT(nested.size () != 0);
+            }
+            outer = inner;
+
+            for (int i = 0; i < 10000; ++i)
+                outer["list"].append (std::string (i % 100, 'x'));
+            BEAST_EXPECT(arena.size () > 64 * 1024);
+
+            // Values escape the arena and are released on another thread
+            Json::Value moved = std::move (inner);
+            other = std::thread ([v = std::move (moved)] () mutable
+                {
+                    v.clear ();
+                });
+        }
+        other.join ();
+
+        BEAST_EXPECT(outer["a"] == "nested");
+        BEAST_EXPECT(outer["list"].size () == 10000);
+        BEAST_EXPECT(outer["list"][9999u].asString ().size () == 99);
+        outer["after"] = "heap";
+        outer.removeMember ("list");
+        BEAST_EXPECT(outer.size () == 2);
+    }
+
     void run ()
     {
         test_bool ();
@@ -225,9 +381,195 @@ struct json_value_test : beast::unit_test::suite
         test_copy ();
         test_move ();
         test_comparisons ();
+        test_members ();
+        test_arrays ();
+        test_arena ();
     }
 };
 
 BEAST_DEFINE_TESTSUITE(json_value, json, ripple);
 
+//------------------------------------------------------------------------------
+
+// Builds, serializes and destroys values shaped like the largest RPC
+// responses, with and without an arena.
+class json_value_timing_test : public beast::unit_test::suite
+{
+    // Handlers name members with jss:: static strings
+    static
+    Json::StaticString
+    key (char const* name)
+    {
+        return Json::StaticString (name);
+    }
+
+    static
+    Json::Value
+    amount (int i)
+    {
+        Json::Value v (Json::objectValue);
+        v[key ("currency")] = "USD";
+        v[key ("issuer")] = "rvYAfWj5gh67oV6fW32ZzP3Aw4Eubs59B";
+        v[key ("value")] = std::to_string (1000 + i) + ".25";
+        return v;
+    }
+
+    static
+    Json::Value
+    accountLines (int n)
+    {
+        Json::Value result (Json::objectValue);
+        result[key ("account")] = "rHb9CJAWyB4rj91VRWn96DkukG4bwdtyTh";
+        Json::Value& lines = result[key ("lines")] = Json::arrayValue;
+        for (int i = 0; i < n; ++i)
+        {
+            Json::Value& line = lines.append (Json::objectValue);
+            line[key ("account")] = "rPEPPER7kfTD9w2To4CQk6UCfuHM9c6GDY";
+            line[key ("balance")] = std::to_string (i) + ".5";
+            line[key ("currency")] = "USD";
+            line[key ("limit")] = "100000";
+            line[key ("limit_peer")] = "0";
+            line[key ("quality_in")] = 0;
+            line[key ("quality_out")] = 0;
+            line[key ("no_ripple")] = true;
+        }
+        result[key ("ledger_current_index")] = 12345678;
+        result[key ("validated")] = false;
+        return result;
+    }
+
+    static
+    Json::Value
+    accountOffers (int n)
+    {
+        Json::Value result (Json::objectValue);
+        result[key ("account")] = "rHb9CJAWyB4rj91VRWn96DkukG4bwdtyTh";
+        Json::Value& offers = result[key ("offers")] = Json::arrayValue;
+        for (int i = 0; i < n; ++i)
+        {
+            Json::Value& offer = offers.append (Json::objectValue);
+            offer[key ("flags")] = 0;
+            offer[key ("seq")] = i;
+            offer[key ("taker_gets")] = amount (i);
+            offer[key ("taker_pays")] = std::to_string (1000000 + i);
+            offer[key ("quality")] = "0.000000007599140009999998";
+        }
+        result[key ("ledger_current_index")] = 12345678;
+        return result;
+    }
+
+    static
+    Json::Value
+    bookOffers (int n)
+    {
+        Json::Value result (Json::objectValue);
+        Json::Value& offers = result[key ("offers")] = Json::arrayValue;
+        for (int i = 0; i < n; ++i)
+        {
+            Json::Value& offer = offers.append (Json::objectValue);
+            offer[key ("Account")] = "rM3X3QSr8icjTGpaF52dozhbT2BZSXJQYM";
+            offer[key ("BookDirectory")] = std::string (64, 'A');
+            offer[key ("BookNode")] = "0000000000000000";
+            offer[key ("Flags")] = 0;
+            offer[key ("LedgerEntryType")] = "Offer";
+            offer[key ("OwnerNode")] = "0000000000000000";
+            offer[key ("PreviousTxnID")] = std::string (64, 'B');
+            offer[key ("PreviousTxnLgrSeq")] = 12345000 + i;
+            offer[key ("Sequence")] = i;
+            offer[key ("TakerGets")] = amount (i);
+            offer[key ("TakerPays")] = std::to_string (1000000 + i);
+            offer[key ("index")] = std::string (64, 'C');
+            offer[key ("owner_funds")] = "10000.5";
+            offer[key ("quality")] = "1000.25";
+        }
+        result[key ("ledger_current_index")] = 12345678;
+        return result;
+    }
+
+    static
+    Json::Value
+    ledger (int n)
+    {
+        Json::Value result (Json::objectValue);
+        Json::Value& ledger = result[key ("ledger")] = Json::objectValue;
+        ledger[key ("ledger_index")] = "12345678";
+        ledger[key ("closed")] = true;
+        Json::Value& txs = ledger[key ("transactions")] = Json::arrayValue;
+        for (int i = 0; i < n; ++i)
+        {
+            Json::Value& tx = txs.append (Json::objectValue);
+            tx[key ("Account")] = "rM3X3QSr8icjTGpaF52dozhbT2BZSXJQYM";
+            tx[key ("Amount")] = amount (i);
+            tx[key ("Destination")] = "rPEPPER7kfTD9w2To4CQk6UCfuHM9c6GDY";
+            tx[key ("Fee")] = "12";
+            tx[key ("Sequence")] = i;
+            tx[key ("SigningPubKey")] = std::string (66, 'D');
+            tx[key ("TransactionType")] = "Payment";
+            tx[key ("TxnSignature")] = std::string (140, 'E');
+            tx[key ("hash")] = std::string (64, 'F');
+            Json::Value& meta = tx[key ("metaData")] = Json::objectValue;
+            Json::Value& nodes =
+                meta[key ("AffectedNodes")] = Json::arrayValue;
+            for (int j = 0; j < 4; ++j)
+            {
+                Json::Value& node = nodes.append (Json::objectValue);
+                Json::Value& modified =
+                    node[key ("ModifiedNode")] = Json::objectValue;
+                Json::Value& fields =
+                    modified[key ("FinalFields")] = Json::objectValue;
+                fields[key ("Balance")] = amount (j);
+                fields[key ("Flags")] = 131072;
+                fields[key ("HighLimit")] = amount (j);
+                fields[key ("LowLimit")] = amount (j);
+                modified[key ("LedgerEntryType")] = "RippleState";
+                modified[key ("LedgerIndex")] = std::string (64, 'G');
+                modified[key ("PreviousFields")][key ("Balance")] =
+                    amount (j + 1);
+            }
+            meta[key ("TransactionIndex")] = i;
+            meta[key ("TransactionResult")] = "tesSUCCESS";
+        }
+        return result;
+    }
+
+    void
+    time (std::string const& name, std::function<Json::Value ()> build)
+    {
+        using namespace std::chrono;
+
+        int const rounds = 20;
+        for (auto const arena : { false, true })
+        {
+            std::size_t bytes = 0;
+            auto const start = steady_clock::now ();
+            for (int i = 0; i < rounds; ++i)
+            {
+                boost::optional<Json::Arena> a;
+                if (arena)
+                    a.emplace ();
+                bytes += to_string (build ()).size ();
+            }
+            auto const elapsed = duration_cast<duration<double>> (
+                steady_clock::now () - start);
+
+            log << name << (arena ? " arena: " : " heap: ") <<
+                1000 * elapsed.count () / rounds << " ms, " <<
+                bytes / rounds << " bytes" << std::endl;
+        }
+    }
+
+public:
+    void
+    run ()
+    {
+        time ("account_lines", [] { return accountLines (20000); });
+        time ("account_offers", [] { return accountOffers (20000); });
+        time ("book_offers", [] { return bookOffers (5000); });
+        time ("ledger", [] { return ledger (2000); });
+        pass ();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(json_value_timing, json, ripple);
+
 } // ripple
@@ -0,0 +1,299 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2013 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/ledger/detail/StateItems.h>
+#include <ripple/beast/unit_test.h>
+#include <ripple/beast/xor_shift_engine.h>
+#include <chrono>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace ripple {
+namespace test {
+
+namespace {
+
+uint256
+randomKey (beast::xor_shift_engine& g)
+{
+    uint256 key;
+    for (auto& b : key)
+        b = static_cast<std::uint8_t>(g());
+    return key;
+}
+
+}
+
+class StateItems_test : public beast::unit_test::suite
+{
+    using items_t = detail::StateItems<int>;
+    using model_t = std::map<uint256, int>;
+
+    // Checks every query against the model
+    void
+    check (items_t const& items, model_t const& model,
+        std::vector<uint256> const& probes)
+    {
+        BEAST_EXPECT(items.size() == model.size());
+        BEAST_EXPECT(items.empty() == model.empty());
+
+        std::size_t count = 0;
+        for (auto const& item : items)
+        {
+            auto const iter = model.find (item.first);
+            if (! BEAST_EXPECT(iter != model.end()))
+                return;
+            BEAST_EXPECT(iter->second == item.second);
+            ++count;
+        }
+        BEAST_EXPECT(count == model.size());
+
+        auto const ordered = items.ordered();
+        if (! BEAST_EXPECT(ordered.size() == model.size()))
+            return;
+        auto iter = model.begin();
+        for (auto const* item : ordered)
+        {
+            BEAST_EXPECT(item->first == iter->first);
+            BEAST_EXPECT(item->second == iter->second);
+            ++iter;
+        }
+
+        auto const odd = [](items_t::value_type const& item)
+        {
+            return item.second % 2 != 0;
+        };
+        for (auto const& key : probes)
+        {
+            auto const found = items.find (key);
+            auto const expected = model.find (key);
+            if (expected == model.end())
+                BEAST_EXPECT(! found);
+            else if (BEAST_EXPECT(found))
+                BEAST_EXPECT(found->second == expected->second);
+
+            auto next = model.upper_bound (key);
+            while (next != model.end() && next->second % 2 == 0)
+                ++next;
+            auto const n = items.next (key, odd);
+            if (next == model.end())
+                BEAST_EXPECT(! n);
+            else if (BEAST_EXPECT(n))
+                BEAST_EXPECT(n->first == next->first);
+        }
+    }
+
+    void
+    testEmpty()
+    {
+        testcase ("empty");
+
+        items_t items;
+        BEAST_EXPECT(items.empty());
+        BEAST_EXPECT(items.begin() == items.end());
+        BEAST_EXPECT(items.ordered().empty());
+        BEAST_EXPECT(! items.find (uint256 (1)));
+        BEAST_EXPECT(! items.next (uint256 (),
+            [](items_t::value_type const&) { return true; }));
+    }
+
+    void
+    testEmplace()
+    {
+        testcase ("emplace and erase");
+
+        items_t items;
+        auto result = items.emplace (uint256 (5), 1);
+        BEAST_EXPECT(result.second);
+        BEAST_EXPECT(result.first->second == 1);
+
+        result = items.emplace (uint256 (5), 2);
+        BEAST_EXPECT(! result.second);
+        BEAST_EXPECT(result.first->second == 1);
+
+        result.first->second = 3;
+        BEAST_EXPECT(items.find (uint256 (5))->second == 3);
+
+        items.erase (uint256 (5));
+        BEAST_EXPECT(items.empty());
+        BEAST_EXPECT(! items.find (uint256 (5)));
+        BEAST_EXPECT(items.begin() == items.end());
+
+        // An erased key can be added again
+        result = items.emplace (uint256 (5), 4);
+        BEAST_EXPECT(result.second);
+        BEAST_EXPECT(items.size() == 1);
+        BEAST_EXPECT(items.find (uint256 (5))->second == 4);
+    }
+
+    void
+    testRandom (std::size_t size)
+    {
+        testcase << "random " << size;
+
+        beast::xor_shift_engine g (size);
+        std::uniform_int_distribution<int> op (0, 9);
+
+        items_t items;
+        model_t model;
+        std::vector<uint256> keys;
+
+        std::vector<uint256> probes;
+        for (int i = 0; i < 64; ++i)
+            probes.push_back (randomKey (g));
+
+        for (std::size_t i = 0; i < 4 * size; ++i)
+        {
+            auto const action = op (g);
+            if (action < 6 || keys.empty())
+            {
+                auto const key = randomKey (g);
+                auto const value = static_cast<int>(g() % 1000);
+                keys.push_back (key);
+                BEAST_EXPECT(items.emplace (key, value).second);
+                model.emplace (key, value);
+            }
+            else
+            {
+                auto const& key = keys[g() % keys.size()];
+                if (action < 8)
+                {
+                    // Erase, or add an erased key back
+                    if (model.count (key))
+                    {
+                        items.erase (key);
+                        model.erase (key);
+                    }
+                    else
+                    {
+                        BEAST_EXPECT(items.emplace (key, 7).second);
+                        model.emplace (key, 7);
+                    }
+                }
+                else if (auto const item = items.find (key))
+                {
+                    item->second += 1;
+                    model[key] += 1;
+                }
+            }
+
+            if (i % (size / 4 + 1) == 0)
+            {
+                probes.push_back (keys[g() % keys.size()]);
+                check (items, model, probes);
+            }
+        }
+        check (items, model, probes);
+
+        // Copies are independent
+        items_t copy (items);
+        model_t const before (model);
+        auto const key = randomKey (g);
+        items.emplace (key, 1);
+        model.emplace (key, 1);
+        check (copy, before, probes);
+        check (items, model, probes);
+    }
+
+    void
+    run() override
+    {
+        testEmpty();
+        testEmplace();
+        testRandom (4);
+        testRandom (20);
+        testRandom (300);
+        testRandom (5000);
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(StateItems,ledger,ripple);
+
+//------------------------------------------------------------------------------
+
+// Measures the table against the std::map it replaced, for the
+// small tables of a sandbox and the large table of an open ledger.
+class StateItems_timing_test : public beast::unit_test::suite
+{
+    template <class Table, class Find>
+    void
+    measure (char const* name, std::size_t size,
+        std::size_t rounds, Find&& find)
+    {
+        using namespace std::chrono;
+
+        beast::xor_shift_engine g (size);
+        std::vector<uint256> keys;
+        for (std::size_t i = 0; i < size; ++i)
+            keys.push_back (randomKey (g));
+
+        std::size_t sink = 0;
+        auto const start = high_resolution_clock::now();
+        for (std::size_t r = 0; r < rounds; ++r)
+        {
+            Table table;
+            for (auto const& key : keys)
+            {
+                table.emplace (key, 1);
+                // Entries are read several times once buffered
+                sink += find (table, keys[g() % keys.size()]);
+                sink += find (table, key);
+            }
+        }
+        auto const elapsed = duration_cast<nanoseconds>(
+            high_resolution_clock::now() - start);
+
+        log << "    " << name << " " << size << ": " <<
+            (double(elapsed.count()) / (rounds * size)) <<
+            " ns/entry (" << sink << ")" << std::endl;
+    }
+
+    void
+    measure (std::size_t size, std::size_t rounds)
+    {
+        measure<std::map<uint256, int>>("std::map", size, rounds,
+            [](std::map<uint256, int> const& table, uint256 const& key)
+            {
+                return table.count (key);
+            });
+        measure<detail::StateItems<int>>("StateItems", size, rounds,
+            [](detail::StateItems<int> const& table, uint256 const& key)
+            {
+                return table.find (key) ? 1 : 0;
+            });
+    }
+
+public:
+    void
+    run() override
+    {
+        measure (6, 200000);
+        measure (50, 20000);
+        measure (1000, 1000);
+        measure (20000, 50);
+        pass();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(StateItems_timing,ledger,ripple);
+
+} // test
+} // ripple
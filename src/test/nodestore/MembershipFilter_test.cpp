@@ -0,0 +1,148 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/nodestore/impl/MembershipFilter.h>
+#include <test/nodestore/TestBase.h>
+#include <ripple/nodestore/DummyScheduler.h>
+#include <ripple/nodestore/Manager.h>
+#include <ripple/beast/utility/temp_dir.h>
+#include <sstream>
+
+namespace ripple {
+namespace NodeStore {
+
+class MembershipFilter_test : public TestBase
+{
+public:
+    void
+    testFilter ()
+    {
+        testcase ("filter");
+
+        auto const batch = createPredictableBatch (numObjectsToTest, 1);
+        auto const other = createPredictableBatch (numObjectsToTest, 2);
+
+        MembershipFilter filter (64 * 1024);
+        BEAST_EXPECT(filter.size () == 64 * 1024);
+
+        for (auto const& object : batch)
+            filter.insert (object->getHash ().begin ());
+
+        bool all = true;
+        for (auto const& object : batch)
+            all = all && filter.mayContain (object->getHash ().begin ());
+        BEAST_EXPECT(all);
+
+        int falsePositives = 0;
+        for (auto const& object : other)
+            if (filter.mayContain (object->getHash ().begin ()))
+                ++falsePositives;
+        BEAST_EXPECT(falsePositives < numObjectsToTest / 100);
+
+        // Round trip
+        std::stringstream ss;
+        filter.save (ss);
+        MembershipFilter copy (64 * 1024);
+        BEAST_EXPECT(copy.load (ss));
+        all = true;
+        for (auto const& object : batch)
+            all = all && copy.mayContain (object->getHash ().begin ());
+        BEAST_EXPECT(all);
+
+        // Filters of another size are rejected
+        ss.clear ();
+        ss.seekg (0);
+        MembershipFilter smaller (1024);
+        BEAST_EXPECT(! smaller.load (ss));
+        BEAST_EXPECT(! smaller.mayContain (batch[0]->getHash ().begin ()));
+    }
+
+    void
+    testBackend ()
+    {
+        testcase ("backend");
+
+        DummyScheduler scheduler;
+        beast::temp_dir tempDir;
+        beast::Journal j;
+
+        Section params;
+        params.set ("type", "memory");
+        params.set ("path", tempDir.path ());
+
+        auto const batch = createPredictableBatch (numObjectsToTest, 3);
+        auto const hidden = createPredictableBatch (numObjectsToTest, 4);
+
+        auto filtered = [&](bool fresh)
+        {
+            return make_FilteredBackend (
+                Manager::instance ().make_Backend (params, scheduler, j),
+                64 * 1024, fresh, j);
+        };
+
+        // Memory backends with the same path share their contents, so
+        // this one stores objects behind the filter's back.
+        auto raw = Manager::instance ().make_Backend (params, scheduler, j);
+
+        {
+            auto backend = filtered (true);
+            storeBatch (*backend, batch);
+            storeBatch (*raw, hidden);
+
+            Batch copy;
+            fetchCopyOfBatch (*backend, &copy, batch);
+            BEAST_EXPECT(areBatchesEqual (batch, copy));
+            fetchMissing (*backend, hidden);
+        }
+
+        // The saved filter is used once, then removed
+        {
+            auto backend = filtered (false);
+            Batch copy;
+            fetchCopyOfBatch (*backend, &copy, batch);
+            BEAST_EXPECT(areBatchesEqual (batch, copy));
+            fetchMissing (*backend, hidden);
+            BEAST_EXPECT(! boost::filesystem::exists (
+                boost::filesystem::path (tempDir.path ()) /
+                    "membership.filter"));
+            backend->setDeletePath ();
+        }
+
+        // Without a saved filter every fetch reaches the backend
+        {
+            auto backend = filtered (false);
+            Batch copy;
+            fetchCopyOfBatch (*backend, &copy, hidden);
+            BEAST_EXPECT(areBatchesEqual (hidden, copy));
+        }
+    }
+
+    void
+    run ()
+    {
+        testFilter ();
+        testBackend ();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(MembershipFilter,NodeStore,ripple);
+
+}
+}
@@ -0,0 +1,143 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright 2014 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/overlay/impl/MessageStats.h>
+#include <ripple/overlay/impl/ProtocolMessage.h>
+#include <ripple/beast/unit_test.h>
+#include <beast/core/streambuf.hpp>
+
+namespace ripple {
+
+class MessageStats_test : public beast::unit_test::suite
+{
+public:
+    // Records what invokeProtocolMessage reports
+    struct Handler
+    {
+        std::uint16_t type = 0;
+        std::size_t size = 0;
+        bool parsed = false;
+        bool handled = false;
+
+        boost::system::error_code
+        onMessageUnknown (std::uint16_t)
+        {
+            return {};
+        }
+
+        boost::system::error_code
+        onMessageBegin (std::uint16_t type_,
+            std::shared_ptr <::google::protobuf::Message> const&,
+            std::size_t size_, std::chrono::steady_clock::duration parseTime)
+        {
+            type = type_;
+            size = size_;
+            parsed = parseTime >= std::chrono::steady_clock::duration::zero();
+            return {};
+        }
+
+        template <class T>
+        void
+        onMessage (std::shared_ptr <T> const&)
+        {
+            handled = true;
+        }
+
+        void
+        onMessageEnd (std::uint16_t,
+            std::shared_ptr <::google::protobuf::Message> const&)
+        {
+        }
+    };
+
+    void
+    testInvoke ()
+    {
+        testcase ("invoke");
+
+        protocol::TMPing ping;
+        ping.set_type (protocol::TMPing::ptPING);
+        ping.set_seq (7);
+
+        beast::streambuf sb;
+        write (sb, ping, protocol::mtPING, 4096);
+        auto const bytes = sb.size ();
+
+        Handler h;
+        auto const result = invokeProtocolMessage (sb.data (), h);
+        BEAST_EXPECT(! result.second);
+        BEAST_EXPECT(result.first == bytes);
+        BEAST_EXPECT(h.type == protocol::mtPING);
+        BEAST_EXPECT(h.size == bytes);
+        BEAST_EXPECT(h.parsed);
+        BEAST_EXPECT(h.handled);
+    }
+
+    void
+    testTotals ()
+    {
+        testcase ("totals");
+
+        using namespace std::chrono;
+
+        MessageStats stats;
+        BEAST_EXPECT(stats.json ().size () == 0);
+
+        stats.addIn (protocol::mtTRANSACTION, 100,
+            microseconds (5), microseconds (40));
+        stats.addIn (protocol::mtTRANSACTION, 50,
+            microseconds (1), microseconds (10));
+        stats.addOut (protocol::mtTRANSACTION, 150);
+        stats.addSendQueue (protocol::mtTRANSACTION, milliseconds (2));
+        stats.addJob (protocol::mtTRANSACTION, microseconds (300));
+
+        // Types outside the table are counted as unknown
+        stats.addOut (1000, 10);
+
+        auto const t = stats.get (protocol::mtTRANSACTION);
+        BEAST_EXPECT(t.bytesIn == 150);
+        BEAST_EXPECT(t.messagesIn == 2);
+        BEAST_EXPECT(t.bytesOut == 150);
+        BEAST_EXPECT(t.messagesOut == 1);
+        BEAST_EXPECT(t.parseTime == 6);
+        BEAST_EXPECT(t.handlerTime == 50);
+        BEAST_EXPECT(t.sendQueueTime == 2000);
+        BEAST_EXPECT(t.jobs == 1);
+        BEAST_EXPECT(t.jobQueueTime == 300);
+        BEAST_EXPECT(! stats.get (protocol::mtVALIDATION));
+
+        auto const json = stats.json ();
+        BEAST_EXPECT(json.size () == 2);
+        BEAST_EXPECT(json["tx"]["bytes_in"] == "150");
+        BEAST_EXPECT(json["tx"]["job_queue_us"] == "300");
+        BEAST_EXPECT(json["unknown"]["bytes_out"] == "10");
+    }
+
+    void
+    run () override
+    {
+        testInvoke ();
+        testTotals ();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(MessageStats,overlay,ripple);
+
+}
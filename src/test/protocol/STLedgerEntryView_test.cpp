@@ -0,0 +1,224 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/protocol/STLedgerEntryView.h>
+#include <ripple/protocol/Indexes.h>
+#include <ripple/protocol/SecretKey.h>
+#include <ripple/protocol/st.h>
+#include <ripple/beast/unit_test.h>
+
+namespace ripple {
+
+class STLedgerEntryView_test : public beast::unit_test::suite
+{
+    static
+    std::shared_ptr<Serializer>
+    serialize (STLedgerEntry const& sle)
+    {
+        auto s = std::make_shared<Serializer>();
+        sle.add (*s);
+        return s;
+    }
+
+    static
+    STLedgerEntryView
+    makeView (STLedgerEntry const& sle)
+    {
+        auto const s = serialize (sle);
+        return STLedgerEntryView (sle.key(), s->slice(), s);
+    }
+
+public:
+    void
+    testAccountRoot()
+    {
+        testcase ("AccountRoot");
+
+        auto const id = calcAccountID (
+            generateKeyPair (KeyType::secp256k1,
+                generateSeed ("alice")).first);
+
+        STLedgerEntry sle (keylet::account (id));
+        sle[sfAccount] = id;
+        sle[sfSequence] = 42;
+        sle[sfBalance] = STAmount (XRPAmount (1000000));
+        sle[sfOwnerCount] = 3;
+        sle[sfPreviousTxnID] = uint256 (7);
+        sle[sfPreviousTxnLgrSeq] = 99;
+        sle[sfFlags] = lsfRequireDestTag | lsfGlobalFreeze;
+        sle[sfTransferRate] = 1005000000;
+        sle[sfDomain] = makeSlice (std::string ("example.com"));
+
+        auto const view = makeView (sle);
+        BEAST_EXPECT(view.key() == sle.key());
+        BEAST_EXPECT(view.getType() == ltACCOUNT_ROOT);
+        BEAST_EXPECT(view[sfAccount] == id);
+        BEAST_EXPECT(view[sfSequence] == 42);
+        BEAST_EXPECT(view[sfBalance] == sle[sfBalance]);
+        BEAST_EXPECT(view[sfOwnerCount] == 3);
+        BEAST_EXPECT(view[sfPreviousTxnID] == uint256 (7));
+        BEAST_EXPECT(view[sfPreviousTxnLgrSeq] == 99);
+        BEAST_EXPECT(view.isFlag (lsfGlobalFreeze));
+        BEAST_EXPECT(! view.isFlag (lsfDisableMaster));
+        BEAST_EXPECT(view[~sfTransferRate] == std::uint32_t(1005000000));
+        BEAST_EXPECT(view[sfDomain] == makeSlice (
+            std::string ("example.com")));
+
+        // Absent optional fields
+        BEAST_EXPECT(! view.isFieldPresent (sfRegularKey));
+        BEAST_EXPECT(! view[~sfRegularKey]);
+        BEAST_EXPECT(! view[~sfTickSize]);
+        BEAST_EXPECT(view.isFieldPresent (sfDomain));
+
+        // Fields which are not part of the template
+        BEAST_EXPECT(! view.isFieldPresent (sfLowLimit));
+        BEAST_EXPECT(! view[~sfLowLimit]);
+
+        try
+        {
+            view[sfRegularKey];
+            fail ("missing field");
+        }
+        catch (missing_field_error const&)
+        {
+            pass();
+        }
+
+        // Full deserialization produces the same entry
+        auto const copy = view.sle();
+        BEAST_EXPECT(copy->getSerializer() == sle.getSerializer());
+        BEAST_EXPECT(copy->key() == sle.key());
+    }
+
+    void
+    testRippleState()
+    {
+        testcase ("RippleState");
+
+        auto const alice = calcAccountID (
+            generateKeyPair (KeyType::secp256k1,
+                generateSeed ("alice")).first);
+        auto const gw = calcAccountID (
+            generateKeyPair (KeyType::secp256k1,
+                generateSeed ("gw")).first);
+        Currency const usd = to_currency ("USD");
+
+        STLedgerEntry sle (keylet::line (alice, gw, usd));
+        sle[sfBalance] = STAmount (Issue{usd, noAccount()}, std::uint64_t(1234), -2, true);
+        sle[sfLowLimit] = STAmount (Issue{usd, alice}, std::uint64_t(100));
+        sle[sfHighLimit] = STAmount (Issue{usd, gw}, std::uint64_t(0));
+        sle[sfPreviousTxnID] = uint256 (1);
+        sle[sfPreviousTxnLgrSeq] = 5;
+        sle[sfFlags] = lsfLowReserve | lsfHighFreeze;
+        sle[sfLowNode] = 0x1234567890;
+        sle[sfHighQualityIn] = 1000000;
+
+        auto const view = makeView (sle);
+        BEAST_EXPECT(view.getType() == ltRIPPLE_STATE);
+        BEAST_EXPECT(view[sfBalance] == sle[sfBalance]);
+        BEAST_EXPECT(view[sfBalance].negative());
+        BEAST_EXPECT(view[sfLowLimit] == sle[sfLowLimit]);
+        BEAST_EXPECT(view[sfLowLimit].getIssuer() == alice);
+        BEAST_EXPECT(view[sfHighLimit].getIssuer() == gw);
+        BEAST_EXPECT(view[~sfLowNode] == std::uint64_t(0x1234567890));
+        BEAST_EXPECT(! view[~sfHighNode]);
+        BEAST_EXPECT(view[~sfHighQualityIn] == std::uint32_t(1000000));
+        BEAST_EXPECT(! view[~sfLowQualityIn]);
+        BEAST_EXPECT(view.isFlag (lsfHighFreeze));
+        BEAST_EXPECT(! view.isFlag (lsfLowFreeze));
+    }
+
+    void
+    testWrapped()
+    {
+        testcase ("wrapped entry");
+
+        auto sle = std::make_shared<STLedgerEntry>(
+            keylet::account (noAccount()));
+        (*sle)[sfAccount] = noAccount();
+        (*sle)[sfFlags] = lsfGlobalFreeze;
+        (*sle)[sfSequence] = 1;
+
+        STLedgerEntryView const view (sle);
+        BEAST_EXPECT(view.key() == sle->key());
+        BEAST_EXPECT(view.getType() == ltACCOUNT_ROOT);
+        BEAST_EXPECT(view[sfSequence] == 1);
+        BEAST_EXPECT(view.isFlag (lsfGlobalFreeze));
+        BEAST_EXPECT(! view[~sfTransferRate]);
+        BEAST_EXPECT(view.sle() == sle);
+    }
+
+    void
+    testMissingFlags()
+    {
+        testcase ("missing flags");
+
+        // Behave like STObject::isFlag, which treats
+        // an entry without flags as having none set.
+        STObject obj (sfLedgerEntry);
+        obj.setFieldU16 (sfLedgerEntryType, ltACCOUNT_ROOT);
+        obj.setFieldU32 (sfSequence, 5);
+        Serializer s;
+        obj.add (s);
+
+        STLedgerEntryView const view (uint256(), s.slice(), nullptr);
+        BEAST_EXPECT(! view.isFieldPresent (sfFlags));
+        BEAST_EXPECT(view.getFlags() == obj.getFlags());
+        BEAST_EXPECT(view.getFlags() == 0);
+        BEAST_EXPECT(! view.isFlag (lsfGlobalFreeze));
+        BEAST_EXPECT(view.isFlag (0));
+        BEAST_EXPECT(view[sfSequence] == 5);
+    }
+
+    void
+    testInvalid()
+    {
+        testcase ("invalid entry");
+
+        STObject obj (sfGeneric);
+        obj.setFieldU16 (sfLedgerEntryType, 0x7777);
+        Serializer s;
+        obj.add (s);
+
+        try
+        {
+            STLedgerEntryView view (uint256(), s.slice(), nullptr);
+            fail ("unknown type");
+        }
+        catch (std::runtime_error const&)
+        {
+            pass();
+        }
+    }
+
+    void
+    run() override
+    {
+        testAccountRoot();
+        testRippleState();
+        testWrapped();
+        testMissingFlags();
+        testInvalid();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(STLedgerEntryView,protocol,ripple);
+
+} // ripple
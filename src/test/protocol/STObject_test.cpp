@@ -22,10 +22,13 @@
 #include <ripple/protocol/SecretKey.h>
 #include <ripple/protocol/st.h>
 #include <ripple/json/json_reader.h>
+#include <ripple/json/Object.h>
 #include <ripple/json/to_string.h>
 #include <ripple/beast/unit_test.h>
 #include <test/jtx.h>
 
+#include <chrono>
+
 #include <memory>
 #include <type_traits>
 
@@ -500,6 +503,190 @@ public:
         }
     }
 
+    void testFieldIndex()
+    {
+        testcase ("field index");
+
+        // A free object built out of canonical order
+        {
+            STObject st (sfGeneric);
+            st.setFieldU32 (sfSequence, 3);
+            st.setFieldU32 (sfFlags, 1);
+            st.setFieldAmount (sfBalance, STAmount (100));
+            st.setAccountID (sfAccount, AccountID{});
+
+            BEAST_EXPECT(st.getFieldIndex (sfSequence) == 0);
+            BEAST_EXPECT(st.getFieldIndex (sfFlags) == 1);
+            BEAST_EXPECT(st.getFieldIndex (sfBalance) == 2);
+            BEAST_EXPECT(st.getFieldIndex (sfAccount) == 3);
+            BEAST_EXPECT(st.getFieldIndex (sfOwnerCount) == -1);
+            BEAST_EXPECT(st.getFieldU32 (sfFlags) == 1);
+            BEAST_EXPECT(st.getFieldU32 (sfSequence) == 3);
+
+            // Round trip through the canonical serialization
+            // produces the fields in fieldCode order.
+            Serializer s;
+            st.add (s);
+            STObject copy (SerialIter{s.slice()}, sfGeneric);
+            BEAST_EXPECT(copy.getCount () == 4);
+            BEAST_EXPECT(copy.getFieldIndex (sfFlags) == 0);
+            BEAST_EXPECT(copy.getFieldIndex (sfSequence) == 1);
+            BEAST_EXPECT(copy.getFieldIndex (sfBalance) == 2);
+            BEAST_EXPECT(copy.getFieldIndex (sfAccount) == 3);
+            BEAST_EXPECT(copy.getFieldIndex (sfOwnerCount) == -1);
+            BEAST_EXPECT(copy.getFieldU32 (sfSequence) == 3);
+            BEAST_EXPECT(copy.getFieldAmount (sfBalance) == STAmount (100));
+            BEAST_EXPECT(copy == st);
+
+            // Deleting fields keeps the remaining ones reachable
+            BEAST_EXPECT(copy.delField (sfSequence));
+            BEAST_EXPECT(! copy.delField (sfSequence));
+            BEAST_EXPECT(copy.getFieldIndex (sfFlags) == 0);
+            BEAST_EXPECT(copy.getFieldIndex (sfSequence) == -1);
+            BEAST_EXPECT(copy.getFieldIndex (sfBalance) == 1);
+            BEAST_EXPECT(copy.getFieldIndex (sfAccount) == 2);
+
+            // Adding a field out of order still finds every field
+            copy.setFieldU32 (sfOwnerCount, 7);
+            copy.setFieldU32 (sfSequence, 4);
+            BEAST_EXPECT(copy.getFieldU32 (sfOwnerCount) == 7);
+            BEAST_EXPECT(copy.getFieldU32 (sfSequence) == 4);
+            BEAST_EXPECT(copy.getFieldU32 (sfFlags) == 1);
+            BEAST_EXPECT(copy.getAccountID (sfAccount) == AccountID{});
+        }
+
+        // Objects large enough to be searched by bisection
+        {
+            std::vector<SField const*> const fields = {
+                &sfFlags, &sfSourceTag, &sfSequence, &sfPreviousTxnLgrSeq,
+                &sfLedgerSequence, &sfCloseTime, &sfParentCloseTime,
+                &sfSigningTime, &sfExpiration, &sfTransferRate,
+                &sfWalletSize, &sfOwnerCount, &sfDestinationTag };
+
+            STObject st (sfGeneric);
+            for (auto iter = fields.rbegin(); iter != fields.rend(); ++iter)
+                st.setFieldU32 (**iter, (*iter)->fieldCode);
+
+            Serializer s;
+            st.add (s);
+            STObject copy (SerialIter{s.slice()}, sfGeneric);
+            BEAST_EXPECT(copy == st);
+
+            int i = 0;
+            for (auto const f : fields)
+            {
+                BEAST_EXPECT(copy.getFieldIndex (*f) == i++);
+                BEAST_EXPECT(copy.getFieldU32 (*f) == f->fieldCode);
+                BEAST_EXPECT(st.getFieldU32 (*f) == f->fieldCode);
+            }
+            BEAST_EXPECT(copy.getFieldIndex (sfHighQualityIn) == -1);
+            BEAST_EXPECT(copy.getFieldIndex (sfLedgerEntryType) == -1);
+            BEAST_EXPECT(copy.getFieldIndex (sfAccount) == -1);
+
+            copy.setFieldU16 (sfLedgerEntryType, 1);
+            BEAST_EXPECT(copy.getFieldU16 (sfLedgerEntryType) == 1);
+            BEAST_EXPECT(copy.getFieldU32 (sfDestinationTag) ==
+                sfDestinationTag.fieldCode);
+        }
+
+        // Applying a template to a deserialized free object
+        {
+            SOTemplate sot;
+            sot.push_back (SOElement (sfAccount, SOE_REQUIRED));
+            sot.push_back (SOElement (sfSequence, SOE_REQUIRED));
+            sot.push_back (SOElement (sfOwnerCount, SOE_OPTIONAL));
+            sot.push_back (SOElement (sfFlags, SOE_REQUIRED));
+
+            STObject st (sfGeneric);
+            st.setFieldU32 (sfFlags, 5);
+            st.setFieldU32 (sfSequence, 6);
+            st.setAccountID (sfAccount, AccountID{});
+
+            Serializer s;
+            st.add (s);
+            STObject copy (SerialIter{s.slice()}, sfGeneric);
+            BEAST_EXPECT(copy.setType (sot));
+            BEAST_EXPECT(copy.getFieldIndex (sfAccount) == 0);
+            BEAST_EXPECT(copy.getFieldIndex (sfSequence) == 1);
+            BEAST_EXPECT(copy.getFieldIndex (sfOwnerCount) == 2);
+            BEAST_EXPECT(copy.getFieldIndex (sfFlags) == 3);
+            BEAST_EXPECT(! copy.isFieldPresent (sfOwnerCount));
+            BEAST_EXPECT(copy.getFieldU32 (sfFlags) == 5);
+            BEAST_EXPECT(copy.getFieldU32 (sfSequence) == 6);
+
+            // A missing required field is reported
+            STObject partial (sfGeneric);
+            partial.setFieldU32 (sfFlags, 5);
+            BEAST_EXPECT(! partial.setType (sot));
+            BEAST_EXPECT(partial.getFieldU32 (sfFlags) == 5);
+        }
+    }
+
+    void testAddJson ()
+    {
+        testcase ("add json");
+
+        auto check = [&](std::string const& json)
+        {
+            Json::Value jsonObject;
+            if (! parseJSONString (json, jsonObject))
+            {
+                fail ("Couldn't parse json: " + json);
+                return;
+            }
+
+            STParsedJSONObject parsed ("test", jsonObject);
+            if (! BEAST_EXPECT(parsed.object))
+                return;
+
+            std::string written;
+            {
+                auto wo = Json::stringWriterObject (written);
+                parsed.object->addJson (*wo, 0);
+            }
+
+            // The fields are written in key order, as to_string writes
+            // the Json::Value, so the output is byte for byte the same.
+            BEAST_EXPECT(written == to_string (parsed.object->getJson (0)));
+        };
+
+        check (R"({
+            "TransactionType": "Payment",
+            "Account": "rHb9CJAWyB4rj91VRWn96DkukG4bwdtyTh",
+            "Destination": "rPMh7Pi9ct699iZUTWaytJUoHcJ7cgyziK",
+            "Amount": {
+                "currency": "USD",
+                "issuer": "rPMh7Pi9ct699iZUTWaytJUoHcJ7cgyziK",
+                "value": "-1.5e-7"
+            },
+            "SendMax": "1000000",
+            "Fee": "10",
+            "Flags": 2147483648,
+            "Sequence": 7,
+            "Memos": [
+                {"Memo": {"MemoType": "74657374", "MemoData": "2F2F22"}},
+                {"Memo": {"MemoData": ""}}
+            ],
+            "Paths": [[{
+                "currency": "EUR",
+                "issuer": "rHb9CJAWyB4rj91VRWn96DkukG4bwdtyTh"
+            }]]
+        })");
+
+        check (R"({
+            "AffectedNodes": [{
+                "ModifiedNode": {
+                    "LedgerEntryType": "AccountRoot",
+                    "LedgerIndex": "13F1A95D7AAB7108D5CE7EEAF504B2894B8C674E6D68499076441C4837282BF8",
+                    "FinalFields": {"Balance": "100", "Flags": 0},
+                    "PreviousFields": {"Balance": "200"}
+                }
+            }],
+            "TransactionIndex": 3,
+            "TransactionResult": 128
+        })");
+    }
+
     void
     run()
     {
@@ -507,12 +694,131 @@ public:
         test::jtx::Env env (*this);
 
         testFields();
+        testFieldIndex();
         testSerialization();
         testParseJSONArray();
         testParseJSONArrayWithInvalidChildrenObjects();
+        testAddJson();
     }
 };
 
 BEAST_DEFINE_TESTSUITE(STObject,protocol,ripple);
 
+//------------------------------------------------------------------------------
+
+// Measures field lookup in free (template-less) objects, comparing a
+// canonically ordered object against the same fields in arbitrary order.
+class STObject_timing_test : public beast::unit_test::suite
+{
+    static
+    std::vector<SField const*>
+    fields()
+    {
+        return {
+            &sfLedgerEntryType, &sfFlags, &sfSequence, &sfOwnerCount,
+            &sfPreviousTxnLgrSeq, &sfTransferRate, &sfAccountTxnID,
+            &sfPreviousTxnID, &sfEmailHash, &sfBalance, &sfAccount,
+            &sfRegularKey, &sfDomain, &sfMessageKey, &sfWalletLocator,
+            &sfTickSize };
+    }
+
+    void
+    populate (STObject& st, std::vector<SField const*> const& order)
+    {
+        for (auto const f : order)
+        {
+            switch (f->fieldType)
+            {
+            case STI_UINT8:
+                st.setFieldU8 (*f, 5);
+                break;
+            case STI_UINT16:
+                st.setFieldU16 (*f, 0x61);
+                break;
+            case STI_UINT32:
+                st.setFieldU32 (*f, 1);
+                break;
+            case STI_HASH128:
+                st.setFieldH128 (*f, uint128{});
+                break;
+            case STI_HASH256:
+                st.setFieldH256 (*f, uint256{});
+                break;
+            case STI_AMOUNT:
+                st.setFieldAmount (*f, STAmount (1000));
+                break;
+            case STI_ACCOUNT:
+                st.setAccountID (*f, AccountID{});
+                break;
+            default:
+                st.setFieldVL (*f, Blob (8, 1));
+                break;
+            }
+        }
+    }
+
+    void
+    measure (char const* name, STObject const& st,
+        std::vector<SField const*> const& lookups)
+    {
+        using namespace std::chrono;
+
+        int const iterations = 1000000;
+        std::size_t found = 0;
+        auto const start = high_resolution_clock::now ();
+        for (int i = 0; i != iterations; ++i)
+            for (auto const f : lookups)
+                found += st.peekAtPField (*f) != nullptr;
+        auto const elapsed = duration_cast<nanoseconds>(
+            high_resolution_clock::now () - start);
+
+        log << "    " << name << ": " <<
+            (double(elapsed.count()) / (iterations * lookups.size())) <<
+            " ns/lookup (" << found << ")" << std::endl;
+    }
+
+public:
+    void
+    run()
+    {
+        auto const canonical = fields();
+        auto reversed = canonical;
+        std::reverse (reversed.begin(), reversed.end());
+
+        STObject unsorted (sfGeneric);
+        populate (unsorted, reversed);
+
+        Serializer s;
+        unsorted.add (s);
+        STObject sorted (SerialIter{s.slice()}, sfGeneric);
+
+        BEAST_EXPECT(sorted == unsorted);
+
+        measure ("linear scan", unsorted, canonical);
+        measure ("sorted", sorted, canonical);
+
+        // Deserializing a ledger entry looks up its type in the free
+        // object and then applies the matching template.
+        {
+            using namespace std::chrono;
+
+            int const iterations = 200000;
+            auto const start = high_resolution_clock::now ();
+            for (int i = 0; i != iterations; ++i)
+            {
+                SerialIter sit (s.slice());
+                STLedgerEntry sle (sit, uint256{});
+                (void) sle.getFieldU32 (sfSequence);
+            }
+            auto const elapsed = duration_cast<nanoseconds>(
+                high_resolution_clock::now () - start);
+            log << "    deserialize ledger entry: " <<
+                (double(elapsed.count()) / iterations) <<
+                " ns/object" << std::endl;
+        }
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(STObject_timing,protocol,ripple);
+
 } // ripple
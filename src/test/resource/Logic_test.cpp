@@ -25,6 +25,8 @@
 #include <ripple/resource/Consumer.h>
 #include <ripple/resource/impl/Entry.h>
 #include <ripple/resource/impl/Logic.h>
+#include <thread>
+#include <vector>
 
 
 
@@ -243,6 +245,64 @@ public:
         pass();
     }
 
+    void testDecay ()
+    {
+        testcase ("Decay");
+
+        TestStopwatch clock;
+        DecayingSample <decayWindowSeconds, clock_type> expected (clock.now());
+        AtomicDecayingSample <decayWindowSeconds, clock_type> actual (clock.now());
+
+        bool same = true;
+        for (int i = 0; i < 1024; ++i)
+        {
+            if (i % 3 == 0)
+            {
+                auto const cost = rand_int (1000);
+                same = same &&
+                    expected.add (cost, clock.now()) ==
+                        actual.add (cost, clock.now());
+            }
+            same = same &&
+                expected.value (clock.now()) == actual.value (clock.now());
+            clock.advance (std::chrono::seconds (rand_int (8) / 4));
+        }
+        BEAST_EXPECT(same);
+
+        // A long idle period resets the balance.
+        actual.add (100000, clock.now());
+        clock.advance (std::chrono::seconds (4 * decayWindowSeconds + 1));
+        BEAST_EXPECT(actual.value (clock.now()) == 0);
+    }
+
+    void testConcurrentCharges (beast::Journal j)
+    {
+        testcase ("Concurrent charges");
+
+        TestLogic logic (j);
+
+        beast::IP::Endpoint address (beast::IP::Endpoint::from_string ("192.0.2.3"));
+        Consumer c (logic.newInboundEndpoint (address));
+
+        int const threads = 8;
+        int const charges = 1000;
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t)
+        {
+            workers.emplace_back ([&c]
+                {
+                    Consumer mine (c);
+                    for (int i = 0; i < charges; ++i)
+                        mine.charge (Charge (decayWindowSeconds));
+                });
+        }
+        for (auto& w : workers)
+            w.join ();
+
+        // The clock did not advance, so no charge decayed away.
+        BEAST_EXPECT(c.balance () == threads * charges);
+    }
+
     void run()
     {
         beast::Journal j;
@@ -251,10 +311,68 @@ public:
         testCharges (j);
         testImports (j);
         testImport (j);
+        testDecay ();
+        testConcurrentCharges (j);
     }
 };
 
 BEAST_DEFINE_TESTSUITE(Manager,resource,ripple);
 
+//------------------------------------------------------------------------------
+
+class Logic_timing_test : public beast::unit_test::suite
+{
+public:
+    void run()
+    {
+        using namespace std::chrono;
+
+        Logic logic (beast::insight::NullCollector::New(),
+            stopwatch(), beast::Journal());
+
+        // Thousands of clients, spread over every available thread
+        int const consumers = 4096;
+        int const threads = std::max (4u, std::thread::hardware_concurrency ());
+        int const rounds = 256;
+
+        std::vector<Consumer> table;
+        table.reserve (consumers);
+        for (int i = 0; i < consumers; ++i)
+            table.push_back (logic.newInboundEndpoint (
+                beast::IP::Endpoint (beast::IP::AddressV4 (
+                    10, (i >> 16) & 0xff, (i >> 8) & 0xff, i & 0xff))));
+
+        std::vector<std::thread> workers;
+        auto const start = steady_clock::now ();
+        for (int t = 0; t < threads; ++t)
+        {
+            workers.emplace_back ([&table, t, threads]
+                {
+                    for (int r = 0; r < rounds; ++r)
+                    {
+                        for (std::size_t i = t; i < table.size (); i += threads)
+                        {
+                            auto& c = table[i];
+                            if (c.charge (feeReferenceRPC) != ok)
+                                c.disconnect ();
+                            c.warn ();
+                        }
+                    }
+                });
+        }
+        for (auto& w : workers)
+            w.join ();
+        auto const elapsed = duration_cast<duration<double>> (
+            steady_clock::now () - start);
+
+        log << consumers << " consumers, " << threads << " threads: " <<
+            (double (consumers) * rounds / elapsed.count ()) <<
+            " charges/s" << std::endl;
+        pass ();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(Logic_timing,resource,ripple);
+
 }
 }
@@ -18,8 +18,12 @@
 //==============================================================================
 
 #include <BeastConfig.h>
+#include <ripple/json/to_string.h>
 #include <ripple/protocol/ErrorCodes.h>
 #include <ripple/protocol/JsonFields.h>
+#include <ripple/resource/Fees.h>
+#include <ripple/rpc/Context.h>
+#include <ripple/rpc/RPCHandler.h>
 #include <test/jtx.h>
 #include <ripple/beast/unit_test.h>
 
@@ -279,6 +283,155 @@ class LedgerRPC_test : public beast::unit_test::suite
         }
     }
 
+    void testStreamedResult()
+    {
+        testcase("Streamed Result Matches Json::Value");
+        using namespace test::jtx;
+
+        Env env {*this};
+        Account const gw {"gateway"};
+        Account const alice {"alice"};
+        auto const USD = gw["USD"];
+        env.fund (XRP(10000), gw, alice);
+        env.close();
+        env.trust (USD(1000), alice);
+        env (pay (gw, alice, USD(100)));
+        // Not self funded, so it shows the owner's funds
+        env (offer (alice, XRP(10), USD(5)));
+        auto const offerID = to_string (env.tx()->getTransactionID());
+        env.close();
+
+        // The streamed result must be byte for byte the to_string of the
+        // Json::Value result, with the status the server adds to it.
+        auto check = [&](Json::Value params, Role role)
+        {
+            auto call = [&](auto&& f)
+            {
+                Resource::Charge loadType = Resource::feeReferenceRPC;
+                Resource::Consumer c;
+                RPC::Context context {beast::Journal(), params, env.app(),
+                    loadType, env.app().getOPs(),
+                        env.app().getLedgerMaster(), c, role, {}};
+                return f (context);
+            };
+
+            auto const expected = call ([&](RPC::Context& context)
+            {
+                Json::Value result;
+                RPC::doCommand (context, result);
+                if (result.isMember (jss::error))
+                {
+                    result[jss::status] = jss::error;
+                    result[jss::request] = params;
+                }
+                else
+                {
+                    result[jss::status] = jss::success;
+                }
+                return to_string (result);
+            });
+
+            std::string streamed;
+            bool const success = call ([&](RPC::Context& context)
+            {
+                return RPC::executeRPC (context, streamed);
+            });
+
+            BEAST_EXPECT(streamed == expected);
+            return success;
+        };
+
+        Json::Value params;
+        params[jss::command] = "ledger";
+        BEAST_EXPECT(check (params, Role::ADMIN));
+
+        params[jss::ledger_index] = "validated";
+        BEAST_EXPECT(check (params, Role::ADMIN));
+
+        params[jss::ledger_index] = "current";
+        params[jss::transactions] = true;
+        BEAST_EXPECT(check (params, Role::ADMIN));
+
+        params[jss::ledger_index] = env.closed()->info().seq;
+        params[jss::expand] = true;
+        params[jss::owner_funds] = true;
+        BEAST_EXPECT(check (params, Role::ADMIN));
+
+        params[jss::full] = true;
+        BEAST_EXPECT(check (params, Role::ADMIN));
+
+        params[jss::binary] = true;
+        BEAST_EXPECT(check (params, Role::ADMIN));
+
+        params[jss::binary] = false;
+        params[jss::full] = false;
+        params[jss::accounts] = true;
+        BEAST_EXPECT(check (params, Role::ADMIN));
+
+        // Errors are reported as the Json::Value path reports them
+        BEAST_EXPECT(! check (params, Role::USER));
+
+        params = Json::objectValue;
+        params[jss::command] = "ledger";
+        params[jss::ledger_index] = "nonsense";
+        BEAST_EXPECT(! check (params, Role::ADMIN));
+
+        params = Json::objectValue;
+        params[jss::command] = "version";
+        BEAST_EXPECT(check (params, Role::ADMIN));
+
+        params = Json::objectValue;
+        params[jss::command] = "tx";
+        params[jss::transaction] = offerID;
+        BEAST_EXPECT(check (params, Role::USER));
+
+        params[jss::binary] = true;
+        BEAST_EXPECT(check (params, Role::USER));
+
+        params[jss::transaction] = to_string (uint256 {});
+        BEAST_EXPECT(! check (params, Role::USER));
+
+        params = Json::objectValue;
+        params[jss::command] = "account_tx";
+        params[jss::account] = alice.human();
+        params[jss::ledger_index_min] = -1;
+        params[jss::ledger_index_max] = -1;
+        BEAST_EXPECT(check (params, Role::USER));
+
+        params[jss::binary] = true;
+        BEAST_EXPECT(check (params, Role::USER));
+
+        params[jss::binary] = false;
+        params[jss::limit] = 1;
+        BEAST_EXPECT(check (params, Role::USER));
+
+        params.removeMember (jss::limit);
+        params.removeMember (jss::ledger_index_min);
+        params.removeMember (jss::ledger_index_max);
+        params[jss::ledger_index] = "validated";
+        BEAST_EXPECT(check (params, Role::USER));
+
+        params[jss::account] = "nonsense";
+        BEAST_EXPECT(! check (params, Role::USER));
+
+        // The deprecated form is answered by doAccountTxOld
+        params = Json::objectValue;
+        params[jss::command] = "account_tx";
+        params[jss::account] = alice.human();
+        params[jss::ledger_min] = -1;
+        params[jss::ledger_max] = -1;
+        params[jss::offset] = 1;
+        BEAST_EXPECT(check (params, Role::USER));
+
+        params[jss::account] = "nonsense";
+        BEAST_EXPECT(! check (params, Role::USER));
+
+        // A handler without a streaming method is unchanged
+        params = Json::objectValue;
+        params[jss::command] = "ledger_closed";
+        BEAST_EXPECT(check (params, Role::ADMIN));
+    }
+
 public:
     void run ()
     {
@@ -292,6 +445,7 @@ public:
         testMalformedAccountRoot();
         testNotFoundAccountRoot();
         testAccountRootFromIndex();
+        testStreamedResult();
     }
 };
 
@@ -0,0 +1,272 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ripple/beast/insight/NullCollector.h>
+#include <ripple/json/json_reader.h>
+#include <ripple/protocol/JsonFields.h>
+#include <ripple/resource/Fees.h>
+#include <ripple/rpc/Context.h>
+#include <ripple/rpc/RPCHandler.h>
+#include <ripple/rpc/impl/ResponseCache.h>
+#include <test/jtx/JSONRPCClient.h>
+#include <test/jtx.h>
+#include <ripple/beast/unit_test.h>
+
+namespace ripple {
+namespace test {
+
+class ResponseCache_test : public beast::unit_test::suite
+{
+    static
+    std::unique_ptr<Config>
+    makeConfig (int size)
+    {
+        auto p = std::make_unique<Config>();
+        setupConfigForUnitTests(*p);
+        (*p)["port_rpc"].set("admin","");
+        (*p)["rpc_response_cache"].set("size", std::to_string(size));
+        return p;
+    }
+
+public:
+    void testValidated(int size)
+    {
+        testcase << "Validated ledger, cache size " << size;
+        using namespace jtx;
+        Env env(*this, makeConfig(size));
+
+        Account const alice {"alice"};
+        Account const bob {"bob"};
+        env.fund (XRP (10000), alice, bob);
+        env.close();
+
+        auto client = makeJSONRPCClient(env.app().config());
+
+        Json::Value params;
+        params[jss::account] = alice.human();
+        params[jss::ledger_index] = "validated";
+
+        auto const first = client->invoke("account_info", params);
+        auto const second = client->invoke("account_info", params);
+        BEAST_EXPECT(first[jss::result][jss::status] == jss::success);
+        BEAST_EXPECT(first[jss::result] == second[jss::result]);
+        BEAST_EXPECT(first[jss::result][jss::account_data]
+            [sfBalance.fieldName] == "10000000000");
+
+        // The same ledger, requested by sequence.
+        params[jss::ledger_index] =
+            first[jss::result][jss::ledger_index];
+        auto const bySeq = client->invoke("account_info", params);
+        BEAST_EXPECT(bySeq[jss::result][jss::account_data] ==
+            first[jss::result][jss::account_data]);
+
+        // A newly validated ledger is a different entry.
+        env (pay (alice, bob, XRP (1)));
+        env.close();
+        params[jss::ledger_index] = "validated";
+        auto const third = client->invoke("account_info", params);
+        BEAST_EXPECT(third[jss::result][jss::status] == jss::success);
+        BEAST_EXPECT(third[jss::result][jss::account_data]
+            [sfBalance.fieldName] == "9998999990");
+
+        // Errors are reported every time.
+        params[jss::account] = Account("carol").human();
+        for (int i = 0; i < 2; ++i)
+        {
+            auto const jv = client->invoke("account_info", params);
+            BEAST_EXPECT(jv[jss::result][jss::status] == jss::error);
+            BEAST_EXPECT(jv[jss::result][jss::error] == "actNotFound");
+        }
+    }
+
+    void testCurrent()
+    {
+        testcase ("Current ledger");
+        using namespace jtx;
+        Env env(*this, makeConfig(1024));
+
+        Account const alice {"alice"};
+        Account const bob {"bob"};
+        env.fund (XRP (10000), alice, bob);
+        env.close();
+
+        auto client = makeJSONRPCClient(env.app().config());
+
+        Json::Value params;
+        params[jss::account] = alice.human();
+
+        auto const before = client->invoke("account_info", params);
+        env (pay (alice, bob, XRP (1)));
+        auto const after = client->invoke("account_info", params);
+        BEAST_EXPECT(before[jss::result][jss::account_data]
+            [sfBalance.fieldName] == "10000000000");
+        BEAST_EXPECT(after[jss::result][jss::account_data]
+            [sfBalance.fieldName] == "9998999990");
+    }
+
+    void testServe()
+    {
+        testcase ("Each result is computed once");
+        using namespace jtx;
+        Env env(*this);
+
+        Account const alice {"alice"};
+        Account const bob {"bob"};
+        env.fund (XRP (10000), alice, bob);
+        env.close();
+
+        RPC::ResponseCache cache (
+            beast::insight::NullCollector::New(), beast::Journal());
+        cache.configure (16, std::chrono::seconds (60), 1 << 20);
+
+        // Counts the commands run, and runs `during` as each one starts.
+        // Each run is charged `charge`, and `loadType` is what the last
+        // request was charged.
+        int runs = 0;
+        std::function<void()> during;
+        Resource::Charge charge = Resource::feeReferenceRPC;
+        Resource::Charge loadType = Resource::feeReferenceRPC;
+        auto request = [&](Json::Value params)
+        {
+            params[jss::command] = "account_info";
+            loadType = Resource::feeReferenceRPC;
+            auto const text = cache.serve (params, Role::USER, env.app(),
+                loadType,
+                [&](Json::Value const& pinned, std::string& output)
+                {
+                    ++runs;
+                    if (during)
+                        during();
+                    loadType = charge;
+                    Resource::Consumer c;
+                    RPC::Context context {beast::Journal(), pinned,
+                        env.app(), loadType, env.app().getOPs(),
+                            env.app().getLedgerMaster(), c, Role::USER, {}};
+                    return RPC::executeRPC (context, output, params);
+                });
+            Json::Value result;
+            BEAST_EXPECT(Json::Reader().parse (text, result));
+            return result;
+        };
+
+        Json::Value params;
+        params[jss::account] = alice.human();
+        params[jss::ledger_index] = "validated";
+
+        auto const first = request (params);
+        BEAST_EXPECT(runs == 1);
+        BEAST_EXPECT(first[jss::status] == jss::success);
+        BEAST_EXPECT(request (params) == first);
+        BEAST_EXPECT(runs == 1);
+
+        // The same ledger by sequence and by hash
+        params[jss::ledger_index] = first[jss::ledger_index];
+        BEAST_EXPECT(request (params) == first);
+        params.removeMember (jss::ledger_index);
+        params[jss::ledger_hash] = first[jss::ledger_hash];
+        BEAST_EXPECT(request (params) == first);
+        BEAST_EXPECT(runs == 1);
+
+        // The open ledger is never cached
+        params.removeMember (jss::ledger_hash);
+        request (params);
+        request (params);
+        BEAST_EXPECT(runs == 3);
+
+        // A ledger validates after the key is chosen, while the command
+        // runs. The result is still for the ledger the key names.
+        runs = 0;
+        during = [&]
+        {
+            env (pay (alice, bob, XRP (1)));
+            env.close();
+        };
+        params[jss::ledger_index] = "validated";
+        params[jss::strict] = true;     // Not cached yet
+        auto const pinned = request (params);
+        during = nullptr;
+        BEAST_EXPECT(runs == 1);
+        BEAST_EXPECT(pinned[jss::ledger_hash] == first[jss::ledger_hash]);
+        BEAST_EXPECT(pinned[jss::account_data][sfBalance.fieldName] ==
+            "10000000000");
+
+        auto const next = request (params);
+        BEAST_EXPECT(runs == 2);
+        BEAST_EXPECT(next[jss::ledger_hash] != first[jss::ledger_hash]);
+        BEAST_EXPECT(next[jss::account_data][sfBalance.fieldName] ==
+            "9998999990");
+        BEAST_EXPECT(request (params) == next);
+
+        params.removeMember (jss::ledger_index);
+        params[jss::ledger_hash] = first[jss::ledger_hash];
+        BEAST_EXPECT(request (params) == pinned);
+        BEAST_EXPECT(runs == 2);
+
+        // Errors are never cached, and report the request as it was sent
+        params[jss::account] = Account("carol").human();
+        params.removeMember (jss::ledger_hash);
+        params[jss::ledger_index] = "validated";
+        for (int i = 0; i < 2; ++i)
+        {
+            auto const jv = request (params);
+            BEAST_EXPECT(jv[jss::error] == "actNotFound");
+            BEAST_EXPECT(jv[jss::request][jss::ledger_index] == "validated");
+            BEAST_EXPECT(! jv[jss::request].isMember (jss::ledger_hash));
+        }
+        BEAST_EXPECT(runs == 4);
+
+        // A hit costs what the run which produced it was charged
+        params[jss::account] = alice.human();
+        params[jss::strict] = false;
+        charge = Resource::feeMediumBurdenRPC;
+        request (params);
+        BEAST_EXPECT(runs == 5);
+        BEAST_EXPECT(loadType == Resource::feeMediumBurdenRPC);
+        charge = Resource::feeReferenceRPC;
+        request (params);
+        BEAST_EXPECT(runs == 5);
+        BEAST_EXPECT(loadType == Resource::feeMediumBurdenRPC);
+
+        // Ledger indexes which are out of range are not cached, and do
+        // not throw
+        runs = 0;
+        for (auto const& index : {Json::Value (3000000000u),
+            Json::Value (-1), Json::Value (1e20), Json::Value (-1.5)})
+        {
+            params[jss::ledger_index] = index;
+            request (params);
+            request (params);
+        }
+        BEAST_EXPECT(runs == 8);
+    }
+
+    void run() override
+    {
+        testValidated(1024);
+        testValidated(0);
+        testCurrent();
+        testServe();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(ResponseCache,app,ripple);
+
+} // test
+} // ripple
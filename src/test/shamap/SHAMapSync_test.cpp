@@ -24,6 +24,7 @@
 #include <ripple/basics/random.h>
 #include <ripple/basics/StringUtilities.h>
 #include <ripple/beast/unit_test.h>
+#include <atomic>
 
 namespace ripple {
 namespace tests {
@@ -119,6 +120,39 @@ public:
             });
         BEAST_EXPECT(count == items);
 
+        {
+            std::atomic<int> leaves {0};
+            std::atomic<int> inner {0};
+            source.visitNodesParallel ([&](SHAMapAbstractNode& node)
+                {
+                    if (node.isInner ())
+                        ++inner;
+                    else
+                        ++leaves;
+                    return SHAMap::Visit::descend;
+                }, 4);
+            BEAST_EXPECT(leaves == items);
+
+            int serialInner = 0;
+            source.visitNodes ([&serialInner](SHAMapAbstractNode& node)
+                {
+                    if (node.isInner ())
+                        ++serialInner;
+                    return false;
+                });
+            BEAST_EXPECT(inner == serialInner);
+
+            // Skipping the subtrees below the root visits only its children
+            std::atomic<int> visited {0};
+            source.visitNodesParallel ([&](SHAMapAbstractNode& node)
+                {
+                    ++visited;
+                    return node.getNodeHash () == source.getHash () ?
+                        SHAMap::Visit::descend : SHAMap::Visit::skip;
+                }, 4);
+            BEAST_EXPECT(visited == 17);
+        }
+
         std::vector<SHAMapMissingNode> missingNodes;
         source.walkMap(missingNodes, 2048);
         BEAST_EXPECT(missingNodes.empty());
@@ -18,6 +18,7 @@
 */
 //==============================================================================
 
+#include <test/app/AccountTxIndex_test.cpp>
 #include <test/app/AccountTxPaging_test.cpp>
 #include <test/app/AmendmentTable_test.cpp>
 #include <test/app/CrossingLimits_test.cpp>
@@ -26,8 +27,10 @@
 #include <test/app/Flow_test.cpp>
 #include <test/app/Freeze_test.cpp>
 #include <test/app/HashRouter_test.cpp>
+#include <test/app/LedgerHashIndex_test.cpp>
 #include <test/app/LedgerLoad_test.cpp>
 #include <test/app/LoadFeeTrack_test.cpp>
+#include <test/app/MemoryBudget_test.cpp>
 #include <test/app/MultiSign_test.cpp>
 #include <test/app/OfferStream_test.cpp>
 #include <test/app/Offer_test.cpp>
@@ -43,6 +46,7 @@
 #include <test/app/Transaction_ordering_test.cpp>
 #include <test/app/TrustAndBalance_test.cpp>
 #include <test/app/TxQ_test.cpp>
+#include <test/app/ValidationArchive_test.cpp>
 #include <test/app/ValidatorList_test.cpp>
 #include <test/app/SetTrust_test.cpp>
 #include <test/app/Ticket_test.cpp>
@@ -23,8 +23,11 @@
 #include <test/beast/beast_asio_error_test.cpp>
 #include <test/beast/beast_basic_seconds_clock_test.cpp>
 #include <test/beast/beast_Debug_test.cpp>
+#include <test/beast/beast_Histogram_test.cpp>
+#include <test/beast/beast_PrometheusCollector_test.cpp>
 #include <test/beast/beast_Journal_test.cpp>
 #include <test/beast/beast_PropertyStream_test.cpp>
+#include <test/beast/beast_StatsDCollector_test.cpp>
 #include <test/beast/beast_tagged_integer_test.cpp>
 #include <test/beast/beast_weak_fn_test.cpp>
 #include <test/beast/beast_Zero_test.cpp>
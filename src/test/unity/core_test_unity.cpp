@@ -21,6 +21,8 @@
 #include <test/core/Config_test.cpp>
 #include <test/core/Coroutine_test.cpp>
 #include <test/core/DeadlineTimer_test.cpp>
+#include <test/core/JobProfiler_test.cpp>
+#include <test/core/Reclaimer_test.cpp>
 #include <test/core/SociDB_test.cpp>
 #include <test/core/Stoppable_test.cpp>
 #include <test/core/Workers_test.cpp>
\ No newline at end of file
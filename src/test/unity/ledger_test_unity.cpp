@@ -24,4 +24,5 @@
 #include <test/ledger/PendingSaves_test.cpp>
 #include <test/ledger/SHAMapV2_test.cpp>
 #include <test/ledger/SkipList_test.cpp>
+#include <test/ledger/StateItems_test.cpp>
 #include <test/ledger/View_test.cpp>
@@ -22,5 +22,6 @@
 #include <test/nodestore/Basics_test.cpp>
 #include <test/nodestore/Database_test.cpp>
 #include <test/nodestore/import_test.cpp>
+#include <test/nodestore/MembershipFilter_test.cpp>
 #include <test/nodestore/Timing_test.cpp>
 #include <test/nodestore/varint_test.cpp>
\ No newline at end of file
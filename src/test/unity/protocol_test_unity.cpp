@@ -29,6 +29,7 @@
 #include <test/protocol/Seed_test.cpp>
 #include <test/protocol/STAccount_test.cpp>
 #include <test/protocol/STAmount_test.cpp>
+#include <test/protocol/STLedgerEntryView_test.cpp>
 #include <test/protocol/STObject_test.cpp>
 #include <test/protocol/STTx_test.cpp>
 #include <test/protocol/types_test.cpp>
@@ -32,6 +32,7 @@
 #include <test/rpc/LedgerRPC_test.cpp>
 #include <test/rpc/LedgerRequestRPC_test.cpp>
 #include <test/rpc/NoRipple_test.cpp>
+#include <test/rpc/ResponseCache_test.cpp>
 #include <test/rpc/RobustTransaction_test.cpp>
 #include <test/rpc/RPCOverload_test.cpp>
 #include <test/rpc/ServerInfo_test.cpp>